@@ -0,0 +1,78 @@
+#include "render_benchmark.h"
+
+#include <gris/engine_exception.h>
+#include <gris/log.h>
+
+#include <string>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+RenderBenchmarkSettings ParseArguments(int argc, char * argv[])
+{
+    auto settings = RenderBenchmarkSettings{};
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto const arguments = std::vector<std::string>(argv + 1, argv + argc);
+    for (size_t index = 0; index < arguments.size(); ++index)
+    {
+        auto const & argument = arguments[index];
+        if (index + 1 == arguments.size())
+        {
+            throw Gris::EngineException("Missing value for argument", argument);
+        }
+
+        auto const & value = arguments[++index];
+        if (argument == "--frames")
+        {
+            settings.FrameCount = static_cast<uint32_t>(std::stoul(value));
+        }
+        else if (argument == "--warmup")
+        {
+            settings.WarmupFrameCount = static_cast<uint32_t>(std::stoul(value));
+        }
+        else if (argument == "--width")
+        {
+            settings.Width = static_cast<uint32_t>(std::stoul(value));
+        }
+        else if (argument == "--height")
+        {
+            settings.Height = static_cast<uint32_t>(std::stoul(value));
+        }
+        else if (argument == "--output")
+        {
+            settings.OutputPath = value;
+        }
+        else
+        {
+            throw Gris::EngineException("Unknown argument", argument);
+        }
+    }
+
+    return settings;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+int main(int argc, char * argv[])
+{
+    SetLogLevel(Gris::Log::Level::Info);
+
+    try
+    {
+        RenderBenchmark benchmark(ParseArguments(argc, argv));
+        benchmark.Run();
+    }
+    catch (const std::exception & e)
+    {
+        Gris::Log::Critical(e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,603 @@
+#include "render_benchmark.h"
+
+#include <gris/graphics/image.h>
+#include <gris/graphics/loaders/assimp_mesh_loader.h>
+#include <gris/graphics/loaders/dds_ktx_image_loader.h>
+#include <gris/graphics/scene.h>
+
+#include <gris/graphics/vulkan/immediate_context.h>
+#include <gris/graphics/vulkan/input_layout.h>
+#include <gris/graphics/vulkan/instance.h>
+#include <gris/graphics/vulkan/physical_device_factory.h>
+#include <gris/graphics/vulkan/utils.h>
+
+#include <gris/directory_registry.h>
+#include <gris/engine_exception.h>
+#include <gris/log.h>
+#include <gris/utils.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+// -------------------------------------------------------------------------------------------------
+
+const char * const MODEL_PATH = "sponza.dae";
+const char * const VERTEX_SHADER_PATH = "vertex.spv";
+const char * const FRAGMENT_SHADER_PATH = "fragment.spv";
+
+constexpr static uint32_t VIRTUAL_FRAME_COUNT = 3;
+constexpr static uint32_t MAX_GPU_ZONES_PER_FRAME = 4;
+
+constexpr static size_t GlslMatrixAlignment = 16;
+
+// -------------------------------------------------------------------------------------------------
+
+struct UniformBufferObject
+{
+    alignas(GlslMatrixAlignment) glm::mat4 model;
+    alignas(GlslMatrixAlignment) glm::mat4 view;
+    alignas(GlslMatrixAlignment) glm::mat4 proj;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct SampleSummary
+{
+    size_t Count = 0;
+    double Min = 0.0;
+    double Mean = 0.0;
+    double P50 = 0.0;
+    double P90 = 0.0;
+    double P95 = 0.0;
+    double P99 = 0.0;
+    double Max = 0.0;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+double ToMilliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+double NearestRankPercentile(const std::vector<double> & sortedValues, double percentile)
+{
+    auto const rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sortedValues.size())));
+    return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+SampleSummary Summarize(std::vector<double> values)
+{
+    auto summary = SampleSummary{};
+    if (values.empty())
+    {
+        return summary;
+    }
+
+    std::sort(std::begin(values), std::end(values));
+
+    summary.Count = values.size();
+    summary.Min = values.front();
+    summary.Mean = std::accumulate(std::begin(values), std::end(values), 0.0) / static_cast<double>(values.size());
+    summary.P50 = NearestRankPercentile(values, 50.0);
+    summary.P90 = NearestRankPercentile(values, 90.0);
+    summary.P95 = NearestRankPercentile(values, 95.0);
+    summary.P99 = NearestRankPercentile(values, 99.0);
+    summary.Max = values.back();
+    return summary;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::string ToJson(const SampleSummary & summary)
+{
+    return fmt::format(
+        R"({{ "count": {}, "min": {:.4f}, "mean": {:.4f}, "p50": {:.4f}, "p90": {:.4f}, "p95": {:.4f}, "p99": {:.4f}, "max": {:.4f} }})",
+        summary.Count,
+        summary.Min,
+        summary.Mean,
+        summary.P50,
+        summary.P90,
+        summary.P95,
+        summary.P99,
+        summary.Max);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::string EscapeJson(const std::string & value)
+{
+    std::string result;
+    result.reserve(value.size());
+    for (auto const character : value)
+    {
+        if (character == '"' || character == '\\')
+        {
+            result.push_back('\\');
+        }
+        result.push_back(character);
+    }
+    return result;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+RenderBenchmark::RenderBenchmark(RenderBenchmarkSettings settings)
+    : m_settings(std::move(settings))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::Run()
+{
+    SetupAssetDirectory();
+    CreateVulkanObjects();
+
+    // The last VIRTUAL_FRAME_COUNT frames only flush GPU timings of the measured ones
+    auto const totalFrameCount = m_settings.WarmupFrameCount + m_settings.FrameCount + VIRTUAL_FRAME_COUNT;
+    m_samples.resize(totalFrameCount);
+
+    Gris::Log::Info("Rendering {} frames at {}x{}", m_settings.FrameCount, m_settings.Width, m_settings.Height);
+
+    for (uint32_t frameNumber = 0; frameNumber < totalFrameCount; ++frameNumber)
+    {
+        RenderFrame(frameNumber);
+    }
+
+    m_device.WaitIdle();
+
+    WriteReport();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::SetupAssetDirectory()
+{
+    static const std::filesystem::path ASSET_DIRECTORY = "render_benchmark/assets";
+    Gris::DirectoryRegistry::AddResolvePath(Gris::DirectoryRegistry::ExecutableLocation() / ASSET_DIRECTORY);
+    Gris::DirectoryRegistry::AddResolvePath(Gris::DirectoryRegistry::ExecutableLocation() / ASSET_DIRECTORY / "sponza");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Format RenderBenchmark::FindDepthFormat() const
+{
+    return m_device.FindSupportedFormat(
+        { vk::Format::eD32Sfloat, vk::Format::eD32SfloatS8Uint, vk::Format::eD24UnormS8Uint },
+        vk::ImageTiling::eOptimal,
+        vk::FormatFeatureFlagBits::eDepthStencilAttachment);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateVulkanObjects()
+{
+    CreateDevice();
+    CreateRenderTargets();
+    CreateRenderPass();
+    CreatePipelineStateObject();
+    CreateFramebuffers();
+    CreateShaderResourceBindingsPools();
+    LoadScene();
+    CreateUniformBuffersAndBindings();
+    CreateCommandBuffers();
+    CreateProfiler();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateDevice()
+{
+    Gris::Graphics::Vulkan::Instance::SetHeadless(true);
+    m_device = Gris::Graphics::Vulkan::Device(Gris::Graphics::Vulkan::FindSuitablePhysicalDevice());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateRenderTargets()
+{
+    m_renderTargets = m_device.CreateRenderTargetRing(m_settings.Width, m_settings.Height, vk::Format::eR8G8B8A8Unorm, VIRTUAL_FRAME_COUNT, VIRTUAL_FRAME_COUNT);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateRenderPass()
+{
+    m_renderPass = m_device.CreateRenderPass(m_renderTargets.Format(), FindDepthFormat(), Gris::Graphics::Vulkan::RenderTargetRing::FINAL_LAYOUT);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreatePipelineStateObject()
+{
+    auto const vertexShaderPath = Gris::DirectoryRegistry::TryResolvePath(VERTEX_SHADER_PATH);
+    if (!vertexShaderPath)
+    {
+        throw Gris::EngineException("Error resolving vertex shader path", VERTEX_SHADER_PATH);
+    }
+
+    m_vertexShader = m_device.CreateShader(Gris::ReadFile<uint32_t>(*vertexShaderPath), "main");
+
+    auto const fragmentShaderPath = Gris::DirectoryRegistry::TryResolvePath(FRAGMENT_SHADER_PATH);
+    if (!fragmentShaderPath)
+    {
+        throw Gris::EngineException("Error resolving fragment shader path", FRAGMENT_SHADER_PATH);
+    }
+
+    m_fragmentShader = m_device.CreateShader(Gris::ReadFile<uint32_t>(*fragmentShaderPath), "main");
+
+    ///
+
+    auto const globalLayouts = std::array{
+        Gris::Graphics::Backend::ShaderResourceBindingLayout{
+            "ubo",
+            0,
+            Gris::Graphics::Backend::ShaderResourceType::UniformBuffer,
+            1,
+            Gris::Graphics::Backend::ShaderStageFlags::Vertex,
+        },
+    };
+    m_resourceLayouts[GLOBAL_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindingsLayout(Gris::Graphics::Backend::ShaderResourceBindingsLayout{ globalLayouts });
+
+    auto const perMaterialLayouts = std::array{
+        Gris::Graphics::Backend::ShaderResourceBindingLayout{
+            "texSampler",
+            0,
+            Gris::Graphics::Backend::ShaderResourceType::CombinedImageSampler,
+            1,
+            Gris::Graphics::Backend::ShaderStageFlags::Fragment,
+        },
+    };
+    m_resourceLayouts[PER_MATERIAL_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindingsLayout(Gris::Graphics::Backend::ShaderResourceBindingsLayout{ perMaterialLayouts });
+
+    auto const perDrawLayouts = std::array<Gris::Graphics::Backend::ShaderResourceBindingLayout, 0>{};
+    m_resourceLayouts[PER_DRAW_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindingsLayout(Gris::Graphics::Backend::ShaderResourceBindingsLayout{ perDrawLayouts });
+
+    ///
+
+    Gris::Graphics::Vulkan::InputLayout layout;
+    layout.AddVertexFormat<Gris::Graphics::MeshVertexFormat>(0);
+
+    m_pso = m_device.CreatePipelineStateObject({}, {}, m_renderPass, layout, m_resourceLayouts, m_vertexShader, m_fragmentShader);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateFramebuffers()
+{
+    auto const extent = m_renderTargets.Extent();
+    auto const format = m_renderTargets.Format();
+    auto const depthFormat = FindDepthFormat();
+
+    m_colorImage = m_device.CreateTexture(extent.width, extent.height, 1, m_device.MsaaSamples(), format, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransientAttachment | vk::ImageUsageFlagBits::eColorAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    m_colorImageView = m_device.CreateTextureView(m_colorImage, format, vk::ImageAspectFlagBits::eColor, 1);
+
+    m_depthImage = m_device.CreateTexture(extent.width, extent.height, 1, m_device.MsaaSamples(), depthFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    m_depthImageView = m_device.CreateTextureView(m_depthImage, depthFormat, vk::ImageAspectFlagBits::eDepth, 1);
+
+    m_framebuffers.resize(m_renderTargets.ImageCount());
+    for (size_t i = 0; i < m_renderTargets.ImageCount(); i++)
+    {
+        m_framebuffers[i] = m_device.CreateFramebuffer(m_colorImageView, m_depthImageView, m_renderTargets.ImageView(i), m_renderPass, extent.width, extent.height);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateShaderResourceBindingsPools()
+{
+    auto sizes = Gris::Graphics::Backend::ShaderResourceBindingsPoolSizes{};
+    sizes.ShaderResourceBindingsCount = DESCRIPTOR_SET_COUNT * m_renderTargets.VirtualFrameCount();
+    sizes.CombinedImageSamplerCount = DESCRIPTOR_SET_COUNT * m_renderTargets.VirtualFrameCount();
+    sizes.UniformBufferCount = DESCRIPTOR_SET_COUNT * m_renderTargets.VirtualFrameCount();
+
+    m_device.RegisterShaderResourceBindingsPoolCategory(m_shaderResourceBindingsPoolCategory, sizes);
+    m_shaderResourceBindingsPools = m_device.CreateShaderResourceBindingsPoolCollection();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::LoadScene()
+{
+    constexpr static float LENS_DEFAULT_NEAR_PLANE = 1.0F;
+    constexpr static float LENS_DEFAULT_FAR_PLANE = 1000.0F;
+    constexpr static float LENS_DEFAULT_FOV = glm::radians(90.0F);
+
+    auto const extent = m_renderTargets.Extent();
+    m_lens.SetFrustum(LENS_DEFAULT_NEAR_PLANE, LENS_DEFAULT_FAR_PLANE, static_cast<float>(extent.width) / static_cast<float>(extent.height), LENS_DEFAULT_FOV);
+
+    CreateMesh();
+    CreateMeshTexture();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateMesh()
+{
+    auto modelPath = Gris::DirectoryRegistry::TryResolvePath(MODEL_PATH);
+    if (!modelPath)
+    {
+        throw Gris::EngineException("Error resolving model path - file not found", MODEL_PATH);
+    }
+
+    std::tie(m_scene.Meshes, m_materialBlueprints) = Gris::Graphics::Loaders::AssimpMeshLoader::Load(*modelPath);
+
+    ///
+
+    for (auto const & mesh : m_scene.Meshes)
+    {
+        auto const vertexBufferSize = sizeof(mesh.Vertices[0]) * mesh.Vertices.size();
+
+        auto vertexStagingBuffer = m_device.CreateBuffer(vertexBufferSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+        vertexStagingBuffer.SetData(mesh.Vertices.data(), static_cast<size_t>(vertexBufferSize));
+
+        auto & vertexBuffer = m_vertexBuffers.emplace_back(m_device.CreateBuffer(vertexBufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
+        m_device.Context().CopyBuffer(vertexStagingBuffer, vertexBuffer, vertexBufferSize);
+
+        m_vertexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(vertexBuffer, 0, static_cast<uint32_t>(vertexBufferSize)));
+    }
+
+    ///
+
+    for (auto const & mesh : m_scene.Meshes)
+    {
+        auto const indexBufferSize = sizeof(mesh.Indices[0]) * mesh.Indices.size();
+
+        auto indexStagingBuffer = m_device.CreateBuffer(indexBufferSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+        indexStagingBuffer.SetData(mesh.Indices.data(), static_cast<size_t>(indexBufferSize));
+
+        auto & indexBuffer = m_indexBuffers.emplace_back(m_device.CreateBuffer(indexBufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
+        m_device.Context().CopyBuffer(indexStagingBuffer, indexBuffer, indexBufferSize);
+
+        m_indexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(indexBuffer, 0, static_cast<uint32_t>(indexBufferSize)));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateMeshTexture()
+{
+    GRIS_ALWAYS_ASSERT(!m_materialBlueprints.empty(), "Must have at least one material");
+    GRIS_ALWAYS_ASSERT(!m_materialBlueprints.front().DiffuseTextures.empty(), "Must have at least one material with diffuse texture");
+
+    auto const & diffuseTexturePath = m_materialBlueprints.front().DiffuseTextures.front();
+    auto const texturePath = Gris::DirectoryRegistry::TryResolvePath(diffuseTexturePath);
+    if (!texturePath)
+    {
+        throw Gris::EngineException("Failed to resolve texture image path", diffuseTexturePath.string());
+    }
+
+    auto image = Gris::Graphics::Loaders::DdsKtxImageLoader::Load(*texturePath);
+    auto const format = Gris::Graphics::Vulkan::ToVulkanFormat(image.Format);
+
+    m_meshTextureImage = m_device.CreateTexture(image.Width, image.Height, 1, vk::SampleCountFlagBits::e1, format, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled, vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+    auto stagingBuffer = m_device.CreateBuffer(image.PixelData.size(), vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    stagingBuffer.SetData(image.PixelData.data(), image.PixelData.size());
+    m_device.Context().CopyBufferToImage(stagingBuffer, m_meshTextureImage, image.Width, image.Height);
+    m_device.Context().TransitionImageLayout(m_meshTextureImage, vk::ImageLayout::eShaderReadOnlyOptimal);
+
+    m_meshTextureImageView = m_device.CreateTextureView(m_meshTextureImage, format, vk::ImageAspectFlagBits::eColor, m_meshTextureImage.MipLevels());
+    m_meshTextureSampler = m_device.CreateSampler(0.0F, static_cast<float>(m_meshTextureImage.MipLevels()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateUniformBuffersAndBindings()
+{
+    m_uniformBuffers.resize(m_renderTargets.VirtualFrameCount());
+    m_uniformBufferViews.resize(m_renderTargets.VirtualFrameCount());
+    m_shaderResourceBindings.resize(m_renderTargets.VirtualFrameCount());
+    for (size_t i = 0; i < m_renderTargets.VirtualFrameCount(); i++)
+    {
+        m_uniformBuffers[i] = m_device.CreateBuffer(sizeof(UniformBufferObject), vk::BufferUsageFlagBits::eUniformBuffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+        m_uniformBufferViews[i] = Gris::Graphics::Vulkan::BufferView(m_uniformBuffers[i], 0, static_cast<uint32_t>(sizeof(UniformBufferObject)));
+
+        m_shaderResourceBindings[i][GLOBAL_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindings(m_resourceLayouts[GLOBAL_DESCRIPTOR_SET_INDEX]);
+        m_shaderResourceBindings[i][PER_MATERIAL_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindings(m_resourceLayouts[PER_MATERIAL_DESCRIPTOR_SET_INDEX]);
+        m_shaderResourceBindings[i][PER_DRAW_DESCRIPTOR_SET_INDEX] = m_device.CreateShaderResourceBindings(m_resourceLayouts[PER_DRAW_DESCRIPTOR_SET_INDEX]);
+
+        m_shaderResourceBindings[i][GLOBAL_DESCRIPTOR_SET_INDEX].SetUniformBuffer("ubo", m_uniformBufferViews[i]);
+        m_shaderResourceBindings[i][PER_MATERIAL_DESCRIPTOR_SET_INDEX].SetCombinedSamplerAndImageView("texSampler", m_meshTextureSampler, m_meshTextureImageView);
+
+        m_shaderResourceBindings[i][GLOBAL_DESCRIPTOR_SET_INDEX].PrepareBindings(m_shaderResourceBindingsPoolCategory, &m_shaderResourceBindingsPools);
+        m_shaderResourceBindings[i][PER_MATERIAL_DESCRIPTOR_SET_INDEX].PrepareBindings(m_shaderResourceBindingsPoolCategory, &m_shaderResourceBindingsPools);
+        m_shaderResourceBindings[i][PER_DRAW_DESCRIPTOR_SET_INDEX].PrepareBindings(m_shaderResourceBindingsPoolCategory, &m_shaderResourceBindingsPools);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateCommandBuffers()
+{
+    m_commandBuffers.resize(m_renderTargets.VirtualFrameCount());
+    for (uint32_t i = 0; i < m_renderTargets.VirtualFrameCount(); i++)
+    {
+        m_commandBuffers[i] = m_device.CreateDeferredContext(true);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::CreateProfiler()
+{
+    m_profiler = m_device.CreateGpuProfiler(m_renderTargets.VirtualFrameCount(), MAX_GPU_ZONES_PER_FRAME);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::UpdateUniformBuffer(uint32_t currentVirtualFrameIndex, uint32_t frameNumber)
+{
+    constexpr static glm::vec3 PATH_CENTER = glm::vec3(0.0F, 5.0F, 0.0F);
+    constexpr static float PATH_RADIUS = 5.0F;
+    constexpr static float PATH_HEIGHT_VARIATION = 2.0F;
+
+    // One full orbit over the warm-up and measured frames, so every run sees the same views
+    auto const pathLength = static_cast<float>(m_settings.WarmupFrameCount + m_settings.FrameCount);
+    auto const angle = glm::two_pi<float>() * static_cast<float>(frameNumber) / pathLength;
+    auto const eye = PATH_CENTER + glm::vec3(PATH_RADIUS * std::cos(angle), PATH_HEIGHT_VARIATION * std::sin(2.0F * angle), PATH_RADIUS * std::sin(angle));
+
+    auto const extent = m_renderTargets.Extent();
+    m_lens.UpdateMatrices(static_cast<float>(extent.width) / static_cast<float>(extent.height));
+
+    UniformBufferObject ubo = {
+        glm::mat4(1.0F),
+        glm::lookAt(eye, PATH_CENTER, glm::vec3(0.0F, 1.0F, 0.0F)),
+        m_lens.GetProjectionMatrix(),
+    };
+    ubo.proj[1][1] *= -1;
+
+    m_uniformBuffers[currentVirtualFrameIndex].SetData(&ubo, sizeof(ubo));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::RenderFrame(uint32_t frameNumber)
+{
+    auto const frameStart = Clock::now();
+
+    auto const nextImageResult = m_renderTargets.NextImage();
+    GRIS_ALWAYS_ASSERT(nextImageResult.has_value(), "Offscreen render targets are always available");
+
+    auto const recordStart = Clock::now();
+    auto const extent = m_renderTargets.Extent();
+    auto & context = m_commandBuffers[nextImageResult->VirtualFrameIndex];
+
+    UpdateUniformBuffer(nextImageResult->VirtualFrameIndex, frameNumber);
+
+    context.ResetContext(false);
+    context.Begin(true);
+
+    m_profiler.BeginFrame(context, nextImageResult->VirtualFrameIndex);
+    auto const resultsFrameNumber = m_profiler.ResultsFrameNumber();
+    if (resultsFrameNumber && !m_profiler.Results().empty())
+    {
+        m_samples[*resultsFrameNumber].GpuMilliseconds = m_profiler.Results().front().GpuTimeMilliseconds;
+    }
+
+    {
+        auto const frameZone = Gris::Graphics::Vulkan::GpuProfilerZone(m_profiler, context, "Frame");
+
+        context.BeginRenderPass(m_renderPass, m_framebuffers[nextImageResult->SwapChainImageIndex], extent);
+        context.BindPipeline(m_pso);
+        context.SetViewport(extent.width, extent.height);
+        context.SetScissor(extent.width, extent.height);
+        context.BindDescriptorSet(m_pso, 0, m_shaderResourceBindings[nextImageResult->VirtualFrameIndex]);
+
+        for (size_t meshIndex = 0; meshIndex < m_scene.Meshes.size(); ++meshIndex)
+        {
+            context.BindVertexBuffer(m_vertexBufferViews[meshIndex]);
+            context.BindIndexBuffer(m_indexBufferViews[meshIndex]);
+            context.DrawIndexed(static_cast<uint32_t>(m_scene.Meshes[meshIndex].Indices.size()));
+        }
+
+        context.EndRenderPass();
+    }
+
+    context.End();
+
+    m_renderTargets.Submit(context, *nextImageResult);
+    [[maybe_unused]] auto const presented = m_renderTargets.Present(*nextImageResult);
+
+    auto const frameEnd = Clock::now();
+
+    auto & sample = m_samples[frameNumber];
+    sample.FrameMilliseconds = ToMilliseconds(frameEnd - frameStart);
+    sample.CpuMilliseconds = ToMilliseconds(frameEnd - recordStart);
+    sample.Commands = context.Statistics();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void RenderBenchmark::WriteReport() const
+{
+    auto const firstFrame = std::begin(m_samples) + m_settings.WarmupFrameCount;
+    auto const lastFrame = firstFrame + m_settings.FrameCount;
+
+    auto frameTimes = Gris::MakeReservedVector<double>(m_settings.FrameCount);
+    auto cpuTimes = Gris::MakeReservedVector<double>(m_settings.FrameCount);
+    auto gpuTimes = Gris::MakeReservedVector<double>(m_settings.FrameCount);
+    auto perFrame = std::string{};
+    for (auto it = firstFrame; it != lastFrame; ++it)
+    {
+        frameTimes.emplace_back(it->FrameMilliseconds);
+        cpuTimes.emplace_back(it->CpuMilliseconds);
+        if (it->GpuMilliseconds)
+        {
+            gpuTimes.emplace_back(*it->GpuMilliseconds);
+        }
+
+        perFrame += fmt::format(
+            R"(    {{ "frame_ms": {:.4f}, "cpu_ms": {:.4f}, "gpu_ms": {}, "draw_calls": {}, "pipeline_binds": {}, "vertex_buffer_binds": {}, "index_buffer_binds": {}, "descriptor_set_binds": {} }}{})",
+            it->FrameMilliseconds,
+            it->CpuMilliseconds,
+            it->GpuMilliseconds ? fmt::format("{:.4f}", *it->GpuMilliseconds) : std::string("null"),
+            it->Commands.DrawCalls,
+            it->Commands.PipelineBinds,
+            it->Commands.VertexBufferBinds,
+            it->Commands.IndexBufferBinds,
+            it->Commands.DescriptorSetBinds,
+            std::next(it) != lastFrame ? ",\n" : "\n");
+    }
+
+    auto const triangleCount = std::accumulate(std::begin(m_scene.Meshes), std::end(m_scene.Meshes), size_t{ 0 }, [](size_t sum, const auto & mesh)
+                                               { return sum + mesh.Indices.size() / 3; });
+
+    auto const report = fmt::format(
+        "{{\n"
+        R"(  "device": "{}",)"
+        "\n"
+        R"(  "width": {}, "height": {}, "warmup_frames": {}, "frames": {}, "meshes": {}, "triangles": {},)"
+        "\n"
+        R"(  "frame_ms": {},)"
+        "\n"
+        R"(  "cpu_ms": {},)"
+        "\n"
+        R"(  "gpu_ms": {},)"
+        "\n"
+        R"(  "per_frame": [)"
+        "\n{}  ]\n}}\n",
+        EscapeJson(static_cast<const char *>(m_device.Properties().deviceName)),
+        m_settings.Width,
+        m_settings.Height,
+        m_settings.WarmupFrameCount,
+        m_settings.FrameCount,
+        m_scene.Meshes.size(),
+        triangleCount,
+        ToJson(Summarize(frameTimes)),
+        ToJson(Summarize(cpuTimes)),
+        ToJson(Summarize(gpuTimes)),
+        perFrame);
+
+    auto output = std::ofstream(m_settings.OutputPath, std::ios::out | std::ios::trunc);
+    if (!output)
+    {
+        throw Gris::EngineException("Error opening benchmark report for writing", m_settings.OutputPath.string());
+    }
+
+    output << report;
+
+    auto const gpuSummary = Summarize(gpuTimes);
+    Gris::Log::Info("Frame p50 {:.3f} ms, CPU p50 {:.3f} ms, GPU p50 {:.3f} ms ({} samples)", Summarize(frameTimes).P50, Summarize(cpuTimes).P50, gpuSummary.P50, gpuSummary.Count);
+    Gris::Log::Info("Report written to {}", m_settings.OutputPath.string());
+}
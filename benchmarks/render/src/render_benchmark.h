@@ -0,0 +1,127 @@
+#pragma once
+
+#include <gris/graphics/vulkan/buffer.h>
+#include <gris/graphics/vulkan/buffer_view.h>
+#include <gris/graphics/vulkan/deferred_context.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/framebuffer.h>
+#include <gris/graphics/vulkan/gpu_profiler.h>
+#include <gris/graphics/vulkan/pipeline_state_object.h>
+#include <gris/graphics/vulkan/render_pass.h>
+#include <gris/graphics/vulkan/render_target_ring.h>
+#include <gris/graphics/vulkan/sampler.h>
+#include <gris/graphics/vulkan/shader.h>
+#include <gris/graphics/vulkan/shader_resource_bindings.h>
+#include <gris/graphics/vulkan/shader_resource_bindings_layout.h>
+#include <gris/graphics/vulkan/shader_resource_bindings_pool_collection.h>
+#include <gris/graphics/vulkan/texture.h>
+#include <gris/graphics/vulkan/texture_view.h>
+
+#include <gris/graphics/lens/perspective_lens.h>
+#include <gris/graphics/scene.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+struct RenderBenchmarkSettings
+{
+    uint32_t FrameCount = 300;
+    uint32_t WarmupFrameCount = 10;
+    uint32_t Width = 1280;
+    uint32_t Height = 720;
+    std::filesystem::path OutputPath = "render_benchmark.json";
+};
+
+class RenderBenchmark
+{
+public:
+    explicit RenderBenchmark(RenderBenchmarkSettings settings);
+
+    void Run();
+
+private:
+    constexpr static uint32_t GLOBAL_DESCRIPTOR_SET_INDEX = 0;
+    constexpr static uint32_t PER_MATERIAL_DESCRIPTOR_SET_INDEX = 1;
+    constexpr static uint32_t PER_DRAW_DESCRIPTOR_SET_INDEX = 2;
+    constexpr static uint32_t DESCRIPTOR_SET_COUNT = 3;
+
+    struct FrameSample
+    {
+        double FrameMilliseconds = 0.0;
+        double CpuMilliseconds = 0.0;
+        std::optional<double> GpuMilliseconds = {};
+        Gris::Graphics::Vulkan::DeferredContextStatistics Commands = {};
+    };
+
+    static void SetupAssetDirectory();
+
+    [[nodiscard]] vk::Format FindDepthFormat() const;
+
+    void CreateVulkanObjects();
+    void CreateDevice();
+    void CreateRenderTargets();
+    void CreateRenderPass();
+    void CreatePipelineStateObject();
+    void CreateFramebuffers();
+    void CreateShaderResourceBindingsPools();
+    void LoadScene();
+    void CreateMesh();
+    void CreateMeshTexture();
+    void CreateUniformBuffersAndBindings();
+    void CreateCommandBuffers();
+    void CreateProfiler();
+
+    void UpdateUniformBuffer(uint32_t currentVirtualFrameIndex, uint32_t frameNumber);
+    void RenderFrame(uint32_t frameNumber);
+    void WriteReport() const;
+
+    RenderBenchmarkSettings m_settings = {};
+
+    Gris::Graphics::Vulkan::Device m_device = {};
+    Gris::Graphics::Vulkan::RenderTargetRing m_renderTargets = {};
+
+    std::vector<Gris::Graphics::Vulkan::Framebuffer> m_framebuffers = {};
+
+    Gris::Graphics::Vulkan::RenderPass m_renderPass = {};
+    Gris::Graphics::Vulkan::Shader m_vertexShader = {};
+    Gris::Graphics::Vulkan::Shader m_fragmentShader = {};
+
+    std::array<Gris::Graphics::Vulkan::ShaderResourceBindingsLayout, DESCRIPTOR_SET_COUNT> m_resourceLayouts = {};
+    Gris::Graphics::Vulkan::PipelineStateObject m_pso = {};
+
+    Gris::Graphics::Backend::ShaderResourceBindingsPoolCategory m_shaderResourceBindingsPoolCategory = Gris::Graphics::Backend::ShaderResourceBindingsPoolCategory{ 0 };
+    Gris::Graphics::Vulkan::ShaderResourceBindingsPoolCollection m_shaderResourceBindingsPools;
+
+    std::vector<std::array<Gris::Graphics::Vulkan::ShaderResourceBindings, DESCRIPTOR_SET_COUNT>> m_shaderResourceBindings = {};
+
+    Gris::Graphics::Vulkan::Texture m_colorImage = {};
+    Gris::Graphics::Vulkan::TextureView m_colorImageView = {};
+
+    Gris::Graphics::Vulkan::Texture m_depthImage = {};
+    Gris::Graphics::Vulkan::TextureView m_depthImageView = {};
+
+    Gris::Graphics::Scene m_scene;
+    std::vector<Gris::Graphics::MaterialBlueprint> m_materialBlueprints;
+
+    std::vector<Gris::Graphics::Vulkan::Buffer> m_vertexBuffers = {};
+    std::vector<Gris::Graphics::Vulkan::BufferView> m_vertexBufferViews = {};
+    std::vector<Gris::Graphics::Vulkan::Buffer> m_indexBuffers = {};
+    std::vector<Gris::Graphics::Vulkan::BufferView> m_indexBufferViews = {};
+
+    Gris::Graphics::Vulkan::Texture m_meshTextureImage = {};
+    Gris::Graphics::Vulkan::TextureView m_meshTextureImageView = {};
+    Gris::Graphics::Vulkan::Sampler m_meshTextureSampler = {};
+
+    std::vector<Gris::Graphics::Vulkan::Buffer> m_uniformBuffers = {};
+    std::vector<Gris::Graphics::Vulkan::BufferView> m_uniformBufferViews = {};
+
+    std::vector<Gris::Graphics::Vulkan::DeferredContext> m_commandBuffers = {};
+
+    Gris::Graphics::Vulkan::GpuProfiler m_profiler = {};
+
+    Gris::Graphics::Lens::PerspectiveLens m_lens = {};
+
+    std::vector<FrameSample> m_samples = {};
+};
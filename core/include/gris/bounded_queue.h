@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 Bartlomiej Siwek All rights reserved.
+ */
+
+#pragma once
+
+#include <gris/assert.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace Gris
+{
+
+// Blocking multi producer multi consumer queue with a fixed capacity, used to hand work between pipeline stages
+// running on different threads. A full queue blocks the producer, which is what keeps the stages in step. Closing wakes
+// up everybody: pushes fail from then on and pops drain what is left before failing.
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity = 1)
+        : m_capacity(capacity)
+    {
+        GRIS_ALWAYS_ASSERT(m_capacity > 0, "Bounded queue capacity has to be positive");
+    }
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+    BoundedQueue(BoundedQueue &&) = delete;
+    BoundedQueue & operator=(BoundedQueue &&) = delete;
+
+    ~BoundedQueue() = default;
+
+    // Returns false when the queue was closed, the value is dropped then
+    bool Push(T value)
+    {
+        auto lock = std::unique_lock(m_mutex);
+        m_notFull.wait(lock, [this]()
+                       { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed)
+        {
+            return false;
+        }
+
+        m_items.emplace_back(std::move(value));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns nothing once the queue is closed and drained
+    [[nodiscard]] std::optional<T> Pop()
+    {
+        auto lock = std::unique_lock(m_mutex);
+        m_notEmpty.wait(lock, [this]()
+                        { return m_closed || !m_items.empty(); });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto result = std::optional<T>(std::move(m_items.front()));
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return result;
+    }
+
+    void Close()
+    {
+        {
+            auto const lock = std::lock_guard(m_mutex);
+            m_closed = true;
+        }
+
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    // Drops the remaining items and reopens the queue, nobody can be waiting on it at this point
+    void Reset(size_t capacity)
+    {
+        GRIS_ALWAYS_ASSERT(capacity > 0, "Bounded queue capacity has to be positive");
+
+        auto const lock = std::lock_guard(m_mutex);
+        m_items.clear();
+        m_capacity = capacity;
+        m_closed = false;
+    }
+
+    [[nodiscard]] bool IsClosed() const
+    {
+        auto const lock = std::lock_guard(m_mutex);
+        return m_closed;
+    }
+
+private:
+    mutable std::mutex m_mutex = {};
+    std::condition_variable m_notFull = {};
+    std::condition_variable m_notEmpty = {};
+    std::deque<T> m_items = {};
+    size_t m_capacity = 1;
+    bool m_closed = false;
+};
+
+}  // namespace Gris
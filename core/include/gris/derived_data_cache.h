@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 Bartlomiej Siwek All rights reserved.
+ */
+
+#pragma once
+
+#include <gris/span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Gris
+{
+
+// On disk cache of cooked loader outputs, shared by every process that points at the same directory. Entries are
+// files named by a key derived from the source bytes, the loader and its settings, so they never need invalidating,
+// a changed input simply maps to another key. Entries are written to a temporary and renamed into place, so a reader
+// sees either the whole entry or nothing, and the least recently used ones are evicted once the directory grows over
+// the size limit.
+class DerivedDataCache
+{
+public:
+    constexpr static uint64_t DEFAULT_MAX_SIZE = uint64_t{ 2 } * 1024 * 1024 * 1024;
+
+    DerivedDataCache(std::filesystem::path directory, uint64_t maxSize);
+
+    // Lives in GRIS_DERIVED_DATA_CACHE, or in the temporary directory if that is not set, with the size limit taken
+    // from GRIS_DERIVED_DATA_CACHE_SIZE_MB
+    [[nodiscard]] static DerivedDataCache & Default();
+
+    // The loader version has to change whenever the cooked output of the same source and settings changes
+    [[nodiscard]] static std::string MakeKey(std::string_view loader, uint32_t loaderVersion, std::string_view settings, Span<const std::byte> source);
+
+    [[nodiscard]] const std::filesystem::path & Directory() const;
+    [[nodiscard]] uint64_t MaxSize() const;
+
+    // Path of the entry, marking it as recently used. Another process may still evict it before it is opened, so
+    // failing to open it has to be treated as a miss.
+    [[nodiscard]] std::optional<std::filesystem::path> Find(const std::string & key) const;
+
+    // Calls write with a temporary path to write the entry to and publishes it under the key, then trims the cache
+    void Store(const std::string & key, const std::function<void(const std::filesystem::path &)> & write) const;
+
+    // Removes the least recently used entries until the cache fits the size limit
+    void Trim() const;
+
+private:
+    std::filesystem::path m_directory = {};
+    uint64_t m_maxSize = DEFAULT_MAX_SIZE;
+};
+
+}  // namespace Gris
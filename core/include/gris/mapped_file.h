@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020 Bartlomiej Siwek All rights reserved.
+ */
+
+#pragma once
+
+#include <gris/span.h>
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Gris
+{
+
+// Read only view of a whole file mapped into memory, pages are read in on first touch
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path & path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile && other) noexcept;
+    MappedFile & operator=(MappedFile && other) noexcept;
+
+    ~MappedFile();
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    [[nodiscard]] Span<const std::byte> Data() const;
+
+    void Reset();
+
+private:
+    const std::byte * m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+};
+
+}  // namespace Gris
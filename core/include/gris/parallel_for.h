@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020 Bartlomiej Siwek All rights reserved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gris
+{
+
+// Calls function(index) for every index in [0, count) on up to hardware concurrency threads, the calling thread
+// included. Indices are handed out one at a time, so uneven work balances itself, and each call should write only to
+// its own slot of the output for the result not to depend on the scheduling. The first exception thrown stops handing
+// out indices and is rethrown once all threads are done.
+template<typename Function>
+void ParallelFor(size_t count, Function && function)
+{
+    auto const threadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+    if (threadCount <= 1)
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            function(index);
+        }
+        return;
+    }
+
+    auto nextIndex = std::atomic<size_t>(0);
+    auto errorMutex = std::mutex{};
+    auto error = std::exception_ptr{};
+
+    auto const worker = [&]()
+    {
+        for (auto index = nextIndex.fetch_add(1); index < count; index = nextIndex.fetch_add(1))
+        {
+            try
+            {
+                function(index);
+            }
+            catch (...)
+            {
+                auto const lock = std::lock_guard(errorMutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+                nextIndex = count;
+            }
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(threadCount - 1);
+    try
+    {
+        for (size_t threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+        {
+            threads.emplace_back(worker);
+        }
+    }
+    catch (...)
+    {
+        // Destroying a joinable thread terminates, the workers already started are stopped and joined first
+        nextIndex = count;
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        throw;
+    }
+
+    worker();
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace Gris
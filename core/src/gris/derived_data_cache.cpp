@@ -0,0 +1,257 @@
+#include <gris/derived_data_cache.h>
+
+#include <gris/engine_exception.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+// Temporaries this old belong to a writer that died before publishing its entry
+constexpr auto ABANDONED_TEMPORARY_AGE = std::chrono::hours(1);
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t HashBytes(const void * data, size_t size, uint64_t hash)
+{
+    auto const * const bytes = static_cast<const unsigned char *>(data);
+    for (size_t byteIndex = 0; byteIndex < size; ++byteIndex)
+    {
+        hash ^= bytes[byteIndex];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::optional<std::string> ReadEnvironmentVariable(const char * name)
+{
+#if defined(_MSC_VER)
+    char * value = nullptr;
+    size_t valueSize = 0;
+    if (_dupenv_s(&value, &valueSize, name) != 0 || value == nullptr)
+    {
+        return {};
+    }
+
+    auto result = std::string(value);
+    free(value);
+    return result;
+#else
+    auto const * const value = std::getenv(name);
+    if (value == nullptr)
+    {
+        return {};
+    }
+
+    return std::string(value);
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool IsTemporary(const std::filesystem::path & path)
+{
+    return path.extension() == ".tmp";
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::DerivedDataCache::DerivedDataCache(std::filesystem::path directory, uint64_t maxSize)
+    : m_directory(std::move(directory))
+    , m_maxSize(maxSize)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::DerivedDataCache & Gris::DerivedDataCache::Default()
+{
+    static DerivedDataCache s_instance = []()
+    {
+        auto directory = std::filesystem::temp_directory_path() / "gris" / "derived_data";
+        if (auto const configuredDirectory = ReadEnvironmentVariable("GRIS_DERIVED_DATA_CACHE"); configuredDirectory && !configuredDirectory->empty())
+        {
+            directory = std::filesystem::u8path(*configuredDirectory);
+        }
+
+        auto maxSize = DEFAULT_MAX_SIZE;
+        if (auto const configuredSize = ReadEnvironmentVariable("GRIS_DERIVED_DATA_CACHE_SIZE_MB"); configuredSize && !configuredSize->empty())
+        {
+            maxSize = std::strtoull(configuredSize->c_str(), nullptr, 10) * 1024 * 1024;
+        }
+
+        return DerivedDataCache(std::move(directory), maxSize);
+    }();
+
+    return s_instance;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::string Gris::DerivedDataCache::MakeKey(std::string_view loader, uint32_t loaderVersion, std::string_view settings, Span<const std::byte> source)
+{
+    auto hash = HashBytes(source.data(), source.size(), FNV_OFFSET_BASIS);
+
+    // Length prefixed so the settings cannot run into the source
+    auto const settingsSize = static_cast<uint64_t>(settings.size());
+    hash = HashBytes(&settingsSize, sizeof(settingsSize), hash);
+    hash = HashBytes(settings.data(), settings.size(), hash);
+
+    return fmt::format("{}-v{}-{:016x}", loader, loaderVersion, hash);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const std::filesystem::path & Gris::DerivedDataCache::Directory() const
+{
+    return m_directory;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::DerivedDataCache::MaxSize() const
+{
+    return m_maxSize;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::optional<std::filesystem::path> Gris::DerivedDataCache::Find(const std::string & key) const
+{
+    auto entryPath = m_directory / key;
+
+    // The modification time doubles as the last use time, which every process sees
+    std::error_code error;
+    std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+    if (error)
+    {
+        return {};
+    }
+
+    return entryPath;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::DerivedDataCache::Store(const std::string & key, const std::function<void(const std::filesystem::path &)> & write) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        throw EngineException("Error creating derived data cache directory", m_directory.string(), error.message());
+    }
+
+    // Unique per writer so concurrent writers of the same key never share a temporary
+    auto const temporaryPath = m_directory / fmt::format("{}.{:08x}.tmp", key, std::random_device{}());
+
+    try
+    {
+        write(temporaryPath);
+    }
+    catch (...)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        throw;
+    }
+
+    auto const entryPath = m_directory / key;
+    std::filesystem::rename(temporaryPath, entryPath, error);
+    if (error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporaryPath, ignored);
+
+        // Replacing fails on some platforms while another process has the entry open, it has the same contents anyway
+        if (!std::filesystem::exists(entryPath, ignored))
+        {
+            throw EngineException("Error storing derived data", entryPath.string(), error.message());
+        }
+    }
+
+    Trim();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::DerivedDataCache::Trim() const
+{
+    struct Entry
+    {
+        std::filesystem::path Path;
+        std::filesystem::file_time_type LastUse;
+        uint64_t Size;
+    };
+
+    auto const now = std::filesystem::file_time_type::clock::now();
+
+    auto entries = std::vector<Entry>{};
+    uint64_t totalSize = 0;
+
+    // Other processes add and remove entries while this runs, anything that fails is skipped
+    std::error_code error;
+    for (auto iterator = std::filesystem::directory_iterator(m_directory, error); !error && iterator != std::filesystem::directory_iterator(); iterator.increment(error))
+    {
+        std::error_code entryError;
+        if (!iterator->is_regular_file(entryError))
+        {
+            continue;
+        }
+
+        auto const lastUse = iterator->last_write_time(entryError);
+        auto const size = iterator->file_size(entryError);
+        if (entryError)
+        {
+            continue;
+        }
+
+        if (IsTemporary(iterator->path()))
+        {
+            if (now - lastUse > ABANDONED_TEMPORARY_AGE)
+            {
+                std::filesystem::remove(iterator->path(), entryError);
+            }
+            continue;
+        }
+
+        entries.emplace_back(Entry{ iterator->path(), lastUse, size });
+        totalSize += size;
+    }
+
+    if (totalSize <= m_maxSize)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry & lhs, const Entry & rhs) { return lhs.LastUse < rhs.LastUse; });
+
+    for (auto const & entry : entries)
+    {
+        if (totalSize <= m_maxSize)
+        {
+            break;
+        }
+
+        // Fails on some platforms while the entry is open elsewhere, the next trim gets another chance
+        std::error_code removeError;
+        if (std::filesystem::remove(entry.Path, removeError))
+        {
+            totalSize -= entry.Size;
+        }
+    }
+}
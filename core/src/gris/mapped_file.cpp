@@ -0,0 +1,172 @@
+#include <gris/mapped_file.h>
+
+#include <gris/engine_exception.h>
+
+#include <system_error>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <Windows.h>
+#include <comdef.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef _MSC_VER
+
+std::string ErrorToString(DWORD error)
+{
+    auto const hResult = HRESULT_FROM_WIN32(error);
+    auto const comError = _com_error(hResult);
+    auto const * const comErrorMessage = comError.ErrorMessage();
+    return std::string(comErrorMessage);
+}
+
+#endif
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::MappedFile::MappedFile(const std::filesystem::path & path)
+{
+    std::error_code sizeError;
+    auto const fileSize = std::filesystem::file_size(path, sizeError);
+    if (sizeError)
+    {
+        throw EngineException("Error opening file for mapping", path.string(), sizeError.message());
+    }
+
+    if (fileSize == 0)
+    {
+        // Nothing to map, an empty span is still a valid view
+        m_mapped = true;
+        return;
+    }
+
+#if defined(_MSC_VER)
+    auto * const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw EngineException("Error opening file for mapping", path.string(), ErrorToString(GetLastError()));
+    }
+
+    auto * const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto const mappingError = GetLastError();
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        throw EngineException("Error creating file mapping", path.string(), ErrorToString(mappingError));
+    }
+
+    // The view keeps the mapping alive
+    auto * const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    auto const viewError = GetLastError();
+    CloseHandle(mapping);
+    if (view == nullptr)
+    {
+        throw EngineException("Error mapping file view", path.string(), ErrorToString(viewError));
+    }
+
+    m_data = static_cast<const std::byte *>(view);
+#else
+    auto const file = open(path.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        throw EngineException("Error opening file for mapping", path.string(), std::strerror(errno));
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    auto * const view = mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ, MAP_PRIVATE, file, 0);
+    auto const mapError = errno;
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        throw EngineException("Error mapping file", path.string(), std::strerror(mapError));
+    }
+
+    m_data = static_cast<const std::byte *>(view);
+#endif
+
+    m_size = static_cast<size_t>(fileSize);
+    m_mapped = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::MappedFile::MappedFile(MappedFile && other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_mapped(std::exchange(other.m_mapped, false))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::MappedFile & Gris::MappedFile::operator=(MappedFile && other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_mapped = std::exchange(other.m_mapped, false);
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::MappedFile::~MappedFile()
+{
+    Reset();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::MappedFile::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::MappedFile::IsValid() const
+{
+    return m_mapped;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Span<const std::byte> Gris::MappedFile::Data() const
+{
+    return Span<const std::byte>(m_data, m_size);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::MappedFile::Reset()
+{
+    if (m_data != nullptr)
+    {
+#if defined(_MSC_VER)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<std::byte *>(m_data), m_size);
+#endif
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
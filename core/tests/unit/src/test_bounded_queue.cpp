@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include <gris/bounded_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// Long enough for a thread that is not blocked to get through, a blocked one stays blocked regardless
+constexpr auto BLOCKING_GRACE_PERIOD = std::chrono::milliseconds(50);
+
+}  // namespace
+
+TEST_CASE("Bounded queue hands items over in order", "[bounded queue]")
+{
+    auto queue = Gris::BoundedQueue<int>(3);
+
+    REQUIRE(queue.Push(1));
+    REQUIRE(queue.Push(2));
+    REQUIRE(queue.Push(3));
+
+    REQUIRE(queue.Pop() == 1);
+    REQUIRE(queue.Pop() == 2);
+    REQUIRE(queue.Pop() == 3);
+}
+
+TEST_CASE("Bounded queue blocking", "[bounded queue]")
+{
+    auto queue = Gris::BoundedQueue<int>(1);
+
+    SECTION("Push blocks while the queue is full")
+    {
+        REQUIRE(queue.Push(1));
+
+        auto pushed = std::atomic<bool>(false);
+        auto producer = std::thread([&queue, &pushed]()
+                                    { pushed = queue.Push(2); });
+
+        std::this_thread::sleep_for(BLOCKING_GRACE_PERIOD);
+        REQUIRE_FALSE(pushed);
+
+        REQUIRE(queue.Pop() == 1);
+        producer.join();
+
+        REQUIRE(pushed);
+        REQUIRE(queue.Pop() == 2);
+    }
+
+    SECTION("Pop blocks while the queue is empty")
+    {
+        auto popped = std::atomic<bool>(false);
+        auto value = std::optional<int>{};
+        auto const consume = [&queue, &popped, &value]()
+        {
+            value = queue.Pop();
+            popped = true;
+        };
+        auto consumer = std::thread(consume);
+
+        std::this_thread::sleep_for(BLOCKING_GRACE_PERIOD);
+        REQUIRE_FALSE(popped);
+
+        REQUIRE(queue.Push(1));
+        consumer.join();
+
+        REQUIRE(popped);
+        REQUIRE(value == 1);
+    }
+}
+
+TEST_CASE("Closing a bounded queue", "[bounded queue]")
+{
+    auto queue = Gris::BoundedQueue<int>(2);
+
+    SECTION("Wakes up a blocked push, which fails")
+    {
+        REQUIRE(queue.Push(1));
+        REQUIRE(queue.Push(2));
+
+        auto pushed = std::atomic<bool>(true);
+        auto producer = std::thread([&queue, &pushed]()
+                                    { pushed = queue.Push(3); });
+
+        std::this_thread::sleep_for(BLOCKING_GRACE_PERIOD);
+        queue.Close();
+        producer.join();
+
+        REQUIRE_FALSE(pushed);
+    }
+
+    SECTION("Wakes up a blocked pop, which fails")
+    {
+        auto value = std::optional<int>(0);
+        auto consumer = std::thread([&queue, &value]()
+                                    { value = queue.Pop(); });
+
+        std::this_thread::sleep_for(BLOCKING_GRACE_PERIOD);
+        queue.Close();
+        consumer.join();
+
+        REQUIRE_FALSE(value.has_value());
+    }
+
+    SECTION("Pops drain the remaining items first")
+    {
+        REQUIRE(queue.Push(1));
+        REQUIRE(queue.Push(2));
+        queue.Close();
+
+        REQUIRE(queue.IsClosed());
+        REQUIRE_FALSE(queue.Push(3));
+        REQUIRE(queue.Pop() == 1);
+        REQUIRE(queue.Pop() == 2);
+        REQUIRE_FALSE(queue.Pop().has_value());
+    }
+
+    SECTION("Reset drops the items and reopens")
+    {
+        REQUIRE(queue.Push(1));
+        queue.Close();
+        queue.Reset(1);
+
+        REQUIRE_FALSE(queue.IsClosed());
+        REQUIRE(queue.Push(2));
+        REQUIRE(queue.Pop() == 2);
+    }
+}
+
+TEST_CASE("Bounded queue between two threads", "[bounded queue]")
+{
+    constexpr int COUNT = 10000;
+
+    auto queue = Gris::BoundedQueue<int>(4);
+    auto const produce = [&queue]()
+    {
+        for (int value = 0; value < COUNT; ++value)
+        {
+            static_cast<void>(queue.Push(value));
+        }
+        queue.Close();
+    };
+    auto producer = std::thread(produce);
+
+    auto received = std::vector<int>{};
+    for (auto value = queue.Pop(); value; value = queue.Pop())
+    {
+        received.emplace_back(*value);
+    }
+    producer.join();
+
+    auto inOrder = static_cast<int>(received.size()) == COUNT;
+    for (size_t index = 0; inOrder && index < received.size(); ++index)
+    {
+        inOrder = received[index] == static_cast<int>(index);
+    }
+    REQUIRE(inOrder);
+}
@@ -0,0 +1,214 @@
+#include <catch2/catch.hpp>
+
+#include <gris/derived_data_cache.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t ENTRY_SIZE = 100;
+
+Gris::Span<const std::byte> AsBytes(const std::string & text)
+{
+    return Gris::Span<const std::byte>(reinterpret_cast<const std::byte *>(text.data()), text.size());
+}
+
+void WriteFile(const std::filesystem::path & path, uint64_t size)
+{
+    auto file = std::ofstream(path, std::ios::binary);
+    file << std::string(size, 'x');
+}
+
+std::string ReadFile(const std::filesystem::path & path)
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+size_t CountTemporaries(const std::filesystem::path & directory)
+{
+    size_t count = 0;
+    for (auto const & entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() == ".tmp")
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void SetLastUse(const std::filesystem::path & path, std::chrono::hours age)
+{
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - age);
+}
+
+// Fresh directory for every test, removed again when the test is done
+class TemporaryDirectory
+{
+public:
+    explicit TemporaryDirectory(const std::string & name)
+        : m_path(std::filesystem::temp_directory_path() / name)
+    {
+        std::filesystem::remove_all(m_path);
+    }
+
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+    TemporaryDirectory & operator=(const TemporaryDirectory &) = delete;
+
+    TemporaryDirectory(TemporaryDirectory &&) = delete;
+    TemporaryDirectory & operator=(TemporaryDirectory &&) = delete;
+
+    ~TemporaryDirectory()
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(m_path, ignored);
+    }
+
+    [[nodiscard]] const std::filesystem::path & Path() const
+    {
+        return m_path;
+    }
+
+private:
+    std::filesystem::path m_path;
+};
+
+}  // namespace
+
+TEST_CASE("Derived data cache keys", "[derived data cache]")
+{
+    auto const source = std::string("mesh source bytes");
+    auto const key = Gris::DerivedDataCache::MakeKey("AssimpMeshLoader", 4, "flags=1", AsBytes(source));
+
+    SECTION("Keys are stable")
+    {
+        // Cached entries outlive the process, the key of the same input must never change
+        REQUIRE(key == Gris::DerivedDataCache::MakeKey("AssimpMeshLoader", 4, "flags=1", AsBytes(source)));
+        REQUIRE(key.rfind("AssimpMeshLoader-v4-", 0) == 0);
+        REQUIRE(key.size() == std::string("AssimpMeshLoader-v4-").size() + 16);
+
+        // 64 bit FNV-1a of nothing but the zero settings length
+        REQUIRE(Gris::DerivedDataCache::MakeKey("Loader", 1, "", AsBytes("")) == "Loader-v1-a8c7f832281a39c5");
+    }
+
+    SECTION("Every input changes the key")
+    {
+        REQUIRE(key != Gris::DerivedDataCache::MakeKey("TinyObjLoaderMeshLoader", 4, "flags=1", AsBytes(source)));
+        REQUIRE(key != Gris::DerivedDataCache::MakeKey("AssimpMeshLoader", 5, "flags=1", AsBytes(source)));
+        REQUIRE(key != Gris::DerivedDataCache::MakeKey("AssimpMeshLoader", 4, "flags=2", AsBytes(source)));
+        REQUIRE(key != Gris::DerivedDataCache::MakeKey("AssimpMeshLoader", 4, "flags=1", AsBytes(source + " ")));
+    }
+
+    SECTION("Settings do not run into the source")
+    {
+        REQUIRE(Gris::DerivedDataCache::MakeKey("Loader", 1, "ab", AsBytes("c")) != Gris::DerivedDataCache::MakeKey("Loader", 1, "a", AsBytes("bc")));
+    }
+}
+
+TEST_CASE("Storing derived data", "[derived data cache]")
+{
+    auto const directory = TemporaryDirectory("gris_test_derived_data_cache_store");
+    auto const cache = Gris::DerivedDataCache(directory.Path(), Gris::DerivedDataCache::DEFAULT_MAX_SIZE);
+
+    REQUIRE_FALSE(cache.Find("entry").has_value());
+
+    SECTION("Entries are written to a temporary and renamed into place")
+    {
+        auto writtenPath = std::filesystem::path{};
+        auto entryVisibleWhileWriting = true;
+        auto const write = [&](const std::filesystem::path & temporaryPath)
+        {
+            writtenPath = temporaryPath;
+            entryVisibleWhileWriting = cache.Find("entry").has_value();
+            auto file = std::ofstream(temporaryPath, std::ios::binary);
+            file << "cooked";
+        };
+        cache.Store("entry", write);
+
+        REQUIRE(writtenPath.parent_path() == directory.Path());
+        REQUIRE(writtenPath.extension() == ".tmp");
+        REQUIRE_FALSE(entryVisibleWhileWriting);
+
+        auto const entryPath = cache.Find("entry");
+        REQUIRE(entryPath.has_value());
+        REQUIRE(*entryPath == directory.Path() / "entry");
+        REQUIRE(ReadFile(*entryPath) == "cooked");
+        REQUIRE(CountTemporaries(directory.Path()) == 0);
+    }
+
+    SECTION("A failed write publishes nothing")
+    {
+        auto const write = [](const std::filesystem::path & temporaryPath)
+        {
+            WriteFile(temporaryPath, ENTRY_SIZE);
+            throw std::runtime_error("Failed");
+        };
+
+        REQUIRE_THROWS_AS(cache.Store("entry", write), std::runtime_error);
+        REQUIRE_FALSE(cache.Find("entry").has_value());
+        REQUIRE(CountTemporaries(directory.Path()) == 0);
+    }
+}
+
+TEST_CASE("Trimming derived data", "[derived data cache]")
+{
+    auto const directory = TemporaryDirectory("gris_test_derived_data_cache_trim");
+    auto const cache = Gris::DerivedDataCache(directory.Path(), 2 * ENTRY_SIZE + ENTRY_SIZE / 2);
+
+    auto const write = [](const std::filesystem::path & temporaryPath)
+    {
+        WriteFile(temporaryPath, ENTRY_SIZE);
+    };
+
+    SECTION("The least recently used entries are evicted")
+    {
+        cache.Store("first", write);
+        cache.Store("second", write);
+        SetLastUse(directory.Path() / "first", std::chrono::hours(3));
+        SetLastUse(directory.Path() / "second", std::chrono::hours(2));
+
+        // Using the older entry makes the other one the least recently used
+        REQUIRE(cache.Find("first").has_value());
+
+        cache.Store("third", write);
+
+        REQUIRE_FALSE(cache.Find("second").has_value());
+        REQUIRE(cache.Find("first").has_value());
+        REQUIRE(cache.Find("third").has_value());
+    }
+
+    SECTION("Nothing is evicted under the limit")
+    {
+        cache.Store("first", write);
+        cache.Store("second", write);
+        SetLastUse(directory.Path() / "first", std::chrono::hours(3));
+        cache.Trim();
+
+        REQUIRE(cache.Find("first").has_value());
+        REQUIRE(cache.Find("second").has_value());
+    }
+
+    SECTION("Only abandoned temporaries are removed")
+    {
+        std::filesystem::create_directories(directory.Path());
+        auto const abandoned = directory.Path() / "abandoned.0.tmp";
+        auto const inProgress = directory.Path() / "in_progress.0.tmp";
+        WriteFile(abandoned, ENTRY_SIZE);
+        WriteFile(inProgress, ENTRY_SIZE);
+        SetLastUse(abandoned, std::chrono::hours(2));
+
+        cache.Trim();
+
+        REQUIRE_FALSE(std::filesystem::exists(abandoned));
+        REQUIRE(std::filesystem::exists(inProgress));
+    }
+}
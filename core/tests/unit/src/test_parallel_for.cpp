@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include <gris/parallel_for.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Parallel for visits every index once", "[parallel for]")
+{
+    constexpr size_t COUNT = 10000;
+
+    auto visits = std::vector<std::atomic<int>>(COUNT);
+    Gris::ParallelFor(COUNT, [&visits](size_t index)
+                      { ++visits[index]; });
+
+    auto visitedOnce = true;
+    for (auto const & visit : visits)
+    {
+        visitedOnce = visitedOnce && visit == 1;
+    }
+    REQUIRE(visitedOnce);
+}
+
+TEST_CASE("Parallel for with a single index runs on the calling thread", "[parallel for]")
+{
+    auto const callingThread = std::this_thread::get_id();
+    auto workerThread = std::thread::id{};
+    Gris::ParallelFor(1, [&workerThread](size_t)
+                      { workerThread = std::this_thread::get_id(); });
+
+    REQUIRE(workerThread == callingThread);
+}
+
+TEST_CASE("Parallel for without indices does nothing", "[parallel for]")
+{
+    auto calls = std::atomic<int>(0);
+    Gris::ParallelFor(0, [&calls](size_t)
+                      { ++calls; });
+
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("Parallel for rethrows the first exception", "[parallel for]")
+{
+    constexpr size_t COUNT = 1000;
+    constexpr size_t THROWING_INDEX = 17;
+
+    auto calls = std::atomic<size_t>(0);
+    auto const throwing = [&calls](size_t index)
+    {
+        ++calls;
+        if (index == THROWING_INDEX)
+        {
+            throw std::runtime_error("Failed");
+        }
+    };
+
+    REQUIRE_THROWS_AS(Gris::ParallelFor(COUNT, throwing), std::runtime_error);
+    // Indices are handed out in order and every index handed out is called
+    REQUIRE(calls.load() >= THROWING_INDEX + 1);
+    REQUIRE(calls.load() <= COUNT);
+}
@@ -1,21 +1,23 @@
 #include "forward_rendering_application.h"
 
+#include <gris/graphics/compact_mesh.h>
 #include <gris/graphics/image.h>
 #include <gris/graphics/loaders/assimp_mesh_loader.h>
 #include <gris/graphics/loaders/dds_ktx_image_loader.h>
 #include <gris/graphics/scene.h>
+#include <gris/graphics/vertex_streams.h>
 
+#include <gris/graphics/vulkan/barrier_batch.h>
 #include <gris/graphics/vulkan/buffer.h>
 #include <gris/graphics/vulkan/buffer_view.h>
 #include <gris/graphics/vulkan/deferred_context.h>
 #include <gris/graphics/vulkan/device.h>
-#include <gris/graphics/vulkan/framebuffer.h>
+#include <gris/graphics/vulkan/frame_graph.h>
 #include <gris/graphics/vulkan/glfw/window.h>
 #include <gris/graphics/vulkan/immediate_context.h>
 #include <gris/graphics/vulkan/input_layout.h>
 #include <gris/graphics/vulkan/physical_device_factory.h>
 #include <gris/graphics/vulkan/pipeline_state_object.h>
-#include <gris/graphics/vulkan/render_pass.h>
 #include <gris/graphics/vulkan/sampler.h>
 #include <gris/graphics/vulkan/shader.h>
 #include <gris/graphics/vulkan/shader_resource_bindings.h>
@@ -37,7 +39,15 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // -------------------------------------------------------------------------------------------------
@@ -45,9 +55,23 @@
 constexpr static uint32_t INITIAL_WINDOW_WIDTH = 800;
 constexpr static uint32_t INITIAL_WINDOW_HEIGHT = 600;
 
+enum class GeometryLayout
+{
+    // One stream of Vertex
+    Interleaved,
+    // Positions and the remaining attributes in separate streams, the depth prepass binds just the positions
+    SplitPositions,
+    // Quantized 12 byte vertices and 16 bit indices where they fit
+    Compact,
+};
+
+constexpr static GeometryLayout GEOMETRY_LAYOUT = GeometryLayout::Compact;
+constexpr static Gris::Graphics::TextureCoordsEncoding COMPACT_TEXTURE_COORDS_ENCODING = Gris::Graphics::TextureCoordsEncoding::Unorm16;
+
 const char * const MODEL_PATH = "sponza.dae";
-const char * const VERTEX_SHADER_PATH = "vertex.spv";
+const char * const VERTEX_SHADER_PATH = GEOMETRY_LAYOUT == GeometryLayout::Compact ? "vertex_compact.spv" : "vertex.spv";
 const char * const FRAGMENT_SHADER_PATH = "fragment.spv";
+const char * const DEPTH_VERTEX_SHADER_PATH = "vertex_depth.spv";
 
 constexpr static int MAX_FRAMES_IN_FLIGHT = 3;
 
@@ -145,17 +169,10 @@ void ForwardRenderingApplication::MouseMoveEvent(float x, float y)
 
 void ForwardRenderingApplication::MouseWheelEvent(float /* x */, float /* y */, float delta)
 {
-    constexpr static float ZOOM_IN_FACTOR = 1.1F;
-    constexpr static float ZOOM_OUT_FACTOR = 0.9F;
+    // Per wheel step, the delta sums all the steps of the frame
+    constexpr static float ZOOM_FACTOR_PER_STEP = 1.1F;
 
-    if (delta > 0)
-    {
-        m_lens.SetZoomFactor(ZOOM_IN_FACTOR * m_lens.GetZoomFactor());
-    }
-    else
-    {
-        m_lens.SetZoomFactor(ZOOM_OUT_FACTOR * m_lens.GetZoomFactor());
-    }
+    m_lens.SetZoomFactor(std::pow(ZOOM_FACTOR_PER_STEP, delta) * m_lens.GetZoomFactor());
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -179,33 +196,45 @@ void ForwardRenderingApplication::InitWindow()
 
 void ForwardRenderingApplication::CreateVulkanObjects()
 {
-    if (!m_device)
-    {
-        CreateDevice();
-    }
-    else
+    CreateDevice();
+    CreateSwapChain();
+    CreateFrameGraph();
+    CreatePipelineStateObject();
+    CreateShaderResourceBindingsPools();
+    LoadScene();
+    CreateUniformBuffersAndBindings();
+    CreateCommandBuffers();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::ResizeSwapChain()
+{
+    // Pools, uniform buffers and bindings do not depend on the size, and the old swap chain and
+    // attachments are retired by the device once the frames using them complete, so there is no idle wait
+    auto const previousFormat = m_swapChain.Format();
+    auto const previousImageCount = m_swapChain.ImageCount();
+    m_swapChain.Resize(m_window, m_window.Width(), m_window.Height());
+
+    if (m_swapChain.ImageCount() != previousImageCount)
     {
-        WaitForDeviceToBeIdle();
+        CreateCommandBuffers();
     }
 
-    CreateSwapChain();
-    CreateRenderPass();
-
-    if (!m_pso)
+    if (m_swapChain.Format() != previousFormat)
     {
+        CreateFrameGraph();
         CreatePipelineStateObject();
+        return;
     }
 
-    CreateFramebuffers();
-    CreateShaderResourceBindingsPools();
-
-    if (m_scene.Meshes.empty())
+    auto const swapChainExtent = m_swapChain.Extent();
+    for (auto const resource : std::array{ m_backBuffer, m_colorTarget, m_depthTarget })
     {
-        LoadScene();
+        m_frameGraph.SetTextureExtent(resource, swapChainExtent.width, swapChainExtent.height);
     }
 
-    CreateUniformBuffersAndBindings();
-    CreateCommandBuffers();
+    m_frameGraph.Compile();
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -221,41 +250,221 @@ void ForwardRenderingApplication::LoadScene()
 
 void ForwardRenderingApplication::MainLoop()
 {
+    // GLFW has to be driven from the main thread, so input and simulation stay here
+    StartFramePipeline();
+
     while (!m_window.ShouldClose())
     {
+        // The camera sees the input of the whole frame at once, with the mouse moves coalesced
         Gris::Graphics::Glfw::Instance::PollEvents();
-        DrawFrame();
+        m_window.DispatchInputEvents();
+
+        if (m_framebufferResized || m_swapChainOutOfDate)
+        {
+            StopFramePipeline();
+            ResizeSwapChain();
+            m_framebufferResized = false;
+            m_swapChainOutOfDate = false;
+            StartFramePipeline();
+        }
+
+        auto const frameConstants = SimulateFrame();
+        {
+            auto const lock = std::lock_guard(m_latestFrameConstantsMutex);
+            m_latestFrameConstants = frameConstants;
+        }
+
+        // Blocks while the render stage is busy, which paces the simulation to the rest of the pipeline. Fails only
+        // when one of the stages threw, the error is rethrown when the pipeline is stopped.
+        if (!m_simulatedFrames.Push(m_simulatedFrameCount++))
+        {
+            break;
+        }
     }
 
+    StopFramePipeline();
     m_device.WaitIdle();
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void ForwardRenderingApplication::CreateDevice()
+void ForwardRenderingApplication::StartFramePipeline()
 {
-    m_device = Gris::Graphics::Vulkan::Device(FindSuitablePhysicalDevice(m_window));
+    // Every acquired image that was not presented yet holds a slot. With fewer slots than virtual frames the frame
+    // NextImage waits on has always been submitted, so the render stage never blocks waiting for the submit stage
+    // while holding the swap chain lock. The swap chain is created with enough images for the acquires not to block
+    // on the presentation engine either.
+    auto const acquireSlotCount = std::max(std::min(m_swapChain.VirtualFrameCount() - 1, m_swapChain.AcquirableImageCount()), 1U);
+
+    m_simulatedFrames.Reset(1);
+    m_preparedFrames.Reset(1);
+    m_freeAcquireSlots.Reset(acquireSlotCount);
+    for (uint32_t acquireSlot = 0; acquireSlot < acquireSlotCount; ++acquireSlot)
+    {
+        m_freeAcquireSlots.Push(acquireSlot);
+    }
+
+    m_submitThread = std::thread([this]()
+                                 { RunFramePipelineStage(&ForwardRenderingApplication::SubmitFrames); });
+    m_renderThread = std::thread([this]()
+                                 { RunFramePipelineStage(&ForwardRenderingApplication::RenderFrames); });
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void ForwardRenderingApplication::WaitForDeviceToBeIdle() const
+void ForwardRenderingApplication::StopFramePipeline()
 {
-    m_device.WaitIdle();
+    // The render stage finishes the frames it has and closes its output, the submit stage then presents everything
+    // that was acquired
+    m_simulatedFrames.Close();
+
+    if (m_renderThread.joinable())
+    {
+        m_renderThread.join();
+    }
+
+    if (m_submitThread.joinable())
+    {
+        m_submitThread.join();
+    }
+
+    if (m_framePipelineError)
+    {
+        std::rethrow_exception(std::exchange(m_framePipelineError, {}));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::RunFramePipelineStage(void (ForwardRenderingApplication::*stage)())
+{
+    try
+    {
+        (this->*stage)();
+    }
+    catch (...)
+    {
+        {
+            auto const lock = std::lock_guard(m_framePipelineErrorMutex);
+            if (!m_framePipelineError)
+            {
+                m_framePipelineError = std::current_exception();
+            }
+        }
+
+        // Unblocks the other stages, the main thread notices on its next push
+        m_simulatedFrames.Close();
+        m_preparedFrames.Close();
+        m_freeAcquireSlots.Close();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::RenderFrames()
+{
+    while (m_simulatedFrames.Pop())
+    {
+        auto const acquireSlot = m_freeAcquireSlots.Pop();
+        if (!acquireSlot)
+        {
+            break;
+        }
+
+        auto preparedFrame = PrepareFrame(*acquireSlot);
+        if (!preparedFrame)
+        {
+            // Nothing was acquired, the main thread recreates the swap chain and restarts the pipeline
+            m_swapChainOutOfDate = true;
+            m_freeAcquireSlots.Push(*acquireSlot);
+            continue;
+        }
+
+        if (!m_preparedFrames.Push(*preparedFrame))
+        {
+            break;
+        }
+    }
+
+    m_preparedFrames.Close();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::SubmitFrames()
+{
+    while (auto const preparedFrame = m_preparedFrames.Pop())
+    {
+        SubmitFrame(*preparedFrame);
+        m_freeAcquireSlots.Push(preparedFrame->AcquireSlot);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::CreateDevice()
+{
+    m_device = Gris::Graphics::Vulkan::Device(FindSuitablePhysicalDevice(m_window));
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void ForwardRenderingApplication::CreateSwapChain()
 {
-    m_swapChain = m_device.CreateSwapChain(m_window, m_window.Width(), m_window.Height(), MAX_FRAMES_IN_FLIGHT, std::move(m_swapChain));
+    m_swapChain = m_device.CreateSwapChain(m_window, m_window.Width(), m_window.Height(), MAX_FRAMES_IN_FLIGHT);
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void ForwardRenderingApplication::CreateRenderPass()
+void ForwardRenderingApplication::CreateFrameGraph()
 {
-    m_renderPass = m_device.CreateRenderPass(m_swapChain.Format(), FindDepthFormat());
+    auto const swapChainExtent = m_swapChain.Extent();
+    auto const swapChainFormat = m_swapChain.Format();
+
+    auto const backBufferDescription = Gris::Graphics::Vulkan::FrameGraphTextureDescription{ swapChainExtent.width, swapChainExtent.height, swapChainFormat, vk::SampleCountFlagBits::e1 };
+    auto const colorDescription = Gris::Graphics::Vulkan::FrameGraphTextureDescription{ swapChainExtent.width, swapChainExtent.height, swapChainFormat, m_device.MsaaSamples() };
+    auto const depthDescription = Gris::Graphics::Vulkan::FrameGraphTextureDescription{ swapChainExtent.width, swapChainExtent.height, FindDepthFormat(), m_device.MsaaSamples() };
+
+    // The submit waits for the image to be acquired at the color attachment output stage
+    auto const backBufferInitialState = Gris::Graphics::Vulkan::TextureState{ vk::ImageLayout::eUndefined, {}, vk::PipelineStageFlagBits::eColorAttachmentOutput };
+    auto const backBufferFinalState = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::ePresentSrcKHR);
+
+    m_frameGraph = m_device.CreateFrameGraph();
+    m_backBuffer = m_frameGraph.ImportTexture("BackBuffer", backBufferDescription, backBufferInitialState, backBufferFinalState);
+    m_colorTarget = m_frameGraph.CreateTexture("Color", colorDescription);
+    m_depthTarget = m_frameGraph.CreateTexture("Depth", depthDescription);
+
+    if constexpr (GEOMETRY_LAYOUT == GeometryLayout::SplitPositions)
+    {
+        // The prepass lays down the depth from the position stream alone, the forward pass then shades only the
+        // visible fragments
+        m_depthPrepass = m_frameGraph.AddPass("DepthPrepass", [this](Gris::Graphics::Vulkan::DeferredContext & context)
+                                              { DrawDepth(context); })
+                             .DepthAttachment(m_depthTarget, vk::ClearDepthStencilValue(1.0F, 0))
+                             .Pass();
+
+        m_forwardPass = m_frameGraph.AddPass("Forward", [this](Gris::Graphics::Vulkan::DeferredContext & context)
+                                             { DrawScene(context); })
+                            .ColorAttachment(m_colorTarget, vk::ClearColorValue(std::array{ 0.0F, 0.0F, 0.0F, 1.0F }))
+                            .DepthAttachment(m_depthTarget)
+                            .ResolveAttachment(m_backBuffer)
+                            .Pass();
+    }
+    else
+    {
+        m_forwardPass = m_frameGraph.AddPass("Forward", [this](Gris::Graphics::Vulkan::DeferredContext & context)
+                                             { DrawScene(context); })
+                            .ColorAttachment(m_colorTarget, vk::ClearColorValue(std::array{ 0.0F, 0.0F, 0.0F, 1.0F }))
+                            .DepthAttachment(m_depthTarget, vk::ClearDepthStencilValue(1.0F, 0))
+                            .ResolveAttachment(m_backBuffer)
+                            .Pass();
+    }
+
+    m_frameGraph.Compile();
+
+    // A new graph starts counting its versions over
+    m_recordedFrameGraphVersion = m_frameGraph.RecordingVersion();
+    ++m_recordingVersion;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -288,36 +497,101 @@ void ForwardRenderingApplication::CreateMesh()
         throw Gris::EngineException("Error resolving model path - file not found", MODEL_PATH);
     }
 
-    std::tie(m_scene.Meshes, m_materialBlueprints) = Gris::Graphics::Loaders::AssimpMeshLoader::Load(*modelPath);
+    // Converted meshes come out of the derived data cache when the model was converted before
+    auto [meshes, materials] = Gris::Graphics::Loaders::AssimpMeshLoader::Load(*modelPath);
+    for (auto const & mesh : meshes)
+    {
+        UploadMesh(Gris::Span<const Gris::Graphics::Vertex>(mesh.Vertices.data(), mesh.Vertices.size()), Gris::Span<const uint32_t>(mesh.Indices.data(), mesh.Indices.size()));
+    }
 
-    ///
+    m_materialBlueprints = std::move(materials);
 
-    for (auto const & mesh : m_scene.Meshes)
+    if constexpr (GEOMETRY_LAYOUT == GeometryLayout::Compact)
     {
-        auto const vertexBufferSize = sizeof(mesh.Vertices[0]) * mesh.Vertices.size();
+        UploadDequantizations();
+    }
 
-        auto vertexStagingBuffer = m_device.CreateBuffer(vertexBufferSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-        vertexStagingBuffer.SetData(mesh.Vertices.data(), static_cast<size_t>(vertexBufferSize));
+    ++m_recordingVersion;
+}
 
-        auto & vertexBuffer = m_vertexBuffers.emplace_back(m_device.CreateBuffer(vertexBufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
-        m_device.Context().CopyBuffer(vertexStagingBuffer, vertexBuffer, vertexBufferSize);
+// -------------------------------------------------------------------------------------------------
 
-        m_vertexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(vertexBuffer, 0, static_cast<uint32_t>(vertexBufferSize)));
+void ForwardRenderingApplication::UploadMesh(Gris::Span<const Gris::Graphics::Vertex> vertices, Gris::Span<const uint32_t> indices)
+{
+    if constexpr (GEOMETRY_LAYOUT == GeometryLayout::Compact)
+    {
+        auto const compactMesh = Gris::Graphics::EncodeCompactMesh(vertices, indices, COMPACT_TEXTURE_COORDS_ENCODING);
+        UploadGeometry(compactMesh.Vertices.data(), compactMesh.Vertices.size() * sizeof(Gris::Graphics::CompactVertex), compactMesh.IndexData.data(), compactMesh.IndexData.size(), compactMesh.IndexType, compactMesh.IndexCount);
+        m_meshDequantizations.emplace_back(compactMesh.Dequantization);
     }
+    else if constexpr (GEOMETRY_LAYOUT == GeometryLayout::SplitPositions)
+    {
+        auto const positions = Gris::Graphics::ExtractVertexStream<Gris::Graphics::PositionStreamFormat>(vertices);
+        auto const attributes = Gris::Graphics::ExtractVertexStream<Gris::Graphics::AttributeStreamFormat>(vertices);
+        UploadGeometry(positions.data(), positions.size() * sizeof(Gris::Graphics::PositionStreamFormat::Vertex), indices.data(), indices.size_bytes(), Gris::Graphics::IndexFormat::Uint32, indices.size());
+        UploadAttributeStream(attributes.data(), attributes.size() * sizeof(Gris::Graphics::AttributeStreamFormat::Vertex));
+    }
+    else
+    {
+        UploadGeometry(vertices.data(), vertices.size_bytes(), indices.data(), indices.size_bytes(), Gris::Graphics::IndexFormat::Uint32, indices.size());
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::UploadGeometry(const void * vertexData, size_t vertexDataSize, const void * indexData, size_t indexDataSize, Gris::Graphics::IndexFormat indexFormat, size_t indexCount)
+{
+    auto vertexStagingBuffer = m_device.CreateBuffer(vertexDataSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    vertexStagingBuffer.SetData(vertexData, vertexDataSize);
+
+    auto & vertexBuffer = m_vertexBuffers.emplace_back(m_device.CreateBuffer(vertexDataSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
+    m_device.Context().CopyBuffer(vertexStagingBuffer, vertexBuffer, vertexDataSize);
+
+    m_vertexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(vertexBuffer, 0, static_cast<uint32_t>(vertexDataSize)));
 
     ///
 
-    for (auto const & mesh : m_scene.Meshes)
-    {
-        auto const indexBufferSize = sizeof(mesh.Indices[0]) * mesh.Indices.size();
+    auto indexStagingBuffer = m_device.CreateBuffer(indexDataSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    indexStagingBuffer.SetData(indexData, indexDataSize);
 
-        auto indexStagingBuffer = m_device.CreateBuffer(indexBufferSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-        indexStagingBuffer.SetData(mesh.Indices.data(), static_cast<size_t>(indexBufferSize));
+    auto & indexBuffer = m_indexBuffers.emplace_back(m_device.CreateBuffer(indexDataSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
+    m_device.Context().CopyBuffer(indexStagingBuffer, indexBuffer, indexDataSize);
 
-        auto & indexBuffer = m_indexBuffers.emplace_back(m_device.CreateBuffer(indexBufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
-        m_device.Context().CopyBuffer(indexStagingBuffer, indexBuffer, indexBufferSize);
+    m_indexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(indexBuffer, 0, static_cast<uint32_t>(indexDataSize)));
+    m_meshIndexFormats.emplace_back(indexFormat);
+    m_meshIndexCounts.emplace_back(static_cast<uint32_t>(indexCount));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::UploadAttributeStream(const void * data, size_t size)
+{
+    auto stagingBuffer = m_device.CreateBuffer(size, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    stagingBuffer.SetData(data, size);
+
+    auto & attributeBuffer = m_attributeBuffers.emplace_back(m_device.CreateBuffer(size, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal));
+    m_device.Context().CopyBuffer(stagingBuffer, attributeBuffer, size);
+
+    m_attributeBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(attributeBuffer, 0, static_cast<uint32_t>(size)));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::UploadDequantizations()
+{
+    // One buffer for all meshes, each draw binds its element as the single instance of the per instance binding
+    auto const bufferSize = m_meshDequantizations.size() * sizeof(Gris::Graphics::CompactMeshDequantization);
+
+    auto stagingBuffer = m_device.CreateBuffer(bufferSize, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    stagingBuffer.SetData(m_meshDequantizations.data(), bufferSize);
 
-        m_indexBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(indexBuffer, 0, static_cast<uint32_t>(indexBufferSize)));
+    m_dequantizationBuffer = m_device.CreateBuffer(bufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    m_device.Context().CopyBuffer(stagingBuffer, m_dequantizationBuffer, bufferSize);
+
+    m_dequantizationBufferViews.clear();
+    for (size_t meshIndex = 0; meshIndex < m_meshDequantizations.size(); ++meshIndex)
+    {
+        m_dequantizationBufferViews.emplace_back(Gris::Graphics::Vulkan::BufferView(m_dequantizationBuffer, static_cast<uint32_t>(meshIndex * sizeof(Gris::Graphics::CompactMeshDequantization)), static_cast<uint32_t>(sizeof(Gris::Graphics::CompactMeshDequantization))));
     }
 }
 
@@ -349,11 +623,10 @@ void ForwardRenderingApplication::CreateMeshTexture()
 
     ///
 
-    m_device.Context().TransitionImageLayout(m_meshTextureImage, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
     auto stagingBuffer = m_device.CreateBuffer(image.PixelData.size(), vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
     stagingBuffer.SetData(image.PixelData.data(), image.PixelData.size());
     m_device.Context().CopyBufferToImage(stagingBuffer, m_meshTextureImage, image.Width, image.Height);
-    m_device.Context().TransitionImageLayout(m_meshTextureImage, vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+    m_device.Context().TransitionImageLayout(m_meshTextureImage, vk::ImageLayout::eShaderReadOnlyOptimal);
 
     ///
 
@@ -431,33 +704,44 @@ void ForwardRenderingApplication::CreatePipelineStateObject()
     ///
 
     Gris::Graphics::Vulkan::InputLayout layout;
-    layout.AddBinding(0, sizeof(Gris::Graphics::Vertex), vk::VertexInputRate::eVertex);
-    layout.AddAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(Gris::Graphics::Vertex, Position));
-    layout.AddAttributeDescription(1, 0, vk::Format::eR32G32B32Sfloat, offsetof(Gris::Graphics::Vertex, Color));
-    layout.AddAttributeDescription(2, 0, vk::Format::eR32G32Sfloat, offsetof(Gris::Graphics::Vertex, TextureCoords));
-
-    m_pso = m_device.CreatePipelineStateObject({}, {}, m_renderPass, layout, m_resourceLayouts, m_vertexShader, m_fragmentShader);
-}
+    if constexpr (GEOMETRY_LAYOUT == GeometryLayout::Compact)
+    {
+        layout.AddVertexFormat<Gris::Graphics::CompactVertexFormat<COMPACT_TEXTURE_COORDS_ENCODING>>(0);
+        layout.AddVertexFormat<Gris::Graphics::CompactMeshDequantizationFormat>(1, vk::VertexInputRate::eInstance);
+    }
+    else if constexpr (GEOMETRY_LAYOUT == GeometryLayout::SplitPositions)
+    {
+        layout.AddVertexFormat<Gris::Graphics::PositionStreamFormat>(Gris::Graphics::POSITION_STREAM_BINDING);
+        layout.AddVertexFormat<Gris::Graphics::AttributeStreamFormat>(Gris::Graphics::ATTRIBUTE_STREAM_BINDING);
+    }
+    else
+    {
+        layout.AddVertexFormat<Gris::Graphics::MeshVertexFormat>(0);
+    }
 
-// -------------------------------------------------------------------------------------------------
+    m_pso = m_device.CreatePipelineStateObject({}, {}, m_frameGraph.PassRenderPass(m_forwardPass), layout, m_resourceLayouts, m_vertexShader, m_fragmentShader);
 
-void ForwardRenderingApplication::CreateFramebuffers()
-{
-    auto const swapChainExtent = m_swapChain.Extent();
-    auto const swapChainFormat = m_swapChain.Format();
-    auto const depthFormat = FindDepthFormat();
+    if constexpr (GEOMETRY_LAYOUT == GeometryLayout::SplitPositions)
+    {
+        if (!m_depthVertexShader)
+        {
+            auto const depthVertexShaderPath = Gris::DirectoryRegistry::TryResolvePath(DEPTH_VERTEX_SHADER_PATH);
+            if (!depthVertexShaderPath)
+            {
+                throw Gris::EngineException("Error resolving depth vertex shader path", DEPTH_VERTEX_SHADER_PATH);
+            }
 
-    m_colorImage = m_device.CreateTexture(swapChainExtent.width, swapChainExtent.height, 1, m_device.MsaaSamples(), swapChainFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eTransientAttachment | vk::ImageUsageFlagBits::eColorAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal);
-    m_colorImageView = m_device.CreateTextureView(m_colorImage, swapChainFormat, vk::ImageAspectFlagBits::eColor, 1);
+            m_depthVertexShader = m_device.CreateShader(Gris::ReadFile<uint32_t>(*depthVertexShaderPath), "main");
+        }
 
-    m_depthImage = m_device.CreateTexture(swapChainExtent.width, swapChainExtent.height, 1, m_device.MsaaSamples(), depthFormat, vk::ImageTiling::eOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal);
-    m_depthImageView = m_device.CreateTextureView(m_depthImage, depthFormat, vk::ImageAspectFlagBits::eDepth, 1);
+        // Fetches 12 bytes per vertex, the attribute stream is not bound at all
+        Gris::Graphics::Vulkan::InputLayout depthLayout;
+        depthLayout.AddVertexFormat<Gris::Graphics::PositionStreamFormat>(Gris::Graphics::POSITION_STREAM_BINDING);
 
-    m_swapChainFramebuffers.resize(m_swapChain.ImageCount());
-    for (size_t i = 0; i < m_swapChain.ImageCount(); i++)
-    {
-        m_swapChainFramebuffers[i] = m_device.CreateFramebuffer(m_colorImageView, m_depthImageView, m_swapChain.ImageView(i), m_renderPass, swapChainExtent.width, swapChainExtent.height);
+        m_depthPso = m_device.CreatePipelineStateObject({}, {}, m_frameGraph.PassRenderPass(m_depthPrepass), depthLayout, m_resourceLayouts, m_depthVertexShader);
     }
+
+    ++m_recordingVersion;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -505,22 +789,27 @@ void ForwardRenderingApplication::CreateUniformBuffersAndBindings()
         m_shaderResourceBindings[i][PER_MATERIAL_DESCRIPTOR_SET_INDEX].PrepareBindings(m_shaderResourceBindingsPoolCategory, &m_shaderResourceBindingsPools);
         m_shaderResourceBindings[i][PER_DRAW_DESCRIPTOR_SET_INDEX].PrepareBindings(m_shaderResourceBindingsPoolCategory, &m_shaderResourceBindingsPools);
     }
+
+    ++m_recordingVersion;
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void ForwardRenderingApplication::CreateCommandBuffers()
 {
-    m_commandBuffers.resize(m_swapChain.VirtualFrameCount());
-    for (uint32_t i = 0; i < m_swapChain.VirtualFrameCount(); i++)
+    // One reusable recording per virtual frame and swap chain image pair, the uniform buffer and bindings follow the
+    // virtual frame while the back buffer follows the image. The virtual frame fence guarantees the previous
+    // submission of a recording has completed before it is submitted again.
+    m_commandBuffers.resize(static_cast<size_t>(m_swapChain.VirtualFrameCount()) * m_swapChain.ImageCount());
+    for (auto & commandBuffer : m_commandBuffers)
     {
-        m_commandBuffers[i] = m_device.CreateDeferredContext(true);
+        commandBuffer = m_device.CreateDeferredContext(false);
     }
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void ForwardRenderingApplication::UpdateUniformBuffer(uint32_t currentVirtualFrameIndex)
+[[nodiscard]] ForwardRenderingApplication::FrameConstants ForwardRenderingApplication::SimulateFrame()
 {
     auto const swapChainExtent = m_swapChain.Extent();
     auto const aspectRatio = static_cast<float>(swapChainExtent.width) / static_cast<float>(swapChainExtent.height);
@@ -528,58 +817,129 @@ void ForwardRenderingApplication::UpdateUniformBuffer(uint32_t currentVirtualFra
     m_lens.UpdateMatrices(aspectRatio);
     m_camera.UpdateMatrices();
 
+    return FrameConstants{ m_camera.GetViewMatrix(), m_lens.GetProjectionMatrix() };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::LatchUniformBuffer(uint32_t currentVirtualFrameIndex)
+{
+    auto frameConstants = FrameConstants{};
+    {
+        auto const lock = std::lock_guard(m_latestFrameConstantsMutex);
+        frameConstants = m_latestFrameConstants;
+    }
+
     UniformBufferObject ubo = {
         glm::mat4(1.0F),
-        m_camera.GetViewMatrix(),
-        m_lens.GetProjectionMatrix(),
+        frameConstants.View,
+        frameConstants.Projection,
     };
     ubo.proj[1][1] *= -1;
 
-    m_uniformBuffers[currentVirtualFrameIndex].SetData(&ubo, sizeof(ubo));
+    std::memcpy(m_uniformBuffers[currentVirtualFrameIndex].MappedData(), &ubo, sizeof(ubo));
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void ForwardRenderingApplication::DrawFrame()
+void ForwardRenderingApplication::DrawScene(Gris::Graphics::Vulkan::DeferredContext & context)
 {
-    auto const nextImageResult = m_swapChain.NextImage();
-    if (!nextImageResult)
+    auto const swapChainExtent = m_swapChain.Extent();
+
+    context.BindPipeline(m_pso);
+    context.SetViewport(swapChainExtent.width, swapChainExtent.height);
+    context.SetScissor(swapChainExtent.width, swapChainExtent.height);
+    context.BindDescriptorSet(m_pso, 0, m_shaderResourceBindings[m_currentVirtualFrameIndex]);
+
+    for (size_t meshIndex = 0; meshIndex < m_meshIndexCounts.size(); ++meshIndex)
     {
-        CreateVulkanObjects();
-        return;
+        context.BindVertexBuffer(m_vertexBufferViews[meshIndex]);
+        if constexpr (GEOMETRY_LAYOUT == GeometryLayout::Compact)
+        {
+            context.BindVertexBuffer(1, m_dequantizationBufferViews[meshIndex]);
+        }
+        else if constexpr (GEOMETRY_LAYOUT == GeometryLayout::SplitPositions)
+        {
+            context.BindVertexBuffer(Gris::Graphics::ATTRIBUTE_STREAM_BINDING, m_attributeBufferViews[meshIndex]);
+        }
+        context.BindIndexBuffer(m_indexBufferViews[meshIndex], m_meshIndexFormats[meshIndex]);
+        context.DrawIndexed(m_meshIndexCounts[meshIndex]);
     }
+}
 
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::DrawDepth(Gris::Graphics::Vulkan::DeferredContext & context)
+{
     auto const swapChainExtent = m_swapChain.Extent();
 
-    UpdateUniformBuffer(nextImageResult->VirtualFrameIndex);
+    context.BindPipeline(m_depthPso);
+    context.SetViewport(swapChainExtent.width, swapChainExtent.height);
+    context.SetScissor(swapChainExtent.width, swapChainExtent.height);
+    context.BindDescriptorSet(m_depthPso, 0, m_shaderResourceBindings[m_currentVirtualFrameIndex]);
+
+    for (size_t meshIndex = 0; meshIndex < m_meshIndexCounts.size(); ++meshIndex)
+    {
+        context.BindVertexBuffer(Gris::Graphics::POSITION_STREAM_BINDING, m_vertexBufferViews[meshIndex]);
+        context.BindIndexBuffer(m_indexBufferViews[meshIndex], m_meshIndexFormats[meshIndex]);
+        context.DrawIndexed(m_meshIndexCounts[meshIndex]);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::optional<ForwardRenderingApplication::PreparedFrame> ForwardRenderingApplication::PrepareFrame(uint32_t acquireSlot)
+{
+    auto nextImageResult = std::optional<Gris::Graphics::Vulkan::VirtualFrame>{};
+    {
+        auto const lock = std::lock_guard(m_swapChainMutex);
+        nextImageResult = m_swapChain.NextImage();
+    }
+
+    if (!nextImageResult)
+    {
+        return std::nullopt;
+    }
 
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].ResetContext(false);
+    m_currentVirtualFrameIndex = nextImageResult->VirtualFrameIndex;
 
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].Begin(true);
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].BeginRenderPass(m_renderPass, m_swapChainFramebuffers[nextImageResult->SwapChainImageIndex], m_swapChain.Extent());
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].BindPipeline(m_pso);
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].SetViewport(swapChainExtent.width, swapChainExtent.height);
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].SetScissor(swapChainExtent.width, swapChainExtent.height);
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].BindDescriptorSet(m_pso, 0, m_shaderResourceBindings[nextImageResult->VirtualFrameIndex]);
+    if (m_frameGraph.RecordingVersion() != m_recordedFrameGraphVersion)
+    {
+        m_recordedFrameGraphVersion = m_frameGraph.RecordingVersion();
+        ++m_recordingVersion;
+    }
 
-    for (size_t meshIndex = 0; meshIndex < m_scene.Meshes.size(); ++meshIndex)
+    // Only the uniform buffer contents change from frame to frame, everything else is recorded once. Recording only
+    // touches the command buffer and the frame graph, which belong to this stage while the pipeline runs.
+    auto & commandBuffer = m_commandBuffers[static_cast<size_t>(nextImageResult->VirtualFrameIndex) * m_swapChain.ImageCount() + nextImageResult->SwapChainImageIndex];
+    if (!commandBuffer.HasRecording(m_recordingVersion))
     {
-        m_commandBuffers[nextImageResult->VirtualFrameIndex].BindVertexBuffer(m_vertexBufferViews[meshIndex]);
-        m_commandBuffers[nextImageResult->VirtualFrameIndex].BindIndexBuffer(m_indexBufferViews[meshIndex]);
-        m_commandBuffers[nextImageResult->VirtualFrameIndex].DrawIndexed(static_cast<uint32_t>(m_scene.Meshes[meshIndex].Indices.size()));
+        commandBuffer.BeginReusable(m_recordingVersion);
+        m_frameGraph.SetImportedTexture(m_backBuffer, m_swapChain.Image(nextImageResult->SwapChainImageIndex), m_swapChain.ImageView(nextImageResult->SwapChainImageIndex).ImageViewHandle());
+        m_frameGraph.Execute(commandBuffer);
+        commandBuffer.End();
     }
 
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].EndRenderPass();
-    m_commandBuffers[nextImageResult->VirtualFrameIndex].End();
+    return PreparedFrame{ *nextImageResult, &commandBuffer, acquireSlot };
+}
 
-    auto const waitSemaphores = std::vector{ std::ref(m_swapChain.ImageAvailableSemaphore(*nextImageResult)) };
-    auto const signalSemaphores = std::vector{ std::ref(m_swapChain.RenderingFinishedSemaphore(*nextImageResult)) };
-    m_device.Context().Submit(&m_commandBuffers[nextImageResult->VirtualFrameIndex], waitSemaphores, signalSemaphores, m_swapChain.RenderingFinishedFence(*nextImageResult));
+// -------------------------------------------------------------------------------------------------
+
+void ForwardRenderingApplication::SubmitFrame(const PreparedFrame & frame)
+{
+    // Late latch, right before the submit this copies m_latestFrameConstants as the main thread last simulated them,
+    // usually a frame or two ahead of the frame this was recorded for
+    LatchUniformBuffer(frame.Frame.VirtualFrameIndex);
+
+    auto presentResult = false;
+    {
+        auto const lock = std::lock_guard(m_swapChainMutex);
+        m_swapChain.Submit(*frame.CommandBuffer, frame.Frame);
+        presentResult = m_swapChain.Present(frame.Frame);
+    }
 
-    auto const presentResult = m_swapChain.Present(*nextImageResult);
-    if (!presentResult || m_framebufferResized)
+    if (!presentResult)
     {
-        CreateVulkanObjects();
-        m_framebufferResized = false;
+        m_swapChainOutOfDate = true;
     }
 }
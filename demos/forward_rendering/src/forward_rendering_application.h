@@ -4,10 +4,9 @@
 #include <gris/graphics/vulkan/buffer_view.h>
 #include <gris/graphics/vulkan/deferred_context.h>
 #include <gris/graphics/vulkan/device.h>
-#include <gris/graphics/vulkan/framebuffer.h>
+#include <gris/graphics/vulkan/frame_graph.h>
 #include <gris/graphics/vulkan/glfw/window.h>
 #include <gris/graphics/vulkan/pipeline_state_object.h>
-#include <gris/graphics/vulkan/render_pass.h>
 #include <gris/graphics/vulkan/sampler.h>
 #include <gris/graphics/vulkan/shader.h>
 #include <gris/graphics/vulkan/shader_resource_bindings.h>
@@ -18,10 +17,21 @@
 #include <gris/graphics/vulkan/texture_view.h>
 
 #include <gris/graphics/cameras/trackball_camera.h>
+#include <gris/graphics/compact_mesh.h>
 #include <gris/graphics/lens/perspective_lens.h>
 #include <gris/graphics/scene.h>
 
+#include <gris/bounded_queue.h>
+#include <gris/span.h>
+
+#include <glm/glm.hpp>
+
+#include <atomic>
 #include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 class ForwardRenderingApplication : public Gris::Graphics::WindowObserver
@@ -35,6 +45,21 @@ private:
     constexpr static uint32_t PER_DRAW_DESCRIPTOR_SET_INDEX = 2;
     constexpr static uint32_t DESCRIPTOR_SET_COUNT = 3;
 
+    // Output of the simulation stage, the camera as of the last input
+    struct FrameConstants
+    {
+        glm::mat4 View = glm::mat4(1.0F);
+        glm::mat4 Projection = glm::mat4(1.0F);
+    };
+
+    // Handed from the render stage to the submit stage, the image stays acquired until the submit stage presents it
+    struct PreparedFrame
+    {
+        Gris::Graphics::Vulkan::VirtualFrame Frame = {};
+        Gris::Graphics::Vulkan::DeferredContext * CommandBuffer = nullptr;
+        uint32_t AcquireSlot = 0;
+    };
+
     static void SetupAssetDirectory();
 
     [[nodiscard]] vk::Format FindDepthFormat() const;
@@ -46,57 +71,82 @@ private:
 
     void InitWindow();
     void CreateVulkanObjects();
+    void ResizeSwapChain();
     void LoadScene();
     void MainLoop();
 
-    void WaitForDeviceToBeIdle() const;
+    // Input and simulation run on the main thread, recording and submission on their own threads. The stages hand
+    // frames over through bounded queues, so the simulation of frame N+1 overlaps the recording of frame N and the
+    // submission of frame N-1.
+    void StartFramePipeline();
+    void StopFramePipeline();
+    void RunFramePipelineStage(void (ForwardRenderingApplication::*stage)());
+    void RenderFrames();
+    void SubmitFrames();
 
     void CreateDevice();
     void CreateSwapChain();
-    void CreateRenderPass();
+    void CreateFrameGraph();
     void CreateCamera();
     void CreateMesh();
+    void UploadMesh(Gris::Span<const Gris::Graphics::Vertex> vertices, Gris::Span<const uint32_t> indices);
+    void UploadGeometry(const void * vertexData, size_t vertexDataSize, const void * indexData, size_t indexDataSize, Gris::Graphics::IndexFormat indexFormat, size_t indexCount);
+    void UploadAttributeStream(const void * data, size_t size);
+    void UploadDequantizations();
     void CreateMeshTexture();
     void CreatePipelineStateObject();
-    void CreateFramebuffers();
     void CreateShaderResourceBindingsPools();
     void CreateUniformBuffersAndBindings();
     void CreateCommandBuffers();
 
-    void UpdateUniformBuffer(uint32_t currentVirtualFrameIndex);
-    void DrawFrame();
+    [[nodiscard]] FrameConstants SimulateFrame();
+    [[nodiscard]] std::optional<PreparedFrame> PrepareFrame(uint32_t acquireSlot);
+    void SubmitFrame(const PreparedFrame & frame);
+
+    // Copies m_latestFrameConstants, the camera the main thread simulated last, under its mutex into the persistently
+    // mapped uniform buffer of the virtual frame
+    void LatchUniformBuffer(uint32_t currentVirtualFrameIndex);
+    void DrawDepth(Gris::Graphics::Vulkan::DeferredContext & context);
+    void DrawScene(Gris::Graphics::Vulkan::DeferredContext & context);
 
     Gris::Graphics::Vulkan::Glfw::Window m_window = {};
     Gris::Graphics::Vulkan::Device m_device = {};
     Gris::Graphics::Vulkan::SwapChain m_swapChain = {};
 
-    std::vector<Gris::Graphics::Vulkan::Framebuffer> m_swapChainFramebuffers = {};
+    Gris::Graphics::Vulkan::FrameGraph m_frameGraph = {};
+    Gris::Graphics::Vulkan::FrameGraph::ResourceHandle m_backBuffer = 0;
+    Gris::Graphics::Vulkan::FrameGraph::ResourceHandle m_colorTarget = 0;
+    Gris::Graphics::Vulkan::FrameGraph::ResourceHandle m_depthTarget = 0;
+    Gris::Graphics::Vulkan::FrameGraph::PassHandle m_depthPrepass = 0;
+    Gris::Graphics::Vulkan::FrameGraph::PassHandle m_forwardPass = 0;
+    uint32_t m_currentVirtualFrameIndex = 0;
 
-    Gris::Graphics::Vulkan::RenderPass m_renderPass = {};
     Gris::Graphics::Vulkan::Shader m_vertexShader = {};
     Gris::Graphics::Vulkan::Shader m_fragmentShader = {};
+    Gris::Graphics::Vulkan::Shader m_depthVertexShader = {};
 
     std::array<Gris::Graphics::Vulkan::ShaderResourceBindingsLayout, DESCRIPTOR_SET_COUNT> m_resourceLayouts = {};
     Gris::Graphics::Vulkan::PipelineStateObject m_pso = {};
+    Gris::Graphics::Vulkan::PipelineStateObject m_depthPso = {};
 
     Gris::Graphics::Backend::ShaderResourceBindingsPoolCategory m_shaderResourceBindingsPoolCategory = Gris::Graphics::Backend::ShaderResourceBindingsPoolCategory{ 0 };
     Gris::Graphics::Vulkan::ShaderResourceBindingsPoolCollection m_shaderResourceBindingsPools;
 
     std::vector<std::array<Gris::Graphics::Vulkan::ShaderResourceBindings, DESCRIPTOR_SET_COUNT>> m_shaderResourceBindings = {};
 
-    Gris::Graphics::Vulkan::Texture m_colorImage = {};
-    Gris::Graphics::Vulkan::TextureView m_colorImageView = {};
-
-    Gris::Graphics::Vulkan::Texture m_depthImage = {};
-    Gris::Graphics::Vulkan::TextureView m_depthImageView = {};
-
-    Gris::Graphics::Scene m_scene;
     std::vector<Gris::Graphics::MaterialBlueprint> m_materialBlueprints;
+    std::vector<uint32_t> m_meshIndexCounts = {};
+    std::vector<Gris::Graphics::IndexFormat> m_meshIndexFormats = {};
+    std::vector<Gris::Graphics::CompactMeshDequantization> m_meshDequantizations = {};
 
     std::vector<Gris::Graphics::Vulkan::Buffer> m_vertexBuffers = {};
     std::vector<Gris::Graphics::Vulkan::BufferView> m_vertexBufferViews = {};
     std::vector<Gris::Graphics::Vulkan::Buffer> m_indexBuffers = {};
     std::vector<Gris::Graphics::Vulkan::BufferView> m_indexBufferViews = {};
+    std::vector<Gris::Graphics::Vulkan::Buffer> m_attributeBuffers = {};
+    std::vector<Gris::Graphics::Vulkan::BufferView> m_attributeBufferViews = {};
+    Gris::Graphics::Vulkan::Buffer m_dequantizationBuffer = {};
+    std::vector<Gris::Graphics::Vulkan::BufferView> m_dequantizationBufferViews = {};
 
     Gris::Graphics::Vulkan::Texture m_meshTextureImage = {};
     Gris::Graphics::Vulkan::TextureView m_meshTextureImageView = {};
@@ -106,9 +156,34 @@ private:
     std::vector<Gris::Graphics::Vulkan::BufferView> m_uniformBufferViews = {};
 
     std::vector<Gris::Graphics::Vulkan::DeferredContext> m_commandBuffers = {};
+    // Bumped whenever anything the recordings reference changes
+    uint64_t m_recordingVersion = 0;
+    uint64_t m_recordedFrameGraphVersion = 0;
 
     Gris::Graphics::Cameras::TrackballCamera m_camera = {};
     Gris::Graphics::Lens::PerspectiveLens m_lens = {};
 
     bool m_framebufferResized = false;
+
+    // Numbers of the simulated frames waiting for the render stage, the constants are not handed over with them since
+    // the submit stage latches the newest ones anyway
+    Gris::BoundedQueue<uint64_t> m_simulatedFrames;
+    Gris::BoundedQueue<PreparedFrame> m_preparedFrames;
+    // Limits the images acquired and not presented yet, see StartFramePipeline
+    Gris::BoundedQueue<uint32_t> m_freeAcquireSlots;
+
+    std::thread m_renderThread = {};
+    std::thread m_submitThread = {};
+
+    // The swap chain, the device and its immediate context are not thread safe, acquire, submit and present are
+    // serialized on this
+    std::mutex m_swapChainMutex = {};
+    std::atomic<bool> m_swapChainOutOfDate = false;
+
+    uint64_t m_simulatedFrameCount = 0;
+    std::mutex m_latestFrameConstantsMutex = {};
+    FrameConstants m_latestFrameConstants = {};
+
+    std::mutex m_framePipelineErrorMutex = {};
+    std::exception_ptr m_framePipelineError = {};
 };
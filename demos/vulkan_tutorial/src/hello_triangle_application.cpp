@@ -162,6 +162,7 @@ void HelloTriangleApplication::MainLoop()
     while (!m_window.ShouldClose())
     {
         Gris::Graphics::Glfw::Instance::PollEvents();
+        m_window.DispatchInputEvents();
         DrawFrame();
     }
 
@@ -262,7 +263,6 @@ void HelloTriangleApplication::CreateMeshTexture()
 
     ///
 
-    m_device.Context().TransitionImageLayout(m_meshTextureImage, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
     auto stagingBuffer = m_device.CreateBuffer(image.PixelData.size(), vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
     stagingBuffer.SetData(image.PixelData.data(), image.PixelData.size());
     m_device.Context().CopyBufferToImage(stagingBuffer, m_meshTextureImage, image.Width, image.Height);
@@ -332,10 +332,7 @@ void HelloTriangleApplication::CreatePipelineStateObject()
     ///
 
     Gris::Graphics::Vulkan::InputLayout layout;
-    layout.AddBinding(0, sizeof(Gris::Graphics::Vertex), vk::VertexInputRate::eVertex);
-    layout.AddAttributeDescription(0, 0, vk::Format::eR32G32B32Sfloat, offsetof(Gris::Graphics::Vertex, Position));
-    layout.AddAttributeDescription(1, 0, vk::Format::eR32G32B32Sfloat, offsetof(Gris::Graphics::Vertex, Color));
-    layout.AddAttributeDescription(2, 0, vk::Format::eR32G32Sfloat, offsetof(Gris::Graphics::Vertex, TextureCoords));
+    layout.AddVertexFormat<Gris::Graphics::MeshVertexFormat>(0);
 
     m_pso = m_device.CreatePipelineStateObject(m_swapChain.Extent().width, m_swapChain.Extent().height, m_renderPass, layout, m_resourceLayout, m_vertexShader, m_fragmentShader);
 }
@@ -463,9 +460,7 @@ void HelloTriangleApplication::DrawFrame()
 
     UpdateUniformBuffer(nextImageResult->SwapChainImageIndex);
 
-    auto const waitSemaphores = std::vector{ std::ref(m_swapChain.ImageAvailableSemaphore(*nextImageResult)) };
-    auto const signalSemaphores = std::vector{ std::ref(m_swapChain.RenderingFinishedSemaphore(*nextImageResult)) };
-    m_device.Context().Submit(&m_commandBuffers[nextImageResult->SwapChainImageIndex], waitSemaphores, signalSemaphores, m_swapChain.RenderingFinishedFence(*nextImageResult));
+    m_swapChain.Submit(m_commandBuffers[nextImageResult->SwapChainImageIndex], *nextImageResult);
 
     auto const presentResult = m_swapChain.Present(*nextImageResult);
     if (!presentResult || m_framebufferResized)
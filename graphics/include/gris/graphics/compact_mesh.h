@@ -0,0 +1,206 @@
+#pragma once
+
+#include <gris/graphics/index_format.h>
+#include <gris/graphics/vertex_format.h>
+
+#include <gris/span.h>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Gris::Graphics
+{
+
+enum class TextureCoordsEncoding : uint32_t
+{
+    // Half floats taken as they are
+    Half,
+    // Fractions of the mesh texture coordinate bounds, uniform precision but the bounds have to be applied back
+    Unorm16,
+};
+
+// Attributes of the compact vertex, bound to the locations of the attributes they encode
+
+struct CompactPositionAttribute
+{
+    constexpr static uint32_t LOCATION = PositionAttribute::LOCATION;
+    // Unorm16 fractions of the mesh bounds, the fourth component pads to the four component format devices support
+    constexpr static uint32_t COMPONENT_COUNT = 4;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Unorm16;
+    using Component = uint16_t;
+
+    struct Member
+    {
+        std::array<uint16_t, 4> Position = {};
+    };
+
+    [[nodiscard]] static uint16_t * Data(Member & member)
+    {
+        return member.Position.data();
+    }
+
+    [[nodiscard]] static const uint16_t * Data(const Member & member)
+    {
+        return member.Position.data();
+    }
+};
+
+// Both encodings store two 16 bit values in the same member, only the way the vertex input reads them differs
+struct CompactTextureCoordsMember
+{
+    std::array<uint16_t, 2> TextureCoords = {};
+};
+
+template<TextureCoordsEncoding Encoding>
+struct CompactTextureCoordsAttribute
+{
+    constexpr static uint32_t LOCATION = TextureCoordsAttribute::LOCATION;
+    constexpr static uint32_t COMPONENT_COUNT = 2;
+    constexpr static VertexComponentType COMPONENT_TYPE = Encoding == TextureCoordsEncoding::Half ? VertexComponentType::Half : VertexComponentType::Unorm16;
+    using Component = uint16_t;
+    using Member = CompactTextureCoordsMember;
+
+    [[nodiscard]] static uint16_t * Data(Member & member)
+    {
+        return member.TextureCoords.data();
+    }
+
+    [[nodiscard]] static const uint16_t * Data(const Member & member)
+    {
+        return member.TextureCoords.data();
+    }
+};
+
+template<TextureCoordsEncoding Encoding>
+using CompactVertexFormat = VertexFormat<CompactPositionAttribute, CompactTextureCoordsAttribute<Encoding>>;
+
+// 12 bytes instead of the 20 of Vertex. The layout is the same for both encodings, so meshes keep their vertices as
+// this type whatever the encoding and bind them with the format of their encoding.
+using CompactVertex = CompactVertexFormat<TextureCoordsEncoding::Unorm16>::Vertex;
+
+static_assert(sizeof(CompactVertex) == 12, "Compact vertices are bound with a fixed stride");
+static_assert(CompactVertexFormat<TextureCoordsEncoding::Half>::STRIDE == sizeof(CompactVertex), "Encodings share the compact vertex layout");
+
+// Per instance attributes of the dequantization, bound to the locations after the vertex attributes
+
+struct PositionOffsetAttribute
+{
+    constexpr static uint32_t LOCATION = 3;
+    constexpr static uint32_t COMPONENT_COUNT = 3;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec3 PositionOffset = glm::vec3(0.0F);
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.PositionOffset.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.PositionOffset.x;
+    }
+};
+
+struct PositionScaleAttribute
+{
+    constexpr static uint32_t LOCATION = 4;
+    constexpr static uint32_t COMPONENT_COUNT = 3;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec3 PositionScale = glm::vec3(1.0F);
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.PositionScale.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.PositionScale.x;
+    }
+};
+
+struct TextureCoordsOffsetAttribute
+{
+    constexpr static uint32_t LOCATION = 5;
+    constexpr static uint32_t COMPONENT_COUNT = 2;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec2 TextureCoordsOffset = glm::vec2(0.0F);
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.TextureCoordsOffset.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.TextureCoordsOffset.x;
+    }
+};
+
+struct TextureCoordsScaleAttribute
+{
+    constexpr static uint32_t LOCATION = 6;
+    constexpr static uint32_t COMPONENT_COUNT = 2;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec2 TextureCoordsScale = glm::vec2(1.0F);
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.TextureCoordsScale.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.TextureCoordsScale.x;
+    }
+};
+
+// Turns the stored values back into the original ones as Offset + Scale * value, with the value as the vertex input
+// sees it, so a unorm fraction in [0, 1] for unorm formats and the float itself for half floats. Bound once per
+// instance next to the compact vertices.
+using CompactMeshDequantizationFormat = VertexFormat<PositionOffsetAttribute, PositionScaleAttribute, TextureCoordsOffsetAttribute, TextureCoordsScaleAttribute>;
+using CompactMeshDequantization = CompactMeshDequantizationFormat::Vertex;
+
+struct CompactMesh
+{
+    std::vector<CompactVertex> Vertices = {};
+
+    // Packed indices of IndexType, 16 bit whenever every vertex is addressable with them
+    std::vector<std::byte> IndexData = {};
+    IndexFormat IndexType = IndexFormat::Uint32;
+    size_t IndexCount = 0;
+
+    TextureCoordsEncoding TextureCoordsFormat = TextureCoordsEncoding::Unorm16;
+    CompactMeshDequantization Dequantization = {};
+};
+
+// Largest vertex count that still gets 16 bit indices, 0xFFFF is left out as it restarts strips
+constexpr size_t MAX_UINT16_INDEXED_VERTEX_COUNT = 65535;
+
+[[nodiscard]] CompactMesh EncodeCompactMesh(Span<const Vertex> vertices, Span<const uint32_t> indices, TextureCoordsEncoding textureCoordsEncoding);
+
+}  // namespace Gris::Graphics
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <gris/graphics/input_event_queue.h>
 #include <gris/graphics/window_observer.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,15 +37,23 @@ public:
     void AddObserver(WindowObserver * observer);
     void RemoveObserver(WindowObserver * observer);
 
+    // Mouse events are queued with their timestamps as GLFW reports them and only reach the observers here, once per
+    // frame and coalesced. Resizes are still reported right away.
+    void DispatchInputEvents();
+
+    // Split version of the above, the consumed events can be recorded and dispatched again to replay a session
+    void ConsumeInputEvents(std::vector<InputEvent> & events);
+    void DispatchInputEvents(const std::vector<InputEvent> & events);
+
+    [[nodiscard]] uint64_t DroppedInputEventCount() const;
+
 protected:
     [[nodiscard]] const GLFWwindow * WindowHandle() const;
     [[nodiscard]] GLFWwindow * WindowHandle();
 
 private:
     void OnSizeChanged(uint32_t width, uint32_t height);
-    void OnMouseButtonEvent(MouseButton button, MouseButtonAction action, float x, float y);
-    void OnMouseMoveEvent(float x, float y);
-    void OnMouseWheelEvent(float x, float y, float delta);
+    void OnInputEvent(const InputEvent & event);
 
     void NotifySizeChanged();
     void NotifyMouseButtonEvent(MouseButton button, MouseButtonAction action, float x, float y);
@@ -54,6 +64,10 @@ private:
     uint32_t m_height = 0;
     GLFWwindow * m_window = nullptr;
     std::vector<WindowObserver *> m_observers = {};
+
+    // Heap allocated so the window stays movable, GLFW keeps a pointer to the window and not the queue
+    std::unique_ptr<InputEventQueue> m_inputEvents = {};
+    std::vector<InputEvent> m_dispatchedInputEvents = {};
 };
 
 }  // namespace Gris::Graphics::Glfw
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Gris::Graphics
+{
+
+enum class IndexFormat : uint32_t
+{
+    Uint16,
+    Uint32,
+};
+
+[[nodiscard]] size_t IndexSize(IndexFormat format);
+
+}  // namespace Gris::Graphics
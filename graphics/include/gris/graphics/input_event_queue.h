@@ -0,0 +1,81 @@
+#pragma once
+
+#include <gris/graphics/window_observer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace Gris::Graphics
+{
+
+struct MouseButtonInputEvent
+{
+    MouseButton Button = MouseButton::Left;
+    MouseButtonAction Action = MouseButtonAction::Up;
+    float X = 0.0F;
+    float Y = 0.0F;
+};
+
+struct MouseMoveInputEvent
+{
+    float X = 0.0F;
+    float Y = 0.0F;
+};
+
+struct MouseWheelInputEvent
+{
+    float X = 0.0F;
+    float Y = 0.0F;
+    float Delta = 0.0F;
+};
+
+struct InputEvent
+{
+    // Seconds, on whatever clock the producer uses
+    double Timestamp = 0.0;
+    std::variant<MouseButtonInputEvent, MouseMoveInputEvent, MouseWheelInputEvent> Data = {};
+};
+
+// Lock free single producer single consumer ring of raw input events. The window pushes from its callbacks and the
+// consumer drains once per frame, possibly from another thread. Pushing never blocks, events that do not fit are
+// dropped and counted.
+class InputEventQueue
+{
+public:
+    constexpr static size_t DEFAULT_CAPACITY = 1024;
+
+    // The capacity has to be a power of two
+    explicit InputEventQueue(size_t capacity = DEFAULT_CAPACITY);
+
+    InputEventQueue(const InputEventQueue &) = delete;
+    InputEventQueue & operator=(const InputEventQueue &) = delete;
+
+    InputEventQueue(InputEventQueue &&) = delete;
+    InputEventQueue & operator=(InputEventQueue &&) = delete;
+
+    ~InputEventQueue() = default;
+
+    // Producer side
+    bool Push(const InputEvent & event);
+
+    // Consumer side, appends the pending events in order. Runs of moves collapse into the last move and runs of wheel
+    // events into one event with the summed delta at the last position, button events are kept as they are.
+    void Consume(std::vector<InputEvent> & events);
+
+    [[nodiscard]] size_t Capacity() const;
+    [[nodiscard]] uint64_t DroppedEventCount() const;
+
+private:
+    std::vector<InputEvent> m_events = {};
+    size_t m_mask = 0;
+
+    // Monotonic, the slot is the value masked with the capacity
+    std::atomic<size_t> m_writeIndex = 0;
+    std::atomic<size_t> m_readIndex = 0;
+    std::atomic<uint64_t> m_droppedEventCount = 0;
+};
+
+}  // namespace Gris::Graphics
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <gris/graphics/loaders/gmesh_format.h>
+#include <gris/graphics/vertex_format.h>
+
+#include <gris/mapped_file.h>
+#include <gris/span.h>
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <tuple>
+#include <vector>
+
+namespace Gris::Graphics
+{
+struct Mesh;
+struct MaterialBlueprint;
+struct Meshlet;
+}  // namespace Gris::Graphics
+
+namespace Gris::Graphics::Loaders
+{
+
+// Mesh data as stored in the file, the spans point into the mapping and stay valid as long as the file is open
+struct GmeshMeshView
+{
+    Span<const Vertex> Vertices = {};
+    // Empty unless the indices are stored raw, use GmeshFile::ReadIndices to get them in any encoding
+    Span<const uint32_t> Indices = {};
+    Span<const std::byte> EncodedIndices = {};
+    GmeshIndexEncoding IndexEncoding = GmeshIndexEncoding::Raw;
+    size_t IndexCount = 0;
+    size_t MaterialIndex = 0;
+    glm::vec3 BoundsMin = {};
+    glm::vec3 BoundsMax = {};
+    Span<const Meshlet> Meshlets = {};
+    Span<const uint32_t> MeshletVertices = {};
+    Span<const uint8_t> MeshletTriangles = {};
+};
+
+// Memory mapped .gmesh file. Opening validates the header and the tables against the file size, the blobs themselves
+// are not touched until they are read.
+class GmeshFile
+{
+public:
+    GmeshFile() = default;
+
+    explicit GmeshFile(const std::filesystem::path & path);
+
+    GmeshFile(const GmeshFile &) = delete;
+    GmeshFile & operator=(const GmeshFile &) = delete;
+
+    GmeshFile(GmeshFile && other) noexcept;
+    GmeshFile & operator=(GmeshFile && other) noexcept;
+
+    ~GmeshFile() = default;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    [[nodiscard]] size_t MeshCount() const;
+    [[nodiscard]] GmeshMeshView MeshView(size_t meshIndex) const;
+
+    // Copies raw indices and decodes encoded ones, appending to the output
+    void ReadIndices(size_t meshIndex, std::vector<uint32_t> & indices) const;
+
+    [[nodiscard]] std::vector<MaterialBlueprint> ReadMaterials() const;
+
+    // Copies everything out, for callers that want the same data the other mesh loaders return
+    [[nodiscard]] std::tuple<std::vector<Mesh>, std::vector<MaterialBlueprint>> ReadAll() const;
+
+    void Reset();
+
+private:
+    MappedFile m_file = {};
+    Span<const GmeshMeshRecord> m_meshes = {};
+    Span<const GmeshMaterialRecord> m_materials = {};
+};
+
+}  // namespace Gris::Graphics::Loaders
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <gris/span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Gris::Graphics::Loaders
+{
+
+// On disk layout of the .gmesh cooked mesh format. Everything is little endian and laid out so a memory mapped file
+// can be used in place:
+//
+//   GmeshHeader
+//   GmeshMeshRecord[MeshCount]          at MeshTableOffset
+//   GmeshMaterialRecord[MaterialCount]  at MaterialTableOffset
+//   vertex, index, meshlet and material blobs   each at a GMESH_BLOB_ALIGNMENT aligned offset
+//
+// Vertex and meshlet blobs hold Vertex and Meshlet structs as they are in memory, the strides guard against the
+// layouts changing under an old file. Meshlet vertex blobs hold uint32_t and meshlet triangle blobs uint8_t local
+// indices. Raw index blobs hold uint32_t indices, delta encoded ones have to be decoded first. A material blob is the
+// name followed by the diffuse, specular and normal texture path lists, strings are a uint32_t byte count and UTF-8
+// bytes, lists are a uint32_t element count and the elements.
+
+constexpr uint32_t GMESH_MAGIC = 0x48534D47;  // "GMSH"
+constexpr uint32_t GMESH_VERSION = 2;
+constexpr uint64_t GMESH_BLOB_ALIGNMENT = 64;
+
+enum class GmeshIndexEncoding : uint32_t
+{
+    Raw = 0,
+    // Differences between consecutive indices, zigzag mapped and stored as LEB128 varints
+    DeltaVarint = 1,
+};
+
+struct GmeshHeader
+{
+    uint32_t Magic = GMESH_MAGIC;
+    uint32_t Version = GMESH_VERSION;
+    uint32_t VertexStride = 0;
+    uint32_t MeshCount = 0;
+    uint32_t MaterialCount = 0;
+    uint32_t MeshletStride = 0;
+    uint64_t MeshTableOffset = 0;
+    uint64_t MaterialTableOffset = 0;
+    uint64_t FileSize = 0;
+};
+
+struct GmeshMeshRecord
+{
+    uint64_t VertexOffset = 0;
+    uint64_t VertexCount = 0;
+    uint64_t IndexOffset = 0;
+    uint64_t IndexByteSize = 0;
+    uint64_t IndexCount = 0;
+    uint64_t MeshletOffset = 0;
+    uint64_t MeshletCount = 0;
+    uint64_t MeshletVertexOffset = 0;
+    uint64_t MeshletVertexCount = 0;
+    uint64_t MeshletTriangleOffset = 0;
+    uint64_t MeshletTriangleByteSize = 0;
+    GmeshIndexEncoding IndexEncoding = GmeshIndexEncoding::Raw;
+    uint32_t MaterialIndex = 0;
+    float BoundsMin[3] = { 0.0F, 0.0F, 0.0F };
+    float BoundsMax[3] = { 0.0F, 0.0F, 0.0F };
+};
+
+struct GmeshMaterialRecord
+{
+    uint64_t Offset = 0;
+    uint64_t ByteSize = 0;
+};
+
+static_assert(sizeof(GmeshHeader) == 48, "The header layout is part of the file format");
+static_assert(sizeof(GmeshMeshRecord) == 120, "The mesh record layout is part of the file format");
+static_assert(sizeof(GmeshMaterialRecord) == 16, "The material record layout is part of the file format");
+
+// Appends the encoded indices to the output
+void EncodeGmeshIndices(Span<const uint32_t> indices, std::vector<std::byte> & encoded);
+
+// Appends indexCount decoded indices to the output, throws if the data is truncated or malformed
+void DecodeGmeshIndices(Span<const std::byte> encoded, size_t indexCount, std::vector<uint32_t> & indices);
+
+}  // namespace Gris::Graphics::Loaders
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <gris/graphics/loaders/gmesh_format.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace Gris::Graphics
+{
+struct Mesh;
+struct MaterialBlueprint;
+}  // namespace Gris::Graphics
+
+namespace Gris::Graphics::Loaders
+{
+
+class GmeshWriter
+{
+public:
+    GmeshWriter() = default;
+
+    // Writes a temporary file next to the target and renames it over the target, so a reader never maps a partially
+    // written file. Bounds are computed here so the reader does not have to touch the vertices to get them.
+    static void Write(const std::filesystem::path & path,
+                      const std::vector<Mesh> & meshes,
+                      const std::vector<MaterialBlueprint> & materials,
+                      GmeshIndexEncoding indexEncoding = GmeshIndexEncoding::Raw);
+};
+
+}  // namespace Gris::Graphics::Loaders
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Gris::Graphics::Loaders
+{
+
+// Open addressing map from the attribute index pairs of formats like OBJ, which index every attribute separately, to
+// vertex indices. Deduplicating on the indices rather than on the vertex contents needs a single probe sequence of
+// integer compares per corner. Sized up front for the largest number of distinct pairs, so it never rehashes.
+class IndexTupleTable
+{
+public:
+    explicit IndexTupleTable(size_t maxTupleCount);
+
+    // Returns the vertex index the tuple maps to and whether it was added by this call, a new tuple gets the next
+    // vertex index in insertion order
+    [[nodiscard]] std::pair<uint32_t, bool> FindOrInsert(int32_t positionIndex, int32_t textureCoordsIndex);
+
+    [[nodiscard]] size_t Size() const;
+
+private:
+    constexpr static uint64_t EMPTY_KEY = ~uint64_t{ 0 };
+
+    std::vector<uint64_t> m_keys = {};
+    std::vector<uint32_t> m_values = {};
+    size_t m_mask = 0;
+    size_t m_size = 0;
+    size_t m_maxSize = 0;
+};
+
+}  // namespace Gris::Graphics::Loaders
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <gris/span.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Gris::Graphics
+{
+
+struct Mesh;
+
+// Typical size of the post transform cache the optimizations model, in vertices
+constexpr size_t DEFAULT_VERTEX_CACHE_SIZE = 16;
+
+// Relative increase of the average cache miss ratio the overdraw ordering may trade for better triangle order
+constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05F;
+
+struct VertexCacheStatistics
+{
+    size_t TransformedVertexCount = 0;
+    size_t TriangleCount = 0;
+    size_t VertexCount = 0;
+
+    // Average cache miss ratio, transformed vertices per triangle, 0.5 at best for regular meshes and 3 at worst
+    [[nodiscard]] float Acmr() const;
+
+    // Average transformed to vertex ratio, transformed vertices per vertex, 1 at best
+    [[nodiscard]] float Atvr() const;
+
+    VertexCacheStatistics & operator+=(const VertexCacheStatistics & other);
+};
+
+struct MeshOptimizationReport
+{
+    VertexCacheStatistics Before = {};
+    VertexCacheStatistics After = {};
+    size_t RemovedTriangleCount = 0;
+    size_t RemovedVertexCount = 0;
+
+    MeshOptimizationReport & operator+=(const MeshOptimizationReport & other);
+};
+
+// Simulates a FIFO post transform cache of the given size over the triangle list
+[[nodiscard]] VertexCacheStatistics AnalyzeVertexCache(Span<const uint32_t> indices, size_t vertexCount, size_t cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+// Drops triangles that repeat a vertex or have no area
+void RemoveDegenerateTriangles(Mesh & mesh);
+
+// Reorders the triangles for the post transform cache with Tipsify (Sander et al. 2007)
+void OptimizeVertexCache(Mesh & mesh, size_t cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+// Splits the cache ordered triangles into clusters wherever that keeps the miss ratio within the threshold and draws
+// the clusters facing away from the mesh center first, as they are the likeliest to occlude the rest
+void OptimizeOverdraw(Mesh & mesh, float threshold = DEFAULT_OVERDRAW_THRESHOLD, size_t cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+// Reorders the vertices by first use and remaps the indices, dropping vertices no triangle references
+void OptimizeVertexFetch(Mesh & mesh);
+
+// All of the above in order. Has to run before BuildMeshlets, which follows the index order.
+MeshOptimizationReport OptimizeMesh(Mesh & mesh);
+
+}  // namespace Gris::Graphics
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Gris::Graphics
+{
+
+struct Mesh;
+
+constexpr size_t MESHLET_MAX_VERTICES = 64;
+constexpr size_t MESHLET_MAX_TRIANGLES = 124;
+
+// Splits the triangles into meshlets in index order, starting a new meshlet whenever the next triangle does not fit,
+// and computes their bounding spheres and normal cones. The clusters are only as compact as the index order is local,
+// so the indices should already be in vertex cache order. Replaces any meshlets the mesh already has.
+void BuildMeshlets(Mesh & mesh);
+
+}  // namespace Gris::Graphics
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <gris/graphics/image.h>
+#include <gris/graphics/vertex_format.h>
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -11,11 +13,25 @@
 namespace Gris::Graphics
 {
 
-struct Vertex
+// Cluster of at most MESHLET_MAX_VERTICES vertices and MESHLET_MAX_TRIANGLES triangles of a mesh
+struct Meshlet
 {
-    glm::vec3 Position;
-    glm::vec3 Color;
-    glm::vec2 TextureCoords;
+    // Range of Mesh::MeshletVertices, which maps the local vertex indices to mesh vertex indices
+    uint32_t VertexOffset = 0;
+    uint32_t VertexCount = 0;
+
+    // Range of Mesh::MeshletTriangles starting at the first local index, three per triangle
+    uint32_t LocalIndexOffset = 0;
+    uint32_t TriangleCount = 0;
+
+    glm::vec3 BoundsCenter = {};
+    float BoundsRadius = 0.0F;
+
+    // Normals are taken as cross(p1 - p0, p2 - p0). Every triangle faces away from a camera at c when
+    // dot(normalize(ConeApex - c), ConeAxis) >= ConeCutoff, a cutoff of 1 means the cone is too wide to ever cull.
+    glm::vec3 ConeApex = {};
+    glm::vec3 ConeAxis = {};
+    float ConeCutoff = 1.0F;
 };
 
 struct Mesh
@@ -23,6 +39,11 @@ struct Mesh
     std::vector<Vertex> Vertices = {};
     std::vector<uint32_t> Indices = {};
     size_t MaterialIndex;
+
+    // Filled in by BuildMeshlets, the triangles are the same as in Indices
+    std::vector<Meshlet> Meshlets = {};
+    std::vector<uint32_t> MeshletVertices = {};
+    std::vector<uint8_t> MeshletTriangles = {};
 };
 
 struct MaterialBlueprint
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Gris::Graphics
+{
+
+// How the vertex input reads the stored components, the shader sees floats either way
+enum class VertexComponentType : uint32_t
+{
+    Float,
+    Half,
+    // Fractions in [0, 1] stored in 16 bits
+    Unorm16,
+};
+
+// Attributes a vertex format is made of. Each one brings the vertex member it is stored in, the components it has
+// along with their type and the shader input location it is bound to.
+
+struct PositionAttribute
+{
+    constexpr static uint32_t LOCATION = 0;
+    constexpr static uint32_t COMPONENT_COUNT = 3;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec3 Position;
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.Position.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.Position.x;
+    }
+};
+
+struct ColorAttribute
+{
+    constexpr static uint32_t LOCATION = 1;
+    constexpr static uint32_t COMPONENT_COUNT = 3;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec3 Color;
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.Color.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.Color.x;
+    }
+};
+
+struct TextureCoordsAttribute
+{
+    constexpr static uint32_t LOCATION = 2;
+    constexpr static uint32_t COMPONENT_COUNT = 2;
+    constexpr static VertexComponentType COMPONENT_TYPE = VertexComponentType::Float;
+    using Component = float;
+
+    struct Member
+    {
+        glm::vec2 TextureCoords;
+    };
+
+    [[nodiscard]] static float * Data(Member & member)
+    {
+        return &member.TextureCoords.x;
+    }
+
+    [[nodiscard]] static const float * Data(const Member & member)
+    {
+        return &member.TextureCoords.x;
+    }
+};
+
+struct VertexAttributeDescription
+{
+    uint32_t Location = 0;
+    uint32_t ComponentCount = 0;
+    VertexComponentType ComponentType = VertexComponentType::Float;
+    // Bytes from the start of the vertex
+    uint32_t Offset = 0;
+};
+
+// Packed vertex made of the given attributes in the given order, along with everything derived from that order. The
+// vertex has one named member per attribute, so code written against a format only compiles when the format has the
+// attributes it touches, and the input layout and the loader writes come from the same list.
+template<typename... Attributes>
+class VertexFormat
+{
+public:
+    struct Vertex : Attributes::Member...
+    {
+    };
+
+    constexpr static size_t ATTRIBUTE_COUNT = sizeof...(Attributes);
+    constexpr static size_t STRIDE = ((Attributes::COMPONENT_COUNT * sizeof(typename Attributes::Component)) + ... + 0);
+
+    template<typename Attribute>
+    constexpr static bool CONTAINS = (std::is_same_v<Attribute, Attributes> || ...);
+
+    constexpr static std::array<VertexAttributeDescription, ATTRIBUTE_COUNT> ATTRIBUTES = []()
+    {
+        auto result = std::array<VertexAttributeDescription, ATTRIBUTE_COUNT>{};
+        size_t index = 0;
+        uint32_t offset = 0;
+        ((result[index++] = VertexAttributeDescription{ Attributes::LOCATION, Attributes::COMPONENT_COUNT, Attributes::COMPONENT_TYPE, offset }, offset += Attributes::COMPONENT_COUNT * static_cast<uint32_t>(sizeof(typename Attributes::Component))), ...);
+        return result;
+    }();
+
+    template<typename Attribute>
+    [[nodiscard]] constexpr static uint32_t OffsetOf()
+    {
+        static_assert(CONTAINS<Attribute>, "The attribute is not part of the vertex format");
+
+        for (auto const & attribute : ATTRIBUTES)
+        {
+            if (attribute.Location == Attribute::LOCATION)
+            {
+                return attribute.Offset;
+            }
+        }
+        return 0;
+    }
+
+    // First component of the attribute, with sizeof(Vertex) as the stride this is what the vertex kernels write through
+    template<typename Attribute>
+    [[nodiscard]] static typename Attribute::Component * Data(Vertex & vertex)
+    {
+        static_assert(CONTAINS<Attribute>, "The attribute is not part of the vertex format");
+        return Attribute::Data(vertex);
+    }
+
+    template<typename Attribute>
+    [[nodiscard]] static const typename Attribute::Component * Data(const Vertex & vertex)
+    {
+        static_assert(CONTAINS<Attribute>, "The attribute is not part of the vertex format");
+        return Attribute::Data(vertex);
+    }
+
+    // Calls function(Attribute{}) for every attribute in order
+    template<typename Function>
+    static void ForEachAttribute(Function && function)
+    {
+        (function(Attributes{}), ...);
+    }
+
+    static_assert(sizeof(Vertex) == STRIDE, "Vertex members have to be packed");
+    static_assert(std::is_trivially_copyable_v<Vertex>, "Vertices are copied to the device as they are");
+};
+
+// For the final else of if constexpr chains over the attributes
+template<typename Attribute>
+constexpr bool UNSUPPORTED_VERTEX_ATTRIBUTE = false;
+
+// Format of the vertices the loaders produce and meshes store. There is no color, the loaders only ever had white to
+// put there.
+using MeshVertexFormat = VertexFormat<PositionAttribute, TextureCoordsAttribute>;
+using Vertex = MeshVertexFormat::Vertex;
+
+}  // namespace Gris::Graphics
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Gris::Graphics
+{
+
+// Bulk conversions between vertex streams. Strides are in bytes so the kernels read and write fields inside
+// interleaved vertices as well as packed arrays, copying with a packed source and an interleaved destination
+// interleaves and the other way around deinterleaves. Each kernel has a scalar version and, depending on the
+// instruction set the library is built for, an SSE4.1 or AVX2 one.
+
+// Name of the instruction set the kernels were built for
+[[nodiscard]] const char * VertexKernelInstructionSet();
+
+void CopyVec3(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count);
+
+// Writes (u, 1 - v), flipping from the bottom left origin most formats use to the top left one Vulkan uses
+void CopyFlippedUv(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count);
+
+void FillVec2(float x, float y, float * destination, size_t destinationStride, size_t count);
+void FillVec3(float x, float y, float z, float * destination, size_t destinationStride, size_t count);
+
+// destination[i] = source[indices[i]], where source is a packed array of sourceCount elements and the indices are read
+// with their own stride so they can come straight out of an index tuple
+void GatherVec3(const float * source, size_t sourceCount, const int32_t * indices, size_t indexStride, float * destination, size_t destinationStride, size_t count);
+void GatherFlippedUv(const float * source, size_t sourceCount, const int32_t * indices, size_t indexStride, float * destination, size_t destinationStride, size_t count);
+
+// Packed to packed, rounding to nearest even
+void PackHalf(const float * source, uint16_t * destination, size_t count);
+
+// Packed to packed, clamping to [-1, 1] and [0, 1] respectively and rounding to nearest
+void PackSnorm16(const float * source, int16_t * destination, size_t count);
+void PackUnorm16(const float * source, uint16_t * destination, size_t count);
+
+}  // namespace Gris::Graphics
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <gris/graphics/vertex_format.h>
+#include <gris/graphics/vertex_kernels.h>
+
+#include <gris/span.h>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace Gris::Graphics
+{
+
+// Mesh vertices split in two streams bound to separate bindings. Depth and shadow passes bind only the positions and
+// fetch 12 bytes per vertex, the passes that shade bind both.
+using PositionStreamFormat = VertexFormat<PositionAttribute>;
+using AttributeStreamFormat = VertexFormat<TextureCoordsAttribute>;
+
+constexpr uint32_t POSITION_STREAM_BINDING = 0;
+constexpr uint32_t ATTRIBUTE_STREAM_BINDING = 1;
+
+// Copies the attributes of DestinationFormat out of the source vertices, every one of them has to be in SourceFormat
+template<typename DestinationFormat, typename SourceFormat = MeshVertexFormat>
+[[nodiscard]] std::vector<typename DestinationFormat::Vertex> ExtractVertexStream(Span<const typename SourceFormat::Vertex> source)
+{
+    auto result = std::vector<typename DestinationFormat::Vertex>(source.size());
+    if (source.empty())
+    {
+        return result;
+    }
+
+    auto const copyAttribute = [&](auto attribute)
+    {
+        using Attribute = decltype(attribute);
+        auto const * const sourceData = SourceFormat::template Data<Attribute>(source[0]);
+        auto * const destinationData = DestinationFormat::template Data<Attribute>(result[0]);
+        if constexpr (Attribute::COMPONENT_COUNT == 3)
+        {
+            CopyVec3(sourceData, SourceFormat::STRIDE, destinationData, DestinationFormat::STRIDE, source.size());
+        }
+        else
+        {
+            for (size_t vertexIndex = 0; vertexIndex < source.size(); ++vertexIndex)
+            {
+                std::memcpy(destinationData + vertexIndex * DestinationFormat::STRIDE / sizeof(float), sourceData + vertexIndex * SourceFormat::STRIDE / sizeof(float), Attribute::COMPONENT_COUNT * sizeof(float));
+            }
+        }
+    };
+    DestinationFormat::ForEachAttribute(copyAttribute);
+
+    return result;
+}
+
+}  // namespace Gris::Graphics
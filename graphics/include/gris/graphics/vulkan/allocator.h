@@ -30,6 +30,8 @@ public:
 
     [[nodiscard]] Allocation AllocateMemory(vk::Buffer buffer, const VmaAllocationCreateInfo & allocationCreateInfo) const;
     [[nodiscard]] Allocation AllocateMemory(vk::Image image, const VmaAllocationCreateInfo & allocationCreateInfo) const;
+    // Allocates memory not tied to a particular resource, e.g. to bind several aliasing images to
+    [[nodiscard]] Allocation AllocateMemory(const vk::MemoryRequirements & memoryRequirements, const VmaAllocationCreateInfo & allocationCreateInfo) const;
 
     void FreeMemory(const VmaAllocation & allocation) const;
 
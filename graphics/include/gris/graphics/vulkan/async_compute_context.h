@@ -0,0 +1,79 @@
+#pragma once
+
+#include <gris/graphics/vulkan/device_resource.h>
+
+#include <gris/graphics/vulkan/immediate_context.h>
+#include <gris/graphics/vulkan/timeline_semaphore.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class DeferredContext;
+
+// Submits compute work to a queue of the compute only family so it overlaps with the graphics queue. Joins go through
+// timeline semaphores in both directions: submissions here wait on graphics timeline values and graphics submissions
+// wait on the values returned by Submit. Without a compute only family the graphics queue is used under the immediate
+// context queue lock and the work is serialized with rendering, the joins stay valid. Deferred destruction follows the
+// graphics queue, so objects used here have to be joined on by a graphics submission before they are released.
+class AsyncComputeContext : public DeviceResource
+{
+public:
+    AsyncComputeContext();
+
+    AsyncComputeContext(const ParentObject<Device> & device, uint32_t queueIndex);
+
+    AsyncComputeContext(const AsyncComputeContext &) = delete;
+    AsyncComputeContext & operator=(const AsyncComputeContext &) = delete;
+
+    AsyncComputeContext(AsyncComputeContext && other) noexcept;
+    AsyncComputeContext & operator=(AsyncComputeContext && other) noexcept;
+
+    ~AsyncComputeContext() override;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    // False when falling back to the graphics queue
+    [[nodiscard]] bool IsAsync() const;
+
+    // Resources with exclusive sharing need an ownership transfer when this differs from the graphics family
+    [[nodiscard]] uint32_t QueueFamily() const;
+
+    // Command buffers submitted here have to be allocated from this queue family
+    [[nodiscard]] DeferredContext CreateDeferredContext(bool transientCommandBuffers) const;
+
+    // Returns the value the compute timeline reaches once the work completes
+    [[nodiscard]] uint64_t Submit(DeferredContext & context, const std::vector<TimelineSemaphoreWait> & timelineWaits);
+
+    [[nodiscard]] const TimelineSemaphore & Timeline() const;
+    [[nodiscard]] uint64_t LastSubmittedValue() const;
+    [[nodiscard]] uint64_t CompletedValue() const;
+    void WaitForValue(uint64_t value) const;
+
+    // Wait for the graphics queue to join on the given compute value
+    [[nodiscard]] TimelineSemaphoreWait JoinWait(uint64_t value, const vk::PipelineStageFlags & stageMask) const;
+
+    void Reset();
+
+private:
+    void ReleaseResources();
+
+    vk::Queue m_queue = {};
+    uint32_t m_queueFamily = 0;
+    bool m_async = false;
+    // Guards the compute only queue, heap allocated so the context stays movable. The fallback uses the immediate
+    // context lock instead.
+    std::unique_ptr<std::mutex> m_queueMutex = {};
+    TimelineSemaphore m_timeline = {};
+    // Written under the queue lock, read from any thread
+    std::atomic<uint64_t> m_lastSubmittedValue = 0;
+};
+
+}  // namespace Gris::Graphics::Vulkan
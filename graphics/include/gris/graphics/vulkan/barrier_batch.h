@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gris/graphics/vulkan/texture.h>
+#include <gris/graphics/vulkan/vulkan_headers.h>
+
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class Buffer;
+
+// Access and stages a subresource in the given layout is typically used with
+[[nodiscard]] TextureState TextureStateForLayout(vk::ImageLayout layout);
+
+// Accumulates image and buffer barriers and records them as a single pipelineBarrier
+class BarrierBatch
+{
+public:
+    // Transitions are computed against the tracked texture state, which is updated immediately, so the
+    // batch must be recorded in the same order the textures are used in
+    void TransitionTexture(Texture & texture, const TextureState & state);
+    void TransitionTexture(Texture & texture, const TextureState & state, uint32_t baseMipLevel, uint32_t mipLevelCount);
+
+    // Single mip images not owned by a Texture, e.g. swap chain images, with the state tracked by the caller
+    void TransitionImage(const vk::Image & image, const vk::ImageAspectFlags & aspectMask, TextureState & trackedState, const TextureState & state);
+
+    void AddBufferBarrier(
+        const Buffer & buffer,
+        const vk::AccessFlags & srcAccess,
+        const vk::PipelineStageFlags & srcStages,
+        const vk::AccessFlags & dstAccess,
+        const vk::PipelineStageFlags & dstStages);
+
+    // Queue family ownership transfer of an exclusive buffer, recorded once as the release on the source queue and once
+    // as the acquire on the destination queue, with a semaphore wait in between
+    void AddBufferOwnershipTransfer(
+        const Buffer & buffer,
+        uint32_t srcQueueFamily,
+        uint32_t dstQueueFamily,
+        const vk::AccessFlags & srcAccess,
+        const vk::PipelineStageFlags & srcStages,
+        const vk::AccessFlags & dstAccess,
+        const vk::PipelineStageFlags & dstStages);
+
+    [[nodiscard]] bool IsEmpty() const;
+
+    [[nodiscard]] const vk::PipelineStageFlags & SourceStages() const;
+    [[nodiscard]] const vk::PipelineStageFlags & DestinationStages() const;
+    [[nodiscard]] const std::vector<vk::ImageMemoryBarrier> & ImageBarriers() const;
+
+    // Records the accumulated barriers, if any, and empties the batch
+    bool Record(const vk::CommandBuffer & commandBuffer, const vk::DispatchLoaderDynamic & dispatch);
+
+    void Clear();
+
+private:
+    void AddImageBarrier(const vk::Image & image, const vk::ImageAspectFlags & aspectMask, const TextureState & previous, const TextureState & state, uint32_t baseMipLevel, uint32_t mipLevelCount);
+
+    vk::PipelineStageFlags m_srcStages = {};
+    vk::PipelineStageFlags m_dstStages = {};
+    std::vector<vk::ImageMemoryBarrier> m_imageBarriers = {};
+    std::vector<vk::BufferMemoryBarrier> m_bufferBarriers = {};
+};
+
+}  // namespace Gris::Graphics::Vulkan
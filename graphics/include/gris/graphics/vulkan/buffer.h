@@ -32,6 +32,9 @@ public:
 
     void SetData(const void * data, size_t size);
 
+    // Host visible buffers only, mapped on the first call and kept mapped until the buffer is released
+    [[nodiscard]] void * MappedData();
+
     void Reset();
 
 private:
@@ -39,6 +42,7 @@ private:
 
     vk::Buffer m_buffer = {};
     Allocation m_bufferMemory = {};
+    void * m_mappedData = nullptr;
 };
 
 }  // namespace Gris::Graphics::Vulkan
@@ -1,24 +1,41 @@
 #pragma once
 
+#include <gris/graphics/index_format.h>
+#include <gris/graphics/vulkan/barrier_batch.h>
 #include <gris/graphics/vulkan/device_resource.h>
 #include <gris/span.h>
 
+#include <cstdint>
+#include <optional>
+
 namespace Gris::Graphics::Vulkan
 {
 
 class RenderPass;
+class Buffer;
 class Texture;
 class Framebuffer;
 class PipelineStateObject;
 class BufferView;
 class ShaderResourceBindings;
 
+struct DeferredContextStatistics
+{
+    uint32_t DrawCalls = 0;
+    uint32_t PipelineBinds = 0;
+    uint32_t VertexBufferBinds = 0;
+    uint32_t IndexBufferBinds = 0;
+    uint32_t DescriptorSetBinds = 0;
+    uint32_t PipelineBarriers = 0;
+};
+
 class DeferredContext : public DeviceResource
 {
 public:
     DeferredContext();
 
     DeferredContext(const ParentObject<Device> & device, bool transientCommandBuffers);
+    DeferredContext(const ParentObject<Device> & device, bool transientCommandBuffers, uint32_t queueFamily);
 
     DeferredContext(const DeferredContext &) = delete;
     DeferredContext & operator=(const DeferredContext &) = delete;
@@ -34,26 +51,60 @@ public:
 
     [[nodiscard]] vk::CommandBuffer & CommandBufferHandle();
 
+    // Counts of commands recorded since the last Begin
+    [[nodiscard]] const DeferredContextStatistics & Statistics() const;
+
     void Begin(bool oneTimeUse);
+
+    // Reusable recordings are tagged with a version of everything they were recorded from, like the scene contents,
+    // pipelines, bindings and render targets. While the version stays the same the recording can be submitted again
+    // without recording anything, so per frame data has to live in memory the recording already references. Every
+    // other Begin or ResetContext drops the recording.
+    [[nodiscard]] bool HasRecording(uint64_t version) const;
+    void BeginReusable(uint64_t version);
+
     void BeginRenderPass(const RenderPass & renderPass, const Framebuffer & framebuffer, const vk::Extent2D & extent);
+    void BeginRenderPass(const RenderPass & renderPass, const Framebuffer & framebuffer, const vk::Extent2D & extent, Span<const vk::ClearValue> clearValues);
     void BindPipeline(const PipelineStateObject & pso);
     void BindVertexBuffer(const BufferView & bufferView);
-    void BindIndexBuffer(const BufferView & bufferView);
+    void BindVertexBuffer(uint32_t binding, const BufferView & bufferView);
+    void BindIndexBuffer(const BufferView & bufferView, IndexFormat indexFormat = IndexFormat::Uint32);
     void BindDescriptorSet(const PipelineStateObject & pso, uint32_t startSetIndex, Span<const ShaderResourceBindings> shaderResourceBindings);
     void DrawIndexed(uint32_t indexCount);
     void SetViewport(uint32_t width, uint32_t height);
     void SetScissor(uint32_t width, uint32_t height);
     void EndRenderPass();
+
+    // Barriers are batched and flushed as one pipelineBarrier before the next command that consumes them: a render pass,
+    // a draw or the end of recording. Any future transfer or dispatch entry point has to flush them first as well.
+    void TransitionTexture(Texture & texture, const TextureState & state);
+    void TransitionTexture(Texture & texture, const TextureState & state, uint32_t baseMipLevel, uint32_t mipLevelCount);
+    void TransitionImage(const vk::Image & image, const vk::ImageAspectFlags & aspectMask, TextureState & trackedState, const TextureState & state);
+    void AddBufferBarrier(
+        const Buffer & buffer,
+        const vk::AccessFlags & srcAccess,
+        const vk::PipelineStageFlags & srcStages,
+        const vk::AccessFlags & dstAccess,
+        const vk::PipelineStageFlags & dstStages);
+    void FlushBarriers();
+    void ResetQueryPool(const vk::QueryPool & queryPool, uint32_t firstQuery, uint32_t queryCount);
+    void WriteTimestamp(vk::PipelineStageFlagBits stage, const vk::QueryPool & queryPool, uint32_t query);
+    void BeginQuery(const vk::QueryPool & queryPool, uint32_t query);
+    void EndQuery(const vk::QueryPool & queryPool, uint32_t query);
     void End();
     void ResetContext(bool releaseResources);
 
     void Reset();
 
 private:
+    void CreateCommandBuffer(bool transientCommandBuffers, uint32_t queueFamily);
     void ReleaseResources();
 
     vk::CommandPool m_commandPool = {};
     vk::CommandBuffer m_commandBuffer = {};
+    DeferredContextStatistics m_statistics = {};
+    BarrierBatch m_barriers = {};
+    std::optional<uint64_t> m_recordingVersion = {};
 };
 
 }  // namespace Gris::Graphics::Vulkan
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <gris/graphics/vulkan/allocation.h>
+#include <gris/graphics/vulkan/vulkan_headers.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <variant>
+
+namespace Gris::Graphics::Vulkan
+{
+
+using DeferredDestruction = std::variant<
+    vk::Buffer,
+    vk::Image,
+    vk::ImageView,
+    vk::Sampler,
+    vk::ShaderModule,
+    vk::Pipeline,
+    vk::PipelineLayout,
+    vk::RenderPass,
+    vk::Framebuffer,
+    vk::CommandPool,
+    vk::SwapchainKHR,
+    vk::Semaphore,
+    vk::QueryPool,
+    vk::DescriptorPool,
+    vk::DescriptorSetLayout,
+    Allocation>;
+
+// Objects released while the GPU may still be using them, each tagged with the graphics queue timeline value of the
+// last submission made before the release
+class DeferredDestructionQueue
+{
+public:
+    using DestroyFunction = std::function<void(DeferredDestruction & object)>;
+
+    // Values have to be enqueued in non-decreasing order, which submission order guarantees
+    void Enqueue(uint64_t value, DeferredDestruction object);
+
+    // Destroys, in release order, the objects whose value the queue timeline has reached
+    void Collect(uint64_t completedValue, const DestroyFunction & destroy);
+
+    // Destroys everything, the device has to be idle
+    void Flush(const DestroyFunction & destroy);
+
+    [[nodiscard]] bool IsEmpty() const;
+    [[nodiscard]] size_t PendingCount() const;
+
+private:
+    struct PendingDestruction
+    {
+        uint64_t Value = 0;
+        DeferredDestruction Object = {};
+    };
+
+    std::deque<PendingDestruction> m_pending = {};
+};
+
+}  // namespace Gris::Graphics::Vulkan
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <gris/graphics/vulkan/allocator.h>
+#include <gris/graphics/vulkan/deferred_destruction_queue.h>
+#include <gris/graphics/vulkan/device_object_cache.h>
 #include <gris/graphics/vulkan/immediate_context.h>
 #include <gris/graphics/vulkan/physical_device.h>
 #include <gris/graphics/vulkan/shader_resource_bindings_pool_manager.h>
@@ -8,6 +10,8 @@
 #include <gris/object_hierarchy.h>
 #include <gris/span.h>
 
+#include <memory>
+
 namespace Gris::Graphics::Backend
 {
 
@@ -37,6 +41,11 @@ class Framebuffer;
 class Fence;
 class Semaphore;
 class RenderPass;
+class GpuProfiler;
+class RenderTargetRing;
+class TimelineSemaphore;
+class FrameGraph;
+class AsyncComputeContext;
 
 class Device : public ParentObject<Device>
 {
@@ -46,6 +55,7 @@ public:
     Device();
 
     explicit Device(PhysicalDevice physicalDevice);
+    Device(PhysicalDevice physicalDevice, const DeviceQueueConfiguration & queueConfiguration);
 
     Device(const Device &) = delete;
     Device & operator=(const Device &) = delete;
@@ -63,9 +73,17 @@ public:
     [[nodiscard]] ImmediateContext & Context();
 
     [[nodiscard]] const vk::SampleCountFlagBits & MsaaSamples() const;
+    [[nodiscard]] float MaxAnisotropy() const;
 
     [[nodiscard]] const DeviceQueueFamilyIndices & QueueFamilies() const;
 
+    [[nodiscard]] vk::PhysicalDeviceProperties Properties() const;
+    [[nodiscard]] vk::PhysicalDeviceLimits Limits() const;
+    [[nodiscard]] vk::QueueFamilyProperties QueueFamilyProperties(uint32_t queueFamily) const;
+    [[nodiscard]] vk::PhysicalDeviceFeatures EnabledFeatures() const;
+    [[nodiscard]] bool HasTimelineSemaphores() const;
+    [[nodiscard]] uint32_t AsyncComputeQueueCount() const;
+
     [[nodiscard]] SwapChainSupportDetails SwapChainSupport(const WindowMixin & window) const;
 
     void WaitIdle() const;
@@ -79,7 +97,9 @@ public:
 
     [[nodiscard]] SwapChain CreateSwapChain(const WindowMixin & window, uint32_t width, uint32_t height, uint32_t virtualFrameCount) const;
     [[nodiscard]] SwapChain CreateSwapChain(const WindowMixin & window, uint32_t width, uint32_t height, uint32_t virtualFrameCount, SwapChain oldSwapChain) const;
+    [[nodiscard]] RenderTargetRing CreateRenderTargetRing(uint32_t width, uint32_t height, vk::Format format, uint32_t imageCount, uint32_t virtualFrameCount) const;
     [[nodiscard]] DeferredContext CreateDeferredContext(bool transientCommandBuffers) const;
+    [[nodiscard]] DeferredContext CreateDeferredContext(bool transientCommandBuffers, uint32_t queueFamily) const;
     [[nodiscard]] Shader CreateShader(const std::vector<uint32_t> & code, std::string entryPoint) const;
     [[nodiscard]] Buffer CreateBuffer(vk::DeviceSize size, const vk::BufferUsageFlags & usage, const vk::MemoryPropertyFlags & properties) const;
     [[nodiscard]] Texture CreateTexture(
@@ -102,6 +122,13 @@ public:
         Span<const ShaderResourceBindingsLayout> resourceLayouts,
         const Shader & vertexShader,
         const Shader & fragmentShader) const;
+    [[nodiscard]] PipelineStateObject CreatePipelineStateObject(
+        std::optional<uint32_t> swapChainWidth,
+        std::optional<uint32_t> swapChainHeight,
+        const RenderPass & renderPass,
+        const InputLayout & inputLayout,
+        Span<const ShaderResourceBindingsLayout> resourceLayouts,
+        const Shader & vertexShader) const;
     [[nodiscard]] ShaderResourceBindings CreateShaderResourceBindings(const ParentObject<ShaderResourceBindingsLayout> & resourceLayout) const;
     [[nodiscard]] Framebuffer CreateFramebuffer(
         const TextureView & colorImageView,
@@ -110,16 +137,44 @@ public:
         const RenderPass & renderPass,
         uint32_t width,
         uint32_t height) const;
+    [[nodiscard]] Framebuffer CreateFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height) const;
     [[nodiscard]] Fence CreateFence(bool signaled) const;
     [[nodiscard]] Semaphore CreateSemaphore() const;
+    [[nodiscard]] TimelineSemaphore CreateTimelineSemaphore(uint64_t initialValue) const;
     [[nodiscard]] RenderPass CreateRenderPass(vk::Format swapChainFormat, vk::Format depthFormat) const;
+    [[nodiscard]] RenderPass CreateRenderPass(vk::Format swapChainFormat, vk::Format depthFormat, vk::ImageLayout finalLayout) const;
+    [[nodiscard]] RenderPass CreateRenderPass(const vk::RenderPassCreateInfo & renderPassInfo) const;
     [[nodiscard]] ShaderResourceBindingsPoolCollection CreateShaderResourceBindingsPoolCollection() const;
     [[nodiscard]] TextureView CreateTextureView(const vk::Image & image, vk::Format format, const vk::ImageAspectFlags & aspectFlags, uint32_t mipLevels) const;
     [[nodiscard]] ShaderResourceBindingsPool CreateShaderResourceBindingsPool(Backend::ShaderResourceBindingsPoolCategory category, vk::DescriptorPool pool) const;
+    [[nodiscard]] GpuProfiler CreateGpuProfiler(uint32_t virtualFrameCount, uint32_t maxZonesPerFrame) const;
+    [[nodiscard]] FrameGraph CreateFrameGraph() const;
+    [[nodiscard]] AsyncComputeContext CreateAsyncComputeContext(uint32_t queueIndex) const;
+
+    // Identical create infos share a single object, the cache keeps every object alive until TrimCaches
+    [[nodiscard]] std::shared_ptr<const Sampler> CachedSampler(float minLod, float maxLod);
+    [[nodiscard]] std::shared_ptr<const Sampler> CachedSampler(const vk::SamplerCreateInfo & samplerInfo);
+    [[nodiscard]] std::shared_ptr<const ShaderResourceBindingsLayout> CachedShaderResourceBindingsLayout(const Gris::Graphics::Backend::ShaderResourceBindingsLayout & bindings);
+    [[nodiscard]] std::shared_ptr<const RenderPass> CachedRenderPass(const vk::RenderPassCreateInfo & renderPassInfo);
+    // Keyed on the attachment and render pass handles, releasing any of them evicts the framebuffers built from it
+    [[nodiscard]] std::shared_ptr<const Framebuffer> CachedFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height);
+    [[nodiscard]] std::shared_ptr<const Shader> CachedShader(const std::vector<uint32_t> & code, const std::string & entryPoint);
+
+    [[nodiscard]] DeviceCacheStatistics CacheStatistics() const;
+
+    // Releases the cached objects nothing outside the caches references
+    void TrimCaches();
 
     [[nodiscard]] ShaderResourceBindingsPool AllocateShaderResourceBindingsPool(Backend::ShaderResourceBindingsPoolCategory category);
     void DeallocateShaderResourceBindingsPool(ShaderResourceBindingsPool pool);
 
+    // Destroys the object once every submission made so far has completed, destroys it immediately if there is no
+    // context to submit to
+    void DestroyDeferred(DeferredDestruction object);
+
+    // Called once per frame after waiting for a virtual frame
+    void CollectDeferredDestructions();
+
     void Reset();
 
 private:
@@ -138,14 +193,26 @@ private:
     [[nodiscard]] const vk::DispatchLoaderDynamic & DispatchHandle() const;
     [[nodiscard]] vk::DispatchLoaderDynamic & DispatchHandle();
 
+    void Destroy(DeferredDestruction & object);
+
+    void ClearCaches();
+
     void ReleaseResources();
 
     PhysicalDevice m_physicalDevice = {};
     vk::Device m_device = {};
     vk::DispatchLoaderDynamic m_dispatch = {};
     Allocator m_allocator = {};
+    bool m_timelineSemaphores = false;
+    uint32_t m_asyncComputeQueueCount = 0;
     ImmediateContext m_context = {};
+    DeferredDestructionQueue m_deferredDestructions = {};
     std::vector<CategoryAndPoolManager> m_poolManagers;
+    DeviceObjectCache<Sampler> m_samplerCache = {};
+    DeviceObjectCache<ShaderResourceBindingsLayout> m_shaderResourceBindingsLayoutCache = {};
+    DeviceObjectCache<RenderPass> m_renderPassCache = {};
+    DeviceObjectCache<Framebuffer> m_framebufferCache = {};
+    DeviceObjectCache<Shader> m_shaderCache = {};
 };
 
 }  // namespace Gris::Graphics::Vulkan
\ No newline at end of file
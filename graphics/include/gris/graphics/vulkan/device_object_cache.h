@@ -0,0 +1,135 @@
+#pragma once
+
+#include <gris/span.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+// Create info flattened into words, pointed to arrays included, so keys compare and hash by value regardless of
+// padding and pointers in the Vulkan structures
+class DeviceObjectCacheKey
+{
+public:
+    void Append(uint64_t value);
+    void Append(float value);
+    void Append(std::string_view value);
+    void Append(Span<const uint32_t> values);
+
+    [[nodiscard]] size_t Hash() const;
+
+    [[nodiscard]] bool Contains(uint64_t value) const;
+
+    [[nodiscard]] bool operator==(const DeviceObjectCacheKey & other) const;
+    [[nodiscard]] bool operator!=(const DeviceObjectCacheKey & other) const;
+
+private:
+    std::vector<uint64_t> m_words = {};
+    uint64_t m_hash = 14695981039346656037ULL;
+};
+
+struct DeviceObjectCacheStatistics
+{
+    uint64_t Hits = 0;
+    uint64_t Misses = 0;
+    size_t Size = 0;
+};
+
+struct DeviceCacheStatistics
+{
+    DeviceObjectCacheStatistics Samplers = {};
+    DeviceObjectCacheStatistics ShaderResourceBindingsLayouts = {};
+    DeviceObjectCacheStatistics RenderPasses = {};
+    DeviceObjectCacheStatistics Framebuffers = {};
+    DeviceObjectCacheStatistics Shaders = {};
+};
+
+// Hash-consed immutable objects, identical keys share a single object. The cache keeps a reference to everything it
+// created until it is trimmed. Not thread safe.
+template<typename T>
+class DeviceObjectCache
+{
+public:
+    template<typename FactoryT>
+    [[nodiscard]] std::shared_ptr<const T> GetOrCreate(DeviceObjectCacheKey key, FactoryT && factory)
+    {
+        auto const objectIt = m_objects.find(key);
+        if (objectIt != m_objects.end())
+        {
+            ++m_statistics.Hits;
+            return objectIt->second;
+        }
+
+        ++m_statistics.Misses;
+        auto object = std::make_shared<const T>(std::forward<FactoryT>(factory)());
+        m_objects.emplace(std::move(key), object);
+        return object;
+    }
+
+    // Releases the objects only the cache still references
+    void Trim()
+    {
+        for (auto objectIt = m_objects.begin(); objectIt != m_objects.end();)
+        {
+            if (objectIt->second.use_count() == 1)
+            {
+                objectIt = m_objects.erase(objectIt);
+            }
+            else
+            {
+                ++objectIt;
+            }
+        }
+    }
+
+    // Releases the objects whose key contains the word. Keys made of handles are evicted with this when one of the
+    // handles is released, the driver can hand out the same value for a new object afterwards. Other words that happen
+    // to be equal only cost a cache miss.
+    void EvictContaining(uint64_t word)
+    {
+        for (auto objectIt = m_objects.begin(); objectIt != m_objects.end();)
+        {
+            if (objectIt->first.Contains(word))
+            {
+                objectIt = m_objects.erase(objectIt);
+            }
+            else
+            {
+                ++objectIt;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        m_objects.clear();
+        m_statistics = {};
+    }
+
+    [[nodiscard]] DeviceObjectCacheStatistics Statistics() const
+    {
+        auto statistics = m_statistics;
+        statistics.Size = m_objects.size();
+        return statistics;
+    }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const DeviceObjectCacheKey & key) const noexcept
+        {
+            return key.Hash();
+        }
+    };
+
+    std::unordered_map<DeviceObjectCacheKey, std::shared_ptr<const T>, KeyHash> m_objects = {};
+    DeviceObjectCacheStatistics m_statistics = {};
+};
+
+}  // namespace Gris::Graphics::Vulkan
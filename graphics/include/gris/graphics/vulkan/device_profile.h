@@ -0,0 +1,52 @@
+#pragma once
+
+#include <gris/graphics/vulkan/vulkan_headers.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Gris::Graphics::Vulkan
+{
+
+// Render quality the application asks for, devices are scored against it and the settings are clamped to what the
+// selected device supports
+struct DeviceProfile
+{
+    // Upper bound, MSAA cost grows with the sample count so higher counts have to be asked for explicitly
+    vk::SampleCountFlagBits MaxMsaaSamples = vk::SampleCountFlagBits::e4;
+
+    // Anisotropic filtering is disabled at 1
+    float MaxAnisotropy = 8.0F;
+
+    // Devices missing any of these are not considered
+    vk::PhysicalDeviceFeatures RequiredFeatures = {};
+
+    // Enabled when the device supports them
+    vk::PhysicalDeviceFeatures OptionalFeatures = vk::PhysicalDeviceFeatures{}.setPipelineStatisticsQuery(static_cast<vk::Bool32>(true));
+
+    // A device whose name contains this wins over the scoring, e.g. to pin a GPU on a multi GPU machine
+    std::optional<std::string> PreferredDeviceName = {};
+};
+
+// What a profile resolves to on a specific device
+struct DeviceCapabilities
+{
+    vk::SampleCountFlagBits MsaaSamples = vk::SampleCountFlagBits::e1;
+    float MaxAnisotropy = 1.0F;
+    vk::PhysicalDeviceFeatures EnabledFeatures = {};
+};
+
+[[nodiscard]] bool SupportsFeatures(const vk::PhysicalDeviceFeatures & supported, const vk::PhysicalDeviceFeatures & required);
+
+[[nodiscard]] DeviceCapabilities ResolveDeviceProfile(const vk::PhysicalDeviceProperties & properties, const vk::PhysicalDeviceFeatures & supported, const DeviceProfile & profile);
+
+// Higher is better. Discrete GPUs come first, then larger device local heaps, then more optional features. Required
+// features are not part of the score, devices missing them have to be filtered out before.
+[[nodiscard]] uint64_t ScorePhysicalDevice(
+    const vk::PhysicalDeviceProperties & properties,
+    const vk::PhysicalDeviceMemoryProperties & memoryProperties,
+    const vk::PhysicalDeviceFeatures & supported,
+    const DeviceProfile & profile);
+
+}  // namespace Gris::Graphics::Vulkan
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <gris/graphics/vulkan/device_resource.h>
+
+#include <gris/graphics/vulkan/allocation.h>
+#include <gris/graphics/vulkan/framebuffer.h>
+#include <gris/graphics/vulkan/render_pass.h>
+#include <gris/graphics/vulkan/texture.h>
+#include <gris/graphics/vulkan/texture_view.h>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class DeferredContext;
+class FrameGraphPassBuilder;
+
+struct FrameGraphTextureDescription
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    vk::Format Format = vk::Format::eUndefined;
+    vk::SampleCountFlagBits Samples = vk::SampleCountFlagBits::e1;
+};
+
+// State a transient texture starts in when its memory held another texture before. The contents are gone, but the
+// accesses to the memory made through the previous texture still have to finish before it is written again.
+[[nodiscard]] TextureState AliasedTextureState(const TextureState & previousState);
+
+// Passes declare how they use virtual textures instead of managing images, render passes and barriers themselves.
+// Compile culls passes that contribute neither to an imported texture nor to a side effect, derives the render pass
+// load and store ops and places transient textures with disjoint lifetimes in shared memory. Execute records the
+// passes in declaration order with the barriers between them batched per pass.
+class FrameGraph : public DeviceResource
+{
+public:
+    using ResourceHandle = uint32_t;
+    using PassHandle = uint32_t;
+    using PassCallback = std::function<void(DeferredContext & context)>;
+
+    FrameGraph();
+
+    explicit FrameGraph(const ParentObject<Device> & device);
+
+    FrameGraph(const FrameGraph &) = delete;
+    FrameGraph & operator=(const FrameGraph &) = delete;
+
+    FrameGraph(FrameGraph && other) noexcept;
+    FrameGraph & operator=(FrameGraph && other) noexcept;
+
+    ~FrameGraph() override;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    // Transient textures are created by Compile and only live for the duration of the graph
+    [[nodiscard]] ResourceHandle CreateTexture(std::string name, const FrameGraphTextureDescription & description);
+
+    // Imported textures are owned elsewhere and have to be bound with SetImportedTexture before each Execute
+    [[nodiscard]] ResourceHandle ImportTexture(std::string name, const FrameGraphTextureDescription & description, const TextureState & initialState, const TextureState & finalState);
+    void SetImportedTexture(ResourceHandle resource, const vk::Image & image, const vk::ImageView & imageView);
+
+    // Takes effect on the next Compile, which keeps the render passes and reuses transient memory of the same size class
+    void SetTextureExtent(ResourceHandle resource, uint32_t width, uint32_t height);
+
+    [[nodiscard]] FrameGraphPassBuilder AddPass(std::string name, PassCallback callback);
+
+    // Framebuffers are cached by image view, so compiling again is also required when imported views are recreated
+    void Compile();
+
+    [[nodiscard]] bool IsCompiled() const;
+    [[nodiscard]] bool IsPassCulled(PassHandle pass) const;
+
+    // Pipelines used in a pass have to be created against a compatible render pass
+    [[nodiscard]] const RenderPass & PassRenderPass(PassHandle pass) const;
+
+    [[nodiscard]] const vk::ImageView & TextureViewHandle(ResourceHandle resource) const;
+
+    // Memory backing all transient textures, after aliasing
+    [[nodiscard]] vk::DeviceSize TransientMemorySize() const;
+
+    // Must be recorded outside of a render pass
+    void Execute(DeferredContext & context);
+
+    // Changes whenever the commands recorded by Execute may change, imported textures aside. The first Execute after a
+    // Compile has nothing from earlier frames to wait on, so its barriers differ from the ones recorded later and it
+    // bumps the version as well.
+    [[nodiscard]] uint64_t RecordingVersion() const;
+
+    void Reset();
+
+private:
+    friend class FrameGraphPassBuilder;
+
+    enum class AccessType
+    {
+        Read,
+        Write,
+        ColorAttachment,
+        DepthAttachment,
+        ResolveAttachment,
+    };
+
+    struct ResourceAccess
+    {
+        ResourceHandle Resource = 0;
+        AccessType Type = AccessType::Read;
+        TextureState State = {};
+        std::optional<vk::ClearValue> ClearValue = {};
+    };
+
+    struct FramebufferCacheEntry
+    {
+        std::vector<vk::ImageView> Attachments = {};
+        Framebuffer Object = {};
+    };
+
+    struct PassNode
+    {
+        std::string Name = {};
+        PassCallback Callback = {};
+        std::vector<ResourceAccess> Accesses = {};
+        bool HasSideEffect = false;
+        bool Culled = false;
+        RenderPass CompiledRenderPass = {};
+        std::vector<vk::AttachmentDescription> RenderPassAttachments = {};
+        std::vector<ResourceHandle> Attachments = {};
+        std::vector<vk::ClearValue> ClearValues = {};
+        vk::Extent2D Extent = {};
+        std::vector<FramebufferCacheEntry> Framebuffers = {};
+    };
+
+    struct ResourceNode
+    {
+        std::string Name = {};
+        FrameGraphTextureDescription Description = {};
+        bool Imported = false;
+        TextureState InitialState = {};
+        TextureState FinalState = {};
+        std::optional<PassHandle> FirstPass = {};
+        std::optional<PassHandle> LastPass = {};
+        std::optional<uint32_t> MemorySlot = {};
+        vk::ImageUsageFlags Usage = {};
+        vk::Image Image = {};
+        vk::ImageView ImageView = {};
+        TextureView View = {};
+        TextureState State = {};
+    };
+
+    struct MemorySlot
+    {
+        vk::MemoryRequirements Requirements = {};
+        PassHandle LastPass = 0;
+        Allocation Memory = {};
+        // State the last texture placed in the slot was left in, the next one has to wait for it. Recycled memory keeps
+        // it, frames recorded before the Compile may still be using the memory.
+        TextureState LastState = {};
+    };
+
+    void CullPasses();
+    void ComputeLifetimes();
+    void CreateTransientTextures();
+    void CreateRenderPasses();
+    [[nodiscard]] const Framebuffer & PassFramebuffer(PassNode & pass);
+
+    void ReleaseCompiledResources();
+    void ReleaseRecycledMemory();
+    void ReleaseResources();
+
+    std::vector<ResourceNode> m_resources = {};
+    std::vector<PassNode> m_passes = {};
+    std::vector<MemorySlot> m_memorySlots = {};
+    // Slot memory of the previous Compile, kept until the next one had a chance to reuse it
+    std::vector<MemorySlot> m_recycledMemory = {};
+    bool m_compiled = false;
+    bool m_executedSinceCompile = false;
+    uint64_t m_recordingVersion = 0;
+};
+
+class FrameGraphPassBuilder
+{
+public:
+    [[nodiscard]] FrameGraph::PassHandle Pass() const;
+
+    FrameGraphPassBuilder & Read(FrameGraph::ResourceHandle resource, const TextureState & state);
+    FrameGraphPassBuilder & Write(FrameGraph::ResourceHandle resource, const TextureState & state);
+
+    // Attachments without a clear value load the previous contents if there are any
+    FrameGraphPassBuilder & ColorAttachment(FrameGraph::ResourceHandle resource);
+    FrameGraphPassBuilder & ColorAttachment(FrameGraph::ResourceHandle resource, const vk::ClearColorValue & clearValue);
+    FrameGraphPassBuilder & DepthAttachment(FrameGraph::ResourceHandle resource);
+    FrameGraphPassBuilder & DepthAttachment(FrameGraph::ResourceHandle resource, const vk::ClearDepthStencilValue & clearValue);
+
+    // Resolves the color attachment declared at the same position
+    FrameGraphPassBuilder & ResolveAttachment(FrameGraph::ResourceHandle resource);
+
+    // Keeps the pass alive even if nothing reads its outputs
+    FrameGraphPassBuilder & SideEffect();
+
+private:
+    friend class FrameGraph;
+
+    FrameGraphPassBuilder(FrameGraph & graph, FrameGraph::PassHandle pass);
+
+    FrameGraphPassBuilder & AddAccess(FrameGraph::ResourceHandle resource, FrameGraph::AccessType type, const TextureState & state, std::optional<vk::ClearValue> clearValue);
+
+    FrameGraph * m_graph = nullptr;
+    FrameGraph::PassHandle m_pass = 0;
+};
+
+}  // namespace Gris::Graphics::Vulkan
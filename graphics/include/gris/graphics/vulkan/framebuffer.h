@@ -2,6 +2,8 @@
 
 #include <gris/graphics/vulkan/device_resource.h>
 
+#include <gris/span.h>
+
 namespace Gris::Graphics::Vulkan
 {
 
@@ -14,6 +16,7 @@ public:
     Framebuffer();
 
     Framebuffer(const ParentObject<Device> & device, const TextureView & colorImageView, const TextureView & depthImageView, const TextureView & swapChainImageView, const RenderPass & renderPass, uint32_t width, uint32_t height);
+    Framebuffer(const ParentObject<Device> & device, Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height);
 
     Framebuffer(const Framebuffer &) = delete;
     Framebuffer & operator=(const Framebuffer &) = delete;
@@ -33,6 +36,7 @@ public:
     void Reset();
 
 private:
+    void CreateFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height);
     void ReleaseResources();
 
     vk::Framebuffer m_framebuffer = {};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <gris/graphics/vulkan/device_resource.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class DeferredContext;
+
+struct GpuZoneResult
+{
+    std::string Name = {};
+    uint32_t Depth = 0;
+    double GpuTimeMilliseconds = 0.0;
+    bool HasPipelineStatistics = false;
+    uint64_t InputAssemblyPrimitives = 0;
+    uint64_t VertexShaderInvocations = 0;
+    uint64_t ClippingPrimitives = 0;
+    uint64_t FragmentShaderInvocations = 0;
+};
+
+class GpuProfiler : public DeviceResource
+{
+public:
+    using ZoneIndex = uint32_t;
+
+    GpuProfiler();
+
+    GpuProfiler(const ParentObject<Device> & device, uint32_t virtualFrameCount, uint32_t maxZonesPerFrame);
+
+    GpuProfiler(const GpuProfiler &) = delete;
+    GpuProfiler & operator=(const GpuProfiler &) = delete;
+
+    GpuProfiler(GpuProfiler && other) noexcept;
+    GpuProfiler & operator=(GpuProfiler && other) noexcept;
+
+    ~GpuProfiler() override;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    [[nodiscard]] bool HasPipelineStatistics() const;
+
+    // Must be recorded outside of a render pass, after the virtual frame fence has been waited on
+    void BeginFrame(DeferredContext & context, uint32_t virtualFrameIndex);
+
+    [[nodiscard]] ZoneIndex BeginZone(DeferredContext & context, std::string name);
+    void EndZone(DeferredContext & context, ZoneIndex zone);
+
+    // Results of the most recent frame whose queries were read back, lagging by up to virtualFrameCount frames
+    [[nodiscard]] const std::vector<GpuZoneResult> & Results() const;
+
+    // Number of the frame (counted in BeginFrame calls) the results belong to
+    [[nodiscard]] std::optional<uint64_t> ResultsFrameNumber() const;
+
+    void Reset();
+
+private:
+    struct ZoneRecord
+    {
+        std::string Name = {};
+        uint32_t Depth = 0;
+        std::optional<uint32_t> StatisticsQuery = {};
+        bool Closed = false;
+    };
+
+    struct FrameRecord
+    {
+        uint64_t FrameNumber = 0;
+        std::vector<ZoneRecord> Zones = {};
+        uint32_t StatisticsQueryCount = 0;
+    };
+
+    void ReadBackResults(uint32_t virtualFrameIndex);
+    void ReleaseResources();
+
+    vk::QueryPool m_timestampPool = {};
+    vk::QueryPool m_statisticsPool = {};
+    uint32_t m_maxZonesPerFrame = 0;
+    double m_timestampPeriod = 0.0;
+    uint64_t m_timestampMask = 0;
+    std::vector<FrameRecord> m_frames = {};
+    uint32_t m_currentFrame = 0;
+    uint64_t m_frameNumber = 0;
+    uint32_t m_openZoneCount = 0;
+    std::optional<ZoneIndex> m_openStatisticsZone = {};
+    std::vector<uint64_t> m_timestampData = {};
+    std::vector<uint64_t> m_statisticsData = {};
+    std::vector<GpuZoneResult> m_results = {};
+    std::optional<uint64_t> m_resultsFrameNumber = {};
+};
+
+class GpuProfilerZone
+{
+public:
+    GpuProfilerZone(GpuProfiler & profiler, DeferredContext & context, std::string name);
+
+    GpuProfilerZone(const GpuProfilerZone &) = delete;
+    GpuProfilerZone & operator=(const GpuProfilerZone &) = delete;
+
+    GpuProfilerZone(GpuProfilerZone &&) = delete;
+    GpuProfilerZone & operator=(GpuProfilerZone &&) = delete;
+
+    ~GpuProfilerZone();
+
+private:
+    GpuProfiler * m_profiler = nullptr;
+    DeferredContext * m_context = nullptr;
+    GpuProfiler::ZoneIndex m_zone = 0;
+};
+
+}  // namespace Gris::Graphics::Vulkan
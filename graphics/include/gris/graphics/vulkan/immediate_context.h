@@ -2,6 +2,17 @@
 
 #include <gris/graphics/vulkan/device_resource.h>
 
+#include <gris/graphics/vulkan/timeline_semaphore.h>
+
+#include <gris/span.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace Gris::Graphics::Vulkan
 {
 
@@ -11,6 +22,13 @@ class DeferredContext;
 class Semaphore;
 class Fence;
 
+struct TimelineSemaphoreWait
+{
+    std::reference_wrapper<const TimelineSemaphore> Timeline;
+    uint64_t Value = 0;
+    vk::PipelineStageFlags StageMask = vk::PipelineStageFlagBits::eTopOfPipe;
+};
+
 class ImmediateContext : public DeviceResource
 {
 public:
@@ -30,23 +48,62 @@ public:
 
     [[nodiscard]] bool IsValid() const;
 
-    void GenerateMipmaps(const Texture & texture, const vk::Format & imageFormat, uint32_t texWidth, uint32_t texHeight);
-    void CopyBufferToImage(const Buffer & buffer, const Texture & texture, uint32_t width, uint32_t height);
-    void TransitionImageLayout(const Texture & texture, const vk::ImageLayout & oldLayout, const vk::ImageLayout & newLayout);
+    void GenerateMipmaps(Texture & texture, const vk::Format & imageFormat, uint32_t texWidth, uint32_t texHeight);
+    void CopyBufferToImage(const Buffer & buffer, Texture & texture, uint32_t width, uint32_t height);
+
+    // Transitions from the tracked layout of each mip, nothing is submitted if the texture is already there
+    void TransitionImageLayout(Texture & texture, const vk::ImageLayout & newLayout);
     void CopyBuffer(const Buffer & srcBuffer, const Buffer & dstBuffer, vk::DeviceSize size);
     void Submit(DeferredContext * context, const std::vector<std::reference_wrapper<Semaphore>> & waitSemaphores, const std::vector<std::reference_wrapper<Semaphore>> & signalSemaphores, Fence & fence);
 
+    // Timeline submission, returns the value the graphics queue timeline reaches once the work completes
+    [[nodiscard]] uint64_t Submit(
+        DeferredContext * context,
+        const std::vector<std::reference_wrapper<Semaphore>> & waitSemaphores,
+        const std::vector<std::reference_wrapper<Semaphore>> & signalSemaphores,
+        const std::vector<TimelineSemaphoreWait> & timelineWaits);
+
+    // The graphics queue timeline is only available when the device has timeline semaphores enabled
+    [[nodiscard]] bool HasTimeline() const;
+    [[nodiscard]] const TimelineSemaphore & Timeline() const;
+    void WaitForValue(uint64_t value) const;
+
+    // Submissions are counted either way, without the timeline completion is only known from the fence waits
+    // reported through NotifyCompleted
+    [[nodiscard]] uint64_t LastSubmittedValue() const;
+    [[nodiscard]] uint64_t CompletedValue() const;
+    void NotifyCompleted(uint64_t value);
+
+    // Queue operations need external synchronization. Submissions made here take this lock, anything else using the
+    // graphics queue, like presenting from it or compute falling back to it, has to hold it too.
+    [[nodiscard]] std::unique_lock<std::mutex> LockQueue();
+
     void Reset();
 
 private:
     [[nodiscard]] vk::CommandBuffer BeginSingleTimeCommands();
-    void EndSingleTimeCommands(vk::CommandBuffer & commandBuffer) const;
+    void EndSingleTimeCommands(vk::CommandBuffer & commandBuffer);
+
+    // Every submission advances the submission count and the graphics queue timeline when it is available
+    uint64_t SubmitToQueue(
+        Span<const vk::CommandBuffer> commandBuffers,
+        std::vector<vk::Semaphore> waitSemaphores,
+        std::vector<vk::PipelineStageFlags> waitStages,
+        std::vector<uint64_t> waitValues,
+        std::vector<vk::Semaphore> signalSemaphores,
+        vk::Fence fence);
 
     void ReleaseResources();
 
     vk::Queue m_graphicsQueue = {};
+    // Heap allocated so the context stays movable
+    std::unique_ptr<std::mutex> m_queueMutex = {};
     vk::CommandPool m_commandPool = {};
     vk::Fence m_fence = {};
+    TimelineSemaphore m_timeline = {};
+    // Written under the queue lock, read from any thread
+    std::atomic<uint64_t> m_lastSubmittedValue = 0;
+    std::atomic<uint64_t> m_completedValue = 0;
 };
 
 }  // namespace Gris::Graphics::Vulkan
\ No newline at end of file
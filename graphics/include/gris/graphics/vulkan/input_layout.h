@@ -2,6 +2,10 @@
 
 #include <gris/graphics/vulkan/vulkan_headers.h>
 
+#include <gris/graphics/vertex_format.h>
+
+#include <gris/span.h>
+
 #include <cstdint>
 
 namespace Gris::Graphics::Vulkan
@@ -23,6 +27,15 @@ public:
     void AddBinding(uint32_t binding, uint32_t stride, vk::VertexInputRate inputRate);
     void AddAttributeDescription(uint32_t location, uint32_t binding, vk::Format format, uint32_t offset);
 
+    // Adds the binding and one attribute per description
+    void AddVertexFormat(uint32_t binding, uint32_t stride, Span<const VertexAttributeDescription> attributes, vk::VertexInputRate inputRate);
+
+    template<typename Format>
+    void AddVertexFormat(uint32_t binding, vk::VertexInputRate inputRate = vk::VertexInputRate::eVertex)
+    {
+        AddVertexFormat(binding, static_cast<uint32_t>(Format::STRIDE), Format::ATTRIBUTES, inputRate);
+    }
+
     [[nodiscard]] const std::vector<vk::VertexInputBindingDescription> & BindingDescription() const;
     [[nodiscard]] const std::vector<vk::VertexInputAttributeDescription> & AttributeDescriptions() const;
 
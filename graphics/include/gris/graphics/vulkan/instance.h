@@ -27,6 +27,10 @@ public:
 
     [[nodiscard]] static std::vector<vk::PhysicalDevice> EnumeratePhysicalDevices();
 
+    // Headless instances do not request window system extensions, must be set before the instance is first used
+    static void SetHeadless(bool headless);
+    [[nodiscard]] static bool IsHeadless();
+
 private:
     [[nodiscard]] static std::vector<const char *> GetRequiredExtensions();
 
@@ -2,6 +2,7 @@
 
 #include "utils.h"
 
+#include <gris/graphics/vulkan/device_profile.h>
 #include <gris/graphics/vulkan/vulkan_headers.h>
 
 namespace Gris::Graphics::Vulkan
@@ -13,13 +14,17 @@ class WindowMixin;
 class PhysicalDevice
 {
 public:
-    constexpr static std::array REQUIRED_EXTENSIONS = {
+    constexpr static std::array PRESENTATION_EXTENSIONS = {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME
     };
 
+    constexpr static std::array TIMELINE_SEMAPHORE_EXTENSIONS = {
+        VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
+    };
+
     PhysicalDevice();
 
-    PhysicalDevice(vk::PhysicalDevice physicalDevice, vk::SampleCountFlagBits msaaSamples, DeviceQueueFamilyIndices queueFamilies);
+    PhysicalDevice(vk::PhysicalDevice physicalDevice, DeviceCapabilities capabilities, DeviceQueueFamilyIndices queueFamilies);
 
     PhysicalDevice(const PhysicalDevice &) = delete;
     PhysicalDevice & operator=(const PhysicalDevice &) = delete;
@@ -34,20 +39,31 @@ public:
     [[nodiscard]] bool IsValid() const;
 
     [[nodiscard]] const vk::SampleCountFlagBits & MsaaSamples() const;
+    [[nodiscard]] float MaxAnisotropy() const;
     [[nodiscard]] const DeviceQueueFamilyIndices & QueueFamilies() const;
+    [[nodiscard]] bool IsHeadless() const;
+
+    [[nodiscard]] vk::PhysicalDeviceProperties Properties() const;
+    [[nodiscard]] vk::QueueFamilyProperties QueueFamilyProperties(uint32_t queueFamily) const;
+    [[nodiscard]] vk::PhysicalDeviceFeatures SupportedFeatures() const;
+    [[nodiscard]] vk::PhysicalDeviceFeatures EnabledFeatures() const;
+    [[nodiscard]] bool SupportsTimelineSemaphores() const;
 
     [[nodiscard]] vk::Format FindSupportedFormat(const std::vector<vk::Format> & candidates, const vk::ImageTiling & tiling, const vk::FormatFeatureFlags & features) const;
     [[nodiscard]] vk::FormatProperties GetFormatProperties(vk::Format format) const;
 
     [[nodiscard]] SwapChainSupportDetails SwapChainSupport(const WindowMixin & window) const;
-    [[nodiscard]] vk::Device CreateDevice() const;
+    // Clamped to the queues the compute family offers, zero without a compute only family
+    [[nodiscard]] uint32_t AsyncComputeQueueCount(const DeviceQueueConfiguration & configuration) const;
+
+    [[nodiscard]] vk::Device CreateDevice(const DeviceQueueConfiguration & configuration) const;
     [[nodiscard]] Allocator CreateAllocator(const vk::Device & device, const vk::DispatchLoaderDynamic & dispatch) const;
 
     void Reset();
 
 private:
     vk::PhysicalDevice m_physicalDevice = {};
-    vk::SampleCountFlagBits m_msaaSamples = vk::SampleCountFlagBits::e1;
+    DeviceCapabilities m_capabilities = {};
     DeviceQueueFamilyIndices m_queueFamilies = {};
 };
 
@@ -1,11 +1,25 @@
 #pragma once
 
+#include <gris/graphics/vulkan/vulkan_headers.h>
+
 namespace Gris::Graphics::Vulkan
 {
 
 class PhysicalDevice;
 class WindowMixin;
+struct DeviceProfile;
 
 [[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice(const WindowMixin & window);
 
+// Selects a device without presentation support, for offscreen rendering
+[[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice();
+
+// A null surface selects a headless device
+[[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice(const vk::SurfaceKHR & surface);
+
+// The suitable device with the highest score is selected and the profile is resolved against it
+[[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice(const WindowMixin & window, const DeviceProfile & profile);
+[[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice(const DeviceProfile & profile);
+[[nodiscard]] PhysicalDevice FindSuitablePhysicalDevice(const vk::SurfaceKHR & surface, const DeviceProfile & profile);
+
 }  // namespace Gris::Graphics::Vulkan
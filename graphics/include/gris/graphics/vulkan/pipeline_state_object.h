@@ -29,6 +29,16 @@ public:
         const Shader & vertexShader,
         const Shader & fragmentShader);
 
+    // Depth only pipeline, without a fragment shader and color attachments, e.g. for a depth prepass
+    PipelineStateObject(
+        const ParentObject<Device> & device,
+        std::optional<uint32_t> swapChainWidth,
+        std::optional<uint32_t> swapChainHeight,
+        const RenderPass & renderPass,
+        const InputLayout & inputLayout,
+        Span<const ShaderResourceBindingsLayout> resourceLayouts,
+        const Shader & vertexShader);
+
     PipelineStateObject(const PipelineStateObject &) = delete;
     PipelineStateObject & operator=(const PipelineStateObject &) = delete;
 
@@ -50,6 +60,16 @@ public:
     void Reset();
 
 private:
+    PipelineStateObject(
+        const ParentObject<Device> & device,
+        std::optional<uint32_t> swapChainWidth,
+        std::optional<uint32_t> swapChainHeight,
+        const RenderPass & renderPass,
+        const InputLayout & inputLayout,
+        Span<const ShaderResourceBindingsLayout> resourceLayouts,
+        const Shader & vertexShader,
+        const Shader * fragmentShader);
+
     void ReleaseResources();
 
     vk::PipelineLayout m_pipelineLayout = {};
@@ -11,6 +11,8 @@ public:
     RenderPass();
 
     RenderPass(const ParentObject<Device> & device, vk::Format swapChainFormat, vk::Format depthFormat);
+    RenderPass(const ParentObject<Device> & device, vk::Format swapChainFormat, vk::Format depthFormat, vk::ImageLayout finalLayout);
+    RenderPass(const ParentObject<Device> & device, const vk::RenderPassCreateInfo & renderPassInfo);
 
     RenderPass(const RenderPass &) = delete;
     RenderPass & operator=(const RenderPass &) = delete;
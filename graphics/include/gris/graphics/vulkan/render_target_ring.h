@@ -0,0 +1,103 @@
+#pragma once
+
+#include <gris/graphics/vulkan/device_resource.h>
+
+#include <gris/graphics/vulkan/fence.h>
+#include <gris/graphics/vulkan/texture.h>
+#include <gris/graphics/vulkan/texture_view.h>
+#include <gris/graphics/vulkan/virtual_frame.h>
+
+#include <gris/assert.h>
+
+#include <optional>
+#include <vector>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class DeferredContext;
+
+// Offscreen stand-in for the swap chain, frames are rendered into a ring of color targets
+class RenderTargetRing : public DeviceResource
+{
+public:
+    constexpr static vk::ImageLayout FINAL_LAYOUT = vk::ImageLayout::eTransferSrcOptimal;
+
+    RenderTargetRing();
+
+    RenderTargetRing(
+        const ParentObject<Device> & device,
+        uint32_t width,
+        uint32_t height,
+        vk::Format format,
+        uint32_t imageCount,
+        uint32_t virtualFrameCount);
+
+    RenderTargetRing(const RenderTargetRing &) = delete;
+    RenderTargetRing & operator=(const RenderTargetRing &) = delete;
+
+    RenderTargetRing(RenderTargetRing && other) noexcept;
+    RenderTargetRing & operator=(RenderTargetRing && other) noexcept;
+
+    ~RenderTargetRing() override;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    [[nodiscard]] uint32_t ImageCount() const;
+
+    [[nodiscard]] uint32_t VirtualFrameCount() const;
+
+    [[nodiscard]] const Texture & Image(size_t index) const;
+    [[nodiscard]] Texture & Image(size_t index);
+
+    [[nodiscard]] const TextureView & ImageView(size_t index) const;
+    [[nodiscard]] TextureView & ImageView(size_t index);
+
+    [[nodiscard]] vk::Format Format() const;
+
+    [[nodiscard]] vk::Extent2D Extent() const;
+
+    [[nodiscard]] std::optional<VirtualFrame> NextImage();
+
+    void Submit(DeferredContext & context, const VirtualFrame & virtualFrame);
+
+    // Nothing to present offscreen, kept so frame loops can be shared with the swap chain
+    [[nodiscard]] bool Present(const VirtualFrame & virtualFrame);
+
+    [[nodiscard]] const Fence & RenderingFinishedFence(const VirtualFrame & frame) const
+    {
+        GRIS_FAST_ASSERT(!m_renderFinishedFences.empty(), "Frame fences are not used with timeline semaphores");
+        return m_renderFinishedFences[frame.VirtualFrameIndex];
+    }
+
+    [[nodiscard]] Fence & RenderingFinishedFence(const VirtualFrame & frame)
+    {
+        GRIS_FAST_ASSERT(!m_renderFinishedFences.empty(), "Frame fences are not used with timeline semaphores");
+        return m_renderFinishedFences[frame.VirtualFrameIndex];
+    }
+
+    void Reset();
+
+private:
+    void ReleaseResources();
+
+    std::vector<Texture> m_images = {};
+    std::vector<TextureView> m_imageViews = {};
+
+    vk::Format m_format = {};
+    vk::Extent2D m_extent = {};
+
+    std::vector<Fence> m_renderFinishedFences = {};
+
+    uint32_t m_currentVirtualFrame = 0;
+    uint32_t m_virtualFrameCount = 1;
+    uint32_t m_currentImage = 0;
+    std::vector<uint32_t> m_imageToVirtualFrame = {};
+
+    std::vector<uint64_t> m_virtualFrameTimelineValues = {};
+    std::vector<uint64_t> m_imageTimelineValues = {};
+};
+
+}  // namespace Gris::Graphics::Vulkan
@@ -11,6 +11,7 @@ public:
     Sampler();
 
     Sampler(const ParentObject<Device> & device, float minLod, float maxLod);
+    Sampler(const ParentObject<Device> & device, const vk::SamplerCreateInfo & samplerInfo);
 
     Sampler(const Sampler &) = delete;
     Sampler & operator=(const Sampler &) = delete;
@@ -29,7 +30,12 @@ public:
 
     void Reset();
 
+    // Trilinear filtering with repeat addressing, anisotropic filtering is disabled at 1
+    [[nodiscard]] static vk::SamplerCreateInfo CreateInfo(float minLod, float maxLod, float maxAnisotropy);
+
 private:
+    void CreateSampler(const vk::SamplerCreateInfo & samplerInfo);
+
     void ReleaseResources();
 
     vk::Sampler m_sampler = {};
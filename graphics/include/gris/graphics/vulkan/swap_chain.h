@@ -5,20 +5,18 @@
 #include <gris/graphics/vulkan/fence.h>
 #include <gris/graphics/vulkan/semaphore.h>
 #include <gris/graphics/vulkan/texture_view.h>
+#include <gris/graphics/vulkan/virtual_frame.h>
+
+#include <gris/assert.h>
 
 #include <optional>
 
 namespace Gris::Graphics::Vulkan
 {
 
+class DeferredContext;
 class WindowMixin;
 
-struct VirtualFrame
-{
-    uint32_t VirtualFrameIndex;
-    uint32_t SwapChainImageIndex;
-};
-
 class SwapChain : public DeviceResource
 {
 public:
@@ -52,8 +50,13 @@ public:
 
     [[nodiscard]] uint32_t ImageCount() const;
 
+    // How many images can be acquired and not presented yet without the acquire blocking on the presentation engine
+    [[nodiscard]] uint32_t AcquirableImageCount() const;
+
     [[nodiscard]] uint32_t VirtualFrameCount() const;
 
+    [[nodiscard]] const vk::Image & Image(size_t index) const;
+
     [[nodiscard]] const TextureView & ImageView(size_t index) const;
     [[nodiscard]] TextureView & ImageView(size_t index);
 
@@ -61,17 +64,26 @@ public:
 
     [[nodiscard]] vk::Extent2D Extent() const;
 
+    // Recreates the swap chain images only, the virtual frames and their synchronization objects are kept and the old
+    // swap chain is retired once the frames presenting from it have completed
+    void Resize(const WindowMixin & window, uint32_t width, uint32_t height);
+
     [[nodiscard]] std::optional<VirtualFrame> NextImage();
 
+    // Submits the frame on the graphics queue, tracked by the queue timeline when available and by the frame fence otherwise
+    void Submit(DeferredContext & context, const VirtualFrame & virtualFrame);
+
     [[nodiscard]] bool Present(const VirtualFrame & virtualFrame);
 
     [[nodiscard]] const Fence & RenderingFinishedFence(const VirtualFrame & frame) const
     {
+        GRIS_FAST_ASSERT(!m_renderFinishedFences.empty(), "Frame fences are not used with timeline semaphores");
         return m_renderFinishedFences[frame.VirtualFrameIndex];
     }
 
     [[nodiscard]] Fence & RenderingFinishedFence(const VirtualFrame & frame)
     {
+        GRIS_FAST_ASSERT(!m_renderFinishedFences.empty(), "Frame fences are not used with timeline semaphores");
         return m_renderFinishedFences[frame.VirtualFrameIndex];
     }
 
@@ -103,9 +115,15 @@ private:
         uint32_t width,
         uint32_t height,
         vk::SwapchainKHR oldSwapChain);
+    void CreateSynchronizationObjects();
+    void ResetSwapChainImageTracking();
+
+    void WaitForVirtualFrame(uint32_t virtualFrameIndex);
+    void WaitForSwapChainImage(uint32_t swapChainImageIndex, uint32_t virtualFrameIndex);
 
     vk::SwapchainKHR m_swapChain = {};
     std::vector<vk::Image> m_swapChainImages = {};
+    uint32_t m_minImageCount = 0;
     vk::Queue m_presentQueue = {};
 
     vk::Format m_swapChainImageFormat = {};
@@ -120,6 +138,10 @@ private:
     uint32_t m_currentVirtualFrame = 0;
     uint32_t m_virtualFrameCount = 1;
     std::vector<uint32_t> m_swapChainImageToVirtualFrame = {};
+
+    // Graphics queue timeline values that retire each virtual frame and each swap chain image
+    std::vector<uint64_t> m_virtualFrameTimelineValues = {};
+    std::vector<uint64_t> m_swapChainImageTimelineValues = {};
 };
 
 
@@ -3,9 +3,24 @@
 #include <gris/graphics/vulkan/allocation.h>
 #include <gris/graphics/vulkan/device_resource.h>
 
+#include <vector>
+
 namespace Gris::Graphics::Vulkan
 {
 
+// Layout and the last accesses of a texture subresource, as seen in command recording order
+struct TextureState
+{
+    vk::ImageLayout Layout = vk::ImageLayout::eUndefined;
+    vk::AccessFlags Access = {};
+    vk::PipelineStageFlags Stages = vk::PipelineStageFlagBits::eTopOfPipe;
+
+    // Last write, or layout transition, the reads in Access and Stages were synchronized against. Empty when there is
+    // nothing left for a read to wait on
+    vk::AccessFlags WriteAccess = {};
+    vk::PipelineStageFlags WriteStages = {};
+};
+
 class Texture : public DeviceResource
 {
 public:
@@ -38,9 +53,16 @@ public:
         return m_mipLevels;
     }
 
+    [[nodiscard]] vk::Format Format() const;
+    [[nodiscard]] vk::ImageAspectFlags AspectMask() const;
+
     [[nodiscard]] const vk::Image & ImageHandle() const;
     [[nodiscard]] vk::Image & ImageHandle();
 
+    // Tracked per mip level, updated by the barrier batches that transition the texture
+    [[nodiscard]] const TextureState & SubresourceState(uint32_t mipLevel) const;
+    void SetSubresourceState(uint32_t mipLevel, const TextureState & state);
+
     void Reset();
 
 private:
@@ -50,6 +72,8 @@ private:
     Allocation m_imageMemory = {};
 
     uint32_t m_mipLevels = 1;
+    vk::Format m_format = vk::Format::eUndefined;
+    std::vector<TextureState> m_subresourceStates = {};
 };
 
 }  // namespace Gris::Graphics::Vulkan
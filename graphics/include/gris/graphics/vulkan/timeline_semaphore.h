@@ -0,0 +1,50 @@
+#pragma once
+
+#include <gris/graphics/vulkan/device_resource.h>
+
+#include <cstdint>
+
+namespace Gris::Graphics::Vulkan
+{
+
+class Device;
+
+// Semaphore carrying a monotonically increasing 64-bit value, requires VK_KHR_timeline_semaphore
+class TimelineSemaphore : public DeviceResource
+{
+public:
+    TimelineSemaphore();
+
+    TimelineSemaphore(const ParentObject<Device> & device, uint64_t initialValue);
+
+    TimelineSemaphore(const TimelineSemaphore &) = delete;
+    TimelineSemaphore & operator=(const TimelineSemaphore &) = delete;
+
+    TimelineSemaphore(TimelineSemaphore && other) noexcept;
+    TimelineSemaphore & operator=(TimelineSemaphore && other) noexcept;
+
+    ~TimelineSemaphore() override;
+
+    explicit operator bool() const;
+
+    [[nodiscard]] bool IsValid() const;
+
+    [[nodiscard]] const vk::Semaphore & SemaphoreHandle() const;
+    [[nodiscard]] vk::Semaphore & SemaphoreHandle();
+
+    [[nodiscard]] uint64_t CompletedValue() const;
+
+    // Blocks until the semaphore value is at least the given value
+    void Wait(uint64_t value) const;
+
+    void Signal(uint64_t value);
+
+    void Reset();
+
+private:
+    void ReleaseResources();
+
+    vk::Semaphore m_semaphore = {};
+};
+
+}  // namespace Gris::Graphics::Vulkan
@@ -3,8 +3,13 @@
 #include <gris/graphics/vulkan/vulkan_headers.h>
 
 #include <gris/graphics/image.h>
+#include <gris/graphics/index_format.h>
 
+#include <gris/span.h>
+
+#include <functional>
 #include <optional>
+#include <vector>
 
 namespace Gris::Graphics::Vulkan
 {
@@ -14,10 +19,45 @@ struct DeviceQueueFamilyIndices
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
 
+    // Compute only family, its queues run independently of the graphics queue
+    std::optional<uint32_t> computeFamily;
+    uint32_t computeQueueCount = 0;
+
     [[nodiscard]] bool IsComplete() const
     {
         return graphicsFamily.has_value() && presentFamily.has_value();
     }
+
+    [[nodiscard]] bool IsHeadlessComplete() const
+    {
+        return graphicsFamily.has_value();
+    }
+
+    [[nodiscard]] bool SupportsPresentation() const
+    {
+        return presentFamily.has_value();
+    }
+
+    [[nodiscard]] bool SupportsAsyncCompute() const
+    {
+        return computeFamily.has_value() && computeQueueCount > 0;
+    }
+};
+
+struct DeviceQueueConfiguration
+{
+    float GraphicsPriority = 1.0F;
+
+    // One async compute queue is created per priority, as many as the compute family offers
+    std::vector<float> AsyncComputePriorities = { 1.0F };
+};
+
+// Queue a context submits to, the async compute one falls back to the graphics queue when there is no compute family
+struct QueueSelection
+{
+    uint32_t QueueFamily = 0;
+    uint32_t QueueIndex = 0;
+    bool IsAsync = false;
 };
 
 struct SwapChainSupportDetails
@@ -27,9 +67,27 @@ struct SwapChainSupportDetails
     std::vector<vk::PresentModeKHR> presentModes;
 };
 
+// Graphics and present families are the first ones that support them, the async compute family is the first compute
+// family without graphics. An empty supportsPresentation looks for a headless device, it is only asked about families
+// until the graphics and present families are found.
+[[nodiscard]] DeviceQueueFamilyIndices FindQueueFamilies(Span<const vk::QueueFamilyProperties> queueFamilies, const std::function<bool(uint32_t)> & supportsPresentation);
+
+// One queue per configured priority, as many as the compute family offers
+[[nodiscard]] uint32_t AsyncComputeQueueCount(const DeviceQueueFamilyIndices & queueFamilies, const DeviceQueueConfiguration & configuration);
+
+// Indices past the async compute queues are only valid when there are none, all of them then share the first graphics
+// queue
+[[nodiscard]] QueueSelection SelectAsyncComputeQueue(const DeviceQueueFamilyIndices & queueFamilies, uint32_t asyncComputeQueueCount, uint32_t queueIndex);
+
 [[nodiscard]] SwapChainSupportDetails QuerySwapChainSupport(const vk::PhysicalDevice & physicalDevice,
                                                             const vk::SurfaceKHR & surface);
 
+[[nodiscard]] bool CheckDeviceExtensionSupport(const vk::PhysicalDevice & physicalDevice, Span<const char * const> extensions);
+
 [[nodiscard]] vk::Format ToVulkanFormat(ImageFormat format);
 
+[[nodiscard]] vk::IndexType ToVulkanIndexType(IndexFormat format);
+
+[[nodiscard]] vk::ImageAspectFlags AspectMaskForFormat(vk::Format format);
+
 }  // namespace Gris::Graphics::Vulkan
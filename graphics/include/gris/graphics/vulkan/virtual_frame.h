@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Gris::Graphics::Vulkan
+{
+
+struct VirtualFrame
+{
+    uint32_t VirtualFrameIndex;
+    uint32_t SwapChainImageIndex;
+};
+
+}  // namespace Gris::Graphics::Vulkan
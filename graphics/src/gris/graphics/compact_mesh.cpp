@@ -0,0 +1,112 @@
+#include <gris/graphics/compact_mesh.h>
+
+#include <gris/graphics/scene.h>
+#include <gris/graphics/vertex_kernels.h>
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+// Rewrites each of the first componentCount components of every stride sized element as a fraction of its range,
+// components without extent map to 0 and come back as the offset
+void NormalizeToBounds(std::vector<float> & values, size_t stride, size_t componentCount, float * offset, float * scale)
+{
+    auto const elementCount = values.size() / stride;
+    for (size_t component = 0; component < componentCount; ++component)
+    {
+        auto boundsMin = values[component];
+        auto boundsMax = values[component];
+        for (size_t elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+        {
+            boundsMin = std::min(boundsMin, values[elementIndex * stride + component]);
+            boundsMax = std::max(boundsMax, values[elementIndex * stride + component]);
+        }
+
+        offset[component] = boundsMin;
+        scale[component] = boundsMax - boundsMin;
+
+        auto const inverseScale = scale[component] > 0.0F ? 1.0F / scale[component] : 0.0F;
+        for (size_t elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+        {
+            auto & value = values[elementIndex * stride + component];
+            value = (value - boundsMin) * inverseScale;
+        }
+    }
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::CompactMesh Gris::Graphics::EncodeCompactMesh(Span<const Vertex> vertices, Span<const uint32_t> indices, TextureCoordsEncoding textureCoordsEncoding)
+{
+    constexpr size_t POSITION_STRIDE = std::tuple_size_v<decltype(CompactVertex::Position)>;
+    constexpr size_t TEXTURE_COORDS_STRIDE = std::tuple_size_v<decltype(CompactVertex::TextureCoords)>;
+
+    auto result = CompactMesh{};
+    result.TextureCoordsFormat = textureCoordsEncoding;
+
+    auto const vertexCount = vertices.size();
+    if (vertexCount > 0)
+    {
+        // The pack kernels go from packed floats to packed values, so the attributes are staged in float arrays with
+        // the layout they have in the compact vertex and interleaved at the end
+        auto positions = std::vector<float>(vertexCount * POSITION_STRIDE, 0.0F);
+        CopyVec3(&vertices[0].Position.x, sizeof(Vertex), positions.data(), POSITION_STRIDE * sizeof(float), vertexCount);
+        NormalizeToBounds(positions, POSITION_STRIDE, 3, &result.Dequantization.PositionOffset.x, &result.Dequantization.PositionScale.x);
+
+        auto packedPositions = std::vector<uint16_t>(positions.size());
+        PackUnorm16(positions.data(), packedPositions.data(), positions.size());
+
+        auto textureCoords = std::vector<float>(vertexCount * TEXTURE_COORDS_STRIDE);
+        for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            textureCoords[vertexIndex * TEXTURE_COORDS_STRIDE + 0] = vertices[vertexIndex].TextureCoords.x;
+            textureCoords[vertexIndex * TEXTURE_COORDS_STRIDE + 1] = vertices[vertexIndex].TextureCoords.y;
+        }
+
+        auto packedTextureCoords = std::vector<uint16_t>(textureCoords.size());
+        if (textureCoordsEncoding == TextureCoordsEncoding::Unorm16)
+        {
+            NormalizeToBounds(textureCoords, TEXTURE_COORDS_STRIDE, 2, &result.Dequantization.TextureCoordsOffset.x, &result.Dequantization.TextureCoordsScale.x);
+            PackUnorm16(textureCoords.data(), packedTextureCoords.data(), textureCoords.size());
+        }
+        else
+        {
+            PackHalf(textureCoords.data(), packedTextureCoords.data(), textureCoords.size());
+        }
+
+        result.Vertices.resize(vertexCount);
+        for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            auto & vertex = result.Vertices[vertexIndex];
+            std::memcpy(vertex.Position.data(), &packedPositions[vertexIndex * POSITION_STRIDE], sizeof(vertex.Position));
+            std::memcpy(vertex.TextureCoords.data(), &packedTextureCoords[vertexIndex * TEXTURE_COORDS_STRIDE], sizeof(vertex.TextureCoords));
+        }
+    }
+
+    result.IndexCount = indices.size();
+    if (vertexCount <= MAX_UINT16_INDEXED_VERTEX_COUNT)
+    {
+        result.IndexType = IndexFormat::Uint16;
+        result.IndexData.resize(indices.size() * sizeof(uint16_t));
+        for (size_t indexIndex = 0; indexIndex < indices.size(); ++indexIndex)
+        {
+            auto const index = static_cast<uint16_t>(indices[indexIndex]);
+            std::memcpy(result.IndexData.data() + indexIndex * sizeof(uint16_t), &index, sizeof(index));
+        }
+    }
+    else
+    {
+        result.IndexType = IndexFormat::Uint32;
+        result.IndexData.resize(indices.size() * sizeof(uint32_t));
+        std::memcpy(result.IndexData.data(), indices.data(), result.IndexData.size());
+    }
+
+    return result;
+}
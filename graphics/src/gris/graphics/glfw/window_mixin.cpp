@@ -7,7 +7,9 @@
 #include <GLFW/glfw3.h>
 
 #include <algorithm>
+#include <memory>
 #include <utility>
+#include <variant>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -53,6 +55,7 @@ Gris::Graphics::MouseButtonAction ToAction(int glfwAction)
 Gris::Graphics::Glfw::WindowMixin::WindowMixin(const uint32_t width, const uint32_t height, const std::string & title)
     : m_width(width)
     , m_height(height)
+    , m_inputEvents(std::make_unique<InputEventQueue>())
 {
     Instance::Init();
 
@@ -73,12 +76,12 @@ Gris::Graphics::Glfw::WindowMixin::WindowMixin(const uint32_t width, const uint3
                                    double y = 0.0;
                                    glfwGetCursorPos(window, &x, &y);
 
-                                   windowPtr->OnMouseButtonEvent(ToButton(button), ToAction(action), static_cast<float>(x), static_cast<float>(y));
+                                   windowPtr->OnInputEvent(InputEvent{ glfwGetTime(), MouseButtonInputEvent{ ToButton(button), ToAction(action), static_cast<float>(x), static_cast<float>(y) } });
                                });
     glfwSetCursorPosCallback(m_window, [](GLFWwindow * window, double x, double y)
                              {
                                  auto * windowPtr = static_cast<WindowMixin *>(glfwGetWindowUserPointer(window));
-                                 windowPtr->OnMouseMoveEvent(static_cast<float>(x), static_cast<float>(y));
+                                 windowPtr->OnInputEvent(InputEvent{ glfwGetTime(), MouseMoveInputEvent{ static_cast<float>(x), static_cast<float>(y) } });
                              });
     glfwSetScrollCallback(m_window, [](GLFWwindow * window, double /* xOffset */, double yOffset)
                           {
@@ -88,7 +91,7 @@ Gris::Graphics::Glfw::WindowMixin::WindowMixin(const uint32_t width, const uint3
                               double y = 0.0;
                               glfwGetCursorPos(window, &x, &y);
 
-                              windowPtr->OnMouseWheelEvent(static_cast<float>(x), static_cast<float>(y), static_cast<float>(yOffset));
+                              windowPtr->OnInputEvent(InputEvent{ glfwGetTime(), MouseWheelInputEvent{ static_cast<float>(x), static_cast<float>(y), static_cast<float>(yOffset) } });
                           });
 }
 
@@ -99,6 +102,8 @@ Gris::Graphics::Glfw::WindowMixin::WindowMixin(WindowMixin && other) noexcept
     , m_height(std::exchange(other.m_height, 0))
     , m_window(std::exchange(other.m_window, nullptr))
     , m_observers(std::exchange(other.m_observers, {}))
+    , m_inputEvents(std::exchange(other.m_inputEvents, {}))
+    , m_dispatchedInputEvents(std::exchange(other.m_dispatchedInputEvents, {}))
 {
     glfwSetWindowUserPointer(m_window, this);
 }
@@ -113,6 +118,8 @@ Gris::Graphics::Glfw::WindowMixin & Gris::Graphics::Glfw::WindowMixin::operator=
         m_height = std::exchange(other.m_height, 0);
         m_window = std::exchange(other.m_window, nullptr);
         m_observers = std::exchange(other.m_observers, {});
+        m_inputEvents = std::exchange(other.m_inputEvents, {});
+        m_dispatchedInputEvents = std::exchange(other.m_dispatchedInputEvents, {});
 
         glfwSetWindowUserPointer(m_window, this);
     }
@@ -175,47 +182,80 @@ void Gris::Graphics::Glfw::WindowMixin::RemoveObserver(WindowObserver * observer
 
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] const GLFWwindow * Gris::Graphics::Glfw::WindowMixin::WindowHandle() const
+void Gris::Graphics::Glfw::WindowMixin::DispatchInputEvents()
 {
-    return m_window;
+    m_dispatchedInputEvents.clear();
+    ConsumeInputEvents(m_dispatchedInputEvents);
+    DispatchInputEvents(m_dispatchedInputEvents);
 }
 
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] GLFWwindow * Gris::Graphics::Glfw::WindowMixin::WindowHandle()
+void Gris::Graphics::Glfw::WindowMixin::ConsumeInputEvents(std::vector<InputEvent> & events)
 {
-    return m_window;
+    if (m_inputEvents)
+    {
+        m_inputEvents->Consume(events);
+    }
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Glfw::WindowMixin::OnSizeChanged(uint32_t width, uint32_t height)
+void Gris::Graphics::Glfw::WindowMixin::DispatchInputEvents(const std::vector<InputEvent> & events)
 {
-    m_width = width;
-    m_height = height;
+    for (auto const & event : events)
+    {
+        if (auto const * const buttonEvent = std::get_if<MouseButtonInputEvent>(&event.Data))
+        {
+            NotifyMouseButtonEvent(buttonEvent->Button, buttonEvent->Action, buttonEvent->X, buttonEvent->Y);
+        }
+        else if (auto const * const moveEvent = std::get_if<MouseMoveInputEvent>(&event.Data))
+        {
+            NotifyMouseMoveEvent(moveEvent->X, moveEvent->Y);
+        }
+        else if (auto const * const wheelEvent = std::get_if<MouseWheelInputEvent>(&event.Data))
+        {
+            NotifyMouseWheelEvent(wheelEvent->X, wheelEvent->Y, wheelEvent->Delta);
+        }
+    }
+}
 
-    NotifySizeChanged();
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Glfw::WindowMixin::DroppedInputEventCount() const
+{
+    return m_inputEvents ? m_inputEvents->DroppedEventCount() : 0;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Glfw::WindowMixin::OnMouseButtonEvent(MouseButton button, MouseButtonAction action, float x, float y)
+[[nodiscard]] const GLFWwindow * Gris::Graphics::Glfw::WindowMixin::WindowHandle() const
 {
-    NotifyMouseButtonEvent(button, action, x, y);
+    return m_window;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Glfw::WindowMixin::OnMouseMoveEvent(float x, float y)
+[[nodiscard]] GLFWwindow * Gris::Graphics::Glfw::WindowMixin::WindowHandle()
 {
-    NotifyMouseMoveEvent(x, y);
+    return m_window;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Glfw::WindowMixin::OnSizeChanged(uint32_t width, uint32_t height)
+{
+    m_width = width;
+    m_height = height;
+
+    NotifySizeChanged();
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Glfw::WindowMixin::OnMouseWheelEvent(float x, float y, float delta)
+void Gris::Graphics::Glfw::WindowMixin::OnInputEvent(const InputEvent & event)
 {
-    NotifyMouseWheelEvent(x, y, delta);
+    m_inputEvents->Push(event);
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -0,0 +1,8 @@
+#include <gris/graphics/index_format.h>
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::IndexSize(IndexFormat format)
+{
+    return format == IndexFormat::Uint16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
@@ -0,0 +1,94 @@
+#include <gris/graphics/input_event_queue.h>
+
+#include <gris/assert.h>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+// Folds the event into the last consumed one when nothing but the newest state or the sum matters
+[[nodiscard]] bool Coalesce(Gris::Graphics::InputEvent & last, const Gris::Graphics::InputEvent & event)
+{
+    if (std::holds_alternative<Gris::Graphics::MouseMoveInputEvent>(last.Data) && std::holds_alternative<Gris::Graphics::MouseMoveInputEvent>(event.Data))
+    {
+        last = event;
+        return true;
+    }
+
+    auto * const lastWheel = std::get_if<Gris::Graphics::MouseWheelInputEvent>(&last.Data);
+    auto const * const wheel = std::get_if<Gris::Graphics::MouseWheelInputEvent>(&event.Data);
+    if (lastWheel != nullptr && wheel != nullptr)
+    {
+        last.Timestamp = event.Timestamp;
+        lastWheel->X = wheel->X;
+        lastWheel->Y = wheel->Y;
+        lastWheel->Delta += wheel->Delta;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::InputEventQueue::InputEventQueue(size_t capacity)
+    : m_events(capacity)
+    , m_mask(capacity - 1)
+{
+    GRIS_ALWAYS_ASSERT(capacity > 0 && (capacity & m_mask) == 0, "Input event queue capacity has to be a power of two");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Gris::Graphics::InputEventQueue::Push(const InputEvent & event)
+{
+    auto const writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    if (writeIndex - m_readIndex.load(std::memory_order_acquire) == m_events.size())
+    {
+        m_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_events[writeIndex & m_mask] = event;
+    m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::InputEventQueue::Consume(std::vector<InputEvent> & events)
+{
+    auto const firstConsumed = events.size();
+    auto const writeIndex = m_writeIndex.load(std::memory_order_acquire);
+    auto readIndex = m_readIndex.load(std::memory_order_relaxed);
+    for (; readIndex != writeIndex; ++readIndex)
+    {
+        auto const & event = m_events[readIndex & m_mask];
+        if (events.size() > firstConsumed && Coalesce(events.back(), event))
+        {
+            continue;
+        }
+
+        events.emplace_back(event);
+    }
+
+    // The slots can only be reused once they were copied out
+    m_readIndex.store(readIndex, std::memory_order_release);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::InputEventQueue::Capacity() const
+{
+    return m_events.size();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::InputEventQueue::DroppedEventCount() const
+{
+    return m_droppedEventCount.load(std::memory_order_relaxed);
+}
@@ -1,10 +1,18 @@
 #include <gris/graphics/loaders/assimp_mesh_loader.h>
 
+#include <gris/graphics/loaders/gmesh_file.h>
+#include <gris/graphics/loaders/gmesh_writer.h>
+#include <gris/graphics/mesh_optimizer.h>
+#include <gris/graphics/meshlet_builder.h>
 #include <gris/graphics/scene.h>
+#include <gris/graphics/vertex_kernels.h>
 
+#include <gris/derived_data_cache.h>
 #include <gris/directory_registry.h>
 #include <gris/engine_exception.h>
 #include <gris/log.h>
+#include <gris/mapped_file.h>
+#include <gris/parallel_for.h>
 #include <gris/span.h>
 #include <gris/utils.h>
 
@@ -12,6 +20,11 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <type_traits>
+
 // -------------------------------------------------------------------------------------------------
 
 constexpr static unsigned int DEFAULT_ASSIMP_FLAGS = static_cast<unsigned int>(aiProcess_Triangulate)
@@ -19,26 +32,170 @@ constexpr static unsigned int DEFAULT_ASSIMP_FLAGS = static_cast<unsigned int>(a
                                                      | static_cast<unsigned int>(aiProcess_CalcTangentSpace)
                                                      | static_cast<unsigned int>(aiProcess_GenSmoothNormals)
                                                      | static_cast<unsigned int>(aiProcess_JoinIdenticalVertices)
-                                                     | static_cast<unsigned int>(aiProcess_FlipWindingOrder)
-                                                     | static_cast<unsigned int>(aiProcess_ImproveCacheLocality);
+                                                     | static_cast<unsigned int>(aiProcess_FlipWindingOrder);
 
+// -------------------------------------------------------------------------------------------------
 
 namespace
 {
 
+// Bump whenever the meshes or materials converted from the same file change, cached results of older versions are
+// then never looked up again and age out of the cache
+constexpr uint32_t ASSIMP_MESH_LOADER_VERSION = 4;
+
+static_assert(std::is_same_v<ai_real, float>, "The vertex kernels read Assimp vectors as floats");
+
+// -------------------------------------------------------------------------------------------------
+
+struct SceneDeleter
+{
+    void operator()(const aiScene * scene) const
+    {
+        aiReleaseImport(scene);
+    }
+};
+
+using ScenePointer = std::unique_ptr<const aiScene, SceneDeleter>;
+
+// -------------------------------------------------------------------------------------------------
+
+// Keeps the stream attached until the import, or the exception that ended it, is done with
+class ScopedLogStream
+{
+public:
+    explicit ScopedLogStream(aiLogStream stream)
+        : m_stream(stream)
+    {
+        aiAttachLogStream(&m_stream);
+    }
+
+    ScopedLogStream(const ScopedLogStream &) = delete;
+    ScopedLogStream & operator=(const ScopedLogStream &) = delete;
+
+    ScopedLogStream(ScopedLogStream &&) = delete;
+    ScopedLogStream & operator=(ScopedLogStream &&) = delete;
+
+    ~ScopedLogStream()
+    {
+        aiDetachLogStream(&m_stream);
+    }
+
+private:
+    aiLogStream m_stream = {};
+};
+
+// -------------------------------------------------------------------------------------------------
+
 std::filesystem::path SanitizePath(const std::filesystem::path & path)
 {
     return path.relative_path();
 }
 
-}  // namespace
+// -------------------------------------------------------------------------------------------------
+
+std::vector<std::filesystem::path> ConvertTexturePaths(const aiMaterial & material, aiTextureType textureType)
+{
+    auto const textureCount = material.GetTextureCount(textureType);
+    auto result = Gris::MakeReservedVector<std::filesystem::path>(textureCount);
+    for (unsigned textureIndex = 0; textureIndex < textureCount; ++textureIndex)
+    {
+        auto assimpTexturePath = aiString{};
+        material.GetTexture(textureType, textureIndex, &assimpTexturePath);
+        result.emplace_back(SanitizePath(assimpTexturePath.C_Str()));
+    }
+
+    return result;
+}
 
 // -------------------------------------------------------------------------------------------------
 
-std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::MaterialBlueprint>> Gris::Graphics::Loaders::AssimpMeshLoader::Load(const std::filesystem::path & path)
+Gris::Graphics::MaterialBlueprint ConvertMaterial(const aiMaterial & currentMaterial)
+{
+    auto material = Gris::Graphics::MaterialBlueprint{};
+    material.DiffuseTextures = ConvertTexturePaths(currentMaterial, aiTextureType_DIFFUSE);
+    material.SpecularTextures = ConvertTexturePaths(currentMaterial, aiTextureType_SPECULAR);
+    material.NormalTextures = ConvertTexturePaths(currentMaterial, aiTextureType_NORMALS);
+
+    aiString name;
+    currentMaterial.Get(AI_MATKEY_NAME, name);
+    material.Name = name.C_Str();
+
+    return material;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Mesh ConvertMesh(const aiMesh & currentMesh)
 {
-    static const aiVector3D ZERO_VECTOR(0.0F, 0.0F, 0.0F);
+    auto mesh = Gris::Graphics::Mesh{};
+
+    // Sized up front and written in place, there is one vertex per Assimp vertex and at most three indices per face
+    mesh.Vertices.resize(currentMesh.mNumVertices);
 
+    auto const vertexCount = static_cast<size_t>(currentMesh.mNumVertices);
+    if (vertexCount > 0)
+    {
+        // Only the attributes of the mesh vertex format are written, one strided pass each
+        auto & firstVertex = mesh.Vertices.front();
+        auto const writeAttribute = [&](auto attribute)
+        {
+            using Attribute = decltype(attribute);
+            auto * const destination = Gris::Graphics::MeshVertexFormat::Data<Attribute>(firstVertex);
+            if constexpr (std::is_same_v<Attribute, Gris::Graphics::PositionAttribute>)
+            {
+                Gris::Graphics::CopyVec3(&currentMesh.mVertices[0].x, sizeof(aiVector3D), destination, sizeof(Gris::Graphics::Vertex), vertexCount);
+            }
+            else if constexpr (std::is_same_v<Attribute, Gris::Graphics::ColorAttribute>)
+            {
+                Gris::Graphics::FillVec3(1.0F, 1.0F, 1.0F, destination, sizeof(Gris::Graphics::Vertex), vertexCount);
+            }
+            else if constexpr (std::is_same_v<Attribute, Gris::Graphics::TextureCoordsAttribute>)
+            {
+                if (currentMesh.HasTextureCoords(0))
+                {
+                    Gris::Graphics::CopyFlippedUv(&currentMesh.mTextureCoords[0][0].x, sizeof(aiVector3D), destination, sizeof(Gris::Graphics::Vertex), vertexCount);
+                }
+                else
+                {
+                    Gris::Graphics::FillVec2(0.0F, 1.0F, destination, sizeof(Gris::Graphics::Vertex), vertexCount);
+                }
+            }
+            else
+            {
+                static_assert(Gris::Graphics::UNSUPPORTED_VERTEX_ATTRIBUTE<Attribute>, "The loader cannot produce the attribute");
+            }
+        };
+        Gris::Graphics::MeshVertexFormat::ForEachAttribute(writeAttribute);
+    }
+
+    mesh.Indices.resize(static_cast<size_t>(currentMesh.mNumFaces) * 3);
+
+    size_t indexCount = 0;
+    auto const faces = Gris::Span<const aiFace>(currentMesh.mFaces, currentMesh.mNumFaces);
+    for (const auto & face : faces)
+    {
+        // Points and lines survive the triangulation, they are not rendered
+        if (face.mNumIndices != 3)
+        {
+            continue;
+        }
+
+        mesh.Indices[indexCount++] = face.mIndices[0];
+        mesh.Indices[indexCount++] = face.mIndices[1];
+        mesh.Indices[indexCount++] = face.mIndices[2];
+    }
+
+    mesh.Indices.resize(indexCount);
+
+    mesh.MaterialIndex = currentMesh.mMaterialIndex;
+
+    return mesh;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::MaterialBlueprint>> Import(const std::filesystem::path & path)
+{
     aiLogStream grisLoggerStream = {};
     grisLoggerStream.callback = [](const char * message, char * /* user */)
     {
@@ -47,103 +204,105 @@ std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::Materi
         {
             stringMessage = stringMessage.substr(0, stringMessage.size() - 1);
         }
-        Log::Debug("[AssimpMeshLoader] {}", stringMessage);
+        Gris::Log::Debug("[AssimpMeshLoader] {}", stringMessage);
     };
 
-    aiAttachLogStream(&grisLoggerStream);
+    auto const logStream = ScopedLogStream(grisLoggerStream);
+
+    auto const importStart = std::chrono::steady_clock::now();
 
-    auto const * scene = aiImportFile(path.string().c_str(), DEFAULT_ASSIMP_FLAGS);
+    auto scene = ScenePointer(aiImportFile(path.string().c_str(), DEFAULT_ASSIMP_FLAGS));
 
-    if (scene == nullptr)
+    if (!scene)
     {
-        throw EngineException("Error loading model", aiGetErrorString());
+        throw Gris::EngineException("Error loading model", aiGetErrorString());
     }
 
-    auto resultMaterials = MakeReservedVector<MaterialBlueprint>(scene->mNumMaterials);
-    auto materials = Gris::Span<aiMaterial *>(scene->mMaterials, scene->mNumMaterials);
-    for (const auto & currentMaterial : materials)
+    auto const conversionStart = std::chrono::steady_clock::now();
+
+    // The scene is only read from here on, every mesh and material converts into its own slot so the output order
+    // matches the file whatever the scheduling
+    auto const materials = Gris::Span<aiMaterial *>(scene->mMaterials, scene->mNumMaterials);
+    auto resultMaterials = std::vector<Gris::Graphics::MaterialBlueprint>(materials.size());
+    Gris::ParallelFor(materials.size(), [&materials, &resultMaterials](size_t materialIndex)
+                      { resultMaterials[materialIndex] = ConvertMaterial(*materials[materialIndex]); });
+
+    auto const meshes = Gris::Span<aiMesh *>(scene->mMeshes, scene->mNumMeshes);
+    auto resultMeshes = std::vector<Gris::Graphics::Mesh>(meshes.size());
+    auto reports = std::vector<Gris::Graphics::MeshOptimizationReport>(meshes.size());
+    Gris::ParallelFor(meshes.size(),
+                      [&meshes, &resultMeshes, &reports](size_t meshIndex)
+                      {
+                          auto & mesh = resultMeshes[meshIndex];
+                          mesh = ConvertMesh(*meshes[meshIndex]);
+                          reports[meshIndex] = Gris::Graphics::OptimizeMesh(mesh);
+                          Gris::Graphics::BuildMeshlets(mesh);
+                      });
+
+    auto const conversionEnd = std::chrono::steady_clock::now();
+
+    scene.reset();
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    Gris::Log::Info("[AssimpMeshLoader] Loaded {} meshes and {} materials from {}, import {:.2f} ms, conversion {:.2f} ms",
+                    resultMeshes.size(),
+                    resultMaterials.size(),
+                    path.string(),
+                    Milliseconds(conversionStart - importStart).count(),
+                    Milliseconds(conversionEnd - conversionStart).count());
+
+    auto report = Gris::Graphics::MeshOptimizationReport{};
+    for (auto const & meshReport : reports)
     {
-        MaterialBlueprint material;
+        report += meshReport;
+    }
 
-        auto diffuseTextureCount = currentMaterial->GetTextureCount(aiTextureType_DIFFUSE);
-        material.DiffuseTextures = MakeReservedVector<std::filesystem::path>(diffuseTextureCount);
-        for (unsigned textureIndex = 0; textureIndex < diffuseTextureCount; ++textureIndex)
-        {
-            auto assimpTexturePath = aiString{};
-            currentMaterial->GetTexture(aiTextureType_DIFFUSE, textureIndex, &assimpTexturePath);
-            material.DiffuseTextures.emplace_back(SanitizePath(assimpTexturePath.C_Str()));
-        }
+    Gris::Log::Info("[AssimpMeshLoader] Optimized {} triangles, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, removed {} degenerate triangles and {} unused vertices",
+                    report.After.TriangleCount,
+                    report.Before.Acmr(),
+                    report.After.Acmr(),
+                    report.Before.Atvr(),
+                    report.After.Atvr(),
+                    report.RemovedTriangleCount,
+                    report.RemovedVertexCount);
 
-        auto specularTextureCount = currentMaterial->GetTextureCount(aiTextureType_SPECULAR);
-        material.SpecularTextures = MakeReservedVector<std::filesystem::path>(specularTextureCount);
-        for (unsigned textureIndex = 0; textureIndex < specularTextureCount; ++textureIndex)
-        {
-            auto assimpTexturePath = aiString{};
-            currentMaterial->GetTexture(aiTextureType_SPECULAR, textureIndex, &assimpTexturePath);
-            material.SpecularTextures.emplace_back(SanitizePath(assimpTexturePath.C_Str()));
-        }
+    return { std::move(resultMeshes), std::move(resultMaterials) };
+}
 
-        auto normalTextureCount = currentMaterial->GetTextureCount(aiTextureType_NORMALS);
-        material.NormalTextures = MakeReservedVector<std::filesystem::path>(normalTextureCount);
-        for (unsigned textureIndex = 0; textureIndex < normalTextureCount; ++textureIndex)
-        {
-            auto assimpTexturePath = aiString{};
-            currentMaterial->GetTexture(aiTextureType_NORMALS, textureIndex, &assimpTexturePath);
-            material.NormalTextures.emplace_back(SanitizePath(assimpTexturePath.C_Str()));
-        }
+}  // namespace
 
-        aiString name;
-        currentMaterial->Get(AI_MATKEY_NAME, name);
-        material.Name = name.C_Str();
+// -------------------------------------------------------------------------------------------------
 
-        resultMaterials.emplace_back(std::move(material));
-    }
+std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::MaterialBlueprint>> Gris::Graphics::Loaders::AssimpMeshLoader::Load(const std::filesystem::path & path)
+{
+    // Only the file itself is hashed, files it references such as OBJ material libraries do not invalidate the result
+    auto const & cache = DerivedDataCache::Default();
+    auto const key = DerivedDataCache::MakeKey("AssimpMeshLoader", ASSIMP_MESH_LOADER_VERSION, std::to_string(DEFAULT_ASSIMP_FLAGS), MappedFile(path).Data());
 
-    auto resultMeshes = MakeReservedVector<Mesh>(scene->mNumMeshes);
-    auto meshes = Gris::Span<aiMesh *>(scene->mMeshes, scene->mNumMeshes);
-    for (const auto & currentMesh : meshes)
+    if (auto const entryPath = cache.Find(key))
     {
-        auto mesh = Mesh{};
-
-        auto vertices = Gris::Span<aiVector3D>(currentMesh->mVertices, currentMesh->mNumVertices);
-        auto textureCoords0 = Gris::Span<aiVector3D>(currentMesh->mTextureCoords[0], currentMesh->mNumVertices);
-        for (size_t vertexIndex = 0; vertexIndex < currentMesh->mNumVertices; ++vertexIndex)
+        try
         {
-            auto vertex = Vertex{};
-
-            auto const & position = vertices[vertexIndex];
-            vertex.Position = { position.x, position.y, position.z };
-
-            auto const & texCoordinates = currentMesh->HasTextureCoords(0) ? textureCoords0[vertexIndex] : ZERO_VECTOR;
-            vertex.TextureCoords = { texCoordinates.x, 1.0F - texCoordinates.y };
-
-            vertex.Color = { 1.0F, 1.0F, 1.0F };
-
-            mesh.Vertices.emplace_back(vertex);
+            auto result = GmeshFile(*entryPath).ReadAll();
+            Log::Info("[AssimpMeshLoader] Loaded {} from derived data {}", path.string(), key);
+            return result;
         }
-
-        auto faces = Gris::Span<aiFace>(currentMesh->mFaces, currentMesh->mNumFaces);
-        for (const auto & face : faces)
+        catch (const EngineException & e)
         {
-            auto indices = Gris::Span<unsigned int>(face.mIndices, face.mNumIndices);
-
-            if (indices.size() != 3)
-            {
-                continue;
-            }
-
-            mesh.Indices.emplace_back(indices[0]);
-            mesh.Indices.emplace_back(indices[1]);
-            mesh.Indices.emplace_back(indices[2]);
+            Log::Warning("[AssimpMeshLoader] Ignoring derived data {}: {}", key, e.what());
         }
+    }
 
-        mesh.MaterialIndex = currentMesh->mMaterialIndex;
+    auto result = Import(path);
 
-        resultMeshes.emplace_back(std::move(mesh));
+    try
+    {
+        cache.Store(key, [&result](const std::filesystem::path & entryPath) { GmeshWriter::Write(entryPath, std::get<0>(result), std::get<1>(result)); });
+    }
+    catch (const EngineException & e)
+    {
+        Log::Warning("[AssimpMeshLoader] Failed to store derived data {}: {}", key, e.what());
     }
 
-    aiReleaseImport(scene);
-    aiDetachLogStream(&grisLoggerStream);
-
-    return { resultMeshes, resultMaterials };
+    return result;
 }
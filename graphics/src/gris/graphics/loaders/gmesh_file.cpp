@@ -0,0 +1,328 @@
+#include <gris/graphics/loaders/gmesh_file.h>
+
+#include <gris/graphics/scene.h>
+
+#include <gris/assert.h>
+#include <gris/engine_exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+void ValidateRange(Gris::Span<const std::byte> data, uint64_t offset, uint64_t byteSize, uint64_t alignment, const char * what)
+{
+    if (offset % alignment != 0 || offset > data.size() || byteSize > data.size() - offset)
+    {
+        throw Gris::EngineException("Error opening gmesh file", what);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Opening only checks the blobs fit in the file, what they reference is checked once they are copied out
+void ValidateMeshContents(const Gris::Graphics::Mesh & mesh)
+{
+    auto const vertexCount = mesh.Vertices.size();
+    if (std::any_of(mesh.Indices.begin(), mesh.Indices.end(), [vertexCount](uint32_t index)
+                    { return index >= vertexCount; }))
+    {
+        throw Gris::EngineException("Error reading gmesh mesh", "Index out of range");
+    }
+
+    if (std::any_of(mesh.MeshletVertices.begin(), mesh.MeshletVertices.end(), [vertexCount](uint32_t index)
+                    { return index >= vertexCount; }))
+    {
+        throw Gris::EngineException("Error reading gmesh mesh", "Meshlet vertex out of range");
+    }
+
+    for (auto const & meshlet : mesh.Meshlets)
+    {
+        auto const vertexEnd = static_cast<uint64_t>(meshlet.VertexOffset) + meshlet.VertexCount;
+        auto const localIndexEnd = static_cast<uint64_t>(meshlet.LocalIndexOffset) + static_cast<uint64_t>(meshlet.TriangleCount) * 3;
+        if (vertexEnd > mesh.MeshletVertices.size() || localIndexEnd > mesh.MeshletTriangles.size())
+        {
+            throw Gris::EngineException("Error reading gmesh mesh", "Meshlet range out of range");
+        }
+
+        auto const localIndicesBegin = mesh.MeshletTriangles.begin() + meshlet.LocalIndexOffset;
+        if (std::any_of(localIndicesBegin, localIndicesBegin + static_cast<ptrdiff_t>(meshlet.TriangleCount) * 3, [&meshlet](uint8_t localIndex)
+                        { return localIndex >= meshlet.VertexCount; }))
+        {
+            throw Gris::EngineException("Error reading gmesh mesh", "Meshlet local index out of range");
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Reads the material blob front to back, every read is bounds checked since the contents are not validated on open
+class MaterialReader
+{
+public:
+    explicit MaterialReader(Gris::Span<const std::byte> data)
+        : m_data(data)
+    {
+    }
+
+    [[nodiscard]] uint32_t ReadCount()
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, Take(sizeof(value)).data(), sizeof(value));
+        return value;
+    }
+
+    [[nodiscard]] std::string ReadString()
+    {
+        auto const bytes = Take(ReadCount());
+        return std::string(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+
+    [[nodiscard]] std::vector<std::filesystem::path> ReadPaths()
+    {
+        auto const count = ReadCount();
+        auto result = std::vector<std::filesystem::path>{};
+        for (uint32_t pathIndex = 0; pathIndex < count; ++pathIndex)
+        {
+            result.emplace_back(std::filesystem::u8path(ReadString()));
+        }
+        return result;
+    }
+
+private:
+    [[nodiscard]] Gris::Span<const std::byte> Take(size_t byteCount)
+    {
+        if (byteCount > m_data.size() - m_position)
+        {
+            throw Gris::EngineException("Error reading gmesh material", "Truncated material blob");
+        }
+
+        auto const result = m_data.subspan(m_position, byteCount);
+        m_position += byteCount;
+        return result;
+    }
+
+    Gris::Span<const std::byte> m_data;
+    size_t m_position = 0;
+};
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Loaders::GmeshFile::GmeshFile(const std::filesystem::path & path)
+    : m_file(path)
+{
+    auto const data = m_file.Data();
+    if (data.size() < sizeof(GmeshHeader))
+    {
+        throw EngineException("Error opening gmesh file", "File too small", path.string());
+    }
+
+    // The mapping is page aligned, so the header and the tables are suitably aligned wherever the offsets allow it
+    auto const & header = *reinterpret_cast<const GmeshHeader *>(data.data());
+
+    // A big endian reader sees the magic byte swapped and rejects the file here
+    if (header.Magic != GMESH_MAGIC)
+    {
+        throw EngineException("Error opening gmesh file", "Bad magic", path.string());
+    }
+
+    if (header.Version != GMESH_VERSION)
+    {
+        throw EngineException("Error opening gmesh file", "Unsupported version " + std::to_string(header.Version), path.string());
+    }
+
+    if (header.VertexStride != sizeof(Vertex) || header.MeshletStride != sizeof(Meshlet))
+    {
+        throw EngineException("Error opening gmesh file", "Vertex or meshlet layout mismatch", path.string());
+    }
+
+    if (header.FileSize != data.size())
+    {
+        throw EngineException("Error opening gmesh file", "Size mismatch", path.string());
+    }
+
+    ValidateRange(data, header.MeshTableOffset, static_cast<uint64_t>(header.MeshCount) * sizeof(GmeshMeshRecord), alignof(GmeshMeshRecord), "Mesh table out of range");
+    ValidateRange(data, header.MaterialTableOffset, static_cast<uint64_t>(header.MaterialCount) * sizeof(GmeshMaterialRecord), alignof(GmeshMaterialRecord), "Material table out of range");
+
+    m_meshes = Span<const GmeshMeshRecord>(reinterpret_cast<const GmeshMeshRecord *>(data.data() + header.MeshTableOffset), header.MeshCount);
+    m_materials = Span<const GmeshMaterialRecord>(reinterpret_cast<const GmeshMaterialRecord *>(data.data() + header.MaterialTableOffset), header.MaterialCount);
+
+    for (auto const & mesh : m_meshes)
+    {
+        if (mesh.VertexCount > data.size() / sizeof(Vertex) || mesh.MeshletCount > data.size() / sizeof(Meshlet) || mesh.MeshletVertexCount > data.size() / sizeof(uint32_t))
+        {
+            throw EngineException("Error opening gmesh file", "Element count out of range", path.string());
+        }
+
+        ValidateRange(data, mesh.VertexOffset, mesh.VertexCount * sizeof(Vertex), alignof(Vertex), "Vertex blob out of range");
+        ValidateRange(data, mesh.IndexOffset, mesh.IndexByteSize, alignof(uint32_t), "Index blob out of range");
+        ValidateRange(data, mesh.MeshletOffset, mesh.MeshletCount * sizeof(Meshlet), alignof(Meshlet), "Meshlet blob out of range");
+        ValidateRange(data, mesh.MeshletVertexOffset, mesh.MeshletVertexCount * sizeof(uint32_t), alignof(uint32_t), "Meshlet vertex blob out of range");
+        ValidateRange(data, mesh.MeshletTriangleOffset, mesh.MeshletTriangleByteSize, 1, "Meshlet triangle blob out of range");
+
+        // Every encoded index takes at least a byte, which also bounds what decoding will allocate
+        auto const validEncoding = (mesh.IndexEncoding == GmeshIndexEncoding::Raw && mesh.IndexCount <= mesh.IndexByteSize / sizeof(uint32_t) && mesh.IndexByteSize == mesh.IndexCount * sizeof(uint32_t))
+                                   || (mesh.IndexEncoding == GmeshIndexEncoding::DeltaVarint && mesh.IndexCount <= mesh.IndexByteSize);
+        if (!validEncoding)
+        {
+            throw EngineException("Error opening gmesh file", "Bad index encoding", path.string());
+        }
+
+        if (mesh.MaterialIndex >= header.MaterialCount && header.MaterialCount > 0)
+        {
+            throw EngineException("Error opening gmesh file", "Material index out of range", path.string());
+        }
+    }
+
+    for (auto const & material : m_materials)
+    {
+        ValidateRange(data, material.Offset, material.ByteSize, 1, "Material blob out of range");
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Loaders::GmeshFile::GmeshFile(GmeshFile && other) noexcept
+    : m_file(std::move(other.m_file))
+    , m_meshes(std::exchange(other.m_meshes, {}))
+    , m_materials(std::exchange(other.m_materials, {}))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Loaders::GmeshFile & Gris::Graphics::Loaders::GmeshFile::operator=(GmeshFile && other) noexcept
+{
+    if (this != &other)
+    {
+        m_file = std::move(other.m_file);
+        m_meshes = std::exchange(other.m_meshes, {});
+        m_materials = std::exchange(other.m_materials, {});
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Loaders::GmeshFile::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Loaders::GmeshFile::IsValid() const
+{
+    return m_file.IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::Loaders::GmeshFile::MeshCount() const
+{
+    return m_meshes.size();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Loaders::GmeshMeshView Gris::Graphics::Loaders::GmeshFile::MeshView(size_t meshIndex) const
+{
+    GRIS_FAST_ASSERT(meshIndex < m_meshes.size(), "Mesh index out of range");
+
+    auto const data = m_file.Data();
+    auto const & mesh = m_meshes[meshIndex];
+
+    auto result = GmeshMeshView{};
+    result.Vertices = Span<const Vertex>(reinterpret_cast<const Vertex *>(data.data() + mesh.VertexOffset), static_cast<size_t>(mesh.VertexCount));
+    result.EncodedIndices = data.subspan(static_cast<size_t>(mesh.IndexOffset), static_cast<size_t>(mesh.IndexByteSize));
+    if (mesh.IndexEncoding == GmeshIndexEncoding::Raw)
+    {
+        result.Indices = Span<const uint32_t>(reinterpret_cast<const uint32_t *>(result.EncodedIndices.data()), static_cast<size_t>(mesh.IndexCount));
+    }
+    result.IndexEncoding = mesh.IndexEncoding;
+    result.IndexCount = static_cast<size_t>(mesh.IndexCount);
+    result.MaterialIndex = mesh.MaterialIndex;
+    result.BoundsMin = glm::vec3(mesh.BoundsMin[0], mesh.BoundsMin[1], mesh.BoundsMin[2]);
+    result.BoundsMax = glm::vec3(mesh.BoundsMax[0], mesh.BoundsMax[1], mesh.BoundsMax[2]);
+    result.Meshlets = Span<const Meshlet>(reinterpret_cast<const Meshlet *>(data.data() + mesh.MeshletOffset), static_cast<size_t>(mesh.MeshletCount));
+    result.MeshletVertices = Span<const uint32_t>(reinterpret_cast<const uint32_t *>(data.data() + mesh.MeshletVertexOffset), static_cast<size_t>(mesh.MeshletVertexCount));
+    result.MeshletTriangles = Span<const uint8_t>(reinterpret_cast<const uint8_t *>(data.data() + mesh.MeshletTriangleOffset), static_cast<size_t>(mesh.MeshletTriangleByteSize));
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Loaders::GmeshFile::ReadIndices(size_t meshIndex, std::vector<uint32_t> & indices) const
+{
+    auto const mesh = MeshView(meshIndex);
+    if (mesh.IndexEncoding == GmeshIndexEncoding::Raw)
+    {
+        indices.insert(indices.end(), mesh.Indices.begin(), mesh.Indices.end());
+        return;
+    }
+
+    DecodeGmeshIndices(mesh.EncodedIndices, mesh.IndexCount, indices);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::vector<Gris::Graphics::MaterialBlueprint> Gris::Graphics::Loaders::GmeshFile::ReadMaterials() const
+{
+    auto const data = m_file.Data();
+
+    auto result = std::vector<MaterialBlueprint>{};
+    result.reserve(m_materials.size());
+    for (auto const & material : m_materials)
+    {
+        auto reader = MaterialReader(data.subspan(static_cast<size_t>(material.Offset), static_cast<size_t>(material.ByteSize)));
+
+        auto & blueprint = result.emplace_back();
+        blueprint.Name = reader.ReadString();
+        blueprint.DiffuseTextures = reader.ReadPaths();
+        blueprint.SpecularTextures = reader.ReadPaths();
+        blueprint.NormalTextures = reader.ReadPaths();
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::MaterialBlueprint>> Gris::Graphics::Loaders::GmeshFile::ReadAll() const
+{
+    auto meshes = std::vector<Mesh>(m_meshes.size());
+    for (size_t meshIndex = 0; meshIndex < m_meshes.size(); ++meshIndex)
+    {
+        auto const view = MeshView(meshIndex);
+
+        auto & mesh = meshes[meshIndex];
+        mesh.Vertices.assign(view.Vertices.begin(), view.Vertices.end());
+        ReadIndices(meshIndex, mesh.Indices);
+        mesh.MaterialIndex = view.MaterialIndex;
+        mesh.Meshlets.assign(view.Meshlets.begin(), view.Meshlets.end());
+        mesh.MeshletVertices.assign(view.MeshletVertices.begin(), view.MeshletVertices.end());
+        mesh.MeshletTriangles.assign(view.MeshletTriangles.begin(), view.MeshletTriangles.end());
+
+        ValidateMeshContents(mesh);
+    }
+
+    return { std::move(meshes), ReadMaterials() };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Loaders::GmeshFile::Reset()
+{
+    m_file.Reset();
+    m_meshes = {};
+    m_materials = {};
+}
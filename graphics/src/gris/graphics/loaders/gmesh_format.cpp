@@ -0,0 +1,61 @@
+#include <gris/graphics/loaders/gmesh_format.h>
+
+#include <gris/engine_exception.h>
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Loaders::EncodeGmeshIndices(Span<const uint32_t> indices, std::vector<std::byte> & encoded)
+{
+    // Mostly one or two bytes per index once the indices are in vertex cache order
+    encoded.reserve(encoded.size() + indices.size() * 2);
+
+    uint32_t previous = 0;
+    for (auto const index : indices)
+    {
+        // Wraps modulo 2^32, which the decoder undoes with the same wrapping addition
+        auto const delta = static_cast<int32_t>(index - previous);
+        auto value = (static_cast<uint32_t>(delta) << 1U) ^ static_cast<uint32_t>(delta >> 31);
+        previous = index;
+
+        while (value >= 0x80U)
+        {
+            encoded.emplace_back(static_cast<std::byte>((value & 0x7FU) | 0x80U));
+            value >>= 7U;
+        }
+        encoded.emplace_back(static_cast<std::byte>(value));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Loaders::DecodeGmeshIndices(Span<const std::byte> encoded, size_t indexCount, std::vector<uint32_t> & indices)
+{
+    constexpr static uint32_t MAX_VARINT_SHIFT = 28;
+
+    indices.reserve(indices.size() + indexCount);
+
+    size_t position = 0;
+    uint32_t previous = 0;
+    for (size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex)
+    {
+        uint32_t value = 0;
+        for (uint32_t shift = 0;; shift += 7)
+        {
+            if (position == encoded.size() || shift > MAX_VARINT_SHIFT)
+            {
+                throw EngineException("Error decoding gmesh indices", "Truncated or malformed varint");
+            }
+
+            auto const byte = static_cast<uint32_t>(encoded[position++]);
+            value |= (byte & 0x7FU) << shift;
+            if ((byte & 0x80U) == 0)
+            {
+                break;
+            }
+        }
+
+        auto const delta = (value >> 1U) ^ (0U - (value & 1U));
+        previous += delta;
+        indices.emplace_back(previous);
+    }
+}
@@ -0,0 +1,217 @@
+#include <gris/graphics/loaders/gmesh_writer.h>
+
+#include <gris/graphics/scene.h>
+
+#include <gris/engine_exception.h>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+[[nodiscard]] uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Pads the output to the alignment and returns the offset the next blob starts at
+uint64_t BeginBlob(std::vector<std::byte> & output, uint64_t alignment)
+{
+    output.resize(static_cast<size_t>(AlignUp(output.size(), alignment)));
+    return output.size();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AppendBytes(std::vector<std::byte> & output, const void * data, size_t byteCount)
+{
+    auto const offset = output.size();
+    output.resize(offset + byteCount);
+    if (byteCount > 0)
+    {
+        std::memcpy(output.data() + offset, data, byteCount);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AppendCount(std::vector<std::byte> & output, size_t count)
+{
+    auto const value = static_cast<uint32_t>(count);
+    AppendBytes(output, &value, sizeof(value));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AppendString(std::vector<std::byte> & output, const std::string & value)
+{
+    AppendCount(output, value.size());
+    AppendBytes(output, value.data(), value.size());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AppendPaths(std::vector<std::byte> & output, const std::vector<std::filesystem::path> & paths)
+{
+    AppendCount(output, paths.size());
+    for (auto const & path : paths)
+    {
+        AppendString(output, path.generic_u8string());
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+template<typename T>
+T & RecordAt(std::vector<std::byte> & output, uint64_t offset)
+{
+    return *reinterpret_cast<T *>(output.data() + offset);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ComputeBounds(const std::vector<Gris::Graphics::Vertex> & vertices, Gris::Graphics::Loaders::GmeshMeshRecord & record)
+{
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    auto boundsMin = vertices.front().Position;
+    auto boundsMax = vertices.front().Position;
+    for (auto const & vertex : vertices)
+    {
+        boundsMin = glm::min(boundsMin, vertex.Position);
+        boundsMax = glm::max(boundsMax, vertex.Position);
+    }
+
+    for (glm::length_t component = 0; component < 3; ++component)
+    {
+        record.BoundsMin[component] = boundsMin[component];
+        record.BoundsMax[component] = boundsMax[component];
+    }
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Loaders::GmeshWriter::Write(const std::filesystem::path & path,
+                                                 const std::vector<Mesh> & meshes,
+                                                 const std::vector<MaterialBlueprint> & materials,
+                                                 GmeshIndexEncoding indexEncoding)
+{
+    auto output = std::vector<std::byte>{};
+
+    // The tables are written zeroed and filled in as the blobs land, the records are found again by offset because
+    // the output reallocates as it grows
+    auto header = GmeshHeader{};
+    header.VertexStride = static_cast<uint32_t>(sizeof(Vertex));
+    header.MeshletStride = static_cast<uint32_t>(sizeof(Meshlet));
+    header.MeshCount = static_cast<uint32_t>(meshes.size());
+    header.MaterialCount = static_cast<uint32_t>(materials.size());
+    AppendBytes(output, &header, sizeof(header));
+
+    auto const meshTableOffset = BeginBlob(output, alignof(GmeshMeshRecord));
+    output.resize(output.size() + meshes.size() * sizeof(GmeshMeshRecord));
+
+    auto const materialTableOffset = BeginBlob(output, alignof(GmeshMaterialRecord));
+    output.resize(output.size() + materials.size() * sizeof(GmeshMaterialRecord));
+
+    auto encodedIndices = std::vector<std::byte>{};
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+    {
+        auto const & mesh = meshes[meshIndex];
+
+        auto record = GmeshMeshRecord{};
+        record.VertexCount = mesh.Vertices.size();
+        record.IndexCount = mesh.Indices.size();
+        record.IndexEncoding = indexEncoding;
+        record.MaterialIndex = static_cast<uint32_t>(mesh.MaterialIndex);
+        ComputeBounds(mesh.Vertices, record);
+
+        record.VertexOffset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        AppendBytes(output, mesh.Vertices.data(), mesh.Vertices.size() * sizeof(Vertex));
+
+        record.IndexOffset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        if (indexEncoding == GmeshIndexEncoding::DeltaVarint)
+        {
+            encodedIndices.clear();
+            EncodeGmeshIndices(Span<const uint32_t>(mesh.Indices.data(), mesh.Indices.size()), encodedIndices);
+            AppendBytes(output, encodedIndices.data(), encodedIndices.size());
+            record.IndexByteSize = encodedIndices.size();
+        }
+        else
+        {
+            AppendBytes(output, mesh.Indices.data(), mesh.Indices.size() * sizeof(uint32_t));
+            record.IndexByteSize = mesh.Indices.size() * sizeof(uint32_t);
+        }
+
+        record.MeshletCount = mesh.Meshlets.size();
+        record.MeshletOffset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        AppendBytes(output, mesh.Meshlets.data(), mesh.Meshlets.size() * sizeof(Meshlet));
+
+        record.MeshletVertexCount = mesh.MeshletVertices.size();
+        record.MeshletVertexOffset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        AppendBytes(output, mesh.MeshletVertices.data(), mesh.MeshletVertices.size() * sizeof(uint32_t));
+
+        record.MeshletTriangleByteSize = mesh.MeshletTriangles.size();
+        record.MeshletTriangleOffset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        AppendBytes(output, mesh.MeshletTriangles.data(), mesh.MeshletTriangles.size());
+
+        RecordAt<GmeshMeshRecord>(output, meshTableOffset + meshIndex * sizeof(GmeshMeshRecord)) = record;
+    }
+
+    for (size_t materialIndex = 0; materialIndex < materials.size(); ++materialIndex)
+    {
+        auto const & material = materials[materialIndex];
+
+        auto record = GmeshMaterialRecord{};
+        record.Offset = BeginBlob(output, GMESH_BLOB_ALIGNMENT);
+        AppendString(output, material.Name);
+        AppendPaths(output, material.DiffuseTextures);
+        AppendPaths(output, material.SpecularTextures);
+        AppendPaths(output, material.NormalTextures);
+        record.ByteSize = output.size() - record.Offset;
+
+        RecordAt<GmeshMaterialRecord>(output, materialTableOffset + materialIndex * sizeof(GmeshMaterialRecord)) = record;
+    }
+
+    header.MeshTableOffset = meshTableOffset;
+    header.MaterialTableOffset = materialTableOffset;
+    header.FileSize = output.size();
+    RecordAt<GmeshHeader>(output, 0) = header;
+
+    // Unique per writer so concurrent writers of the same target never share a temporary
+    auto temporaryPath = path;
+    temporaryPath += "." + std::to_string(std::random_device{}()) + ".tmp";
+
+    {
+        auto file = std::ofstream(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(output.data()), static_cast<std::streamsize>(output.size()));
+        file.close();
+        if (!file)
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temporaryPath, ignored);
+            throw EngineException("Error writing gmesh file", temporaryPath.string());
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporaryPath, ignored);
+        throw EngineException("Error writing gmesh file", path.string(), error.message());
+    }
+}
@@ -0,0 +1,73 @@
+#include <gris/graphics/loaders/index_tuple_table.h>
+
+#include <gris/assert.h>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+[[nodiscard]] uint64_t TupleKey(int32_t positionIndex, int32_t textureCoordsIndex)
+{
+    return (uint64_t{ static_cast<uint32_t>(positionIndex) } << 32U) | uint64_t{ static_cast<uint32_t>(textureCoordsIndex) };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t TupleHash(uint64_t key)
+{
+    // Fibonacci hashing, the high bits are well mixed and used as the slot
+    constexpr static uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    auto const hash = key * MULTIPLIER;
+    return static_cast<size_t>(hash ^ (hash >> 32U));
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Loaders::IndexTupleTable::IndexTupleTable(size_t maxTupleCount)
+    : m_maxSize(maxTupleCount)
+{
+    // At most half full, which keeps the probe sequences short
+    auto capacity = size_t{ 16 };
+    while (capacity < 2 * maxTupleCount)
+    {
+        capacity *= 2;
+    }
+
+    m_keys.assign(capacity, EMPTY_KEY);
+    m_values.resize(capacity);
+    m_mask = capacity - 1;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::pair<uint32_t, bool> Gris::Graphics::Loaders::IndexTupleTable::FindOrInsert(int32_t positionIndex, int32_t textureCoordsIndex)
+{
+    auto const key = TupleKey(positionIndex, textureCoordsIndex);
+    GRIS_FAST_ASSERT(key != EMPTY_KEY, "Tuple collides with the empty slot marker");
+
+    for (auto slot = TupleHash(key) & m_mask;; slot = (slot + 1) & m_mask)
+    {
+        if (m_keys[slot] == key)
+        {
+            return { m_values[slot], false };
+        }
+
+        if (m_keys[slot] == EMPTY_KEY)
+        {
+            GRIS_ALWAYS_ASSERT(m_size < m_maxSize, "Index tuple table is full");
+            m_keys[slot] = key;
+            m_values[slot] = static_cast<uint32_t>(m_size++);
+            return { m_values[slot], true };
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::Loaders::IndexTupleTable::Size() const
+{
+    return m_size;
+}
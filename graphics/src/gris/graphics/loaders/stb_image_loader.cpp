@@ -3,18 +3,48 @@
 #include <gris/engine_exception.h>
 #include <gris/graphics/image.h>
 
+#include <gris/derived_data_cache.h>
+#include <gris/log.h>
+#include <gris/mapped_file.h>
+
 #include <stb_image.h>
 
 #include <cstring>
+#include <fstream>
+#include <limits>
 
 // -------------------------------------------------------------------------------------------------
 
-Gris::Graphics::Image Gris::Graphics::Loaders::StbImageLoader::Load(const std::filesystem::path & path)
+namespace
+{
+
+// Bump whenever the image decoded from the same file changes
+constexpr uint32_t STB_IMAGE_LOADER_VERSION = 1;
+
+constexpr uint32_t COOKED_IMAGE_MAGIC = 0x474D4947;  // "GIMG"
+
+struct CookedImageHeader
+{
+    uint32_t Magic = COOKED_IMAGE_MAGIC;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    Gris::Graphics::ImageFormat Format = Gris::Graphics::ImageFormat::Undefined;
+    uint64_t PixelDataSize = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Image Decode(Gris::Span<const std::byte> source, const std::filesystem::path & path)
 {
+    if (source.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw Gris::EngineException("Failed to load texture image", path.string(), "File too large");
+    }
+
     int texWidth = 0;
     int texHeight = 0;
     int texChannels = 0;
-    auto * pixels = stbi_load(path.string().c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    auto * pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(source.data()), static_cast<int>(source.size()), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
     if (pixels == nullptr)
     {
         throw Gris::EngineException("Failed to load texture image", path.string());
@@ -23,11 +53,11 @@ Gris::Graphics::Image Gris::Graphics::Loaders::StbImageLoader::Load(const std::f
     auto const forcedChannelCount = 4;
     auto const dataSize = static_cast<size_t>(texWidth) * static_cast<size_t>(texHeight) * forcedChannelCount;
 
-    Image result;
+    Gris::Graphics::Image result;
     result.PixelData.resize(dataSize);
     result.Width = static_cast<uint32_t>(texWidth);
     result.Height = static_cast<uint32_t>(texHeight);
-    result.Format = ImageFormat::R8G8B8A8SRGB;
+    result.Format = Gris::Graphics::ImageFormat::R8G8B8A8SRGB;
 
     std::memcpy(result.PixelData.data(), pixels, dataSize);
 
@@ -35,3 +65,89 @@ Gris::Graphics::Image Gris::Graphics::Loaders::StbImageLoader::Load(const std::f
 
     return result;
 }
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Image ReadCookedImage(const std::filesystem::path & path)
+{
+    auto const file = Gris::MappedFile(path);
+    auto const data = file.Data();
+
+    auto header = CookedImageHeader{};
+    if (data.size() < sizeof(header))
+    {
+        throw Gris::EngineException("Error reading cooked image", path.string(), "File too small");
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.Magic != COOKED_IMAGE_MAGIC || header.PixelDataSize != data.size() - sizeof(header))
+    {
+        throw Gris::EngineException("Error reading cooked image", path.string(), "Bad header");
+    }
+
+    Gris::Graphics::Image result;
+    result.PixelData.resize(static_cast<size_t>(header.PixelDataSize));
+    result.Width = header.Width;
+    result.Height = header.Height;
+    result.Format = header.Format;
+
+    std::memcpy(result.PixelData.data(), data.data() + sizeof(header), result.PixelData.size());
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void WriteCookedImage(const std::filesystem::path & path, const Gris::Graphics::Image & image)
+{
+    auto header = CookedImageHeader{};
+    header.Width = image.Width;
+    header.Height = image.Height;
+    header.Format = image.Format;
+    header.PixelDataSize = image.PixelData.size();
+
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.PixelData.data()), static_cast<std::streamsize>(image.PixelData.size()));
+    file.close();
+    if (!file)
+    {
+        throw Gris::EngineException("Error writing cooked image", path.string());
+    }
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Image Gris::Graphics::Loaders::StbImageLoader::Load(const std::filesystem::path & path)
+{
+    auto const & cache = DerivedDataCache::Default();
+    auto const source = MappedFile(path);
+    auto const key = DerivedDataCache::MakeKey("StbImageLoader", STB_IMAGE_LOADER_VERSION, "rgba", source.Data());
+
+    if (auto const entryPath = cache.Find(key))
+    {
+        try
+        {
+            return ReadCookedImage(*entryPath);
+        }
+        catch (const EngineException & e)
+        {
+            Log::Warning("[StbImageLoader] Ignoring derived data {}: {}", key, e.what());
+        }
+    }
+
+    auto result = Decode(source.Data(), path);
+
+    try
+    {
+        cache.Store(key, [&result](const std::filesystem::path & entryPath) { WriteCookedImage(entryPath, result); });
+    }
+    catch (const EngineException & e)
+    {
+        Log::Warning("[StbImageLoader] Failed to store derived data {}: {}", key, e.what());
+    }
+
+    return result;
+}
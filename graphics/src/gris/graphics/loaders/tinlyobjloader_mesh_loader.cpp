@@ -1,35 +1,118 @@
 #include <gris/graphics/loaders/tinlyobjloader_mesh_loader.h>
 
+#include <gris/graphics/loaders/index_tuple_table.h>
+#include <gris/graphics/mesh_optimizer.h>
+#include <gris/graphics/meshlet_builder.h>
 #include <gris/graphics/scene.h>
+#include <gris/graphics/vertex_kernels.h>
 
 #include <gris/engine_exception.h>
-#include <gris/utils.h>
+#include <gris/log.h>
+#include <gris/parallel_for.h>
+#include <gris/span.h>
 
 #include <tiny_obj_loader.h>
 
-#include <glm/gtx/hash.hpp>
-
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
 // -------------------------------------------------------------------------------------------------
 
-struct VertexHash
+namespace
+{
+
+// Faces can leave out the texture coordinates even when others in the file have them. Their corners get the same UV
+// as meshes without texture coordinates, the runs in between are gathered.
+void WriteTextureCoords(const tinyobj::attrib_t & attributes, Gris::Span<const tinyobj::index_t> tuples, float * destination)
 {
-    size_t operator()(Gris::Graphics::Vertex const & vertex) const noexcept
+    constexpr size_t DESTINATION_STRIDE = sizeof(Gris::Graphics::Vertex);
+    auto const hasTextureCoords = [&attributes](const tinyobj::index_t & tuple)
     {
-        return ((std::hash<glm::vec3>()(vertex.Position) ^ (std::hash<glm::vec3>()(vertex.Color) << 1U)) >> 1U) ^ (std::hash<glm::vec2>()(vertex.TextureCoords) << 1U);
+        return !attributes.texcoords.empty() && tuple.texcoord_index >= 0;
+    };
+
+    size_t runStart = 0;
+    while (runStart < tuples.size())
+    {
+        auto const runHasTextureCoords = hasTextureCoords(tuples[runStart]);
+        auto runEnd = runStart + 1;
+        while (runEnd < tuples.size() && hasTextureCoords(tuples[runEnd]) == runHasTextureCoords)
+        {
+            ++runEnd;
+        }
+
+        auto * const runDestination = destination + runStart * DESTINATION_STRIDE / sizeof(float);
+        if (runHasTextureCoords)
+        {
+            Gris::Graphics::GatherFlippedUv(attributes.texcoords.data(), attributes.texcoords.size() / 2, &tuples[runStart].texcoord_index, sizeof(tinyobj::index_t), runDestination, DESTINATION_STRIDE, runEnd - runStart);
+        }
+        else
+        {
+            Gris::Graphics::FillVec2(0.0F, 1.0F, runDestination, DESTINATION_STRIDE, runEnd - runStart);
+        }
+
+        runStart = runEnd;
     }
-};
+}
 
 // -------------------------------------------------------------------------------------------------
 
-struct VertexComparator
+Gris::Graphics::Mesh ConvertShape(const tinyobj::attrib_t & attributes, const tinyobj::shape_t & shape)
 {
-    bool operator()(const Gris::Graphics::Vertex & lhs, const Gris::Graphics::Vertex & rhs) const
+    auto const & indices = shape.mesh.indices;
+
+    // The vertex only holds the position and the texture coordinates, so the normal index does not take part and
+    // corners that differ only in their normals share a vertex
+    auto table = Gris::Graphics::Loaders::IndexTupleTable(indices.size());
+    auto uniqueTuples = std::vector<tinyobj::index_t>{};
+
+    auto mesh = Gris::Graphics::Mesh{};
+    mesh.Indices.resize(indices.size());
+    for (size_t cornerIndex = 0; cornerIndex < indices.size(); ++cornerIndex)
     {
-        return lhs.Position == rhs.Position && lhs.Color == rhs.Color && lhs.TextureCoords == rhs.TextureCoords;
+        auto const & corner = indices[cornerIndex];
+        auto const [vertexIndex, inserted] = table.FindOrInsert(corner.vertex_index, corner.texcoord_index);
+        if (inserted)
+        {
+            uniqueTuples.emplace_back(corner);
+        }
+
+        mesh.Indices[cornerIndex] = vertexIndex;
+    }
+
+    mesh.Vertices.resize(uniqueTuples.size());
+    if (!uniqueTuples.empty())
+    {
+        // Only the attributes of the mesh vertex format are written, one strided pass each
+        auto & firstVertex = mesh.Vertices.front();
+        auto const writeAttribute = [&](auto attribute)
+        {
+            using Attribute = decltype(attribute);
+            auto * const destination = Gris::Graphics::MeshVertexFormat::Data<Attribute>(firstVertex);
+            if constexpr (std::is_same_v<Attribute, Gris::Graphics::PositionAttribute>)
+            {
+                Gris::Graphics::GatherVec3(attributes.vertices.data(), attributes.vertices.size() / 3, &uniqueTuples.front().vertex_index, sizeof(tinyobj::index_t), destination, sizeof(Gris::Graphics::Vertex), uniqueTuples.size());
+            }
+            else if constexpr (std::is_same_v<Attribute, Gris::Graphics::ColorAttribute>)
+            {
+                Gris::Graphics::FillVec3(1.0F, 1.0F, 1.0F, destination, sizeof(Gris::Graphics::Vertex), uniqueTuples.size());
+            }
+            else if constexpr (std::is_same_v<Attribute, Gris::Graphics::TextureCoordsAttribute>)
+            {
+                WriteTextureCoords(attributes, uniqueTuples, destination);
+            }
+            else
+            {
+                static_assert(Gris::Graphics::UNSUPPORTED_VERTEX_ATTRIBUTE<Attribute>, "The loader cannot produce the attribute");
+            }
+        };
+        Gris::Graphics::MeshVertexFormat::ForEachAttribute(writeAttribute);
     }
-};
+
+    return mesh;
+}
+
+}  // namespace
 
 // -------------------------------------------------------------------------------------------------
 
@@ -40,46 +123,39 @@ std::tuple<std::vector<Gris::Graphics::Mesh>, std::vector<Gris::Graphics::Materi
     std::vector<tinyobj::material_t> materials;
     std::string err;
 
-    if (!LoadObj(&attributes, &shapes, &materials, &err, path.string().c_str(), nullptr, false))
+    // Polygons are split into triangles, the optimizer and the meshlet builder only take triangle lists
+    if (!LoadObj(&attributes, &shapes, &materials, &err, path.string().c_str(), nullptr, true))
     {
         throw EngineException("Error loading model", err);
     }
 
-    auto resultMeshes = MakeReservedVector<Mesh>(shapes.size());
-
-    for (auto const & shape : shapes)
+    // Shapes only read the shared attributes, each converts into its own slot
+    auto resultMeshes = std::vector<Mesh>(shapes.size());
+    auto reports = std::vector<MeshOptimizationReport>(shapes.size());
+    ParallelFor(shapes.size(),
+                [&attributes, &shapes, &resultMeshes, &reports](size_t shapeIndex)
+                {
+                    auto & mesh = resultMeshes[shapeIndex];
+                    mesh = ConvertShape(attributes, shapes[shapeIndex]);
+                    reports[shapeIndex] = OptimizeMesh(mesh);
+                    BuildMeshlets(mesh);
+                });
+
+    auto report = MeshOptimizationReport{};
+    for (auto const & meshReport : reports)
     {
-        auto uniqueVertices = std::unordered_map<Vertex, uint32_t, VertexHash, VertexComparator>{};
-        auto currentMesh = Mesh{};
-
-        for (auto const & index : shape.mesh.indices)
-        {
-            auto vertex = Vertex{};
-
-            vertex.Position = {
-                attributes.vertices[3 * static_cast<size_t>(index.vertex_index) + 0],
-                attributes.vertices[3 * static_cast<size_t>(index.vertex_index) + 1],
-                attributes.vertices[3 * static_cast<size_t>(index.vertex_index) + 2]
-            };
-
-            vertex.TextureCoords = {
-                attributes.texcoords[2 * static_cast<size_t>(index.texcoord_index) + 0],
-                1.0F - attributes.texcoords[2 * static_cast<size_t>(index.texcoord_index) + 1]
-            };
-
-            vertex.Color = { 1.0F, 1.0F, 1.0F };
-
-            if (uniqueVertices.count(vertex) == 0)
-            {
-                uniqueVertices[vertex] = static_cast<uint32_t>(currentMesh.Vertices.size());
-                currentMesh.Vertices.push_back(vertex);
-            }
-
-            currentMesh.Indices.push_back(uniqueVertices[vertex]);
-        }
-
-        resultMeshes.emplace_back(std::move(currentMesh));
+        report += meshReport;
     }
 
-    return { resultMeshes, {} };
+    Log::Info("[TinyObjLoaderMeshLoader] Optimized {} triangles from {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, removed {} degenerate triangles and {} unused vertices",
+              report.After.TriangleCount,
+              path.string(),
+              report.Before.Acmr(),
+              report.After.Acmr(),
+              report.Before.Atvr(),
+              report.After.Atvr(),
+              report.RemovedTriangleCount,
+              report.RemovedVertexCount);
+
+    return { std::move(resultMeshes), {} };
 }
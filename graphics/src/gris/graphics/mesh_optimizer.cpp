@@ -0,0 +1,467 @@
+#include <gris/graphics/mesh_optimizer.h>
+
+#include <gris/graphics/scene.h>
+
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
+// -------------------------------------------------------------------------------------------------
+
+void AssertOptimizable(const Gris::Graphics::Mesh & mesh)
+{
+    GRIS_ALWAYS_ASSERT(mesh.Indices.size() % 3 == 0, "Meshes are optimized as triangle lists");
+    GRIS_ALWAYS_ASSERT(mesh.Meshlets.empty(), "Reordering would invalidate the meshlets, optimize before building them");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// FIFO cache keyed by the time each vertex entered it, a vertex is cached while fewer than the cache size misses
+// happened since
+class VertexCacheSimulator
+{
+public:
+    VertexCacheSimulator(size_t vertexCount, size_t cacheSize)
+        : m_entryTimes(vertexCount, 0)
+        , m_cacheSize(cacheSize)
+        , m_time(cacheSize + 1)
+    {
+    }
+
+    [[nodiscard]] uint32_t Triangle(const uint32_t * triangle)
+    {
+        return Vertex(triangle[0]) + Vertex(triangle[1]) + Vertex(triangle[2]);
+    }
+
+    void Flush()
+    {
+        m_time += m_cacheSize + 1;
+    }
+
+private:
+    [[nodiscard]] uint32_t Vertex(uint32_t vertex)
+    {
+        if (m_time - m_entryTimes[vertex] <= m_cacheSize)
+        {
+            return 0;
+        }
+
+        m_entryTimes[vertex] = m_time++;
+        return 1;
+    }
+
+    std::vector<size_t> m_entryTimes;
+    size_t m_cacheSize;
+    size_t m_time;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// Triangles around each vertex, as a compressed sparse row table
+struct VertexAdjacency
+{
+    VertexAdjacency(const std::vector<uint32_t> & indices, size_t vertexCount)
+        : Offsets(vertexCount + 1, 0)
+        , Triangles(indices.size())
+    {
+        for (auto const index : indices)
+        {
+            ++Offsets[index + 1];
+        }
+
+        std::partial_sum(Offsets.begin(), Offsets.end(), Offsets.begin());
+
+        auto fill = std::vector<uint32_t>(Offsets.begin(), Offsets.end() - 1);
+        for (size_t cornerIndex = 0; cornerIndex < indices.size(); ++cornerIndex)
+        {
+            Triangles[fill[indices[cornerIndex]]++] = static_cast<uint32_t>(cornerIndex / 3);
+        }
+    }
+
+    std::vector<uint32_t> Offsets;
+    std::vector<uint32_t> Triangles;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] glm::vec3 TriangleNormal(const Gris::Graphics::Mesh & mesh, const uint32_t * triangle)
+{
+    auto const & p0 = mesh.Vertices[triangle[0]].Position;
+    return glm::cross(mesh.Vertices[triangle[1]].Position - p0, mesh.Vertices[triangle[2]].Position - p0);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Hard boundaries are where the cache ordering ran into a dead end and all three vertices miss, soft ones are added
+// inside each hard cluster wherever the miss ratio so far is already within the threshold of the cluster average
+[[nodiscard]] std::vector<size_t> FindClusterBoundaries(const Gris::Graphics::Mesh & mesh, float threshold, size_t cacheSize)
+{
+    auto const triangleCount = mesh.Indices.size() / 3;
+
+    auto hardBoundaries = std::vector<size_t>{};
+    auto misses = std::vector<uint32_t>(triangleCount);
+    auto cache = VertexCacheSimulator(mesh.Vertices.size(), cacheSize);
+    for (size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+    {
+        misses[triangleIndex] = cache.Triangle(&mesh.Indices[triangleIndex * 3]);
+        if (misses[triangleIndex] == 3)
+        {
+            hardBoundaries.emplace_back(triangleIndex);
+        }
+    }
+    hardBoundaries.emplace_back(triangleCount);
+
+    auto boundaries = std::vector<size_t>{};
+    for (size_t clusterIndex = 0; clusterIndex + 1 < hardBoundaries.size(); ++clusterIndex)
+    {
+        auto const begin = hardBoundaries[clusterIndex];
+        auto const end = hardBoundaries[clusterIndex + 1];
+
+        auto const clusterMisses = std::accumulate(misses.begin() + static_cast<ptrdiff_t>(begin), misses.begin() + static_cast<ptrdiff_t>(end), size_t{ 0 });
+        auto const clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        boundaries.emplace_back(begin);
+
+        // Every cut restarts cold, which is what the cluster sees once it is drawn somewhere else
+        cache.Flush();
+        size_t runningMisses = 0;
+        size_t runningTriangles = 0;
+        for (auto triangleIndex = begin; triangleIndex + 1 < end; ++triangleIndex)
+        {
+            runningMisses += cache.Triangle(&mesh.Indices[triangleIndex * 3]);
+            ++runningTriangles;
+
+            if (static_cast<float>(runningMisses) <= clusterThreshold * static_cast<float>(runningTriangles))
+            {
+                boundaries.emplace_back(triangleIndex + 1);
+                cache.Flush();
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+    boundaries.emplace_back(triangleCount);
+
+    return boundaries;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] float Gris::Graphics::VertexCacheStatistics::Acmr() const
+{
+    return TriangleCount == 0 ? 0.0F : static_cast<float>(TransformedVertexCount) / static_cast<float>(TriangleCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] float Gris::Graphics::VertexCacheStatistics::Atvr() const
+{
+    return VertexCount == 0 ? 0.0F : static_cast<float>(TransformedVertexCount) / static_cast<float>(VertexCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::VertexCacheStatistics & Gris::Graphics::VertexCacheStatistics::operator+=(const VertexCacheStatistics & other)
+{
+    TransformedVertexCount += other.TransformedVertexCount;
+    TriangleCount += other.TriangleCount;
+    VertexCount += other.VertexCount;
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::MeshOptimizationReport & Gris::Graphics::MeshOptimizationReport::operator+=(const MeshOptimizationReport & other)
+{
+    Before += other.Before;
+    After += other.After;
+    RemovedTriangleCount += other.RemovedTriangleCount;
+    RemovedVertexCount += other.RemovedVertexCount;
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::VertexCacheStatistics Gris::Graphics::AnalyzeVertexCache(Span<const uint32_t> indices, size_t vertexCount, size_t cacheSize)
+{
+    GRIS_ALWAYS_ASSERT(indices.size() % 3 == 0, "Vertex cache statistics are for triangle lists");
+
+    auto result = VertexCacheStatistics{};
+    result.TriangleCount = indices.size() / 3;
+
+    auto cache = VertexCacheSimulator(vertexCount, cacheSize);
+    for (size_t triangleIndex = 0; triangleIndex < result.TriangleCount; ++triangleIndex)
+    {
+        result.TransformedVertexCount += cache.Triangle(&indices[triangleIndex * 3]);
+    }
+
+    // Only the referenced vertices count, unreferenced ones are never transformed
+    auto referenced = std::vector<bool>(vertexCount, false);
+    for (auto const index : indices)
+    {
+        if (!referenced[index])
+        {
+            referenced[index] = true;
+            ++result.VertexCount;
+        }
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::RemoveDegenerateTriangles(Mesh & mesh)
+{
+    AssertOptimizable(mesh);
+
+    size_t keptIndexCount = 0;
+    for (size_t cornerIndex = 0; cornerIndex < mesh.Indices.size(); cornerIndex += 3)
+    {
+        auto const * const triangle = &mesh.Indices[cornerIndex];
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0] || TriangleNormal(mesh, triangle) == glm::vec3(0.0F))
+        {
+            continue;
+        }
+
+        std::copy(triangle, triangle + 3, mesh.Indices.begin() + static_cast<ptrdiff_t>(keptIndexCount));
+        keptIndexCount += 3;
+    }
+
+    mesh.Indices.resize(keptIndexCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::OptimizeVertexCache(Mesh & mesh, size_t cacheSize)
+{
+    AssertOptimizable(mesh);
+
+    auto const vertexCount = mesh.Vertices.size();
+    auto const triangleCount = mesh.Indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    auto const adjacency = VertexAdjacency(mesh.Indices, vertexCount);
+
+    auto liveTriangles = std::vector<uint32_t>(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    {
+        liveTriangles[vertex] = adjacency.Offsets[vertex + 1] - adjacency.Offsets[vertex];
+    }
+
+    auto cacheTimes = std::vector<size_t>(vertexCount, 0);
+    auto emitted = std::vector<bool>(triangleCount, false);
+    auto deadEnds = std::vector<uint32_t>{};
+    auto candidates = std::vector<uint32_t>{};
+
+    auto result = std::vector<uint32_t>{};
+    result.reserve(mesh.Indices.size());
+
+    size_t time = cacheSize + 1;
+    uint32_t scanCursor = 0;
+
+    // Falls back to recently used vertices with triangles left, then to the first such vertex in index order
+    auto const skipDeadEnd = [&]()
+    {
+        while (!deadEnds.empty())
+        {
+            auto const vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[vertex] > 0)
+            {
+                return vertex;
+            }
+        }
+
+        for (; scanCursor < vertexCount; ++scanCursor)
+        {
+            if (liveTriangles[scanCursor] > 0)
+            {
+                return scanCursor;
+            }
+        }
+
+        return NO_VERTEX;
+    };
+
+    auto fanningVertex = skipDeadEnd();
+    while (fanningVertex != NO_VERTEX)
+    {
+        candidates.clear();
+
+        for (auto triangleSlot = adjacency.Offsets[fanningVertex]; triangleSlot < adjacency.Offsets[fanningVertex + 1]; ++triangleSlot)
+        {
+            auto const triangleIndex = adjacency.Triangles[triangleSlot];
+            if (emitted[triangleIndex])
+            {
+                continue;
+            }
+
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                auto const vertex = mesh.Indices[triangleIndex * 3 + corner];
+                result.emplace_back(vertex);
+                deadEnds.emplace_back(vertex);
+                candidates.emplace_back(vertex);
+                --liveTriangles[vertex];
+
+                if (time - cacheTimes[vertex] > cacheSize)
+                {
+                    cacheTimes[vertex] = time++;
+                }
+            }
+
+            emitted[triangleIndex] = true;
+        }
+
+        // Prefers the oldest candidate that will still be in the cache once all its triangles are emitted, so it is
+        // used up before it is evicted
+        auto nextVertex = NO_VERTEX;
+        auto bestPriority = -1;
+        for (auto const vertex : candidates)
+        {
+            if (liveTriangles[vertex] == 0)
+            {
+                continue;
+            }
+
+            auto priority = 0;
+            auto const age = time - cacheTimes[vertex];
+            if (age + 2 * liveTriangles[vertex] <= cacheSize)
+            {
+                priority = static_cast<int>(age);
+            }
+
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                nextVertex = vertex;
+            }
+        }
+
+        fanningVertex = nextVertex != NO_VERTEX ? nextVertex : skipDeadEnd();
+    }
+
+    mesh.Indices = std::move(result);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::OptimizeOverdraw(Mesh & mesh, float threshold, size_t cacheSize)
+{
+    AssertOptimizable(mesh);
+
+    if (mesh.Indices.empty())
+    {
+        return;
+    }
+
+    auto const boundaries = FindClusterBoundaries(mesh, threshold, cacheSize);
+    auto const clusterCount = boundaries.size() - 1;
+
+    auto meshCenter = glm::vec3(0.0F);
+    for (auto const & vertex : mesh.Vertices)
+    {
+        meshCenter += vertex.Position;
+    }
+    meshCenter /= static_cast<float>(mesh.Vertices.size());
+
+    // Area weighted centroid and normal of each cluster
+    auto sortKeys = std::vector<float>(clusterCount, 0.0F);
+    for (size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex)
+    {
+        auto centroid = glm::vec3(0.0F);
+        auto normal = glm::vec3(0.0F);
+        auto area = 0.0F;
+        for (auto triangleIndex = boundaries[clusterIndex]; triangleIndex < boundaries[clusterIndex + 1]; ++triangleIndex)
+        {
+            auto const * const triangle = &mesh.Indices[triangleIndex * 3];
+            auto const triangleNormal = TriangleNormal(mesh, triangle);
+            auto const triangleArea = glm::length(triangleNormal);
+
+            centroid += (mesh.Vertices[triangle[0]].Position + mesh.Vertices[triangle[1]].Position + mesh.Vertices[triangle[2]].Position) * (triangleArea / 3.0F);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        auto const normalLength = glm::length(normal);
+        if (area > 0.0F && normalLength > 0.0F)
+        {
+            sortKeys[clusterIndex] = glm::dot(centroid / area - meshCenter, normal / normalLength);
+        }
+    }
+
+    auto order = std::vector<size_t>(clusterCount);
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t lhs, size_t rhs) { return sortKeys[lhs] > sortKeys[rhs]; });
+
+    auto result = std::vector<uint32_t>{};
+    result.reserve(mesh.Indices.size());
+    for (auto const clusterIndex : order)
+    {
+        result.insert(result.end(), mesh.Indices.begin() + static_cast<ptrdiff_t>(boundaries[clusterIndex] * 3), mesh.Indices.begin() + static_cast<ptrdiff_t>(boundaries[clusterIndex + 1] * 3));
+    }
+
+    mesh.Indices = std::move(result);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::OptimizeVertexFetch(Mesh & mesh)
+{
+    AssertOptimizable(mesh);
+
+    auto remap = std::vector<uint32_t>(mesh.Vertices.size(), NO_VERTEX);
+    auto vertices = std::vector<Vertex>{};
+    vertices.reserve(mesh.Vertices.size());
+
+    for (auto & index : mesh.Indices)
+    {
+        if (remap[index] == NO_VERTEX)
+        {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.emplace_back(mesh.Vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    mesh.Vertices = std::move(vertices);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::MeshOptimizationReport Gris::Graphics::OptimizeMesh(Mesh & mesh)
+{
+    auto report = MeshOptimizationReport{};
+    report.Before = AnalyzeVertexCache(Span<const uint32_t>(mesh.Indices.data(), mesh.Indices.size()), mesh.Vertices.size());
+
+    auto const triangleCount = mesh.Indices.size() / 3;
+    auto const vertexCount = mesh.Vertices.size();
+
+    RemoveDegenerateTriangles(mesh);
+    OptimizeVertexCache(mesh);
+    OptimizeOverdraw(mesh);
+    OptimizeVertexFetch(mesh);
+
+    report.After = AnalyzeVertexCache(Span<const uint32_t>(mesh.Indices.data(), mesh.Indices.size()), mesh.Vertices.size());
+    report.RemovedTriangleCount = triangleCount - mesh.Indices.size() / 3;
+    report.RemovedVertexCount = vertexCount - mesh.Vertices.size();
+
+    return report;
+}
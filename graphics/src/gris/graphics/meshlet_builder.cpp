@@ -0,0 +1,193 @@
+#include <gris/graphics/meshlet_builder.h>
+
+#include <gris/graphics/scene.h>
+
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+constexpr uint8_t NOT_IN_MESHLET = 0xFF;
+
+// Cones narrower than this are still too wide to cull anything in practice
+constexpr float MIN_CONE_NORMAL_DOT = 0.1F;
+
+static_assert(Gris::Graphics::MESHLET_MAX_VERTICES < NOT_IN_MESHLET, "Local vertex indices have to fit a byte");
+
+// -------------------------------------------------------------------------------------------------
+
+void ComputeBounds(const Gris::Graphics::Mesh & mesh, Gris::Graphics::Meshlet & meshlet)
+{
+    auto const vertexBegin = mesh.MeshletVertices.begin() + meshlet.VertexOffset;
+    auto const vertexEnd = vertexBegin + meshlet.VertexCount;
+
+    auto boundsMin = mesh.Vertices[*vertexBegin].Position;
+    auto boundsMax = boundsMin;
+    for (auto vertex = vertexBegin; vertex != vertexEnd; ++vertex)
+    {
+        boundsMin = glm::min(boundsMin, mesh.Vertices[*vertex].Position);
+        boundsMax = glm::max(boundsMax, mesh.Vertices[*vertex].Position);
+    }
+
+    // Not the smallest sphere, but close enough for culling and cheap
+    meshlet.BoundsCenter = (boundsMin + boundsMax) * 0.5F;
+
+    auto radiusSquared = 0.0F;
+    for (auto vertex = vertexBegin; vertex != vertexEnd; ++vertex)
+    {
+        auto const offset = mesh.Vertices[*vertex].Position - meshlet.BoundsCenter;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+
+    meshlet.BoundsRadius = std::sqrt(radiusSquared);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ComputeCone(const Gris::Graphics::Mesh & mesh, Gris::Graphics::Meshlet & meshlet)
+{
+    auto const trianglePosition = [&mesh, &meshlet](uint32_t triangleIndex, uint32_t corner)
+    {
+        auto const localIndex = mesh.MeshletTriangles[meshlet.LocalIndexOffset + triangleIndex * 3 + corner];
+        return mesh.Vertices[mesh.MeshletVertices[meshlet.VertexOffset + localIndex]].Position;
+    };
+
+    auto normals = std::array<glm::vec3, Gris::Graphics::MESHLET_MAX_TRIANGLES>{};
+    auto axis = glm::vec3(0.0F);
+    for (uint32_t triangleIndex = 0; triangleIndex < meshlet.TriangleCount; ++triangleIndex)
+    {
+        auto const p0 = trianglePosition(triangleIndex, 0);
+        auto const normal = glm::cross(trianglePosition(triangleIndex, 1) - p0, trianglePosition(triangleIndex, 2) - p0);
+        auto const length = glm::length(normal);
+
+        // Degenerate triangles face nowhere and are left out
+        normals[triangleIndex] = length > 0.0F ? normal / length : glm::vec3(0.0F);
+        axis += normals[triangleIndex];
+    }
+
+    auto const axisLength = glm::length(axis);
+    if (axisLength == 0.0F)
+    {
+        return;
+    }
+    axis /= axisLength;
+
+    auto minNormalDot = 1.0F;
+    for (uint32_t triangleIndex = 0; triangleIndex < meshlet.TriangleCount; ++triangleIndex)
+    {
+        if (normals[triangleIndex] != glm::vec3(0.0F))
+        {
+            minNormalDot = std::min(minNormalDot, glm::dot(axis, normals[triangleIndex]));
+        }
+    }
+
+    if (minNormalDot <= MIN_CONE_NORMAL_DOT)
+    {
+        return;
+    }
+
+    // Moves the apex back along the axis until every triangle plane is in front of it, so testing the direction to
+    // the apex is conservative for the whole cluster and not just its center
+    auto maxDistance = 0.0F;
+    for (uint32_t triangleIndex = 0; triangleIndex < meshlet.TriangleCount; ++triangleIndex)
+    {
+        auto const & normal = normals[triangleIndex];
+        if (normal != glm::vec3(0.0F))
+        {
+            auto const distance = glm::dot(meshlet.BoundsCenter - trianglePosition(triangleIndex, 0), normal) / glm::dot(axis, normal);
+            maxDistance = std::max(maxDistance, distance);
+        }
+    }
+
+    meshlet.ConeApex = meshlet.BoundsCenter - axis * maxDistance;
+    meshlet.ConeAxis = axis;
+
+    // All normals are within acos(minNormalDot) of the axis, so all triangles face away once the view direction is
+    // within 90 degrees minus that of the axis
+    meshlet.ConeCutoff = std::sqrt(1.0F - minNormalDot * minNormalDot);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void FinishMeshlet(Gris::Graphics::Mesh & mesh, Gris::Graphics::Meshlet & meshlet, std::vector<uint8_t> & localIndices)
+{
+    auto const vertexBegin = mesh.MeshletVertices.begin() + meshlet.VertexOffset;
+    std::for_each(vertexBegin, vertexBegin + meshlet.VertexCount, [&localIndices](uint32_t vertex) { localIndices[vertex] = NOT_IN_MESHLET; });
+
+    ComputeBounds(mesh, meshlet);
+    ComputeCone(mesh, meshlet);
+
+    mesh.Meshlets.emplace_back(meshlet);
+
+    meshlet = Gris::Graphics::Meshlet{};
+    meshlet.VertexOffset = static_cast<uint32_t>(mesh.MeshletVertices.size());
+    meshlet.LocalIndexOffset = static_cast<uint32_t>(mesh.MeshletTriangles.size());
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::BuildMeshlets(Mesh & mesh)
+{
+    GRIS_ALWAYS_ASSERT(mesh.Indices.size() % 3 == 0, "Meshlets are built from triangle lists");
+
+    mesh.Meshlets.clear();
+    mesh.MeshletVertices.clear();
+    mesh.MeshletTriangles.clear();
+
+    auto const triangleCount = mesh.Indices.size() / 3;
+    mesh.Meshlets.reserve((triangleCount + MESHLET_MAX_TRIANGLES - 1) / MESHLET_MAX_TRIANGLES);
+    mesh.MeshletTriangles.reserve(mesh.Indices.size());
+
+    // Local index of each mesh vertex in the meshlet being built
+    auto localIndices = std::vector<uint8_t>(mesh.Vertices.size(), NOT_IN_MESHLET);
+
+    auto meshlet = Meshlet{};
+    for (size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+    {
+        auto const * const triangle = &mesh.Indices[triangleIndex * 3];
+
+        size_t newVertexCount = 0;
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            auto const repeated = std::find(triangle, triangle + corner, triangle[corner]) != triangle + corner;
+            if (localIndices[triangle[corner]] == NOT_IN_MESHLET && !repeated)
+            {
+                ++newVertexCount;
+            }
+        }
+
+        if (meshlet.VertexCount + newVertexCount > MESHLET_MAX_VERTICES || meshlet.TriangleCount == MESHLET_MAX_TRIANGLES)
+        {
+            FinishMeshlet(mesh, meshlet, localIndices);
+        }
+
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            auto & localIndex = localIndices[triangle[corner]];
+            if (localIndex == NOT_IN_MESHLET)
+            {
+                localIndex = static_cast<uint8_t>(meshlet.VertexCount++);
+                mesh.MeshletVertices.emplace_back(triangle[corner]);
+            }
+
+            mesh.MeshletTriangles.emplace_back(localIndex);
+        }
+
+        ++meshlet.TriangleCount;
+    }
+
+    if (meshlet.TriangleCount > 0)
+    {
+        FinishMeshlet(mesh, meshlet, localIndices);
+    }
+}
@@ -0,0 +1,424 @@
+#include <gris/graphics/vertex_kernels.h>
+
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Set by the build from GRIS_VERTEX_KERNELS_ISA, or picked up from the compiler flags otherwise
+#if !defined(GRIS_VERTEX_KERNELS_AVX2) && defined(__AVX2__)
+#define GRIS_VERTEX_KERNELS_AVX2
+#endif
+
+#if !defined(GRIS_VERTEX_KERNELS_SSE4) && (defined(GRIS_VERTEX_KERNELS_AVX2) || defined(__SSE4_1__))
+#define GRIS_VERTEX_KERNELS_SSE4
+#endif
+
+#if defined(GRIS_VERTEX_KERNELS_AVX2)
+#include <immintrin.h>
+#elif defined(GRIS_VERTEX_KERNELS_SSE4)
+#include <smmintrin.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+template<typename T>
+[[nodiscard]] T * Advance(T * pointer, size_t bytes)
+{
+    using BytePointer = std::conditional_t<std::is_const_v<T>, const std::byte *, std::byte *>;
+    return reinterpret_cast<T *>(reinterpret_cast<BytePointer>(pointer) + bytes);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t FloatBits(float value)
+{
+    auto bits = uint32_t{ 0 };
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] float BitsFloat(uint32_t bits)
+{
+    auto value = 0.0F;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint16_t FloatToHalf(float value)
+{
+    constexpr static uint32_t HALF_OVERFLOW = 0x47800000U;  // 65536, everything from here on is infinity
+    constexpr static uint32_t HALF_NORMAL_MIN = 0x38800000U;  // 2^-14
+    constexpr static uint32_t FLOAT_INFINITY = 0x7F800000U;
+    constexpr static uint32_t SUBNORMAL_MAGIC = 126U << 23U;  // Aligns the half mantissa with the bottom float bits
+    constexpr static uint32_t REBIAS_AND_ROUND = 0xC8000FFFU;  // (15 - 127) << 23 plus half an ulp minus one
+
+    auto bits = FloatBits(value);
+    auto const sign = bits & 0x80000000U;
+    bits ^= sign;
+
+    auto result = uint32_t{ 0 };
+    if (bits >= HALF_OVERFLOW)
+    {
+        result = bits > FLOAT_INFINITY ? 0x7E00U : 0x7C00U;
+    }
+    else if (bits < HALF_NORMAL_MIN)
+    {
+        // The float addition does the round to nearest even
+        result = FloatBits(BitsFloat(bits) + BitsFloat(SUBNORMAL_MAGIC)) - SUBNORMAL_MAGIC;
+    }
+    else
+    {
+        auto const mantissaOdd = (bits >> 13U) & 1U;
+        bits += REBIAS_AND_ROUND + mantissaOdd;
+        result = bits >> 13U;
+    }
+
+    return static_cast<uint16_t>((sign >> 16U) | result);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ScalarCopyVec3(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        std::memcpy(destination, source, 3 * sizeof(float));
+        source = Advance(source, sourceStride);
+        destination = Advance(destination, destinationStride);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+#if !defined(GRIS_VERTEX_KERNELS_SSE4)
+
+void ScalarCopyFlippedUv(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[0] = source[0];
+        destination[1] = 1.0F - source[1];
+        source = Advance(source, sourceStride);
+        destination = Advance(destination, destinationStride);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+#endif
+
+void ScalarPackHalf(const float * source, uint16_t * destination, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[index] = FloatToHalf(source[index]);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ScalarPackSnorm16(const float * source, int16_t * destination, size_t count)
+{
+    constexpr static float SCALE = 32767.0F;
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[index] = static_cast<int16_t>(std::nearbyint(std::clamp(source[index], -1.0F, 1.0F) * SCALE));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ScalarPackUnorm16(const float * source, uint16_t * destination, size_t count)
+{
+    constexpr static float SCALE = 65535.0F;
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[index] = static_cast<uint16_t>(std::nearbyint(std::clamp(source[index], 0.0F, 1.0F) * SCALE));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+
+// Exactly 12 bytes, the next field of an interleaved vertex is left alone
+void StoreVec3(float * destination, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64 *>(destination), value);
+    _mm_store_ss(destination + 2, _mm_movehl_ps(value, value));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Exactly 8 bytes
+[[nodiscard]] __m128 LoadVec2(const float * source)
+{
+    return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(source)));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void StoreVec2(float * destination, __m128 value)
+{
+    _mm_storel_pi(reinterpret_cast<__m64 *>(destination), value);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] __m128 FlipUv(__m128 uv)
+{
+    // (0 + u, 1 - v)
+    auto const negateV = _mm_castsi128_ps(_mm_set_epi32(0, 0, static_cast<int>(0x80000000U), 0));
+    return _mm_add_ps(_mm_xor_ps(uv, negateV), _mm_set_ps(0.0F, 0.0F, 1.0F, 0.0F));
+}
+
+#endif
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const char * Gris::Graphics::VertexKernelInstructionSet()
+{
+#if defined(GRIS_VERTEX_KERNELS_AVX2)
+    return "AVX2";
+#elif defined(GRIS_VERTEX_KERNELS_SSE4)
+    return "SSE4.1";
+#else
+    return "Scalar";
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::CopyVec3(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count)
+{
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Four wide loads read one float past the element, which is still inside the source for all but the last one
+    for (size_t index = 0; index + 1 < count; ++index)
+    {
+        StoreVec3(destination, _mm_loadu_ps(source));
+        source = Advance(source, sourceStride);
+        destination = Advance(destination, destinationStride);
+    }
+
+    ScalarCopyVec3(source, sourceStride, destination, destinationStride, 1);
+#else
+    ScalarCopyVec3(source, sourceStride, destination, destinationStride, count);
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::CopyFlippedUv(const float * source, size_t sourceStride, float * destination, size_t destinationStride, size_t count)
+{
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    for (size_t index = 0; index < count; ++index)
+    {
+        StoreVec2(destination, FlipUv(LoadVec2(source)));
+        source = Advance(source, sourceStride);
+        destination = Advance(destination, destinationStride);
+    }
+#else
+    ScalarCopyFlippedUv(source, sourceStride, destination, destinationStride, count);
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::FillVec2(float x, float y, float * destination, size_t destinationStride, size_t count)
+{
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    auto const value = _mm_set_ps(0.0F, 0.0F, y, x);
+    for (size_t index = 0; index < count; ++index)
+    {
+        StoreVec2(destination, value);
+        destination = Advance(destination, destinationStride);
+    }
+#else
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[0] = x;
+        destination[1] = y;
+        destination = Advance(destination, destinationStride);
+    }
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::FillVec3(float x, float y, float z, float * destination, size_t destinationStride, size_t count)
+{
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    auto const value = _mm_set_ps(0.0F, z, y, x);
+    for (size_t index = 0; index < count; ++index)
+    {
+        StoreVec3(destination, value);
+        destination = Advance(destination, destinationStride);
+    }
+#else
+    for (size_t index = 0; index < count; ++index)
+    {
+        destination[0] = x;
+        destination[1] = y;
+        destination[2] = z;
+        destination = Advance(destination, destinationStride);
+    }
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::GatherVec3(const float * source, size_t sourceCount, const int32_t * indices, size_t indexStride, float * destination, size_t destinationStride, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        auto const sourceIndex = static_cast<size_t>(*indices);
+        GRIS_FAST_ASSERT(*indices >= 0 && sourceIndex < sourceCount, "Gather index out of range");
+
+        auto const * const element = source + 3 * sourceIndex;
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+        if (sourceIndex + 1 < sourceCount)
+        {
+            StoreVec3(destination, _mm_loadu_ps(element));
+        }
+        else
+        {
+            std::memcpy(destination, element, 3 * sizeof(float));
+        }
+#else
+        std::memcpy(destination, element, 3 * sizeof(float));
+#endif
+
+        indices = Advance(indices, indexStride);
+        destination = Advance(destination, destinationStride);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::GatherFlippedUv(const float * source, size_t sourceCount, const int32_t * indices, size_t indexStride, float * destination, size_t destinationStride, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        auto const sourceIndex = static_cast<size_t>(*indices);
+        GRIS_FAST_ASSERT(*indices >= 0 && sourceIndex < sourceCount, "Gather index out of range");
+
+        auto const * const element = source + 2 * sourceIndex;
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+        StoreVec2(destination, FlipUv(LoadVec2(element)));
+#else
+        ScalarCopyFlippedUv(element, 0, destination, 0, 1);
+#endif
+
+        indices = Advance(indices, indexStride);
+        destination = Advance(destination, destinationStride);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::PackHalf(const float * source, uint16_t * destination, size_t count)
+{
+    size_t index = 0;
+#if defined(GRIS_VERTEX_KERNELS_AVX2)
+    // F16C comes with every AVX2 CPU
+    for (; index + 8 <= count; index += 8)
+    {
+        auto const halves = _mm256_cvtps_ph(_mm256_loadu_ps(source + index), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), halves);
+    }
+#endif
+
+    ScalarPackHalf(source + index, destination + index, count - index);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::PackSnorm16(const float * source, int16_t * destination, size_t count)
+{
+    size_t index = 0;
+#if defined(GRIS_VERTEX_KERNELS_AVX2)
+    {
+        auto const minimum = _mm256_set1_ps(-1.0F);
+        auto const maximum = _mm256_set1_ps(1.0F);
+        auto const scale = _mm256_set1_ps(32767.0F);
+        for (; index + 16 <= count; index += 16)
+        {
+            auto const low = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + index), minimum), maximum), scale));
+            auto const high = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + index + 8), minimum), maximum), scale));
+            // Packing works per 128 bit lane, the permute puts the quarters back in order
+            auto const packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index), packed);
+        }
+    }
+#endif
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    {
+        auto const minimum = _mm_set1_ps(-1.0F);
+        auto const maximum = _mm_set1_ps(1.0F);
+        auto const scale = _mm_set1_ps(32767.0F);
+        for (; index + 8 <= count; index += 8)
+        {
+            auto const low = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + index), minimum), maximum), scale));
+            auto const high = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + index + 4), minimum), maximum), scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), _mm_packs_epi32(low, high));
+        }
+    }
+#endif
+
+    ScalarPackSnorm16(source + index, destination + index, count - index);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::PackUnorm16(const float * source, uint16_t * destination, size_t count)
+{
+    size_t index = 0;
+#if defined(GRIS_VERTEX_KERNELS_AVX2)
+    {
+        auto const minimum = _mm256_set1_ps(0.0F);
+        auto const maximum = _mm256_set1_ps(1.0F);
+        auto const scale = _mm256_set1_ps(65535.0F);
+        for (; index + 16 <= count; index += 16)
+        {
+            auto const low = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + index), minimum), maximum), scale));
+            auto const high = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + index + 8), minimum), maximum), scale));
+            auto const packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(low, high), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + index), packed);
+        }
+    }
+#endif
+#if defined(GRIS_VERTEX_KERNELS_SSE4)
+    {
+        auto const minimum = _mm_set1_ps(0.0F);
+        auto const maximum = _mm_set1_ps(1.0F);
+        auto const scale = _mm_set1_ps(65535.0F);
+        for (; index + 8 <= count; index += 8)
+        {
+            auto const low = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + index), minimum), maximum), scale));
+            auto const high = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + index + 4), minimum), maximum), scale));
+            // The unsigned saturating pack is the SSE4.1 part
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + index), _mm_packus_epi32(low, high));
+        }
+    }
+#endif
+
+    ScalarPackUnorm16(source + index, destination + index, count - index);
+}
@@ -87,6 +87,22 @@ Gris::Graphics::Vulkan::Allocator::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::Allocation Gris::Graphics::Vulkan::Allocator::AllocateMemory(const vk::MemoryRequirements & memoryRequirements, const VmaAllocationCreateInfo & allocationCreateInfo) const
+{
+    auto const requirements = static_cast<VkMemoryRequirements>(memoryRequirements);
+
+    VmaAllocation allocation = nullptr;
+    auto const allocateResult = static_cast<vk::Result>(vmaAllocateMemory(m_allocator, &requirements, &allocationCreateInfo, &allocation, nullptr));
+    if (allocateResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error allocating memory from VMA", vk::to_string(allocateResult));
+    }
+
+    return Allocation(allocation, *this);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::Allocator::FreeMemory(const VmaAllocation & allocation) const
 {
     vmaFreeMemory(m_allocator, allocation);
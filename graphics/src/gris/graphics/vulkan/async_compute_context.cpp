@@ -0,0 +1,214 @@
+#include <gris/graphics/vulkan/async_compute_context.h>
+
+#include <gris/graphics/vulkan/deferred_context.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/utils.h>
+#include <gris/graphics/vulkan/vulkan_engine_exception.h>
+
+#include <gris/assert.h>
+
+#include <array>
+#include <mutex>
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext::AsyncComputeContext() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext::AsyncComputeContext(const ParentObject<Device> & device, uint32_t queueIndex)
+    : DeviceResource(device)
+{
+    GRIS_ALWAYS_ASSERT(ParentDevice().HasTimelineSemaphores(), "Async compute joins require timeline semaphores");
+
+    auto const queue = SelectAsyncComputeQueue(ParentDevice().QueueFamilies(), ParentDevice().AsyncComputeQueueCount(), queueIndex);
+    m_queueFamily = queue.QueueFamily;
+    m_async = queue.IsAsync;
+
+    m_queue = DeviceHandle().getQueue(m_queueFamily, queue.QueueIndex, Dispatch());
+    m_queueMutex = std::make_unique<std::mutex>();
+    m_timeline = ParentDevice().CreateTimelineSemaphore(m_lastSubmittedValue);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext::AsyncComputeContext(AsyncComputeContext && other) noexcept
+    : DeviceResource(std::move(other))
+    , m_queue(std::exchange(other.m_queue, {}))
+    , m_queueFamily(std::exchange(other.m_queueFamily, 0))
+    , m_async(std::exchange(other.m_async, false))
+    , m_queueMutex(std::move(other.m_queueMutex))
+    , m_timeline(std::exchange(other.m_timeline, {}))
+    , m_lastSubmittedValue(other.m_lastSubmittedValue.exchange(0))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext & Gris::Graphics::Vulkan::AsyncComputeContext::operator=(AsyncComputeContext && other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseResources();
+
+        DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
+        m_queue = std::exchange(other.m_queue, {});
+        m_queueFamily = std::exchange(other.m_queueFamily, 0);
+        m_async = std::exchange(other.m_async, false);
+        m_queueMutex = std::move(other.m_queueMutex);
+        m_timeline = std::exchange(other.m_timeline, {});
+        m_lastSubmittedValue = other.m_lastSubmittedValue.exchange(0);
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext::~AsyncComputeContext()
+{
+    ReleaseResources();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::AsyncComputeContext::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::AsyncComputeContext::IsValid() const
+{
+    return IsDeviceValid() && static_cast<bool>(m_queue) && static_cast<bool>(m_timeline);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::AsyncComputeContext::IsAsync() const
+{
+    return m_async;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::AsyncComputeContext::QueueFamily() const
+{
+    return m_queueFamily;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeferredContext Gris::Graphics::Vulkan::AsyncComputeContext::CreateDeferredContext(bool transientCommandBuffers) const
+{
+    return ParentDevice().CreateDeferredContext(transientCommandBuffers, m_queueFamily);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::AsyncComputeContext::Submit(DeferredContext & context, const std::vector<TimelineSemaphoreWait> & timelineWaits)
+{
+    auto waitSemaphores = std::vector<vk::Semaphore>{};
+    auto waitStages = std::vector<vk::PipelineStageFlags>{};
+    auto waitValues = std::vector<uint64_t>{};
+    for (auto const & timelineWait : timelineWaits)
+    {
+        waitSemaphores.emplace_back(timelineWait.Timeline.get().SemaphoreHandle());
+        waitStages.emplace_back(timelineWait.StageMask);
+        waitValues.emplace_back(timelineWait.Value);
+    }
+
+    // Timeline values have to reach the queue in increasing order, so the value is taken under the queue lock. The
+    // fallback shares the queue with the immediate context and takes its lock.
+    auto const queueLock = m_async ? std::unique_lock(*m_queueMutex) : ParentDevice().Context().LockQueue();
+    auto const submittedValue = m_lastSubmittedValue.load() + 1;
+
+    auto const signalSemaphores = std::array{ m_timeline.SemaphoreHandle() };
+    auto const signalValues = std::array{ submittedValue };
+
+    auto const timelineInfo = vk::TimelineSemaphoreSubmitInfo{}
+                                  .setWaitSemaphoreValues(waitValues)
+                                  .setSignalSemaphoreValues(signalValues);
+
+    auto const commandBuffers = std::array{ context.CommandBufferHandle() };
+    auto const submits = std::array{ vk::SubmitInfo{}
+                                         .setPNext(&timelineInfo)
+                                         .setWaitSemaphores(waitSemaphores)
+                                         .setWaitDstStageMask(waitStages)
+                                         .setCommandBuffers(commandBuffers)
+                                         .setSignalSemaphores(signalSemaphores) };
+
+    auto const submitResult = m_queue.submit(submits, {}, Dispatch());
+    if (submitResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error submitting to async compute queue", submitResult);
+    }
+
+    m_lastSubmittedValue = submittedValue;
+    return submittedValue;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::TimelineSemaphore & Gris::Graphics::Vulkan::AsyncComputeContext::Timeline() const
+{
+    return m_timeline;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::AsyncComputeContext::LastSubmittedValue() const
+{
+    return m_lastSubmittedValue;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::AsyncComputeContext::CompletedValue() const
+{
+    return m_timeline.CompletedValue();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::AsyncComputeContext::WaitForValue(uint64_t value) const
+{
+    GRIS_FAST_ASSERT(value <= m_lastSubmittedValue, "Waiting for a compute timeline value that was never submitted");
+    m_timeline.Wait(value);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::TimelineSemaphoreWait Gris::Graphics::Vulkan::AsyncComputeContext::JoinWait(uint64_t value, const vk::PipelineStageFlags & stageMask) const
+{
+    GRIS_FAST_ASSERT(value <= m_lastSubmittedValue, "Joining on a compute timeline value that was never submitted");
+    return TimelineSemaphoreWait{ m_timeline, value, stageMask };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::AsyncComputeContext::Reset()
+{
+    ReleaseResources();
+    ResetParent();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::AsyncComputeContext::ReleaseResources()
+{
+    // The queue is owned by the device, only the timeline has to go. Deferred destruction follows the graphics queue,
+    // so the compute work signaling the timeline is waited on here
+    if (m_timeline && m_lastSubmittedValue > 0)
+    {
+        m_timeline.Wait(m_lastSubmittedValue);
+    }
+
+    m_timeline.Reset();
+    m_lastSubmittedValue = 0;
+    m_queueMutex.reset();
+    m_async = false;
+    m_queueFamily = 0;
+    m_queue = nullptr;
+}
@@ -0,0 +1,296 @@
+#include <gris/graphics/vulkan/barrier_batch.h>
+
+#include <gris/graphics/vulkan/buffer.h>
+
+#include <gris/assert.h>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+const vk::AccessFlags WRITE_ACCESS = vk::AccessFlagBits::eShaderWrite
+                                     | vk::AccessFlagBits::eColorAttachmentWrite
+                                     | vk::AccessFlagBits::eDepthStencilAttachmentWrite
+                                     | vk::AccessFlagBits::eTransferWrite
+                                     | vk::AccessFlagBits::eHostWrite
+                                     | vk::AccessFlagBits::eMemoryWrite;
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool IsWrite(const vk::AccessFlags & access)
+{
+    return static_cast<bool>(access & WRITE_ACCESS);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool IsSameState(const Gris::Graphics::Vulkan::TextureState & lhs, const Gris::Graphics::Vulkan::TextureState & rhs)
+{
+    return lhs.Layout == rhs.Layout && lhs.Access == rhs.Access && lhs.Stages == rhs.Stages;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+struct Transition
+{
+    bool NeedsBarrier = false;
+    Gris::Graphics::Vulkan::TextureState Source = {};
+    Gris::Graphics::Vulkan::TextureState Next = {};
+};
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Transition ComputeTransition(const Gris::Graphics::Vulkan::TextureState & previous, const Gris::Graphics::Vulkan::TextureState & state)
+{
+    if (previous.Layout == state.Layout && !IsWrite(previous.Access) && !IsWrite(state.Access))
+    {
+        auto const next = Gris::Graphics::Vulkan::TextureState{ state.Layout, previous.Access | state.Access, previous.Stages | state.Stages, previous.WriteAccess, previous.WriteStages };
+
+        // Reads in the same layout do not need a barrier as long as an earlier one already made the last write visible
+        // to the new access and stages, later writers have to wait on all of them though
+        auto const isCovered = (state.Access & ~previous.Access) == vk::AccessFlags{} && (state.Stages & ~previous.Stages) == vk::PipelineStageFlags{};
+        if (isCovered || !previous.WriteStages)
+        {
+            return Transition{ false, {}, next };
+        }
+
+        return Transition{ true, Gris::Graphics::Vulkan::TextureState{ state.Layout, previous.WriteAccess, previous.WriteStages }, next };
+    }
+
+    auto next = state;
+    if (IsWrite(state.Access))
+    {
+        next.WriteAccess = state.Access & WRITE_ACCESS;
+        next.WriteStages = state.Stages;
+    }
+    else
+    {
+        // Later reads wait on the write through its stages, or on the layout transition by chaining to this barrier
+        next.WriteAccess = IsWrite(previous.Access) ? previous.Access & WRITE_ACCESS : vk::AccessFlags{};
+        next.WriteStages = IsWrite(previous.Access) ? previous.Stages : vk::PipelineStageFlags{};
+        if (previous.Layout != state.Layout)
+        {
+            next.WriteStages |= state.Stages;
+        }
+    }
+
+    return Transition{ true, previous, next };
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::TextureState Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout layout)
+{
+    switch (layout)
+    {
+    case vk::ImageLayout::eUndefined:
+        return TextureState{ layout, {}, vk::PipelineStageFlagBits::eTopOfPipe };
+    case vk::ImageLayout::eTransferDstOptimal:
+        return TextureState{ layout, vk::AccessFlagBits::eTransferWrite, vk::PipelineStageFlagBits::eTransfer };
+    case vk::ImageLayout::eTransferSrcOptimal:
+        return TextureState{ layout, vk::AccessFlagBits::eTransferRead, vk::PipelineStageFlagBits::eTransfer };
+    case vk::ImageLayout::eShaderReadOnlyOptimal:
+        return TextureState{ layout, vk::AccessFlagBits::eShaderRead, vk::PipelineStageFlagBits::eFragmentShader };
+    case vk::ImageLayout::eColorAttachmentOptimal:
+        return TextureState{ layout, vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite, vk::PipelineStageFlagBits::eColorAttachmentOutput };
+    case vk::ImageLayout::eDepthStencilAttachmentOptimal:
+        return TextureState{ layout, vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite, vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests };
+    case vk::ImageLayout::ePresentSrcKHR:
+        return TextureState{ layout, {}, vk::PipelineStageFlagBits::eBottomOfPipe };
+    default:
+        return TextureState{ layout, vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite, vk::PipelineStageFlagBits::eAllCommands };
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::TransitionTexture(Texture & texture, const TextureState & state)
+{
+    TransitionTexture(texture, state, 0, texture.MipLevels());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::TransitionTexture(Texture & texture, const TextureState & state, uint32_t baseMipLevel, uint32_t mipLevelCount)
+{
+    GRIS_ALWAYS_ASSERT(baseMipLevel + mipLevelCount <= texture.MipLevels(), "Mip level range out of bounds");
+    GRIS_ALWAYS_ASSERT(state.Layout != vk::ImageLayout::eUndefined, "Cannot transition into the undefined layout");
+
+    // Consecutive mips waiting on the same source state are covered by a single barrier
+    auto runSource = TextureState{};
+    auto runBase = baseMipLevel;
+    auto runCount = 0U;
+
+    for (auto mipLevel = baseMipLevel; mipLevel < baseMipLevel + mipLevelCount; ++mipLevel)
+    {
+        auto const transition = ComputeTransition(texture.SubresourceState(mipLevel), state);
+
+        if (runCount > 0 && (!transition.NeedsBarrier || !IsSameState(runSource, transition.Source)))
+        {
+            AddImageBarrier(texture.ImageHandle(), texture.AspectMask(), runSource, state, runBase, runCount);
+            runCount = 0;
+        }
+
+        if (transition.NeedsBarrier)
+        {
+            if (runCount == 0)
+            {
+                runSource = transition.Source;
+                runBase = mipLevel;
+            }
+
+            ++runCount;
+        }
+
+        texture.SetSubresourceState(mipLevel, transition.Next);
+    }
+
+    if (runCount > 0)
+    {
+        AddImageBarrier(texture.ImageHandle(), texture.AspectMask(), runSource, state, runBase, runCount);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::TransitionImage(const vk::Image & image, const vk::ImageAspectFlags & aspectMask, TextureState & trackedState, const TextureState & state)
+{
+    GRIS_ALWAYS_ASSERT(state.Layout != vk::ImageLayout::eUndefined, "Cannot transition into the undefined layout");
+
+    auto const transition = ComputeTransition(trackedState, state);
+    if (transition.NeedsBarrier)
+    {
+        AddImageBarrier(image, aspectMask, transition.Source, state, 0, 1);
+    }
+
+    trackedState = transition.Next;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::AddBufferBarrier(
+    const Buffer & buffer,
+    const vk::AccessFlags & srcAccess,
+    const vk::PipelineStageFlags & srcStages,
+    const vk::AccessFlags & dstAccess,
+    const vk::PipelineStageFlags & dstStages)
+{
+    m_srcStages |= srcStages;
+    m_dstStages |= dstStages;
+    m_bufferBarriers.emplace_back(vk::BufferMemoryBarrier{}
+                                      .setSrcAccessMask(srcAccess)
+                                      .setDstAccessMask(dstAccess)
+                                      .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                                      .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                                      .setBuffer(buffer.BufferHandle())
+                                      .setOffset(0)
+                                      .setSize(VK_WHOLE_SIZE));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::AddBufferOwnershipTransfer(
+    const Buffer & buffer,
+    uint32_t srcQueueFamily,
+    uint32_t dstQueueFamily,
+    const vk::AccessFlags & srcAccess,
+    const vk::PipelineStageFlags & srcStages,
+    const vk::AccessFlags & dstAccess,
+    const vk::PipelineStageFlags & dstStages)
+{
+    // The same family needs no transfer, a regular barrier does
+    if (srcQueueFamily == dstQueueFamily)
+    {
+        AddBufferBarrier(buffer, srcAccess, srcStages, dstAccess, dstStages);
+        return;
+    }
+
+    m_srcStages |= srcStages;
+    m_dstStages |= dstStages;
+    m_bufferBarriers.emplace_back(vk::BufferMemoryBarrier{}
+                                      .setSrcAccessMask(srcAccess)
+                                      .setDstAccessMask(dstAccess)
+                                      .setSrcQueueFamilyIndex(srcQueueFamily)
+                                      .setDstQueueFamilyIndex(dstQueueFamily)
+                                      .setBuffer(buffer.BufferHandle())
+                                      .setOffset(0)
+                                      .setSize(VK_WHOLE_SIZE));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::BarrierBatch::IsEmpty() const
+{
+    return m_imageBarriers.empty() && m_bufferBarriers.empty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const vk::PipelineStageFlags & Gris::Graphics::Vulkan::BarrierBatch::SourceStages() const
+{
+    return m_srcStages;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const vk::PipelineStageFlags & Gris::Graphics::Vulkan::BarrierBatch::DestinationStages() const
+{
+    return m_dstStages;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const std::vector<vk::ImageMemoryBarrier> & Gris::Graphics::Vulkan::BarrierBatch::ImageBarriers() const
+{
+    return m_imageBarriers;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool Gris::Graphics::Vulkan::BarrierBatch::Record(const vk::CommandBuffer & commandBuffer, const vk::DispatchLoaderDynamic & dispatch)
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    commandBuffer.pipelineBarrier(m_srcStages, m_dstStages, {}, {}, m_bufferBarriers, m_imageBarriers, dispatch);
+    Clear();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::Clear()
+{
+    m_srcStages = {};
+    m_dstStages = {};
+    m_imageBarriers.clear();
+    m_bufferBarriers.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::BarrierBatch::AddImageBarrier(
+    const vk::Image & image,
+    const vk::ImageAspectFlags & aspectMask,
+    const TextureState & previous,
+    const TextureState & state,
+    uint32_t baseMipLevel,
+    uint32_t mipLevelCount)
+{
+    m_srcStages |= previous.Stages;
+    m_dstStages |= state.Stages;
+    m_imageBarriers.emplace_back(vk::ImageMemoryBarrier{}
+                                     .setSrcAccessMask(IsWrite(previous.Access) ? previous.Access & WRITE_ACCESS : vk::AccessFlags{})
+                                     .setDstAccessMask(state.Access)
+                                     .setOldLayout(previous.Layout)
+                                     .setNewLayout(state.Layout)
+                                     .setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                                     .setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+                                     .setImage(image)
+                                     .setSubresourceRange(vk::ImageSubresourceRange(aspectMask, baseMipLevel, mipLevelCount, 0, 1)));
+}
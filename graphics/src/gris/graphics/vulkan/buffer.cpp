@@ -1,6 +1,7 @@
 #include <gris/graphics/vulkan/buffer.h>
 
 #include <gris/graphics/vulkan/allocator.h>
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -45,6 +46,7 @@ Gris::Graphics::Vulkan::Buffer::Buffer(Buffer && other) noexcept
     , ParentObject(std::move(other))
     , m_buffer(std::exchange(other.m_buffer, {}))
     , m_bufferMemory(std::exchange(other.m_bufferMemory, {}))
+    , m_mappedData(std::exchange(other.m_mappedData, nullptr))
 {
 }
 
@@ -60,6 +62,7 @@ Gris::Graphics::Vulkan::Buffer & Gris::Graphics::Vulkan::Buffer::operator=(Buffe
         DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
         m_buffer = std::exchange(other.m_buffer, {});
         m_bufferMemory = std::exchange(other.m_bufferMemory, {});
+        m_mappedData = std::exchange(other.m_mappedData, nullptr);
     }
 
     return *this;
@@ -104,6 +107,12 @@ Gris::Graphics::Vulkan::Buffer::operator bool() const
 
 void Gris::Graphics::Vulkan::Buffer::SetData(const void * const data, size_t size)
 {
+    if (m_mappedData != nullptr)
+    {
+        memcpy(m_mappedData, data, size);
+        return;
+    }
+
     auto * const memoryPtr = AllocatorHandle().Map(m_bufferMemory);
     memcpy(memoryPtr, data, size);
     AllocatorHandle().Unmap(m_bufferMemory);
@@ -111,13 +120,20 @@ void Gris::Graphics::Vulkan::Buffer::SetData(const void * const data, size_t siz
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::Buffer::Reset()
+[[nodiscard]] void * Gris::Graphics::Vulkan::Buffer::MappedData()
 {
-    if (m_bufferMemory)
+    if (m_mappedData == nullptr)
     {
-        m_bufferMemory.Reset();
+        m_mappedData = AllocatorHandle().Map(m_bufferMemory);
     }
 
+    return m_mappedData;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Buffer::Reset()
+{
     ReleaseResources();
     ResetParent();
 }
@@ -128,7 +144,17 @@ void Gris::Graphics::Vulkan::Buffer::ReleaseResources()
 {
     if (m_buffer)
     {
-        DeviceHandle().destroyBuffer(m_buffer, nullptr, Dispatch());
-        m_buffer = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_buffer, {}));
+    }
+
+    if (m_mappedData != nullptr)
+    {
+        AllocatorHandle().Unmap(m_bufferMemory);
+        m_mappedData = nullptr;
+    }
+
+    if (m_bufferMemory)
+    {
+        ParentDevice().DestroyDeferred(std::exchange(m_bufferMemory, {}));
     }
 }
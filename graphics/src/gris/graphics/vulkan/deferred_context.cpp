@@ -1,11 +1,14 @@
 #include <gris/graphics/vulkan/deferred_context.h>
 
+#include <gris/graphics/vulkan/buffer.h>
 #include <gris/graphics/vulkan/buffer_view.h>
 #include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/framebuffer.h>
 #include <gris/graphics/vulkan/pipeline_state_object.h>
 #include <gris/graphics/vulkan/render_pass.h>
 #include <gris/graphics/vulkan/shader_resource_bindings.h>
+#include <gris/graphics/vulkan/texture.h>
+#include <gris/graphics/vulkan/utils.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 #include <gris/utils.h>
@@ -19,40 +22,15 @@ Gris::Graphics::Vulkan::DeferredContext::DeferredContext() = default;
 Gris::Graphics::Vulkan::DeferredContext::DeferredContext(const ParentObject<Device> & device, bool transientCommandBuffers)
     : DeviceResource(device)
 {
-    auto const queueFamilies = ParentDevice().QueueFamilies();
-    auto const graphicsQueueFamily = queueFamilies.graphicsFamily.value();
-
-    auto poolFlags = vk::CommandPoolCreateFlags{};
-    if (transientCommandBuffers)
-    {
-        poolFlags |= vk::CommandPoolCreateFlagBits::eTransient;
-    }
-
-    auto const poolInfo = vk::CommandPoolCreateInfo{}
-                              .setFlags(poolFlags)
-                              .setQueueFamilyIndex(graphicsQueueFamily);
-
-    auto const createCommandPoolResult = DeviceHandle().createCommandPool(poolInfo, nullptr, Dispatch());
-    if (createCommandPoolResult.result != vk::Result::eSuccess)
-    {
-        throw VulkanEngineException("Error creating command pool", createCommandPoolResult);
-    }
-
-    m_commandPool = createCommandPoolResult.value;
-
-    auto const allocInfo = vk::CommandBufferAllocateInfo{}
-                               .setCommandPool(m_commandPool)
-                               .setLevel(vk::CommandBufferLevel::ePrimary)
-                               .setCommandBufferCount(1);
+    CreateCommandBuffer(transientCommandBuffers, ParentDevice().QueueFamilies().graphicsFamily.value());
+}
 
-    auto allocateCommandBuffersResult = DeviceHandle().allocateCommandBuffers(allocInfo, Dispatch());
-    if (allocateCommandBuffersResult.result != vk::Result::eSuccess)
-    {
-        throw VulkanEngineException("Error allocating command buffers", allocateCommandBuffersResult);
-    }
+// -------------------------------------------------------------------------------------------------
 
-    GRIS_ALWAYS_ASSERT(allocateCommandBuffersResult.value.size() == 1, "Number of allocated command buffers should be one");
-    m_commandBuffer = allocateCommandBuffersResult.value.front();
+Gris::Graphics::Vulkan::DeferredContext::DeferredContext(const ParentObject<Device> & device, bool transientCommandBuffers, uint32_t queueFamily)
+    : DeviceResource(device)
+{
+    CreateCommandBuffer(transientCommandBuffers, queueFamily);
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -61,6 +39,9 @@ Gris::Graphics::Vulkan::DeferredContext::DeferredContext(DeferredContext && othe
     : DeviceResource(std::move(other))
     , m_commandPool(std::exchange(other.m_commandPool, {}))
     , m_commandBuffer(std::exchange(other.m_commandBuffer, {}))
+    , m_statistics(std::exchange(other.m_statistics, {}))
+    , m_barriers(std::exchange(other.m_barriers, {}))
+    , m_recordingVersion(std::exchange(other.m_recordingVersion, {}))
 {
 }
 
@@ -75,6 +56,9 @@ Gris::Graphics::Vulkan::DeferredContext & Gris::Graphics::Vulkan::DeferredContex
         DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
         m_commandPool = std::exchange(other.m_commandPool, {});
         m_commandBuffer = std::exchange(other.m_commandBuffer, {});
+        m_statistics = std::exchange(other.m_statistics, {});
+        m_barriers = std::exchange(other.m_barriers, {});
+        m_recordingVersion = std::exchange(other.m_recordingVersion, {});
     }
 
     return *this;
@@ -110,8 +94,19 @@ Gris::Graphics::Vulkan::DeferredContext::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] const Gris::Graphics::Vulkan::DeferredContextStatistics & Gris::Graphics::Vulkan::DeferredContext::Statistics() const
+{
+    return m_statistics;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::DeferredContext::Begin(bool oneTimeUse)
 {
+    m_statistics = {};
+    m_barriers.Clear();
+    m_recordingVersion.reset();
+
     auto beginInfo = vk::CommandBufferBeginInfo{};
     if (oneTimeUse)
     {
@@ -127,18 +122,45 @@ void Gris::Graphics::Vulkan::DeferredContext::Begin(bool oneTimeUse)
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] bool Gris::Graphics::Vulkan::DeferredContext::HasRecording(uint64_t version) const
+{
+    return m_recordingVersion == version;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::BeginReusable(uint64_t version)
+{
+    // Without one time submit the recording survives submission, re-recording needs an explicit reset
+    ResetContext(false);
+    Begin(false);
+    m_recordingVersion = version;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::DeferredContext::BeginRenderPass(const RenderPass & renderPass, const Framebuffer & framebuffer, const vk::Extent2D & extent)
 {
-    std::array<vk::ClearValue, 2> clearValues = {
+    auto const clearValues = std::array<vk::ClearValue, 2>{
         vk::ClearColorValue(std::array{ 0.0F, 0.0F, 0.0F, 1.0F }),
         vk::ClearDepthStencilValue(1.0F, 0)
     };
 
+    BeginRenderPass(renderPass, framebuffer, extent, clearValues);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::BeginRenderPass(const RenderPass & renderPass, const Framebuffer & framebuffer, const vk::Extent2D & extent, Span<const vk::ClearValue> clearValues)
+{
+    FlushBarriers();
+
     auto const renderPassInfo = vk::RenderPassBeginInfo{}
                                     .setRenderPass(renderPass.RenderPassHandle())
                                     .setFramebuffer(framebuffer.FramebufferHandle())
                                     .setRenderArea(vk::Rect2D({ 0, 0 }, extent))
-                                    .setClearValues(clearValues);
+                                    .setClearValueCount(static_cast<uint32_t>(clearValues.size()))
+                                    .setPClearValues(clearValues.data());
 
     m_commandBuffer.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline, Dispatch());
 }
@@ -148,22 +170,32 @@ void Gris::Graphics::Vulkan::DeferredContext::BeginRenderPass(const RenderPass &
 void Gris::Graphics::Vulkan::DeferredContext::BindPipeline(const PipelineStateObject & pso)
 {
     m_commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pso.GraphicsPipelineHandle(), Dispatch());
+    ++m_statistics.PipelineBinds;
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void Gris::Graphics::Vulkan::DeferredContext::BindVertexBuffer(const BufferView & bufferView)
+{
+    BindVertexBuffer(0, bufferView);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::BindVertexBuffer(uint32_t binding, const BufferView & bufferView)
 {
     std::array vertexBuffers = { bufferView.BufferHandle() };
     std::array offsets = { static_cast<vk::DeviceSize>(bufferView.Offset()) };
-    m_commandBuffer.bindVertexBuffers(0, vertexBuffers, offsets, Dispatch());
+    m_commandBuffer.bindVertexBuffers(binding, vertexBuffers, offsets, Dispatch());
+    ++m_statistics.VertexBufferBinds;
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::DeferredContext::BindIndexBuffer(const BufferView & bufferView)
+void Gris::Graphics::Vulkan::DeferredContext::BindIndexBuffer(const BufferView & bufferView, IndexFormat indexFormat)
 {
-    m_commandBuffer.bindIndexBuffer(bufferView.BufferHandle(), bufferView.Offset(), vk::IndexType::eUint32, Dispatch());
+    m_commandBuffer.bindIndexBuffer(bufferView.BufferHandle(), bufferView.Offset(), ToVulkanIndexType(indexFormat), Dispatch());
+    ++m_statistics.IndexBufferBinds;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -174,13 +206,17 @@ void Gris::Graphics::Vulkan::DeferredContext::BindDescriptorSet(const PipelineSt
     std::transform(std::begin(shaderResourceBindings), std::end(shaderResourceBindings), std::back_inserter(descriptorSets), [](auto const & srb)
                    { return srb.DescriptorSetHandle(); });
     m_commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pso.PipelineLayoutHandle(), startSetIndex, descriptorSets, {}, Dispatch());
+    m_statistics.DescriptorSetBinds += static_cast<uint32_t>(descriptorSets.size());
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void Gris::Graphics::Vulkan::DeferredContext::DrawIndexed(uint32_t indexCount)
 {
+    FlushBarriers();
+
     m_commandBuffer.drawIndexed(indexCount, 1, 0, 0, 0, Dispatch());
+    ++m_statistics.DrawCalls;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -222,8 +258,81 @@ void Gris::Graphics::Vulkan::DeferredContext::EndRenderPass()
 
 // -------------------------------------------------------------------------------------------------
 
+void Gris::Graphics::Vulkan::DeferredContext::TransitionTexture(Texture & texture, const TextureState & state)
+{
+    m_barriers.TransitionTexture(texture, state);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::TransitionTexture(Texture & texture, const TextureState & state, uint32_t baseMipLevel, uint32_t mipLevelCount)
+{
+    m_barriers.TransitionTexture(texture, state, baseMipLevel, mipLevelCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::TransitionImage(const vk::Image & image, const vk::ImageAspectFlags & aspectMask, TextureState & trackedState, const TextureState & state)
+{
+    m_barriers.TransitionImage(image, aspectMask, trackedState, state);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::AddBufferBarrier(
+    const Buffer & buffer,
+    const vk::AccessFlags & srcAccess,
+    const vk::PipelineStageFlags & srcStages,
+    const vk::AccessFlags & dstAccess,
+    const vk::PipelineStageFlags & dstStages)
+{
+    m_barriers.AddBufferBarrier(buffer, srcAccess, srcStages, dstAccess, dstStages);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::FlushBarriers()
+{
+    if (m_barriers.Record(m_commandBuffer, Dispatch()))
+    {
+        ++m_statistics.PipelineBarriers;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::ResetQueryPool(const vk::QueryPool & queryPool, uint32_t firstQuery, uint32_t queryCount)
+{
+    m_commandBuffer.resetQueryPool(queryPool, firstQuery, queryCount, Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::WriteTimestamp(vk::PipelineStageFlagBits stage, const vk::QueryPool & queryPool, uint32_t query)
+{
+    m_commandBuffer.writeTimestamp(stage, queryPool, query, Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::BeginQuery(const vk::QueryPool & queryPool, uint32_t query)
+{
+    m_commandBuffer.beginQuery(queryPool, query, {}, Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::EndQuery(const vk::QueryPool & queryPool, uint32_t query)
+{
+    m_commandBuffer.endQuery(queryPool, query, Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::DeferredContext::End()
 {
+    FlushBarriers();
+
     auto const endResult = m_commandBuffer.end(Dispatch());
     if (endResult != vk::Result::eSuccess)
     {
@@ -241,6 +350,8 @@ void Gris::Graphics::Vulkan::DeferredContext::ResetContext(bool releaseResources
         flags |= vk::CommandPoolResetFlagBits::eReleaseResources;
     }
 
+    m_recordingVersion.reset();
+
     DeviceHandle().resetCommandPool(m_commandPool, flags, Dispatch());
 }
 
@@ -254,18 +365,53 @@ void Gris::Graphics::Vulkan::DeferredContext::Reset()
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::DeferredContext::ReleaseResources()
+void Gris::Graphics::Vulkan::DeferredContext::CreateCommandBuffer(bool transientCommandBuffers, uint32_t queueFamily)
 {
-    if (m_commandBuffer)
+    auto poolFlags = vk::CommandPoolCreateFlags{};
+    if (transientCommandBuffers)
+    {
+        poolFlags |= vk::CommandPoolCreateFlagBits::eTransient;
+    }
+
+    auto const poolInfo = vk::CommandPoolCreateInfo{}
+                              .setFlags(poolFlags)
+                              .setQueueFamilyIndex(queueFamily);
+
+    auto const createCommandPoolResult = DeviceHandle().createCommandPool(poolInfo, nullptr, Dispatch());
+    if (createCommandPoolResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error creating command pool", createCommandPoolResult);
+    }
+
+    m_commandPool = createCommandPoolResult.value;
+
+    auto const allocInfo = vk::CommandBufferAllocateInfo{}
+                               .setCommandPool(m_commandPool)
+                               .setLevel(vk::CommandBufferLevel::ePrimary)
+                               .setCommandBufferCount(1);
+
+    auto allocateCommandBuffersResult = DeviceHandle().allocateCommandBuffers(allocInfo, Dispatch());
+    if (allocateCommandBuffersResult.result != vk::Result::eSuccess)
     {
-        auto commandBuffers = { m_commandBuffer };
-        DeviceHandle().freeCommandBuffers(m_commandPool, commandBuffers, Dispatch());
-        m_commandBuffer = nullptr;
+        throw VulkanEngineException("Error allocating command buffers", allocateCommandBuffersResult);
     }
 
+    GRIS_ALWAYS_ASSERT(allocateCommandBuffersResult.value.size() == 1, "Number of allocated command buffers should be one");
+    m_commandBuffer = allocateCommandBuffersResult.value.front();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredContext::ReleaseResources()
+{
+    m_barriers.Clear();
+    m_recordingVersion.reset();
+
+    // The command buffer may still be pending, destroying the pool frees it once it is not
+    m_commandBuffer = nullptr;
+
     if (m_commandPool)
     {
-        DeviceHandle().destroyCommandPool(m_commandPool, nullptr, Dispatch());
-        m_commandPool = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_commandPool, {}));
     }
 }
@@ -0,0 +1,47 @@
+#include <gris/graphics/vulkan/deferred_destruction_queue.h>
+
+#include <gris/assert.h>
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredDestructionQueue::Enqueue(uint64_t value, DeferredDestruction object)
+{
+    GRIS_FAST_ASSERT(m_pending.empty() || m_pending.back().Value <= value, "Deferred destructions must be enqueued in timeline order");
+    m_pending.emplace_back(PendingDestruction{ value, std::move(object) });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredDestructionQueue::Collect(uint64_t completedValue, const DestroyFunction & destroy)
+{
+    while (!m_pending.empty() && m_pending.front().Value <= completedValue)
+    {
+        destroy(m_pending.front().Object);
+        m_pending.pop_front();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeferredDestructionQueue::Flush(const DestroyFunction & destroy)
+{
+    while (!m_pending.empty())
+    {
+        destroy(m_pending.front().Object);
+        m_pending.pop_front();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::DeferredDestructionQueue::IsEmpty() const
+{
+    return m_pending.empty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::Vulkan::DeferredDestructionQueue::PendingCount() const
+{
+    return m_pending.size();
+}
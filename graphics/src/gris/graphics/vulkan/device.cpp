@@ -1,13 +1,17 @@
 #include <gris/graphics/vulkan/device.h>
 
+#include <gris/graphics/vulkan/async_compute_context.h>
 #include <gris/graphics/vulkan/buffer.h>
 #include <gris/graphics/vulkan/deferred_context.h>
 #include <gris/graphics/vulkan/fence.h>
+#include <gris/graphics/vulkan/frame_graph.h>
 #include <gris/graphics/vulkan/framebuffer.h>
+#include <gris/graphics/vulkan/gpu_profiler.h>
 #include <gris/graphics/vulkan/immediate_context.h>
 #include <gris/graphics/vulkan/instance.h>
 #include <gris/graphics/vulkan/pipeline_state_object.h>
 #include <gris/graphics/vulkan/render_pass.h>
+#include <gris/graphics/vulkan/render_target_ring.h>
 #include <gris/graphics/vulkan/sampler.h>
 #include <gris/graphics/vulkan/semaphore.h>
 #include <gris/graphics/vulkan/shader.h>
@@ -17,8 +21,185 @@
 #include <gris/graphics/vulkan/swap_chain.h>
 #include <gris/graphics/vulkan/texture.h>
 #include <gris/graphics/vulkan/texture_view.h>
+#include <gris/graphics/vulkan/timeline_semaphore.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
+#include <gris/assert.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+template<typename T>
+[[nodiscard]] uint64_t KeyWord(T value)
+{
+    return static_cast<uint64_t>(value);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+template<typename BitT>
+[[nodiscard]] uint64_t KeyWord(vk::Flags<BitT> flags)
+{
+    return static_cast<uint64_t>(static_cast<typename vk::Flags<BitT>::MaskType>(flags));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+template<typename HandleT>
+[[nodiscard]] uint64_t HandleKeyWord(HandleT handle)
+{
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<typename HandleT::CType>(handle)));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceObjectCacheKey SamplerKey(const vk::SamplerCreateInfo & samplerInfo)
+{
+    GRIS_ALWAYS_ASSERT(samplerInfo.pNext == nullptr, "Cached samplers cannot have extension structures");
+
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(KeyWord(samplerInfo.flags));
+    key.Append(KeyWord(samplerInfo.magFilter));
+    key.Append(KeyWord(samplerInfo.minFilter));
+    key.Append(KeyWord(samplerInfo.mipmapMode));
+    key.Append(KeyWord(samplerInfo.addressModeU));
+    key.Append(KeyWord(samplerInfo.addressModeV));
+    key.Append(KeyWord(samplerInfo.addressModeW));
+    key.Append(samplerInfo.mipLodBias);
+    key.Append(KeyWord(samplerInfo.anisotropyEnable));
+    key.Append(samplerInfo.maxAnisotropy);
+    key.Append(KeyWord(samplerInfo.compareEnable));
+    key.Append(KeyWord(samplerInfo.compareOp));
+    key.Append(samplerInfo.minLod);
+    key.Append(samplerInfo.maxLod);
+    key.Append(KeyWord(samplerInfo.borderColor));
+    key.Append(KeyWord(samplerInfo.unnormalizedCoordinates));
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceObjectCacheKey ShaderResourceBindingsLayoutKey(const Gris::Graphics::Backend::ShaderResourceBindingsLayout & bindings)
+{
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(KeyWord(bindings.Layouts.size()));
+    for (auto const & layout : bindings.Layouts)
+    {
+        // The semantic is part of the object, it maps names to bindings
+        key.Append(layout.Semantic);
+        key.Append(KeyWord(layout.Binding));
+        key.Append(KeyWord(layout.Type));
+        key.Append(KeyWord(layout.Count));
+        key.Append(KeyWord(layout.Stages));
+    }
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void AppendAttachmentReferences(Gris::Graphics::Vulkan::DeviceObjectCacheKey & key, uint32_t count, const vk::AttachmentReference * references)
+{
+    if (references == nullptr)
+    {
+        key.Append(uint64_t{ 0 });
+        return;
+    }
+
+    key.Append(KeyWord(count));
+    for (uint32_t referenceIndex = 0; referenceIndex < count; ++referenceIndex)
+    {
+        key.Append(KeyWord(references[referenceIndex].attachment));
+        key.Append(KeyWord(references[referenceIndex].layout));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceObjectCacheKey RenderPassKey(const vk::RenderPassCreateInfo & renderPassInfo)
+{
+    GRIS_ALWAYS_ASSERT(renderPassInfo.pNext == nullptr, "Cached render passes cannot have extension structures");
+
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(KeyWord(renderPassInfo.flags));
+
+    key.Append(KeyWord(renderPassInfo.attachmentCount));
+    for (uint32_t attachmentIndex = 0; attachmentIndex < renderPassInfo.attachmentCount; ++attachmentIndex)
+    {
+        auto const & attachment = renderPassInfo.pAttachments[attachmentIndex];
+        key.Append(KeyWord(attachment.flags));
+        key.Append(KeyWord(attachment.format));
+        key.Append(KeyWord(attachment.samples));
+        key.Append(KeyWord(attachment.loadOp));
+        key.Append(KeyWord(attachment.storeOp));
+        key.Append(KeyWord(attachment.stencilLoadOp));
+        key.Append(KeyWord(attachment.stencilStoreOp));
+        key.Append(KeyWord(attachment.initialLayout));
+        key.Append(KeyWord(attachment.finalLayout));
+    }
+
+    key.Append(KeyWord(renderPassInfo.subpassCount));
+    for (uint32_t subpassIndex = 0; subpassIndex < renderPassInfo.subpassCount; ++subpassIndex)
+    {
+        auto const & subpass = renderPassInfo.pSubpasses[subpassIndex];
+        key.Append(KeyWord(subpass.flags));
+        key.Append(KeyWord(subpass.pipelineBindPoint));
+        AppendAttachmentReferences(key, subpass.inputAttachmentCount, subpass.pInputAttachments);
+        AppendAttachmentReferences(key, subpass.colorAttachmentCount, subpass.pColorAttachments);
+        AppendAttachmentReferences(key, subpass.colorAttachmentCount, subpass.pResolveAttachments);
+        AppendAttachmentReferences(key, 1, subpass.pDepthStencilAttachment);
+        key.Append(Gris::Span<const uint32_t>(subpass.pPreserveAttachments, subpass.preserveAttachmentCount));
+    }
+
+    key.Append(KeyWord(renderPassInfo.dependencyCount));
+    for (uint32_t dependencyIndex = 0; dependencyIndex < renderPassInfo.dependencyCount; ++dependencyIndex)
+    {
+        auto const & dependency = renderPassInfo.pDependencies[dependencyIndex];
+        key.Append(KeyWord(dependency.srcSubpass));
+        key.Append(KeyWord(dependency.dstSubpass));
+        key.Append(KeyWord(dependency.srcStageMask));
+        key.Append(KeyWord(dependency.dstStageMask));
+        key.Append(KeyWord(dependency.srcAccessMask));
+        key.Append(KeyWord(dependency.dstAccessMask));
+        key.Append(KeyWord(dependency.dependencyFlags));
+    }
+
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceObjectCacheKey FramebufferKey(Gris::Span<const vk::ImageView> attachments, const vk::RenderPass & renderPass, uint32_t width, uint32_t height)
+{
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(HandleKeyWord(renderPass));
+    key.Append(KeyWord(attachments.size()));
+    for (auto const & attachment : attachments)
+    {
+        key.Append(HandleKeyWord(attachment));
+    }
+    key.Append(KeyWord(width));
+    key.Append(KeyWord(height));
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceObjectCacheKey ShaderKey(const std::vector<uint32_t> & code, const std::string & entryPoint)
+{
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(Gris::Span<const uint32_t>(code));
+    key.Append(std::string_view(entryPoint));
+    return key;
+}
+
+}  // namespace
+
 // -------------------------------------------------------------------------------------------------
 
 Gris::Graphics::Vulkan::Device::Device() = default;
@@ -26,10 +207,19 @@ Gris::Graphics::Vulkan::Device::Device() = default;
 // -------------------------------------------------------------------------------------------------
 
 Gris::Graphics::Vulkan::Device::Device(PhysicalDevice physicalDevice)
+    : Device(std::move(physicalDevice), DeviceQueueConfiguration{})
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::Device::Device(PhysicalDevice physicalDevice, const DeviceQueueConfiguration & queueConfiguration)
     : m_physicalDevice(std::move(physicalDevice))
-    , m_device(m_physicalDevice.CreateDevice())
+    , m_device(m_physicalDevice.CreateDevice(queueConfiguration))
     , m_dispatch(Instance::CreateDispatch(m_device))
     , m_allocator(m_physicalDevice.CreateAllocator(m_device, m_dispatch))
+    , m_timelineSemaphores(m_physicalDevice.SupportsTimelineSemaphores())
+    , m_asyncComputeQueueCount(m_physicalDevice.AsyncComputeQueueCount(queueConfiguration))
     , m_context(*this)
 {
 }
@@ -42,8 +232,16 @@ Gris::Graphics::Vulkan::Device::Device(Device && other) noexcept
     , m_device(std::exchange(other.m_device, {}))
     , m_dispatch(std::exchange(other.m_dispatch, {}))
     , m_allocator(std::exchange(other.m_allocator, {}))
+    , m_timelineSemaphores(std::exchange(other.m_timelineSemaphores, false))
+    , m_asyncComputeQueueCount(std::exchange(other.m_asyncComputeQueueCount, 0))
     , m_context(std::exchange(other.m_context, {}))
+    , m_deferredDestructions(std::exchange(other.m_deferredDestructions, {}))
     , m_poolManagers(std::exchange(other.m_poolManagers, {}))
+    , m_samplerCache(std::exchange(other.m_samplerCache, {}))
+    , m_shaderResourceBindingsLayoutCache(std::exchange(other.m_shaderResourceBindingsLayoutCache, {}))
+    , m_renderPassCache(std::exchange(other.m_renderPassCache, {}))
+    , m_framebufferCache(std::exchange(other.m_framebufferCache, {}))
+    , m_shaderCache(std::exchange(other.m_shaderCache, {}))
 {
 }
 
@@ -60,8 +258,16 @@ Gris::Graphics::Vulkan::Device & Gris::Graphics::Vulkan::Device::operator=(Devic
         m_device = std::exchange(other.m_device, {});
         m_dispatch = std::exchange(other.m_dispatch, {});
         m_allocator = std::exchange(other.m_allocator, {});
+        m_timelineSemaphores = std::exchange(other.m_timelineSemaphores, false);
+        m_asyncComputeQueueCount = std::exchange(other.m_asyncComputeQueueCount, 0);
         m_context = std::exchange(other.m_context, {});
+        m_deferredDestructions = std::exchange(other.m_deferredDestructions, {});
         m_poolManagers = std::exchange(other.m_poolManagers, {});
+        m_samplerCache = std::exchange(other.m_samplerCache, {});
+        m_shaderResourceBindingsLayoutCache = std::exchange(other.m_shaderResourceBindingsLayoutCache, {});
+        m_renderPassCache = std::exchange(other.m_renderPassCache, {});
+        m_framebufferCache = std::exchange(other.m_framebufferCache, {});
+        m_shaderCache = std::exchange(other.m_shaderCache, {});
     }
 
     return *this;
@@ -111,6 +317,13 @@ Gris::Graphics::Vulkan::Device::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] float Gris::Graphics::Vulkan::Device::MaxAnisotropy() const
+{
+    return m_physicalDevice.MaxAnisotropy();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] const Gris::Graphics::Vulkan::DeviceQueueFamilyIndices & Gris::Graphics::Vulkan::Device::QueueFamilies() const
 {
     return m_physicalDevice.QueueFamilies();
@@ -118,6 +331,48 @@ Gris::Graphics::Vulkan::Device::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] vk::PhysicalDeviceProperties Gris::Graphics::Vulkan::Device::Properties() const
+{
+    return m_physicalDevice.Properties();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::PhysicalDeviceLimits Gris::Graphics::Vulkan::Device::Limits() const
+{
+    return m_physicalDevice.Properties().limits;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::QueueFamilyProperties Gris::Graphics::Vulkan::Device::QueueFamilyProperties(uint32_t queueFamily) const
+{
+    return m_physicalDevice.QueueFamilyProperties(queueFamily);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::PhysicalDeviceFeatures Gris::Graphics::Vulkan::Device::EnabledFeatures() const
+{
+    return m_physicalDevice.EnabledFeatures();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::Device::HasTimelineSemaphores() const
+{
+    return m_timelineSemaphores;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::Device::AsyncComputeQueueCount() const
+{
+    return m_asyncComputeQueueCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::SwapChainSupportDetails Gris::Graphics::Vulkan::Device::SwapChainSupport(const WindowMixin & window) const
 {
     return m_physicalDevice.SwapChainSupport(window);
@@ -203,6 +458,13 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::RenderTargetRing Gris::Graphics::Vulkan::Device::CreateRenderTargetRing(uint32_t width, uint32_t height, vk::Format format, uint32_t imageCount, uint32_t virtualFrameCount) const
+{
+    return RenderTargetRing(*this, width, height, format, imageCount, virtualFrameCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::DeferredContext Gris::Graphics::Vulkan::Device::CreateDeferredContext(bool transientCommandBuffers) const
 {
     return DeferredContext(*this, transientCommandBuffers);
@@ -210,6 +472,13 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::DeferredContext Gris::Graphics::Vulkan::Device::CreateDeferredContext(bool transientCommandBuffers, uint32_t queueFamily) const
+{
+    return DeferredContext(*this, transientCommandBuffers, queueFamily);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::Shader Gris::Graphics::Vulkan::Device::CreateShader(const std::vector<uint32_t> & code, std::string entryPoint) const
 {
     return Shader(*this, code, std::move(entryPoint));
@@ -275,6 +544,19 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::PipelineStateObject Gris::Graphics::Vulkan::Device::CreatePipelineStateObject(
+    std::optional<uint32_t> swapChainWidth,
+    std::optional<uint32_t> swapChainHeight,
+    const RenderPass & renderPass,
+    const InputLayout & inputLayout,
+    Span<const ShaderResourceBindingsLayout> resourceLayouts,
+    const Shader & vertexShader) const
+{
+    return PipelineStateObject(*this, swapChainWidth, swapChainHeight, renderPass, inputLayout, resourceLayouts, vertexShader);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::ShaderResourceBindings Gris::Graphics::Vulkan::Device::CreateShaderResourceBindings(const ParentObject<ShaderResourceBindingsLayout> & resourceLayout) const
 {
     return ShaderResourceBindings(*this, resourceLayout);
@@ -295,6 +577,13 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::Framebuffer Gris::Graphics::Vulkan::Device::CreateFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height) const
+{
+    return Framebuffer(*this, attachments, renderPass, width, height);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::Fence Gris::Graphics::Vulkan::Device::CreateFence(bool signaled) const
 {
     return Fence(*this, signaled);
@@ -309,6 +598,13 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::TimelineSemaphore Gris::Graphics::Vulkan::Device::CreateTimelineSemaphore(uint64_t initialValue) const
+{
+    return TimelineSemaphore(*this, initialValue);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::RenderPass Gris::Graphics::Vulkan::Device::CreateRenderPass(vk::Format swapChainFormat, vk::Format depthFormat) const
 {
     return RenderPass(*this, swapChainFormat, depthFormat);
@@ -316,6 +612,20 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::RenderPass Gris::Graphics::Vulkan::Device::CreateRenderPass(vk::Format swapChainFormat, vk::Format depthFormat, vk::ImageLayout finalLayout) const
+{
+    return RenderPass(*this, swapChainFormat, depthFormat, finalLayout);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::RenderPass Gris::Graphics::Vulkan::Device::CreateRenderPass(const vk::RenderPassCreateInfo & renderPassInfo) const
+{
+    return RenderPass(*this, renderPassInfo);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::ShaderResourceBindingsPoolCollection Gris::Graphics::Vulkan::Device::CreateShaderResourceBindingsPoolCollection() const
 {
     return ShaderResourceBindingsPoolCollection(*this);
@@ -337,6 +647,99 @@ vk::Device & Gris::Graphics::Vulkan::Device::DeviceHandle()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] Gris::Graphics::Vulkan::GpuProfiler Gris::Graphics::Vulkan::Device::CreateGpuProfiler(uint32_t virtualFrameCount, uint32_t maxZonesPerFrame) const
+{
+    return GpuProfiler(*this, virtualFrameCount, maxZonesPerFrame);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::FrameGraph Gris::Graphics::Vulkan::Device::CreateFrameGraph() const
+{
+    return FrameGraph(*this);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::AsyncComputeContext Gris::Graphics::Vulkan::Device::CreateAsyncComputeContext(uint32_t queueIndex) const
+{
+    return AsyncComputeContext(*this, queueIndex);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::Sampler> Gris::Graphics::Vulkan::Device::CachedSampler(float minLod, float maxLod)
+{
+    return CachedSampler(Sampler::CreateInfo(minLod, maxLod, MaxAnisotropy()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::Sampler> Gris::Graphics::Vulkan::Device::CachedSampler(const vk::SamplerCreateInfo & samplerInfo)
+{
+    return m_samplerCache.GetOrCreate(SamplerKey(samplerInfo), [this, &samplerInfo]()
+                                      { return Sampler(*this, samplerInfo); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::ShaderResourceBindingsLayout> Gris::Graphics::Vulkan::Device::CachedShaderResourceBindingsLayout(const Gris::Graphics::Backend::ShaderResourceBindingsLayout & bindings)
+{
+    return m_shaderResourceBindingsLayoutCache.GetOrCreate(ShaderResourceBindingsLayoutKey(bindings), [this, &bindings]()
+                                                           { return ShaderResourceBindingsLayout(*this, bindings); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::RenderPass> Gris::Graphics::Vulkan::Device::CachedRenderPass(const vk::RenderPassCreateInfo & renderPassInfo)
+{
+    return m_renderPassCache.GetOrCreate(RenderPassKey(renderPassInfo), [this, &renderPassInfo]()
+                                         { return RenderPass(*this, renderPassInfo); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::Framebuffer> Gris::Graphics::Vulkan::Device::CachedFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height)
+{
+    return m_framebufferCache.GetOrCreate(FramebufferKey(attachments, renderPass.RenderPassHandle(), width, height), [this, &attachments, &renderPass, width, height]()
+                                          { return Framebuffer(*this, attachments, renderPass, width, height); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::shared_ptr<const Gris::Graphics::Vulkan::Shader> Gris::Graphics::Vulkan::Device::CachedShader(const std::vector<uint32_t> & code, const std::string & entryPoint)
+{
+    return m_shaderCache.GetOrCreate(ShaderKey(code, entryPoint), [this, &code, &entryPoint]()
+                                     { return Shader(*this, code, entryPoint); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceCacheStatistics Gris::Graphics::Vulkan::Device::CacheStatistics() const
+{
+    auto statistics = DeviceCacheStatistics{};
+    statistics.Samplers = m_samplerCache.Statistics();
+    statistics.ShaderResourceBindingsLayouts = m_shaderResourceBindingsLayoutCache.Statistics();
+    statistics.RenderPasses = m_renderPassCache.Statistics();
+    statistics.Framebuffers = m_framebufferCache.Statistics();
+    statistics.Shaders = m_shaderCache.Statistics();
+    return statistics;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Device::TrimCaches()
+{
+    // Framebuffers first, they hold the render pass handles
+    m_framebufferCache.Trim();
+    m_renderPassCache.Trim();
+    m_samplerCache.Trim();
+    m_shaderResourceBindingsLayoutCache.Trim();
+    m_shaderCache.Trim();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] Gris::Graphics::Vulkan::ShaderResourceBindingsPool Gris::Graphics::Vulkan::Device::AllocateShaderResourceBindingsPool(Backend::ShaderResourceBindingsPoolCategory category)
 {
     auto it = std::find_if(std::begin(m_poolManagers), std::end(m_poolManagers), [&category](const auto & entry)
@@ -397,13 +800,90 @@ void Gris::Graphics::Vulkan::Device::Reset()
 
 // -------------------------------------------------------------------------------------------------
 
+void Gris::Graphics::Vulkan::Device::DestroyDeferred(DeferredDestruction object)
+{
+    // Cached framebuffers are keyed on these handles, a new object can get the same handle once this one is destroyed
+    if (auto const * imageView = std::get_if<vk::ImageView>(&object))
+    {
+        m_framebufferCache.EvictContaining(HandleKeyWord(*imageView));
+    }
+    else if (auto const * renderPass = std::get_if<vk::RenderPass>(&object))
+    {
+        m_framebufferCache.EvictContaining(HandleKeyWord(*renderPass));
+    }
+
+    if (!m_context)
+    {
+        Destroy(object);
+        return;
+    }
+
+    m_deferredDestructions.Enqueue(m_context.LastSubmittedValue(), std::move(object));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Device::CollectDeferredDestructions()
+{
+    m_deferredDestructions.Collect(m_context.CompletedValue(), [this](DeferredDestruction & object)
+                                   { Destroy(object); });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Device::Destroy(DeferredDestruction & object)
+{
+    std::visit(
+        [this](auto & handle)
+        {
+            using HandleType = std::decay_t<decltype(handle)>;
+            if constexpr (std::is_same_v<HandleType, Allocation>)
+            {
+                handle = {};
+            }
+            else
+            {
+                m_device.destroy(handle, nullptr, m_dispatch);
+            }
+        },
+        object);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Device::ClearCaches()
+{
+    m_framebufferCache.Clear();
+    m_renderPassCache.Clear();
+    m_samplerCache.Clear();
+    m_shaderResourceBindingsLayoutCache.Clear();
+    m_shaderCache.Clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::Device::ReleaseResources()
 {
+    // The cached objects and the descriptor pools release their handles through the deferred destruction queue flushed
+    // below
+    ClearCaches();
     m_poolManagers.clear();
 
+    if (m_device)
+    {
+        // Nothing the queue holds can still be in use once the device is idle
+        static_cast<void>(m_device.waitIdle(m_dispatch));
+        m_deferredDestructions.Flush([this](DeferredDestruction & object)
+                                     { Destroy(object); });
+    }
+
     if (m_context)
     {
         m_context.Reset();
+
+        // The context's own timeline semaphore is released through the queue too
+        m_deferredDestructions.Flush([this](DeferredDestruction & object)
+                                     { Destroy(object); });
     }
 
     if (m_allocator)
@@ -411,6 +891,8 @@ void Gris::Graphics::Vulkan::Device::ReleaseResources()
         m_allocator.Reset();
     }
 
+    m_timelineSemaphores = false;
+    m_asyncComputeQueueCount = 0;
     m_dispatch = {};
 
     if (m_device)
@@ -0,0 +1,76 @@
+#include <gris/graphics/vulkan/device_object_cache.h>
+
+#include <algorithm>
+#include <cstring>
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeviceObjectCacheKey::Append(uint64_t value)
+{
+    // FNV-1a over the words
+    constexpr static uint64_t FNV_PRIME = 1099511628211ULL;
+
+    m_words.emplace_back(value);
+    m_hash = (m_hash ^ value) * FNV_PRIME;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeviceObjectCacheKey::Append(float value)
+{
+    auto bits = uint32_t{ 0 };
+    static_assert(sizeof(bits) == sizeof(value));
+    std::memcpy(&bits, &value, sizeof(bits));
+    Append(uint64_t{ bits });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeviceObjectCacheKey::Append(std::string_view value)
+{
+    // The length goes first so adjacent strings cannot run into each other
+    Append(uint64_t{ value.size() });
+    for (auto const character : value)
+    {
+        Append(uint64_t{ static_cast<unsigned char>(character) });
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::DeviceObjectCacheKey::Append(Span<const uint32_t> values)
+{
+    Append(uint64_t{ values.size() });
+    for (auto const value : values)
+    {
+        Append(uint64_t{ value });
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] size_t Gris::Graphics::Vulkan::DeviceObjectCacheKey::Hash() const
+{
+    return static_cast<size_t>(m_hash);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::DeviceObjectCacheKey::Contains(uint64_t value) const
+{
+    return std::find(std::begin(m_words), std::end(m_words), value) != std::end(m_words);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::DeviceObjectCacheKey::operator==(const DeviceObjectCacheKey & other) const
+{
+    return m_hash == other.m_hash && m_words == other.m_words;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::DeviceObjectCacheKey::operator!=(const DeviceObjectCacheKey & other) const
+{
+    return !(*this == other);
+}
@@ -0,0 +1,168 @@
+#include <gris/graphics/vulkan/device_profile.h>
+
+#include <algorithm>
+#include <array>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+// VkPhysicalDeviceFeatures is nothing but VkBool32 members, so the features can be walked as an array
+constexpr size_t FEATURE_COUNT = sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32);
+
+static_assert(sizeof(vk::PhysicalDeviceFeatures) == FEATURE_COUNT * sizeof(VkBool32), "Physical device features must only hold booleans");
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const vk::Bool32 * FeatureArray(const vk::PhysicalDeviceFeatures & features)
+{
+    return reinterpret_cast<const vk::Bool32 *>(&features);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Bool32 * FeatureArray(vk::PhysicalDeviceFeatures & features)
+{
+    return reinterpret_cast<vk::Bool32 *>(&features);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t DeviceTypeRank(vk::PhysicalDeviceType type)
+{
+    switch (type)
+    {
+    case vk::PhysicalDeviceType::eDiscreteGpu:
+        return 4;
+    case vk::PhysicalDeviceType::eIntegratedGpu:
+        return 3;
+    case vk::PhysicalDeviceType::eVirtualGpu:
+        return 2;
+    case vk::PhysicalDeviceType::eCpu:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::DeviceSize LargestDeviceLocalHeap(const vk::PhysicalDeviceMemoryProperties & memoryProperties)
+{
+    auto largestHeap = vk::DeviceSize{ 0 };
+    for (uint32_t heapIndex = 0; heapIndex < memoryProperties.memoryHeapCount; ++heapIndex)
+    {
+        auto const & heap = memoryProperties.memoryHeaps[heapIndex];
+        if (heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal)
+        {
+            largestHeap = std::max(largestHeap, heap.size);
+        }
+    }
+
+    return largestHeap;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::SupportsFeatures(const vk::PhysicalDeviceFeatures & supported, const vk::PhysicalDeviceFeatures & required)
+{
+    auto const * const supportedArray = FeatureArray(supported);
+    auto const * const requiredArray = FeatureArray(required);
+    for (size_t featureIndex = 0; featureIndex < FEATURE_COUNT; ++featureIndex)
+    {
+        if (requiredArray[featureIndex] && !supportedArray[featureIndex])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceCapabilities Gris::Graphics::Vulkan::ResolveDeviceProfile(const vk::PhysicalDeviceProperties & properties, const vk::PhysicalDeviceFeatures & supported, const DeviceProfile & profile)
+{
+    auto capabilities = DeviceCapabilities{};
+
+    // Highest count supported for both color and depth that does not exceed the profile
+    auto const counts = properties.limits.framebufferColorSampleCounts & properties.limits.framebufferDepthSampleCounts;
+    constexpr static auto SAMPLE_COUNTS = std::array{
+        vk::SampleCountFlagBits::e64,
+        vk::SampleCountFlagBits::e32,
+        vk::SampleCountFlagBits::e16,
+        vk::SampleCountFlagBits::e8,
+        vk::SampleCountFlagBits::e4,
+        vk::SampleCountFlagBits::e2,
+    };
+    for (auto const sampleCount : SAMPLE_COUNTS)
+    {
+        if (sampleCount <= profile.MaxMsaaSamples && (counts & sampleCount))
+        {
+            capabilities.MsaaSamples = sampleCount;
+            break;
+        }
+    }
+
+    ///
+
+    auto * const enabledArray = FeatureArray(capabilities.EnabledFeatures);
+    auto const * const supportedArray = FeatureArray(supported);
+    auto const * const requiredArray = FeatureArray(profile.RequiredFeatures);
+    auto const * const optionalArray = FeatureArray(profile.OptionalFeatures);
+    for (size_t featureIndex = 0; featureIndex < FEATURE_COUNT; ++featureIndex)
+    {
+        enabledArray[featureIndex] = static_cast<vk::Bool32>(requiredArray[featureIndex] || (optionalArray[featureIndex] && supportedArray[featureIndex]));
+    }
+
+    ///
+
+    if (profile.MaxAnisotropy > 1.0F && supported.samplerAnisotropy)
+    {
+        capabilities.MaxAnisotropy = std::min(profile.MaxAnisotropy, properties.limits.maxSamplerAnisotropy);
+        capabilities.EnabledFeatures.samplerAnisotropy = static_cast<vk::Bool32>(true);
+    }
+
+    return capabilities;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::ScorePhysicalDevice(
+    const vk::PhysicalDeviceProperties & properties,
+    const vk::PhysicalDeviceMemoryProperties & memoryProperties,
+    const vk::PhysicalDeviceFeatures & supported,
+    const DeviceProfile & profile)
+{
+    constexpr static uint64_t PREFERRED_SHIFT = 63;
+    constexpr static uint64_t DEVICE_TYPE_SHIFT = 56;
+    constexpr static uint64_t HEAP_SIZE_SHIFT = 8;
+    constexpr static uint64_t HEAP_SIZE_MASK = (uint64_t{ 1 } << (DEVICE_TYPE_SHIFT - HEAP_SIZE_SHIFT)) - 1;
+    constexpr static uint64_t MEBIBYTE = 1024 * 1024;
+
+    auto score = uint64_t{ 0 };
+
+    auto const deviceName = std::string(static_cast<const char *>(properties.deviceName));
+    if (profile.PreferredDeviceName && deviceName.find(*profile.PreferredDeviceName) != std::string::npos)
+    {
+        score |= uint64_t{ 1 } << PREFERRED_SHIFT;
+    }
+
+    score |= DeviceTypeRank(properties.deviceType) << DEVICE_TYPE_SHIFT;
+    score |= std::min(LargestDeviceLocalHeap(memoryProperties) / MEBIBYTE, HEAP_SIZE_MASK) << HEAP_SIZE_SHIFT;
+
+    auto const * const supportedArray = FeatureArray(supported);
+    auto const * const optionalArray = FeatureArray(profile.OptionalFeatures);
+    for (size_t featureIndex = 0; featureIndex < FEATURE_COUNT; ++featureIndex)
+    {
+        if (optionalArray[featureIndex] && supportedArray[featureIndex])
+        {
+            ++score;
+        }
+    }
+
+    return score;
+}
@@ -0,0 +1,884 @@
+#include <gris/graphics/vulkan/frame_graph.h>
+
+#include <gris/graphics/vulkan/allocator.h>
+#include <gris/graphics/vulkan/barrier_batch.h>
+#include <gris/graphics/vulkan/deferred_context.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/utils.h>
+#include <gris/graphics/vulkan/vulkan_engine_exception.h>
+
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+const vk::ImageUsageFlags ATTACHMENT_USAGE = vk::ImageUsageFlagBits::eColorAttachment
+                                             | vk::ImageUsageFlagBits::eDepthStencilAttachment
+                                             | vk::ImageUsageFlagBits::eInputAttachment;
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::ImageUsageFlags UsageForLayout(vk::ImageLayout layout)
+{
+    switch (layout)
+    {
+    case vk::ImageLayout::eShaderReadOnlyOptimal:
+        return vk::ImageUsageFlagBits::eSampled;
+    case vk::ImageLayout::eTransferSrcOptimal:
+        return vk::ImageUsageFlagBits::eTransferSrc;
+    case vk::ImageLayout::eTransferDstOptimal:
+        return vk::ImageUsageFlagBits::eTransferDst;
+    case vk::ImageLayout::eGeneral:
+        return vk::ImageUsageFlagBits::eStorage;
+    case vk::ImageLayout::eColorAttachmentOptimal:
+        return vk::ImageUsageFlagBits::eColorAttachment;
+    case vk::ImageLayout::eDepthStencilAttachmentOptimal:
+    case vk::ImageLayout::eDepthStencilReadOnlyOptimal:
+        return vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    default:
+        return {};
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool HasStencil(vk::Format format)
+{
+    return static_cast<bool>(Gris::Graphics::Vulkan::AspectMaskForFormat(format) & vk::ImageAspectFlagBits::eStencil);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Four size classes per power of two, so a slot grows by at most a quarter and small resizes stay in the same class
+[[nodiscard]] vk::DeviceSize RoundUpToSizeClass(vk::DeviceSize size)
+{
+    constexpr static vk::DeviceSize MINIMUM_SIZE_CLASS = 64 * 1024;
+    if (size <= MINIMUM_SIZE_CLASS)
+    {
+        return MINIMUM_SIZE_CLASS;
+    }
+
+    auto highestBit = vk::DeviceSize{ 1 };
+    while (highestBit <= size / 2)
+    {
+        highestBit *= 2;
+    }
+
+    auto const step = highestBit / 4;
+    return (size + step - 1) / step * step;
+}
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::TextureState Gris::Graphics::Vulkan::AliasedTextureState(const TextureState & previousState)
+{
+    return TextureState{ vk::ImageLayout::eUndefined, previousState.Access, previousState.Stages };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph::FrameGraph() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph::FrameGraph(const ParentObject<Device> & device)
+    : DeviceResource(device)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph::FrameGraph(FrameGraph && other) noexcept
+    : DeviceResource(std::move(other))
+    , m_resources(std::exchange(other.m_resources, {}))
+    , m_passes(std::exchange(other.m_passes, {}))
+    , m_memorySlots(std::exchange(other.m_memorySlots, {}))
+    , m_recycledMemory(std::exchange(other.m_recycledMemory, {}))
+    , m_compiled(std::exchange(other.m_compiled, false))
+    , m_executedSinceCompile(std::exchange(other.m_executedSinceCompile, false))
+    , m_recordingVersion(std::exchange(other.m_recordingVersion, 0))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph & Gris::Graphics::Vulkan::FrameGraph::operator=(FrameGraph && other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseResources();
+
+        DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
+        m_resources = std::exchange(other.m_resources, {});
+        m_passes = std::exchange(other.m_passes, {});
+        m_memorySlots = std::exchange(other.m_memorySlots, {});
+        m_recycledMemory = std::exchange(other.m_recycledMemory, {});
+        m_compiled = std::exchange(other.m_compiled, false);
+        m_executedSinceCompile = std::exchange(other.m_executedSinceCompile, false);
+        m_recordingVersion = std::exchange(other.m_recordingVersion, 0);
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph::~FrameGraph()
+{
+    ReleaseResources();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraph::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::FrameGraph::IsValid() const
+{
+    return IsDeviceValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::FrameGraph::ResourceHandle Gris::Graphics::Vulkan::FrameGraph::CreateTexture(std::string name, const FrameGraphTextureDescription & description)
+{
+    GRIS_ALWAYS_ASSERT(!m_compiled, "Resources cannot be added to a compiled frame graph");
+
+    auto & resource = m_resources.emplace_back();
+    resource.Name = std::move(name);
+    resource.Description = description;
+    return static_cast<ResourceHandle>(m_resources.size() - 1);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::FrameGraph::ResourceHandle Gris::Graphics::Vulkan::FrameGraph::ImportTexture(
+    std::string name,
+    const FrameGraphTextureDescription & description,
+    const TextureState & initialState,
+    const TextureState & finalState)
+{
+    GRIS_ALWAYS_ASSERT(!m_compiled, "Resources cannot be added to a compiled frame graph");
+    GRIS_ALWAYS_ASSERT(finalState.Layout != vk::ImageLayout::eUndefined, "Imported textures must be left in a defined layout");
+
+    auto & resource = m_resources.emplace_back();
+    resource.Name = std::move(name);
+    resource.Description = description;
+    resource.Imported = true;
+    resource.InitialState = initialState;
+    resource.FinalState = finalState;
+    return static_cast<ResourceHandle>(m_resources.size() - 1);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::SetImportedTexture(ResourceHandle resource, const vk::Image & image, const vk::ImageView & imageView)
+{
+    GRIS_ALWAYS_ASSERT(resource < m_resources.size(), "Frame graph resource out of bounds");
+    GRIS_ALWAYS_ASSERT(m_resources[resource].Imported, "Only imported textures can be rebound");
+
+    m_resources[resource].Image = image;
+    m_resources[resource].ImageView = imageView;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::SetTextureExtent(ResourceHandle resource, uint32_t width, uint32_t height)
+{
+    GRIS_ALWAYS_ASSERT(resource < m_resources.size(), "Frame graph resource out of bounds");
+
+    m_resources[resource].Description.Width = width;
+    m_resources[resource].Description.Height = height;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::FrameGraphPassBuilder Gris::Graphics::Vulkan::FrameGraph::AddPass(std::string name, PassCallback callback)
+{
+    GRIS_ALWAYS_ASSERT(!m_compiled, "Passes cannot be added to a compiled frame graph");
+
+    auto & pass = m_passes.emplace_back();
+    pass.Name = std::move(name);
+    pass.Callback = std::move(callback);
+    return FrameGraphPassBuilder(*this, static_cast<PassHandle>(m_passes.size() - 1));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::Compile()
+{
+    ReleaseCompiledResources();
+
+    CullPasses();
+    ComputeLifetimes();
+    CreateTransientTextures();
+    CreateRenderPasses();
+    ReleaseRecycledMemory();
+
+    m_compiled = true;
+    m_executedSinceCompile = false;
+    ++m_recordingVersion;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::FrameGraph::IsCompiled() const
+{
+    return m_compiled;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::FrameGraph::IsPassCulled(PassHandle pass) const
+{
+    GRIS_ALWAYS_ASSERT(m_compiled, "Frame graph has to be compiled first");
+    GRIS_ALWAYS_ASSERT(pass < m_passes.size(), "Frame graph pass out of bounds");
+    return m_passes[pass].Culled;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::RenderPass & Gris::Graphics::Vulkan::FrameGraph::PassRenderPass(PassHandle pass) const
+{
+    GRIS_ALWAYS_ASSERT(m_compiled, "Frame graph has to be compiled first");
+    GRIS_ALWAYS_ASSERT(pass < m_passes.size(), "Frame graph pass out of bounds");
+    GRIS_ALWAYS_ASSERT(m_passes[pass].CompiledRenderPass, "Pass has no attachments or was culled");
+    return m_passes[pass].CompiledRenderPass;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const vk::ImageView & Gris::Graphics::Vulkan::FrameGraph::TextureViewHandle(ResourceHandle resource) const
+{
+    GRIS_ALWAYS_ASSERT(resource < m_resources.size(), "Frame graph resource out of bounds");
+    return m_resources[resource].ImageView;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::DeviceSize Gris::Graphics::Vulkan::FrameGraph::TransientMemorySize() const
+{
+    return std::accumulate(std::begin(m_memorySlots), std::end(m_memorySlots), vk::DeviceSize{ 0 }, [](vk::DeviceSize sum, const MemorySlot & slot)
+                           { return sum + slot.Requirements.size; });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::Execute(DeferredContext & context)
+{
+    GRIS_ALWAYS_ASSERT(m_compiled, "Frame graph has to be compiled first");
+
+    for (auto & resource : m_resources)
+    {
+        if (resource.Imported && resource.FirstPass)
+        {
+            GRIS_ALWAYS_ASSERT(resource.Image && resource.ImageView, "Imported texture was not bound");
+            resource.State = resource.InitialState;
+        }
+    }
+
+    for (PassHandle passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+    {
+        auto & pass = m_passes[passIndex];
+        if (pass.Culled)
+        {
+            continue;
+        }
+
+        // Contents of a transient texture do not survive between frames, but its memory may still be in use by the
+        // previous texture placed in the same slot
+        for (auto const & access : pass.Accesses)
+        {
+            auto & resource = m_resources[access.Resource];
+            if (!resource.Imported && resource.FirstPass == passIndex)
+            {
+                resource.State = AliasedTextureState(m_memorySlots[*resource.MemorySlot].LastState);
+            }
+        }
+
+        for (auto const & access : pass.Accesses)
+        {
+            auto & resource = m_resources[access.Resource];
+            context.TransitionImage(resource.Image, AspectMaskForFormat(resource.Description.Format), resource.State, access.State);
+        }
+
+        if (pass.CompiledRenderPass)
+        {
+            context.BeginRenderPass(pass.CompiledRenderPass, PassFramebuffer(pass), pass.Extent, pass.ClearValues);
+            pass.Callback(context);
+            context.EndRenderPass();
+        }
+        else
+        {
+            context.FlushBarriers();
+            pass.Callback(context);
+        }
+
+        for (auto const & access : pass.Accesses)
+        {
+            auto & resource = m_resources[access.Resource];
+            if (!resource.Imported && resource.LastPass == passIndex)
+            {
+                m_memorySlots[*resource.MemorySlot].LastState = resource.State;
+            }
+        }
+    }
+
+    for (auto & resource : m_resources)
+    {
+        if (resource.Imported && resource.FirstPass)
+        {
+            context.TransitionImage(resource.Image, AspectMaskForFormat(resource.Description.Format), resource.State, resource.FinalState);
+        }
+    }
+
+    context.FlushBarriers();
+
+    if (!m_executedSinceCompile)
+    {
+        m_executedSinceCompile = true;
+        ++m_recordingVersion;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::FrameGraph::RecordingVersion() const
+{
+    return m_recordingVersion;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::Reset()
+{
+    ReleaseResources();
+    ResetParent();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::CullPasses()
+{
+    // Walking backwards, a pass is needed if it has side effects or writes a texture a later needed pass reads. Passes
+    // overwriting a texture entirely stop the earlier writers from being needed on their account.
+    auto needed = std::vector<bool>(m_resources.size(), false);
+    for (size_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+    {
+        needed[resourceIndex] = m_resources[resourceIndex].Imported;
+    }
+
+    for (auto passIt = m_passes.rbegin(); passIt != m_passes.rend(); ++passIt)
+    {
+        auto & pass = *passIt;
+
+        auto const writesNeeded = std::any_of(std::begin(pass.Accesses), std::end(pass.Accesses), [&needed](const ResourceAccess & access)
+                                              { return access.Type != AccessType::Read && needed[access.Resource]; });
+        pass.Culled = !pass.HasSideEffect && !writesNeeded;
+        if (pass.Culled)
+        {
+            continue;
+        }
+
+        for (auto const & access : pass.Accesses)
+        {
+            auto const overwrites = access.Type == AccessType::ResolveAttachment || access.ClearValue.has_value();
+            if (overwrites && !m_resources[access.Resource].Imported)
+            {
+                needed[access.Resource] = false;
+            }
+        }
+
+        for (auto const & access : pass.Accesses)
+        {
+            auto const overwrites = access.Type == AccessType::ResolveAttachment || access.ClearValue.has_value();
+            if (!overwrites)
+            {
+                needed[access.Resource] = true;
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::ComputeLifetimes()
+{
+    for (PassHandle passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+    {
+        auto const & pass = m_passes[passIndex];
+        if (pass.Culled)
+        {
+            continue;
+        }
+
+        for (auto const & access : pass.Accesses)
+        {
+            auto & resource = m_resources[access.Resource];
+            if (!resource.FirstPass)
+            {
+                resource.FirstPass = passIndex;
+            }
+
+            resource.LastPass = passIndex;
+            resource.Usage |= UsageForLayout(access.State.Layout);
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::CreateTransientTextures()
+{
+    auto transientResources = std::vector<ResourceHandle>{};
+    for (ResourceHandle resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+    {
+        auto const & resource = m_resources[resourceIndex];
+        if (!resource.Imported && resource.FirstPass)
+        {
+            transientResources.emplace_back(resourceIndex);
+        }
+    }
+
+    std::stable_sort(std::begin(transientResources), std::end(transientResources), [this](ResourceHandle lhs, ResourceHandle rhs)
+                     { return *m_resources[lhs].FirstPass < *m_resources[rhs].FirstPass; });
+
+    for (auto const resourceIndex : transientResources)
+    {
+        auto & resource = m_resources[resourceIndex];
+
+        // Attachments never read outside of a render pass can live in lazily allocated memory on tilers
+        auto usage = resource.Usage;
+        if (!(usage & ~ATTACHMENT_USAGE))
+        {
+            usage |= vk::ImageUsageFlagBits::eTransientAttachment;
+        }
+
+        auto const imageInfo = vk::ImageCreateInfo{}
+                                   .setImageType(vk::ImageType::e2D)
+                                   .setFormat(resource.Description.Format)
+                                   .setExtent(vk::Extent3D(resource.Description.Width, resource.Description.Height, 1))
+                                   .setMipLevels(1)
+                                   .setArrayLayers(1)
+                                   .setSamples(resource.Description.Samples)
+                                   .setTiling(vk::ImageTiling::eOptimal)
+                                   .setUsage(usage)
+                                   .setSharingMode(vk::SharingMode::eExclusive)
+                                   .setQueueFamilyIndices({})
+                                   .setInitialLayout(vk::ImageLayout::eUndefined);
+
+        auto const createImageResult = DeviceHandle().createImage(imageInfo, nullptr, Dispatch());
+        if (createImageResult.result != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Error creating frame graph image", createImageResult);
+        }
+
+        resource.Image = createImageResult.value;
+
+        // Best fit among the slots whose last texture is dead by the time this one is first used
+        auto const requirements = DeviceHandle().getImageMemoryRequirements(resource.Image, Dispatch());
+
+        auto bestSlot = std::optional<uint32_t>{};
+        auto bestGrowth = vk::DeviceSize{ 0 };
+        for (uint32_t slotIndex = 0; slotIndex < m_memorySlots.size(); ++slotIndex)
+        {
+            auto const & slot = m_memorySlots[slotIndex];
+            if (slot.LastPass >= *resource.FirstPass || !(slot.Requirements.memoryTypeBits & requirements.memoryTypeBits))
+            {
+                continue;
+            }
+
+            auto const growth = std::max(slot.Requirements.size, requirements.size) - slot.Requirements.size;
+            if (!bestSlot || growth < bestGrowth)
+            {
+                bestSlot = slotIndex;
+                bestGrowth = growth;
+            }
+        }
+
+        if (!bestSlot)
+        {
+            bestSlot = static_cast<uint32_t>(m_memorySlots.size());
+            auto & slot = m_memorySlots.emplace_back();
+            slot.Requirements = requirements;
+        }
+
+        auto & slot = m_memorySlots[*bestSlot];
+        slot.Requirements.size = std::max(slot.Requirements.size, requirements.size);
+        slot.Requirements.alignment = std::max(slot.Requirements.alignment, requirements.alignment);
+        slot.Requirements.memoryTypeBits &= requirements.memoryTypeBits;
+        slot.LastPass = *resource.LastPass;
+        slot.LastState = TextureStateForLayout(vk::ImageLayout::eUndefined);
+
+        resource.MemorySlot = *bestSlot;
+    }
+
+    for (auto & slot : m_memorySlots)
+    {
+        slot.Requirements.size = RoundUpToSizeClass(slot.Requirements.size);
+
+        // Memory of the previous Compile is reused when the slot still fits the same size class, which is what keeps
+        // window resizes from reallocating every frame
+        auto recycled = std::find_if(std::begin(m_recycledMemory), std::end(m_recycledMemory), [&slot](const MemorySlot & candidate)
+                                     { return candidate.Memory
+                                              && candidate.Requirements.size == slot.Requirements.size
+                                              && candidate.Requirements.alignment >= slot.Requirements.alignment
+                                              && (candidate.Requirements.memoryTypeBits & ~slot.Requirements.memoryTypeBits) == 0; });
+        if (recycled != std::end(m_recycledMemory))
+        {
+            slot.Requirements = recycled->Requirements;
+            slot.Memory = std::exchange(recycled->Memory, {});
+            slot.LastState = recycled->LastState;
+            continue;
+        }
+
+        auto allocationInfo = VmaAllocationCreateInfo{};
+        allocationInfo.flags = {};
+        allocationInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+        allocationInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(vk::MemoryPropertyFlagBits::eDeviceLocal);
+        allocationInfo.preferredFlags = {};
+        allocationInfo.memoryTypeBits = 0;
+        allocationInfo.pool = {};
+        allocationInfo.pUserData = nullptr;
+        slot.Memory = AllocatorHandle().AllocateMemory(slot.Requirements, allocationInfo);
+    }
+
+    for (auto const resourceIndex : transientResources)
+    {
+        auto & resource = m_resources[resourceIndex];
+        AllocatorHandle().Bind(resource.Image, m_memorySlots[*resource.MemorySlot].Memory);
+
+        resource.View = ParentDevice().CreateTextureView(resource.Image, resource.Description.Format, AspectMaskForFormat(resource.Description.Format), 1);
+        resource.ImageView = resource.View.ImageViewHandle();
+        resource.State = TextureStateForLayout(vk::ImageLayout::eUndefined);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::CreateRenderPasses()
+{
+    for (PassHandle passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+    {
+        auto & pass = m_passes[passIndex];
+        if (pass.Culled)
+        {
+            pass.CompiledRenderPass = {};
+            pass.RenderPassAttachments.clear();
+            continue;
+        }
+
+        auto colorAccesses = std::vector<const ResourceAccess *>{};
+        auto resolveAccesses = std::vector<const ResourceAccess *>{};
+        const ResourceAccess * depthAccess = nullptr;
+        for (auto const & access : pass.Accesses)
+        {
+            switch (access.Type)
+            {
+            case AccessType::ColorAttachment:
+                colorAccesses.emplace_back(&access);
+                break;
+            case AccessType::ResolveAttachment:
+                resolveAccesses.emplace_back(&access);
+                break;
+            case AccessType::DepthAttachment:
+                GRIS_ALWAYS_ASSERT(depthAccess == nullptr, "A pass can have only one depth attachment");
+                depthAccess = &access;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (colorAccesses.empty() && depthAccess == nullptr)
+        {
+            pass.CompiledRenderPass = {};
+            pass.RenderPassAttachments.clear();
+            continue;
+        }
+
+        GRIS_ALWAYS_ASSERT(resolveAccesses.size() <= colorAccesses.size(), "Each resolve attachment needs a matching color attachment");
+
+        // Attachments hold a single layout for the whole pass, the transitions are done by the barriers in Execute
+        auto attachments = std::vector<vk::AttachmentDescription>{};
+        auto const addAttachment = [this, &pass, &attachments, passIndex](const ResourceAccess & access)
+        {
+            auto const & resource = m_resources[access.Resource];
+
+            auto const hasContents = resource.FirstPass < passIndex || (resource.Imported && resource.InitialState.Layout != vk::ImageLayout::eUndefined);
+            auto loadOp = hasContents ? vk::AttachmentLoadOp::eLoad : vk::AttachmentLoadOp::eDontCare;
+            if (access.ClearValue)
+            {
+                loadOp = vk::AttachmentLoadOp::eClear;
+            }
+            else if (access.Type == AccessType::ResolveAttachment)
+            {
+                loadOp = vk::AttachmentLoadOp::eDontCare;
+            }
+
+            auto const storeOp = resource.Imported || resource.LastPass > passIndex ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare;
+            auto const hasStencil = HasStencil(resource.Description.Format);
+
+            if (pass.Extent == vk::Extent2D{})
+            {
+                pass.Extent = vk::Extent2D(resource.Description.Width, resource.Description.Height);
+            }
+            GRIS_ALWAYS_ASSERT(pass.Extent == vk::Extent2D(resource.Description.Width, resource.Description.Height), "All attachments of a pass must have the same size");
+
+            attachments.emplace_back(vk::AttachmentDescription{}
+                                         .setFormat(resource.Description.Format)
+                                         .setSamples(resource.Description.Samples)
+                                         .setLoadOp(loadOp)
+                                         .setStoreOp(storeOp)
+                                         .setStencilLoadOp(hasStencil ? loadOp : vk::AttachmentLoadOp::eDontCare)
+                                         .setStencilStoreOp(hasStencil ? storeOp : vk::AttachmentStoreOp::eDontCare)
+                                         .setInitialLayout(access.State.Layout)
+                                         .setFinalLayout(access.State.Layout));
+            pass.Attachments.emplace_back(access.Resource);
+            pass.ClearValues.emplace_back(access.ClearValue.value_or(vk::ClearValue{}));
+
+            return vk::AttachmentReference{}
+                .setAttachment(static_cast<uint32_t>(attachments.size() - 1))
+                .setLayout(access.State.Layout);
+        };
+
+        auto colorReferences = std::vector<vk::AttachmentReference>{};
+        for (auto const * access : colorAccesses)
+        {
+            colorReferences.emplace_back(addAttachment(*access));
+        }
+
+        auto resolveReferences = std::vector<vk::AttachmentReference>{};
+        for (auto const * access : resolveAccesses)
+        {
+            resolveReferences.emplace_back(addAttachment(*access));
+        }
+
+        if (!resolveReferences.empty())
+        {
+            resolveReferences.resize(colorReferences.size(), vk::AttachmentReference{}.setAttachment(VK_ATTACHMENT_UNUSED));
+        }
+
+        auto depthReference = vk::AttachmentReference{};
+        if (depthAccess != nullptr)
+        {
+            depthReference = addAttachment(*depthAccess);
+        }
+
+        // The subpass only depends on the declared accesses, so the attachments decide whether the render pass changed
+        if (pass.CompiledRenderPass && pass.RenderPassAttachments == attachments)
+        {
+            continue;
+        }
+
+        auto const subpasses = std::array{
+            vk::SubpassDescription{}
+                .setPipelineBindPoint(vk::PipelineBindPoint::eGraphics)
+                .setColorAttachments(colorReferences)
+                .setPResolveAttachments(resolveReferences.empty() ? nullptr : resolveReferences.data())
+                .setPDepthStencilAttachment(depthAccess != nullptr ? &depthReference : nullptr)
+        };
+
+        auto const renderPassInfo = vk::RenderPassCreateInfo{}
+                                        .setAttachments(attachments)
+                                        .setSubpasses(subpasses);
+
+        pass.CompiledRenderPass = ParentDevice().CreateRenderPass(renderPassInfo);
+        pass.RenderPassAttachments = std::move(attachments);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::Framebuffer & Gris::Graphics::Vulkan::FrameGraph::PassFramebuffer(PassNode & pass)
+{
+    auto attachments = std::vector<vk::ImageView>{};
+    attachments.reserve(pass.Attachments.size());
+    for (auto const resource : pass.Attachments)
+    {
+        attachments.emplace_back(m_resources[resource].ImageView);
+    }
+
+    // Imported textures like swap chain images change every frame, so a pass ends up with one framebuffer per image
+    auto it = std::find_if(std::begin(pass.Framebuffers), std::end(pass.Framebuffers), [&attachments](const FramebufferCacheEntry & entry)
+                           { return entry.Attachments == attachments; });
+    if (it == std::end(pass.Framebuffers))
+    {
+        auto framebuffer = ParentDevice().CreateFramebuffer(attachments, pass.CompiledRenderPass, pass.Extent.width, pass.Extent.height);
+        it = pass.Framebuffers.insert(std::end(pass.Framebuffers), FramebufferCacheEntry{ std::move(attachments), std::move(framebuffer) });
+    }
+
+    return it->Object;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::ReleaseCompiledResources()
+{
+    for (auto & pass : m_passes)
+    {
+        pass.Framebuffers.clear();
+        pass.Attachments.clear();
+        pass.ClearValues.clear();
+        pass.Extent = vk::Extent2D{};
+        pass.Culled = false;
+    }
+
+    for (auto & resource : m_resources)
+    {
+        resource.View = {};
+        if (!resource.Imported)
+        {
+            if (resource.Image)
+            {
+                ParentDevice().DestroyDeferred(std::exchange(resource.Image, {}));
+            }
+
+            resource.ImageView = nullptr;
+        }
+
+        resource.FirstPass.reset();
+        resource.LastPass.reset();
+        resource.MemorySlot.reset();
+        resource.Usage = {};
+    }
+
+    for (auto & slot : m_memorySlots)
+    {
+        if (slot.Memory)
+        {
+            m_recycledMemory.emplace_back(std::move(slot));
+        }
+    }
+
+    m_memorySlots.clear();
+    m_compiled = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::ReleaseRecycledMemory()
+{
+    for (auto & slot : m_recycledMemory)
+    {
+        if (slot.Memory)
+        {
+            ParentDevice().DestroyDeferred(std::exchange(slot.Memory, {}));
+        }
+    }
+
+    m_recycledMemory.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::FrameGraph::ReleaseResources()
+{
+    if (IsDeviceValid())
+    {
+        ReleaseCompiledResources();
+        ReleaseRecycledMemory();
+    }
+
+    m_resources.clear();
+    m_passes.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder::FrameGraphPassBuilder(FrameGraph & graph, FrameGraph::PassHandle pass)
+    : m_graph(&graph)
+    , m_pass(pass)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::FrameGraph::PassHandle Gris::Graphics::Vulkan::FrameGraphPassBuilder::Pass() const
+{
+    return m_pass;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::Read(FrameGraph::ResourceHandle resource, const TextureState & state)
+{
+    return AddAccess(resource, FrameGraph::AccessType::Read, state, std::nullopt);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::Write(FrameGraph::ResourceHandle resource, const TextureState & state)
+{
+    return AddAccess(resource, FrameGraph::AccessType::Write, state, std::nullopt);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::ColorAttachment(FrameGraph::ResourceHandle resource)
+{
+    return AddAccess(resource, FrameGraph::AccessType::ColorAttachment, TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal), std::nullopt);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::ColorAttachment(FrameGraph::ResourceHandle resource, const vk::ClearColorValue & clearValue)
+{
+    return AddAccess(resource, FrameGraph::AccessType::ColorAttachment, TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal), vk::ClearValue(clearValue));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::DepthAttachment(FrameGraph::ResourceHandle resource)
+{
+    return AddAccess(resource, FrameGraph::AccessType::DepthAttachment, TextureStateForLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal), std::nullopt);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::DepthAttachment(FrameGraph::ResourceHandle resource, const vk::ClearDepthStencilValue & clearValue)
+{
+    return AddAccess(resource, FrameGraph::AccessType::DepthAttachment, TextureStateForLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal), vk::ClearValue(clearValue));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::ResolveAttachment(FrameGraph::ResourceHandle resource)
+{
+    return AddAccess(resource, FrameGraph::AccessType::ResolveAttachment, TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal), std::nullopt);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::SideEffect()
+{
+    m_graph->m_passes[m_pass].HasSideEffect = true;
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::FrameGraphPassBuilder & Gris::Graphics::Vulkan::FrameGraphPassBuilder::AddAccess(
+    FrameGraph::ResourceHandle resource,
+    FrameGraph::AccessType type,
+    const TextureState & state,
+    std::optional<vk::ClearValue> clearValue)
+{
+    GRIS_ALWAYS_ASSERT(!m_graph->m_compiled, "Passes of a compiled frame graph cannot be changed");
+    GRIS_ALWAYS_ASSERT(resource < m_graph->m_resources.size(), "Frame graph resource out of bounds");
+
+    m_graph->m_passes[m_pass].Accesses.emplace_back(FrameGraph::ResourceAccess{ resource, type, state, clearValue });
+    return *this;
+}
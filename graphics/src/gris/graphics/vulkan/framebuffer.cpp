@@ -1,5 +1,6 @@
 ﻿#include <gris/graphics/vulkan/framebuffer.h>
 
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/render_pass.h>
 #include <gris/graphics/vulkan/texture_view.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
@@ -13,11 +14,26 @@ Gris::Graphics::Vulkan::Framebuffer::Framebuffer() = default;
 Gris::Graphics::Vulkan::Framebuffer::Framebuffer(const ParentObject<Device> & device, const TextureView & colorImageView, const TextureView & depthImageView, const TextureView & swapChainImageView, const RenderPass & renderPass, uint32_t width, uint32_t height)
     : DeviceResource(device)
 {
-    std::array attachments = { colorImageView.ImageViewHandle(), depthImageView.ImageViewHandle(), swapChainImageView.ImageViewHandle() };
+    auto const attachments = std::array{ colorImageView.ImageViewHandle(), depthImageView.ImageViewHandle(), swapChainImageView.ImageViewHandle() };
+    CreateFramebuffer(attachments, renderPass, width, height);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::Framebuffer::Framebuffer(const ParentObject<Device> & device, Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height)
+    : DeviceResource(device)
+{
+    CreateFramebuffer(attachments, renderPass, width, height);
+}
 
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Framebuffer::CreateFramebuffer(Span<const vk::ImageView> attachments, const RenderPass & renderPass, uint32_t width, uint32_t height)
+{
     auto const framebufferInfo = vk::FramebufferCreateInfo{}
                                      .setRenderPass(renderPass.RenderPassHandle())
-                                     .setAttachments(attachments)
+                                     .setAttachmentCount(static_cast<uint32_t>(attachments.size()))
+                                     .setPAttachments(attachments.data())
                                      .setWidth(width)
                                      .setHeight(height)
                                      .setLayers(1);
@@ -103,7 +119,6 @@ void Gris::Graphics::Vulkan::Framebuffer::ReleaseResources()
 {
     if (m_framebuffer)
     {
-        DeviceHandle().destroyFramebuffer(m_framebuffer, nullptr, Dispatch());
-        m_framebuffer = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_framebuffer, {}));
     }
 }
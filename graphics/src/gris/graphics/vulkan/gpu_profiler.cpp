@@ -0,0 +1,381 @@
+#include <gris/graphics/vulkan/gpu_profiler.h>
+
+#include <gris/graphics/vulkan/deferred_context.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/vulkan_engine_exception.h>
+
+#include <gris/assert.h>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+constexpr uint32_t TIMESTAMPS_PER_ZONE = 2;
+constexpr uint32_t STATISTICS_PER_QUERY = 4;
+constexpr double NANOSECONDS_PER_MILLISECOND = 1000000.0;
+constexpr uint32_t TIMESTAMP_BITS = 64;
+
+// Results are written in the order of the flag bits
+const vk::QueryPipelineStatisticFlags PIPELINE_STATISTICS = vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives
+                                                            | vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations
+                                                            | vk::QueryPipelineStatisticFlagBits::eClippingPrimitives
+                                                            | vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+
+}  // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler::GpuProfiler() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler::GpuProfiler(const ParentObject<Device> & device, uint32_t virtualFrameCount, uint32_t maxZonesPerFrame)
+    : DeviceResource(device)
+    , m_maxZonesPerFrame(maxZonesPerFrame)
+    , m_frames(virtualFrameCount)
+{
+    GRIS_ALWAYS_ASSERT(virtualFrameCount > 0, "Virtual frame count must be positive");
+    GRIS_ALWAYS_ASSERT(maxZonesPerFrame > 0, "Maximum zone count must be positive");
+
+    auto const limits = ParentDevice().Limits();
+    if (limits.timestampComputeAndGraphics == VK_FALSE)
+    {
+        throw VulkanEngineException("Device does not support timestamp queries on graphics queues");
+    }
+
+    m_timestampPeriod = static_cast<double>(limits.timestampPeriod);
+
+    // Only the low bits of a timestamp are valid, a zone spanning their wrap around is still measured correctly when
+    // the difference is masked the same way
+    auto const timestampValidBits = ParentDevice().QueueFamilyProperties(ParentDevice().QueueFamilies().graphicsFamily.value()).timestampValidBits;
+    if (timestampValidBits == 0)
+    {
+        throw VulkanEngineException("Graphics queue does not support timestamp queries");
+    }
+
+    m_timestampMask = timestampValidBits >= TIMESTAMP_BITS ? ~uint64_t{ 0 } : (uint64_t{ 1 } << timestampValidBits) - 1;
+
+    auto const timestampPoolInfo = vk::QueryPoolCreateInfo{}
+                                       .setQueryType(vk::QueryType::eTimestamp)
+                                       .setQueryCount(virtualFrameCount * maxZonesPerFrame * TIMESTAMPS_PER_ZONE);
+
+    auto const createTimestampPoolResult = DeviceHandle().createQueryPool(timestampPoolInfo, nullptr, Dispatch());
+    if (createTimestampPoolResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error creating timestamp query pool", createTimestampPoolResult);
+    }
+
+    m_timestampPool = createTimestampPoolResult.value;
+
+    if (ParentDevice().EnabledFeatures().pipelineStatisticsQuery == VK_TRUE)
+    {
+        auto const statisticsPoolInfo = vk::QueryPoolCreateInfo{}
+                                            .setQueryType(vk::QueryType::ePipelineStatistics)
+                                            .setQueryCount(virtualFrameCount * maxZonesPerFrame)
+                                            .setPipelineStatistics(PIPELINE_STATISTICS);
+
+        auto const createStatisticsPoolResult = DeviceHandle().createQueryPool(statisticsPoolInfo, nullptr, Dispatch());
+        if (createStatisticsPoolResult.result != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Error creating pipeline statistics query pool", createStatisticsPoolResult);
+        }
+
+        m_statisticsPool = createStatisticsPoolResult.value;
+    }
+
+    for (auto & frame : m_frames)
+    {
+        frame.Zones.reserve(maxZonesPerFrame);
+    }
+
+    m_timestampData.resize(static_cast<size_t>(maxZonesPerFrame) * TIMESTAMPS_PER_ZONE);
+    m_statisticsData.resize(static_cast<size_t>(maxZonesPerFrame) * STATISTICS_PER_QUERY);
+    m_results.reserve(maxZonesPerFrame);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler::GpuProfiler(GpuProfiler && other) noexcept
+    : DeviceResource(std::move(other))
+    , m_timestampPool(std::exchange(other.m_timestampPool, {}))
+    , m_statisticsPool(std::exchange(other.m_statisticsPool, {}))
+    , m_maxZonesPerFrame(std::exchange(other.m_maxZonesPerFrame, 0))
+    , m_timestampPeriod(std::exchange(other.m_timestampPeriod, 0.0))
+    , m_timestampMask(std::exchange(other.m_timestampMask, 0))
+    , m_frames(std::exchange(other.m_frames, {}))
+    , m_currentFrame(std::exchange(other.m_currentFrame, 0))
+    , m_frameNumber(std::exchange(other.m_frameNumber, 0))
+    , m_openZoneCount(std::exchange(other.m_openZoneCount, 0))
+    , m_openStatisticsZone(std::exchange(other.m_openStatisticsZone, {}))
+    , m_timestampData(std::exchange(other.m_timestampData, {}))
+    , m_statisticsData(std::exchange(other.m_statisticsData, {}))
+    , m_results(std::exchange(other.m_results, {}))
+    , m_resultsFrameNumber(std::exchange(other.m_resultsFrameNumber, {}))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler & Gris::Graphics::Vulkan::GpuProfiler::operator=(GpuProfiler && other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseResources();
+
+        DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
+        m_timestampPool = std::exchange(other.m_timestampPool, {});
+        m_statisticsPool = std::exchange(other.m_statisticsPool, {});
+        m_maxZonesPerFrame = std::exchange(other.m_maxZonesPerFrame, 0);
+        m_timestampPeriod = std::exchange(other.m_timestampPeriod, 0.0);
+        m_timestampMask = std::exchange(other.m_timestampMask, 0);
+        m_frames = std::exchange(other.m_frames, {});
+        m_currentFrame = std::exchange(other.m_currentFrame, 0);
+        m_frameNumber = std::exchange(other.m_frameNumber, 0);
+        m_openZoneCount = std::exchange(other.m_openZoneCount, 0);
+        m_openStatisticsZone = std::exchange(other.m_openStatisticsZone, {});
+        m_timestampData = std::exchange(other.m_timestampData, {});
+        m_statisticsData = std::exchange(other.m_statisticsData, {});
+        m_results = std::exchange(other.m_results, {});
+        m_resultsFrameNumber = std::exchange(other.m_resultsFrameNumber, {});
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler::~GpuProfiler()
+{
+    ReleaseResources();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfiler::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::GpuProfiler::IsValid() const
+{
+    return IsDeviceValid() && static_cast<bool>(m_timestampPool);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::GpuProfiler::HasPipelineStatistics() const
+{
+    return static_cast<bool>(m_statisticsPool);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::GpuProfiler::BeginFrame(DeferredContext & context, uint32_t virtualFrameIndex)
+{
+    GRIS_ALWAYS_ASSERT(virtualFrameIndex < m_frames.size(), "Virtual frame index out of range");
+    GRIS_FAST_ASSERT(m_openZoneCount == 0, "All zones of the previous frame must be closed");
+
+    ReadBackResults(virtualFrameIndex);
+
+    m_currentFrame = virtualFrameIndex;
+    m_openZoneCount = 0;
+    m_openStatisticsZone = {};
+
+    auto & frame = m_frames[m_currentFrame];
+    frame.FrameNumber = m_frameNumber++;
+    frame.Zones.clear();
+    frame.StatisticsQueryCount = 0;
+
+    context.ResetQueryPool(m_timestampPool, m_currentFrame * m_maxZonesPerFrame * TIMESTAMPS_PER_ZONE, m_maxZonesPerFrame * TIMESTAMPS_PER_ZONE);
+    if (m_statisticsPool)
+    {
+        context.ResetQueryPool(m_statisticsPool, m_currentFrame * m_maxZonesPerFrame, m_maxZonesPerFrame);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::GpuProfiler::ZoneIndex Gris::Graphics::Vulkan::GpuProfiler::BeginZone(DeferredContext & context, std::string name)
+{
+    auto & frame = m_frames[m_currentFrame];
+    GRIS_ALWAYS_ASSERT(frame.Zones.size() < m_maxZonesPerFrame, "Exceeded the maximum number of GPU zones per frame");
+
+    auto const zone = static_cast<ZoneIndex>(frame.Zones.size());
+    auto & record = frame.Zones.emplace_back(ZoneRecord{ std::move(name), m_openZoneCount, {}, false });
+    ++m_openZoneCount;
+
+    auto const timestampBase = (m_currentFrame * m_maxZonesPerFrame + zone) * TIMESTAMPS_PER_ZONE;
+    context.WriteTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, m_timestampPool, timestampBase);
+
+    // Pipeline statistics queries cannot nest, so only the outermost zone collects them
+    if (m_statisticsPool && !m_openStatisticsZone)
+    {
+        record.StatisticsQuery = frame.StatisticsQueryCount++;
+        m_openStatisticsZone = zone;
+        context.BeginQuery(m_statisticsPool, m_currentFrame * m_maxZonesPerFrame + *record.StatisticsQuery);
+    }
+
+    return zone;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::GpuProfiler::EndZone(DeferredContext & context, ZoneIndex zone)
+{
+    auto & frame = m_frames[m_currentFrame];
+    GRIS_ALWAYS_ASSERT(zone < frame.Zones.size(), "Ending an unknown GPU zone");
+
+    auto & record = frame.Zones[zone];
+    GRIS_FAST_ASSERT(!record.Closed, "Ending an already closed GPU zone");
+    GRIS_FAST_ASSERT(record.Depth + 1 == m_openZoneCount, "GPU zones must be closed in reverse order");
+
+    if (record.StatisticsQuery)
+    {
+        context.EndQuery(m_statisticsPool, m_currentFrame * m_maxZonesPerFrame + *record.StatisticsQuery);
+        m_openStatisticsZone = {};
+    }
+
+    auto const timestampBase = (m_currentFrame * m_maxZonesPerFrame + zone) * TIMESTAMPS_PER_ZONE;
+    context.WriteTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_timestampPool, timestampBase + 1);
+
+    record.Closed = true;
+    --m_openZoneCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const std::vector<Gris::Graphics::Vulkan::GpuZoneResult> & Gris::Graphics::Vulkan::GpuProfiler::Results() const
+{
+    return m_results;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::optional<uint64_t> Gris::Graphics::Vulkan::GpuProfiler::ResultsFrameNumber() const
+{
+    return m_resultsFrameNumber;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::GpuProfiler::Reset()
+{
+    ReleaseResources();
+    ResetParent();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::GpuProfiler::ReadBackResults(uint32_t virtualFrameIndex)
+{
+    auto const & frame = m_frames[virtualFrameIndex];
+    if (frame.Zones.empty())
+    {
+        return;
+    }
+
+    auto const zoneCount = static_cast<uint32_t>(frame.Zones.size());
+
+    // No eWait here - the caller has already waited for the frame fence, if the results are still not
+    // there we keep the previous ones instead of stalling the CPU. Both pools are read before the results
+    // change, so they never mix timings and statistics of different frames
+    auto const timestampResult = DeviceHandle().getQueryPoolResults(
+        m_timestampPool,
+        virtualFrameIndex * m_maxZonesPerFrame * TIMESTAMPS_PER_ZONE,
+        zoneCount * TIMESTAMPS_PER_ZONE,
+        m_timestampData.size() * sizeof(uint64_t),
+        m_timestampData.data(),
+        sizeof(uint64_t),
+        vk::QueryResultFlagBits::e64,
+        Dispatch());
+    if (timestampResult == vk::Result::eNotReady)
+    {
+        return;
+    }
+    if (timestampResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error reading timestamp query results", timestampResult);
+    }
+
+    if (frame.StatisticsQueryCount > 0)
+    {
+        auto const statisticsResult = DeviceHandle().getQueryPoolResults(
+            m_statisticsPool,
+            virtualFrameIndex * m_maxZonesPerFrame,
+            frame.StatisticsQueryCount,
+            m_statisticsData.size() * sizeof(uint64_t),
+            m_statisticsData.data(),
+            STATISTICS_PER_QUERY * sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64,
+            Dispatch());
+        if (statisticsResult == vk::Result::eNotReady)
+        {
+            return;
+        }
+        if (statisticsResult != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Error reading pipeline statistics query results", statisticsResult);
+        }
+    }
+
+    m_results.clear();
+    m_resultsFrameNumber = frame.FrameNumber;
+    for (uint32_t zone = 0; zone < zoneCount; ++zone)
+    {
+        auto const & record = frame.Zones[zone];
+
+        auto const begin = m_timestampData[static_cast<size_t>(zone) * TIMESTAMPS_PER_ZONE];
+        auto const end = m_timestampData[static_cast<size_t>(zone) * TIMESTAMPS_PER_ZONE + 1];
+        auto const ticks = (end - begin) & m_timestampMask;
+
+        auto & result = m_results.emplace_back();
+        result.Name = record.Name;
+        result.Depth = record.Depth;
+        result.GpuTimeMilliseconds = static_cast<double>(ticks) * m_timestampPeriod / NANOSECONDS_PER_MILLISECOND;
+
+        if (record.StatisticsQuery)
+        {
+            auto const * statistics = &m_statisticsData[static_cast<size_t>(*record.StatisticsQuery) * STATISTICS_PER_QUERY];
+
+            result.HasPipelineStatistics = true;
+            result.InputAssemblyPrimitives = statistics[0];
+            result.VertexShaderInvocations = statistics[1];
+            result.ClippingPrimitives = statistics[2];
+            result.FragmentShaderInvocations = statistics[3];
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::GpuProfiler::ReleaseResources()
+{
+    if (m_statisticsPool)
+    {
+        ParentDevice().DestroyDeferred(std::exchange(m_statisticsPool, {}));
+    }
+
+    if (m_timestampPool)
+    {
+        ParentDevice().DestroyDeferred(std::exchange(m_timestampPool, {}));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfilerZone::GpuProfilerZone(GpuProfiler & profiler, DeferredContext & context, std::string name)
+    : m_profiler(&profiler)
+    , m_context(&context)
+    , m_zone(profiler.BeginZone(context, std::move(name)))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::GpuProfilerZone::~GpuProfilerZone()
+{
+    m_profiler->EndZone(*m_context, m_zone);
+}
@@ -1,5 +1,6 @@
 #include <gris/graphics/vulkan/immediate_context.h>
 
+#include <gris/graphics/vulkan/barrier_batch.h>
 #include <gris/graphics/vulkan/buffer.h>
 #include <gris/graphics/vulkan/deferred_context.h>
 #include <gris/graphics/vulkan/device.h>
@@ -8,7 +9,12 @@
 #include <gris/graphics/vulkan/texture.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -23,6 +29,7 @@ Gris::Graphics::Vulkan::ImmediateContext::ImmediateContext(const ParentObject<De
     auto const graphicsQueueFamily = queueFamilies.graphicsFamily.value();
 
     m_graphicsQueue = DeviceHandle().getQueue(graphicsQueueFamily, 0, Dispatch());
+    m_queueMutex = std::make_unique<std::mutex>();
 
     auto const poolInfo = vk::CommandPoolCreateInfo{}
                               .setFlags(vk::CommandPoolCreateFlagBits::eTransient)
@@ -36,6 +43,12 @@ Gris::Graphics::Vulkan::ImmediateContext::ImmediateContext(const ParentObject<De
 
     m_commandPool = createCommandPoolResult.value;
 
+    if (ParentDevice().HasTimelineSemaphores())
+    {
+        m_timeline = ParentDevice().CreateTimelineSemaphore(m_lastSubmittedValue);
+        return;
+    }
+
     auto const fenceInfo = vk::FenceCreateInfo{};
     auto const fenceCreateResult = DeviceHandle().createFence(fenceInfo, nullptr, Dispatch());
     if (fenceCreateResult.result != vk::Result::eSuccess)
@@ -51,8 +64,12 @@ Gris::Graphics::Vulkan::ImmediateContext::ImmediateContext(const ParentObject<De
 Gris::Graphics::Vulkan::ImmediateContext::ImmediateContext(ImmediateContext && other) noexcept
     : DeviceResource(std::move(other))
     , m_graphicsQueue(std::exchange(other.m_graphicsQueue, {}))
+    , m_queueMutex(std::move(other.m_queueMutex))
     , m_commandPool(std::exchange(other.m_commandPool, {}))
     , m_fence(std::exchange(other.m_fence, {}))
+    , m_timeline(std::exchange(other.m_timeline, {}))
+    , m_lastSubmittedValue(other.m_lastSubmittedValue.exchange(0))
+    , m_completedValue(other.m_completedValue.exchange(0))
 {
 }
 
@@ -66,8 +83,12 @@ Gris::Graphics::Vulkan::ImmediateContext & Gris::Graphics::Vulkan::ImmediateCont
 
         DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
         m_graphicsQueue = std::exchange(other.m_graphicsQueue, {});
+        m_queueMutex = std::move(other.m_queueMutex);
         m_commandPool = std::exchange(other.m_commandPool, {});
         m_fence = std::exchange(other.m_fence, {});
+        m_timeline = std::exchange(other.m_timeline, {});
+        m_lastSubmittedValue = other.m_lastSubmittedValue.exchange(0);
+        m_completedValue = other.m_completedValue.exchange(0);
     }
 
     return *this;
@@ -91,12 +112,12 @@ Gris::Graphics::Vulkan::ImmediateContext::operator bool() const
 
 [[nodiscard]] bool Gris::Graphics::Vulkan::ImmediateContext::IsValid() const
 {
-    return IsDeviceValid() && static_cast<bool>(m_graphicsQueue) && static_cast<bool>(m_commandPool) && static_cast<bool>(m_fence);
+    return IsDeviceValid() && static_cast<bool>(m_graphicsQueue) && static_cast<bool>(m_commandPool) && (static_cast<bool>(m_fence) || static_cast<bool>(m_timeline));
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::ImmediateContext::GenerateMipmaps(const Texture & texture, const vk::Format & imageFormat, uint32_t texWidth, uint32_t texHeight)
+void Gris::Graphics::Vulkan::ImmediateContext::GenerateMipmaps(Texture & texture, const vk::Format & imageFormat, uint32_t texWidth, uint32_t texHeight)
 {
     auto const formatProperties = ParentDevice().GetFormatProperties(imageFormat);
 
@@ -177,14 +198,24 @@ void Gris::Graphics::Vulkan::ImmediateContext::GenerateMipmaps(const Texture & t
     commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {}, barriers, Dispatch());
 
     EndSingleTimeCommands(commandBuffer);
+
+    for (uint32_t i = 0; i < texture.MipLevels(); i++)
+    {
+        texture.SetSubresourceState(i, TextureStateForLayout(vk::ImageLayout::eShaderReadOnlyOptimal));
+    }
 }
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::ImmediateContext::CopyBufferToImage(const Buffer & buffer, const Texture & texture, uint32_t width, uint32_t height)
+void Gris::Graphics::Vulkan::ImmediateContext::CopyBufferToImage(const Buffer & buffer, Texture & texture, uint32_t width, uint32_t height)
 {
     auto commandBuffer = BeginSingleTimeCommands();
 
+    // The whole chain goes to transfer destination so mip generation can follow without another transition
+    auto barriers = BarrierBatch{};
+    barriers.TransitionTexture(texture, TextureStateForLayout(vk::ImageLayout::eTransferDstOptimal));
+    barriers.Record(commandBuffer, Dispatch());
+
     auto const region = vk::BufferImageCopy(0,
                                             0,
                                             0,
@@ -205,50 +236,17 @@ void Gris::Graphics::Vulkan::ImmediateContext::CopyBufferToImage(const Buffer &
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::ImmediateContext::TransitionImageLayout(const Texture & texture, const vk::ImageLayout & oldLayout, const vk::ImageLayout & newLayout)
+void Gris::Graphics::Vulkan::ImmediateContext::TransitionImageLayout(Texture & texture, const vk::ImageLayout & newLayout)
 {
-    auto commandBuffer = BeginSingleTimeCommands();
-
-    vk::ImageMemoryBarrier barrier({},
-                                   {},
-                                   oldLayout,
-                                   newLayout,
-                                   VK_QUEUE_FAMILY_IGNORED,
-                                   VK_QUEUE_FAMILY_IGNORED,
-                                   texture.ImageHandle(),
-                                   vk::ImageSubresourceRange(
-                                       vk::ImageAspectFlagBits::eColor,
-                                       0,
-                                       texture.MipLevels(),
-                                       0,
-                                       1));
-
-    vk::PipelineStageFlags sourceStage;
-    vk::PipelineStageFlags destinationStage;
-
-    if (oldLayout == vk::ImageLayout::eUndefined && newLayout == vk::ImageLayout::eTransferDstOptimal)
-    {
-        barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-
-        sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
-        destinationStage = vk::PipelineStageFlagBits::eTransfer;
-    }
-    else if (oldLayout == vk::ImageLayout::eTransferDstOptimal && newLayout == vk::ImageLayout::eShaderReadOnlyOptimal)
-    {
-        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-
-        sourceStage = vk::PipelineStageFlagBits::eTransfer;
-        destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
-    }
-    else
+    auto barriers = BarrierBatch{};
+    barriers.TransitionTexture(texture, TextureStateForLayout(newLayout));
+    if (barriers.IsEmpty())
     {
-        throw VulkanEngineException("Unsupported layout transition!");
+        return;
     }
 
-    std::array imageMemoryBarriers = { barrier };
-    commandBuffer.pipelineBarrier(sourceStage, destinationStage, {}, {}, {}, imageMemoryBarriers, Dispatch());
-
+    auto commandBuffer = BeginSingleTimeCommands();
+    barriers.Record(commandBuffer, Dispatch());
     EndSingleTimeCommands(commandBuffer);
 }
 
@@ -280,19 +278,117 @@ void Gris::Graphics::Vulkan::ImmediateContext::Submit(
     std::transform(signalSemaphores.begin(), signalSemaphores.end(), std::back_inserter(signalSemaphoreHandles), [](const auto & semaphore)
                    { return semaphore.get().SemaphoreHandle(); });
 
-    std::array waitStages = { vk::PipelineStageFlags(vk::PipelineStageFlagBits::eColorAttachmentOutput) };
+    auto waitStages = std::vector<vk::PipelineStageFlags>(waitSemaphoreHandles.size(), vk::PipelineStageFlagBits::eColorAttachmentOutput);
+    auto waitValues = std::vector<uint64_t>(waitSemaphoreHandles.size(), 0);
+
     std::array commandBuffers = { context->CommandBufferHandle() };
-    std::array submits = { vk::SubmitInfo{}
-                               .setWaitSemaphores(waitSemaphoreHandles)
-                               .setWaitDstStageMask(waitStages)
-                               .setCommandBuffers(commandBuffers)
-                               .setSignalSemaphores(signalSemaphoreHandles) };
+    [[maybe_unused]] auto const submittedValue = SubmitToQueue(
+        commandBuffers,
+        std::move(waitSemaphoreHandles),
+        std::move(waitStages),
+        std::move(waitValues),
+        std::move(signalSemaphoreHandles),
+        fence.FenceHandle());
+}
 
-    auto const submitResult = m_graphicsQueue.submit(submits, fence.FenceHandle(), Dispatch());
-    if (submitResult != vk::Result::eSuccess)
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::ImmediateContext::Submit(
+    DeferredContext * context,
+    const std::vector<std::reference_wrapper<Semaphore>> & waitSemaphores,
+    const std::vector<std::reference_wrapper<Semaphore>> & signalSemaphores,
+    const std::vector<TimelineSemaphoreWait> & timelineWaits)
+{
+    GRIS_ALWAYS_ASSERT(HasTimeline(), "Timeline submission requires timeline semaphore support");
+
+    std::vector<vk::Semaphore> waitSemaphoreHandles;
+    std::transform(waitSemaphores.begin(), waitSemaphores.end(), std::back_inserter(waitSemaphoreHandles), [](const auto & semaphore)
+                   { return semaphore.get().SemaphoreHandle(); });
+
+    auto waitStages = std::vector<vk::PipelineStageFlags>(waitSemaphoreHandles.size(), vk::PipelineStageFlagBits::eColorAttachmentOutput);
+    auto waitValues = std::vector<uint64_t>(waitSemaphoreHandles.size(), 0);
+    for (auto const & timelineWait : timelineWaits)
     {
-        throw VulkanEngineException("Error submitting to graphics queue", submitResult);
+        waitSemaphoreHandles.emplace_back(timelineWait.Timeline.get().SemaphoreHandle());
+        waitStages.emplace_back(timelineWait.StageMask);
+        waitValues.emplace_back(timelineWait.Value);
     }
+
+    std::vector<vk::Semaphore> signalSemaphoreHandles;
+    std::transform(signalSemaphores.begin(), signalSemaphores.end(), std::back_inserter(signalSemaphoreHandles), [](const auto & semaphore)
+                   { return semaphore.get().SemaphoreHandle(); });
+
+    std::array commandBuffers = { context->CommandBufferHandle() };
+    return SubmitToQueue(
+        commandBuffers,
+        std::move(waitSemaphoreHandles),
+        std::move(waitStages),
+        std::move(waitValues),
+        std::move(signalSemaphoreHandles),
+        {});
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::ImmediateContext::HasTimeline() const
+{
+    return static_cast<bool>(m_timeline);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::TimelineSemaphore & Gris::Graphics::Vulkan::ImmediateContext::Timeline() const
+{
+    GRIS_FAST_ASSERT(HasTimeline(), "Graphics queue timeline is not available");
+    return m_timeline;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::ImmediateContext::LastSubmittedValue() const
+{
+    return m_lastSubmittedValue;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::ImmediateContext::CompletedValue() const
+{
+    if (!HasTimeline())
+    {
+        return m_completedValue;
+    }
+
+    return m_timeline.CompletedValue();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::ImmediateContext::NotifyCompleted(uint64_t value)
+{
+    GRIS_FAST_ASSERT(value <= m_lastSubmittedValue, "Completed value was never submitted");
+
+    // Completions may be reported out of order by different threads, the value only ever moves forward
+    auto completedValue = m_completedValue.load();
+    while (completedValue < value && !m_completedValue.compare_exchange_weak(completedValue, value))
+    {
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::ImmediateContext::WaitForValue(uint64_t value) const
+{
+    GRIS_FAST_ASSERT(HasTimeline(), "Graphics queue timeline is not available");
+    GRIS_FAST_ASSERT(value <= m_lastSubmittedValue, "Waiting for a timeline value that was never submitted");
+    m_timeline.Wait(value);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::unique_lock<std::mutex> Gris::Graphics::Vulkan::ImmediateContext::LockQueue()
+{
+    return std::unique_lock(*m_queueMutex);
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -334,7 +430,7 @@ void Gris::Graphics::Vulkan::ImmediateContext::Reset()
 
 // -------------------------------------------------------------------------------------------------
 
-void Gris::Graphics::Vulkan::ImmediateContext::EndSingleTimeCommands(vk::CommandBuffer & commandBuffer) const
+void Gris::Graphics::Vulkan::ImmediateContext::EndSingleTimeCommands(vk::CommandBuffer & commandBuffer)
 {
     auto const endResult = commandBuffer.end(Dispatch());
     if (endResult != vk::Result::eSuccess)
@@ -345,40 +441,92 @@ void Gris::Graphics::Vulkan::ImmediateContext::EndSingleTimeCommands(vk::Command
     ///
 
     std::array commandBuffers = { commandBuffer };
-    std::array submits = { vk::SubmitInfo{}.setCommandBuffers(commandBuffers) };
+    auto const submittedValue = SubmitToQueue(commandBuffers, {}, {}, {}, {}, m_fence);
 
-    auto const submitResult = m_graphicsQueue.submit(submits, m_fence, Dispatch());
-    if (submitResult != vk::Result::eSuccess)
+    ///
+
+    if (HasTimeline())
     {
-        throw VulkanEngineException("Error submitting the command buffer", submitResult);
+        m_timeline.Wait(submittedValue);
     }
+    else
+    {
+        auto waitFences = std::array{ m_fence };
+        auto const waitResult = DeviceHandle().waitForFences(waitFences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
+        if (waitResult != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Failed to wait for immediate context fence!", waitResult);
+        }
 
-    ///
+        auto const resetResult = DeviceHandle().resetFences(waitFences, Dispatch());
+        if (resetResult != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Error resetting immediate context fence", resetResult);
+        }
 
-    auto waitFences = std::array{ m_fence };
-    auto const waitResult = DeviceHandle().waitForFences(waitFences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
-    if (waitResult != vk::Result::eSuccess)
-    {
-        throw VulkanEngineException("Failed to wait for immediate context fence!", waitResult);
+        NotifyCompleted(submittedValue);
     }
 
     ///
 
-    auto const resetResult = DeviceHandle().resetFences(waitFences, Dispatch());
-    if (resetResult != vk::Result::eSuccess)
+    DeviceHandle().freeCommandBuffers(m_commandPool, commandBuffers, Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint64_t Gris::Graphics::Vulkan::ImmediateContext::SubmitToQueue(
+    Span<const vk::CommandBuffer> commandBuffers,
+    std::vector<vk::Semaphore> waitSemaphores,
+    std::vector<vk::PipelineStageFlags> waitStages,
+    std::vector<uint64_t> waitValues,
+    std::vector<vk::Semaphore> signalSemaphores,
+    vk::Fence fence)
+{
+    GRIS_FAST_ASSERT(waitSemaphores.size() == waitStages.size() && waitSemaphores.size() == waitValues.size(), "Wait semaphores, stages and values must match");
+
+    // Timeline values have to reach the queue in increasing order, so the value is taken under the queue lock
+    auto const lock = LockQueue();
+    auto const submittedValue = m_lastSubmittedValue.load() + 1;
+
+    auto signalValues = std::vector<uint64_t>(signalSemaphores.size(), 0);
+    if (HasTimeline())
     {
-        throw VulkanEngineException("Error resetting immediate context fence", resetResult);
+        signalSemaphores.emplace_back(m_timeline.SemaphoreHandle());
+        signalValues.emplace_back(submittedValue);
     }
 
-    ///
+    // Binary semaphores ignore their values, the arrays only have to line up with the semaphores
+    auto const timelineInfo = vk::TimelineSemaphoreSubmitInfo{}
+                                  .setWaitSemaphoreValues(waitValues)
+                                  .setSignalSemaphoreValues(signalValues);
 
-    DeviceHandle().freeCommandBuffers(m_commandPool, commandBuffers, Dispatch());
+    std::array submits = { vk::SubmitInfo{}
+                               .setPNext(HasTimeline() ? &timelineInfo : nullptr)
+                               .setWaitSemaphores(waitSemaphores)
+                               .setWaitDstStageMask(waitStages)
+                               .setCommandBufferCount(static_cast<uint32_t>(commandBuffers.size()))
+                               .setPCommandBuffers(commandBuffers.data())
+                               .setSignalSemaphores(signalSemaphores) };
+
+    auto const submitResult = m_graphicsQueue.submit(submits, fence, Dispatch());
+    if (submitResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error submitting to graphics queue", submitResult);
+    }
+
+    m_lastSubmittedValue = submittedValue;
+    return submittedValue;
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void Gris::Graphics::Vulkan::ImmediateContext::ReleaseResources()
 {
+    m_lastSubmittedValue = 0;
+    m_completedValue = 0;
+    m_timeline.Reset();
+    m_queueMutex.reset();
+
     if (m_fence)
     {
         DeviceHandle().destroyFence(m_fence, nullptr, Dispatch());
@@ -1,5 +1,33 @@
 ﻿#include <gris/graphics/vulkan/input_layout.h>
 
+#include <gris/assert.h>
+#include <gris/casts.h>
+
+#include <array>
+#include <iterator>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace
+{
+
+[[nodiscard]] vk::Format AttributeFormat(Gris::Graphics::VertexComponentType componentType, uint32_t componentCount)
+{
+    // One row per component type, one column per component count
+    constexpr static std::array LookUpTable = {
+        std::array{ vk::Format::eR32Sfloat, vk::Format::eR32G32Sfloat, vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32A32Sfloat },
+        std::array{ vk::Format::eR16Sfloat, vk::Format::eR16G16Sfloat, vk::Format::eR16G16B16Sfloat, vk::Format::eR16G16B16A16Sfloat },
+        std::array{ vk::Format::eR16Unorm, vk::Format::eR16G16Unorm, vk::Format::eR16G16B16Unorm, vk::Format::eR16G16B16A16Unorm },
+    };
+
+    GRIS_ALWAYS_ASSERT(Gris::UnderlyingCast(componentType) < std::size(LookUpTable), "Value of current component type exceeds LookUpTable size");
+    GRIS_ALWAYS_ASSERT(componentCount > 0 && componentCount <= std::size(LookUpTable[0]), "Vertex attributes have one to four components");
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return LookUpTable[Gris::UnderlyingCast(componentType)][componentCount - 1];
+}
+
+}  // namespace
+
 // -------------------------------------------------------------------------------------------------
 
 void Gris::Graphics::Vulkan::InputLayout::AddBinding(uint32_t binding, uint32_t stride, vk::VertexInputRate inputRate)
@@ -16,6 +44,17 @@ void Gris::Graphics::Vulkan::InputLayout::AddAttributeDescription(uint32_t locat
 
 // -------------------------------------------------------------------------------------------------
 
+void Gris::Graphics::Vulkan::InputLayout::AddVertexFormat(uint32_t binding, uint32_t stride, Span<const VertexAttributeDescription> attributes, vk::VertexInputRate inputRate)
+{
+    AddBinding(binding, stride, inputRate);
+    for (auto const & attribute : attributes)
+    {
+        AddAttributeDescription(attribute.Location, binding, AttributeFormat(attribute.ComponentType, attribute.ComponentCount), attribute.Offset);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] const std::vector<vk::VertexInputBindingDescription> & Gris::Graphics::Vulkan::InputLayout::BindingDescription() const
 {
     return m_bindings;
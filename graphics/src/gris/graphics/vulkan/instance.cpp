@@ -62,6 +62,22 @@ VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(const VkDebugUtilsMessageSeverityFl
     return VK_FALSE;
 }
 
+// -------------------------------------------------------------------------------------------------
+
+struct InstanceConfiguration
+{
+    bool Headless = false;
+    bool Created = false;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+InstanceConfiguration & Configuration()
+{
+    static InstanceConfiguration s_configuration = {};
+    return s_configuration;
+}
+
 }  // namespace
 
 // -------------------------------------------------------------------------------------------------
@@ -207,12 +223,34 @@ Gris::Graphics::Vulkan::Instance::~Instance()
 
 // -------------------------------------------------------------------------------------------------
 
+void Gris::Graphics::Vulkan::Instance::SetHeadless(bool headless)
+{
+    GRIS_ALWAYS_ASSERT(!Configuration().Created, "Headless mode must be set before the instance is created");
+    Configuration().Headless = headless;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::Instance::IsHeadless()
+{
+#ifdef GRIS_CHRAPHICS_HAS_GLFW
+    return Configuration().Headless;
+#else
+    return true;
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] std::vector<const char *> Gris::Graphics::Vulkan::Instance::GetRequiredExtensions()
 {
     auto extensions = std::vector<const char *>{};
 
 #ifdef GRIS_CHRAPHICS_HAS_GLFW
-    Glfw::GetInstanceExtensionsFromGLFW(&extensions);
+    if (!IsHeadless())
+    {
+        Glfw::GetInstanceExtensionsFromGLFW(&extensions);
+    }
 #endif
 
     if constexpr (ENABLE_VALIDATION_LAYERS)
@@ -236,6 +274,8 @@ Gris::Graphics::Vulkan::Instance & Gris::Graphics::Vulkan::Instance::GetInstance
 
 Gris::Graphics::Vulkan::Instance::Instance()
 {
+    Configuration().Created = true;
+
     CreateInstance();
     SetupDebugMessenger();
 }
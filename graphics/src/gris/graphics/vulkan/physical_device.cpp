@@ -11,7 +11,8 @@
 #include <gris/assert.h>
 #include <gris/utils.h>
 
-#include <set>
+#include <algorithm>
+#include <map>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -19,13 +20,13 @@ Gris::Graphics::Vulkan::PhysicalDevice::PhysicalDevice() = default;
 
 // -------------------------------------------------------------------------------------------------
 
-Gris::Graphics::Vulkan::PhysicalDevice::PhysicalDevice(vk::PhysicalDevice physicalDevice, vk::SampleCountFlagBits msaaSamples, DeviceQueueFamilyIndices queueFamilies)
+Gris::Graphics::Vulkan::PhysicalDevice::PhysicalDevice(vk::PhysicalDevice physicalDevice, DeviceCapabilities capabilities, DeviceQueueFamilyIndices queueFamilies)
     : m_physicalDevice(physicalDevice)
-    , m_msaaSamples(msaaSamples)
+    , m_capabilities(capabilities)
     , m_queueFamilies(queueFamilies)
 {
     GRIS_ALWAYS_ASSERT(m_physicalDevice, "Physical device must be valid");
-    GRIS_ALWAYS_ASSERT(m_queueFamilies.IsComplete(), "Queue family indices must be complete");
+    GRIS_ALWAYS_ASSERT(m_queueFamilies.IsHeadlessComplete(), "Queue family indices must be complete");
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -39,14 +40,21 @@ Gris::Graphics::Vulkan::PhysicalDevice::operator bool() const
 
 [[nodiscard]] bool Gris::Graphics::Vulkan::PhysicalDevice::IsValid() const
 {
-    return static_cast<bool>(m_physicalDevice) && m_queueFamilies.IsComplete();
+    return static_cast<bool>(m_physicalDevice) && m_queueFamilies.IsHeadlessComplete();
 }
 
 // -------------------------------------------------------------------------------------------------
 
 [[nodiscard]] const vk::SampleCountFlagBits & Gris::Graphics::Vulkan::PhysicalDevice::MsaaSamples() const
 {
-    return m_msaaSamples;
+    return m_capabilities.MsaaSamples;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] float Gris::Graphics::Vulkan::PhysicalDevice::MaxAnisotropy() const
+{
+    return m_capabilities.MaxAnisotropy;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -58,6 +66,56 @@ Gris::Graphics::Vulkan::PhysicalDevice::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] bool Gris::Graphics::Vulkan::PhysicalDevice::IsHeadless() const
+{
+    return !m_queueFamilies.SupportsPresentation();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::PhysicalDeviceProperties Gris::Graphics::Vulkan::PhysicalDevice::Properties() const
+{
+    return m_physicalDevice.getProperties(Instance::Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::QueueFamilyProperties Gris::Graphics::Vulkan::PhysicalDevice::QueueFamilyProperties(uint32_t queueFamily) const
+{
+    auto const queueFamilies = m_physicalDevice.getQueueFamilyProperties(Instance::Dispatch());
+    GRIS_ALWAYS_ASSERT(queueFamily < queueFamilies.size(), "Queue family index out of range");
+    return queueFamilies[queueFamily];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::PhysicalDeviceFeatures Gris::Graphics::Vulkan::PhysicalDevice::SupportedFeatures() const
+{
+    return m_physicalDevice.getFeatures(Instance::Dispatch());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::PhysicalDeviceFeatures Gris::Graphics::Vulkan::PhysicalDevice::EnabledFeatures() const
+{
+    return m_capabilities.EnabledFeatures;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::PhysicalDevice::SupportsTimelineSemaphores() const
+{
+    if (!CheckDeviceExtensionSupport(m_physicalDevice, TIMELINE_SEMAPHORE_EXTENSIONS))
+    {
+        return false;
+    }
+
+    auto const features = m_physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceTimelineSemaphoreFeatures>(Instance::Dispatch());
+    return static_cast<bool>(features.get<vk::PhysicalDeviceTimelineSemaphoreFeatures>().timelineSemaphore);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] vk::Format Gris::Graphics::Vulkan::PhysicalDevice::FindSupportedFormat(const std::vector<vk::Format> & candidates, const vk::ImageTiling & tiling, const vk::FormatFeatureFlags & features) const
 {
     for (auto const & format : candidates)
@@ -84,29 +142,46 @@ Gris::Graphics::Vulkan::PhysicalDevice::operator bool() const
 
 [[nodiscard]] Gris::Graphics::Vulkan::SwapChainSupportDetails Gris::Graphics::Vulkan::PhysicalDevice::SwapChainSupport(const WindowMixin & window) const
 {
+    GRIS_ALWAYS_ASSERT(!IsHeadless(), "Headless physical devices do not support swap chains");
     return QuerySwapChainSupport(m_physicalDevice, window.SurfaceHandle());
 }
 
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] vk::Device Gris::Graphics::Vulkan::PhysicalDevice::CreateDevice() const
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::PhysicalDevice::AsyncComputeQueueCount(const DeviceQueueConfiguration & configuration) const
 {
-    auto uniqueQueueFamilies = std::set<uint32_t>{
-        m_queueFamilies.graphicsFamily.value(),
-        m_queueFamilies.presentFamily.value()
-    };
+    return Vulkan::AsyncComputeQueueCount(m_queueFamilies, configuration);
+}
 
-    std::array<float, 1> queuePriority = { 1.0F };
-    auto queueCreateInfos = Gris::MakeReservedVector<vk::DeviceQueueCreateInfo>(uniqueQueueFamilies.size());
-    for (auto queueFamily : uniqueQueueFamilies)
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Device Gris::Graphics::Vulkan::PhysicalDevice::CreateDevice(const DeviceQueueConfiguration & configuration) const
+{
+    // Each family can only be listed once, the present queue shares the priority of the graphics one
+    auto queuePriorities = std::map<uint32_t, std::vector<float>>{};
+    queuePriorities[m_queueFamilies.graphicsFamily.value()] = { configuration.GraphicsPriority };
+
+    auto const asyncComputeQueueCount = AsyncComputeQueueCount(configuration);
+    if (asyncComputeQueueCount > 0)
+    {
+        auto const first = std::begin(configuration.AsyncComputePriorities);
+        queuePriorities[m_queueFamilies.computeFamily.value()] = std::vector<float>(first, first + asyncComputeQueueCount);
+    }
+
+    if (m_queueFamilies.presentFamily)
+    {
+        queuePriorities.try_emplace(m_queueFamilies.presentFamily.value(), std::vector<float>{ configuration.GraphicsPriority });
+    }
+
+    auto queueCreateInfos = Gris::MakeReservedVector<vk::DeviceQueueCreateInfo>(queuePriorities.size());
+    for (auto const & [queueFamily, priorities] : queuePriorities)
     {
         queueCreateInfos.emplace_back(vk::DeviceQueueCreateInfo{}
                                           .setQueueFamilyIndex(queueFamily)
-                                          .setQueuePriorities(queuePriority));
+                                          .setQueuePriorities(priorities));
     }
 
-    vk::PhysicalDeviceFeatures deviceFeatures{};
-    deviceFeatures.samplerAnisotropy = static_cast<vk::Bool32>(true);
+    auto const deviceFeatures = EnabledFeatures();
 
     std::vector<const char *> enabledLayers;
     if constexpr (ENABLE_VALIDATION_LAYERS)
@@ -114,10 +189,24 @@ Gris::Graphics::Vulkan::PhysicalDevice::operator bool() const
         enabledLayers.insert(enabledLayers.end(), VALIDATION_LAYERS.begin(), VALIDATION_LAYERS.end());
     }
 
+    std::vector<const char *> enabledExtensions;
+    if (!IsHeadless())
+    {
+        enabledExtensions.insert(enabledExtensions.end(), PRESENTATION_EXTENSIONS.begin(), PRESENTATION_EXTENSIONS.end());
+    }
+
+    auto timelineSemaphoreFeatures = vk::PhysicalDeviceTimelineSemaphoreFeatures{};
+    if (SupportsTimelineSemaphores())
+    {
+        enabledExtensions.insert(enabledExtensions.end(), TIMELINE_SEMAPHORE_EXTENSIONS.begin(), TIMELINE_SEMAPHORE_EXTENSIONS.end());
+        timelineSemaphoreFeatures.setTimelineSemaphore(static_cast<vk::Bool32>(true));
+    }
+
     auto const createInfo = vk::DeviceCreateInfo{}
+                                .setPNext(timelineSemaphoreFeatures.timelineSemaphore ? &timelineSemaphoreFeatures : nullptr)
                                 .setQueueCreateInfos(queueCreateInfos)
                                 .setPEnabledLayerNames(enabledLayers)
-                                .setPEnabledExtensionNames(REQUIRED_EXTENSIONS)
+                                .setPEnabledExtensionNames(enabledExtensions)
                                 .setPEnabledFeatures(&deviceFeatures);
 
     auto createDeviceResult = m_physicalDevice.createDevice(createInfo, nullptr, Instance::Dispatch());
@@ -141,6 +230,6 @@ Gris::Graphics::Vulkan::PhysicalDevice::operator bool() const
 void Gris::Graphics::Vulkan::PhysicalDevice::Reset()
 {
     m_queueFamilies = {};
-    m_msaaSamples = vk::SampleCountFlagBits::e1;
+    m_capabilities = {};
     m_physicalDevice = nullptr;
 }
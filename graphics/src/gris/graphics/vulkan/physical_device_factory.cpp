@@ -1,84 +1,59 @@
 #include <gris/graphics/vulkan/physical_device_factory.h>
 
+#include <gris/graphics/vulkan/device_profile.h>
 #include <gris/graphics/vulkan/instance.h>
 #include <gris/graphics/vulkan/physical_device.h>
 #include <gris/graphics/vulkan/utils.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 #include <gris/graphics/vulkan/window_mixin.h>
 
-#include <set>
+#include <gris/span.h>
 
 // -------------------------------------------------------------------------------------------------
 
 namespace
 {
 
-[[nodiscard]] Gris::Graphics::Vulkan::DeviceQueueFamilyIndices FindQueueFamilies(const vk::PhysicalDevice & device, const vk::SurfaceKHR & surface)
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceQueueFamilyIndices QueryQueueFamilies(const vk::PhysicalDevice & device, const vk::SurfaceKHR & surface)
 {
     using namespace Gris::Graphics::Vulkan;
 
-    auto queueFamilies = device.getQueueFamilyProperties(Instance::Dispatch());
-
-    DeviceQueueFamilyIndices indices;
-    auto i = 0U;
-    for (auto const & queueFamily : queueFamilies)
+    auto const queueFamilies = device.getQueueFamilyProperties(Instance::Dispatch());
+    if (!surface)
     {
-        if (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
-        {
-            indices.graphicsFamily = i;
-        }
+        return FindQueueFamilies(queueFamilies, {});
+    }
 
-        auto const surfaceSupportResult = device.getSurfaceSupportKHR(i, surface, Instance::Dispatch());
+    auto const supportsPresentation = [&device, &surface](uint32_t queueFamilyIndex)
+    {
+        auto const surfaceSupportResult = device.getSurfaceSupportKHR(queueFamilyIndex, surface, Instance::Dispatch());
         if (surfaceSupportResult.result != vk::Result::eSuccess)
         {
             throw VulkanEngineException("Error getting surface support for physical device", surfaceSupportResult);
         }
 
-        if (surfaceSupportResult.value != 0U)
-        {
-            indices.presentFamily = i;
-        }
-
-        if (indices.IsComplete())
-        {
-            break;
-        }
-
-        i++;
-    }
-
-    return indices;
+        return surfaceSupportResult.value != 0U;
+    };
+    return FindQueueFamilies(queueFamilies, supportsPresentation);
 }
 
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] bool CheckDeviceExtensionSupport(const vk::PhysicalDevice & device)
+[[nodiscard]] std::tuple<bool, Gris::Graphics::Vulkan::DeviceQueueFamilyIndices> IsDeviceSuitable(const vk::PhysicalDevice & device, const vk::SurfaceKHR & surface, const Gris::Graphics::Vulkan::DeviceProfile & profile)
 {
     using namespace Gris::Graphics::Vulkan;
 
-    auto availableExtensionsResult = device.enumerateDeviceExtensionProperties(nullptr, Instance::Dispatch());
-    if (availableExtensionsResult.result != vk::Result::eSuccess)
-    {
-        throw VulkanEngineException("Error enumerating physical device extension properties", availableExtensionsResult);
-    }
+    auto queueFamilies = QueryQueueFamilies(device, surface);
+    auto supportedFeatures = device.getFeatures(Instance::Dispatch());
+    auto const featuresSupported = SupportsFeatures(supportedFeatures, profile.RequiredFeatures);
 
-    std::set<std::string> requiredExtensions(PhysicalDevice::REQUIRED_EXTENSIONS.begin(), PhysicalDevice::REQUIRED_EXTENSIONS.end());
-    for (auto const & extension : availableExtensionsResult.value)
+    if (!surface)
     {
-        requiredExtensions.erase(extension.extensionName);
+        auto isSuitable = queueFamilies.IsHeadlessComplete() && featuresSupported;
+        return { isSuitable, queueFamilies };
     }
 
-    return requiredExtensions.empty();
-}
-
-// -------------------------------------------------------------------------------------------------
-
-[[nodiscard]] std::tuple<bool, Gris::Graphics::Vulkan::DeviceQueueFamilyIndices> IsDeviceSuitable(const vk::PhysicalDevice & device, const vk::SurfaceKHR & surface)
-{
-    using namespace Gris::Graphics::Vulkan;
-
-    auto queueFamilies = FindQueueFamilies(device, surface);
-    auto extensionsSupported = CheckDeviceExtensionSupport(device);
+    auto extensionsSupported = CheckDeviceExtensionSupport(device, PhysicalDevice::PRESENTATION_EXTENSIONS);
 
     auto swapChainSupport = SwapChainSupportDetails{};
     auto swapChainAdequate = false;
@@ -88,63 +63,83 @@ namespace
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
 
-    auto supportedFeatures = device.getFeatures(Instance::Dispatch());
-    auto isSuitable = queueFamilies.IsComplete() && extensionsSupported && swapChainAdequate && static_cast<bool>(supportedFeatures.samplerAnisotropy);
+    auto isSuitable = queueFamilies.IsComplete() && extensionsSupported && swapChainAdequate && featuresSupported;
     return { isSuitable, queueFamilies };
 }
 
+}  // namespace
+
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] vk::SampleCountFlagBits GetMaxUsableSampleCount(const vk::PhysicalDevice & physicalDevice)
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const WindowMixin & window)
 {
-    auto const physicalDeviceProperties = physicalDevice.getProperties(Gris::Graphics::Vulkan::Instance::Dispatch());
+    return FindSuitablePhysicalDevice(window, DeviceProfile{});
+}
 
-    auto const counts = physicalDeviceProperties.limits.framebufferColorSampleCounts & physicalDeviceProperties.limits.framebufferDepthSampleCounts;
-    if (counts & vk::SampleCountFlagBits::e64)
-    {
-        return vk::SampleCountFlagBits::e64;
-    }
-    if (counts & vk::SampleCountFlagBits::e32)
-    {
-        return vk::SampleCountFlagBits::e32;
-    }
-    if (counts & vk::SampleCountFlagBits::e16)
-    {
-        return vk::SampleCountFlagBits::e16;
-    }
-    if (counts & vk::SampleCountFlagBits::e8)
-    {
-        return vk::SampleCountFlagBits::e8;
-    }
-    if (counts & vk::SampleCountFlagBits::e4)
-    {
-        return vk::SampleCountFlagBits::e4;
-    }
-    if (counts & vk::SampleCountFlagBits::e2)
-    {
-        return vk::SampleCountFlagBits::e2;
-    }
+// -------------------------------------------------------------------------------------------------
 
-    return vk::SampleCountFlagBits::e1;
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice()
+{
+    return FindSuitablePhysicalDevice(DeviceProfile{});
 }
 
-}  // namespace
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const vk::SurfaceKHR & surface)
+{
+    return FindSuitablePhysicalDevice(surface, DeviceProfile{});
+}
 
 // -------------------------------------------------------------------------------------------------
 
-[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const WindowMixin & window)
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const WindowMixin & window, const DeviceProfile & profile)
+{
+    return FindSuitablePhysicalDevice(window.SurfaceHandle(), profile);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const DeviceProfile & profile)
+{
+    return FindSuitablePhysicalDevice(vk::SurfaceKHR{}, profile);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::PhysicalDevice Gris::Graphics::Vulkan::FindSuitablePhysicalDevice(const vk::SurfaceKHR & surface, const DeviceProfile & profile)
 {
     auto devices = Instance::EnumeratePhysicalDevices();
 
+    // Enumeration order is up to the driver, on hybrid laptops the integrated GPU often comes first
+    auto bestDevice = vk::PhysicalDevice{};
+    auto bestQueueFamilies = DeviceQueueFamilyIndices{};
+    auto bestScore = uint64_t{ 0 };
     for (auto const & device : devices)
     {
-        auto [isSuitable, queueFamilies] = IsDeviceSuitable(device, window.SurfaceHandle());
-        if (isSuitable)
+        auto [isSuitable, queueFamilies] = IsDeviceSuitable(device, surface, profile);
+        if (!isSuitable)
+        {
+            continue;
+        }
+
+        auto const properties = device.getProperties(Instance::Dispatch());
+        auto const memoryProperties = device.getMemoryProperties(Instance::Dispatch());
+        auto const supportedFeatures = device.getFeatures(Instance::Dispatch());
+        auto const score = ScorePhysicalDevice(properties, memoryProperties, supportedFeatures, profile);
+        if (!bestDevice || score > bestScore)
         {
-            auto const msaaSamples = GetMaxUsableSampleCount(device);
-            return PhysicalDevice(device, msaaSamples, queueFamilies);
+            bestDevice = device;
+            bestQueueFamilies = queueFamilies;
+            bestScore = score;
         }
     }
 
-    throw VulkanEngineException("Failed to find a suitable GPU!");
+    if (!bestDevice)
+    {
+        throw VulkanEngineException("Failed to find a suitable GPU!");
+    }
+
+    auto const properties = bestDevice.getProperties(Instance::Dispatch());
+    auto const supportedFeatures = bestDevice.getFeatures(Instance::Dispatch());
+    return PhysicalDevice(bestDevice, ResolveDeviceProfile(properties, supportedFeatures, profile), bestQueueFamilies);
 }
@@ -24,18 +24,50 @@ Gris::Graphics::Vulkan::PipelineStateObject::PipelineStateObject(
     Span<const ShaderResourceBindingsLayout> resourceLayouts,
     const Shader & vertexShader,
     const Shader & fragmentShader)
+    : PipelineStateObject(device, swapChainWidth, swapChainHeight, renderPass, inputLayout, resourceLayouts, vertexShader, &fragmentShader)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::PipelineStateObject::PipelineStateObject(
+    const ParentObject<Device> & device,
+    std::optional<uint32_t> swapChainWidth,
+    std::optional<uint32_t> swapChainHeight,
+    const RenderPass & renderPass,
+    const InputLayout & inputLayout,
+    Span<const ShaderResourceBindingsLayout> resourceLayouts,
+    const Shader & vertexShader)
+    : PipelineStateObject(device, swapChainWidth, swapChainHeight, renderPass, inputLayout, resourceLayouts, vertexShader, nullptr)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::PipelineStateObject::PipelineStateObject(
+    const ParentObject<Device> & device,
+    std::optional<uint32_t> swapChainWidth,
+    std::optional<uint32_t> swapChainHeight,
+    const RenderPass & renderPass,
+    const InputLayout & inputLayout,
+    Span<const ShaderResourceBindingsLayout> resourceLayouts,
+    const Shader & vertexShader,
+    const Shader * fragmentShader)
     : DeviceResource(device)
 {
-    auto const shaderStages = std::array{
+    auto shaderStages = std::vector{
         vk::PipelineShaderStageCreateInfo{}
             .setStage(vk::ShaderStageFlagBits::eVertex)
             .setModule(vertexShader.ModuleHandle())
             .setPName(vertexShader.EntryPoint().c_str()),
-        vk::PipelineShaderStageCreateInfo{}
-            .setStage(vk::ShaderStageFlagBits::eFragment)
-            .setModule(fragmentShader.ModuleHandle())
-            .setPName(fragmentShader.EntryPoint().c_str()),
     };
+    if (fragmentShader != nullptr)
+    {
+        shaderStages.emplace_back(vk::PipelineShaderStageCreateInfo{}
+                                      .setStage(vk::ShaderStageFlagBits::eFragment)
+                                      .setModule(fragmentShader->ModuleHandle())
+                                      .setPName(fragmentShader->EntryPoint().c_str()));
+    }
 
     auto const & bindingDescriptors = inputLayout.BindingDescription();
     auto const & attributeDescriptors = inputLayout.AttributeDescriptions();
@@ -93,10 +125,11 @@ Gris::Graphics::Vulkan::PipelineStateObject::PipelineStateObject(
                                      .setRasterizationSamples(ParentDevice().MsaaSamples())
                                      .setSampleShadingEnable(static_cast<vk::Bool32>(false));
 
+    // Less or equal lets a pass draw over the depth a prepass laid down for the same geometry
     auto const depthStencil = vk::PipelineDepthStencilStateCreateInfo{}
                                   .setDepthTestEnable(static_cast<vk::Bool32>(true))
                                   .setDepthWriteEnable(static_cast<vk::Bool32>(true))
-                                  .setDepthCompareOp(vk::CompareOp::eLess)
+                                  .setDepthCompareOp(vk::CompareOp::eLessOrEqual)
                                   .setStencilTestEnable(static_cast<vk::Bool32>(false));
 
     auto const colorBlendAttachments = std::array{
@@ -111,10 +144,12 @@ Gris::Graphics::Vulkan::PipelineStateObject::PipelineStateObject(
             .setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA)
     };
 
+    // Depth only pipelines have no color attachments to blend into
     auto const colorBlending = vk::PipelineColorBlendStateCreateInfo{}
                                    .setLogicOpEnable(static_cast<vk::Bool32>(false))
                                    .setLogicOp(vk::LogicOp::eCopy)
-                                   .setAttachments(colorBlendAttachments)
+                                   .setAttachmentCount(fragmentShader != nullptr ? static_cast<uint32_t>(colorBlendAttachments.size()) : 0)
+                                   .setPAttachments(colorBlendAttachments.data())
                                    .setBlendConstants({ 0.0F, 0.0F, 0.0F, 0.0F });
 
     auto dynamicState = vk::PipelineDynamicStateCreateInfo{};
@@ -254,13 +289,11 @@ void Gris::Graphics::Vulkan::PipelineStateObject::ReleaseResources()
 {
     if (m_graphicsPipeline)
     {
-        DeviceHandle().destroyPipeline(m_graphicsPipeline, nullptr, Dispatch());
-        m_graphicsPipeline = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_graphicsPipeline, {}));
     }
 
     if (m_pipelineLayout)
     {
-        DeviceHandle().destroyPipelineLayout(m_pipelineLayout, nullptr, Dispatch());
-        m_pipelineLayout = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_pipelineLayout, {}));
     }
 }
@@ -10,6 +10,13 @@ Gris::Graphics::Vulkan::RenderPass::RenderPass() = default;
 // -------------------------------------------------------------------------------------------------
 
 Gris::Graphics::Vulkan::RenderPass::RenderPass(const ParentObject<Device> & device, vk::Format swapChainFormat, vk::Format depthFormat)
+    : RenderPass(device, swapChainFormat, depthFormat, vk::ImageLayout::ePresentSrcKHR)
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderPass::RenderPass(const ParentObject<Device> & device, vk::Format swapChainFormat, vk::Format depthFormat, vk::ImageLayout finalLayout)
     : DeviceResource(device)
 {
     auto const colorAttachment = vk::AttachmentDescription{}
@@ -40,7 +47,7 @@ Gris::Graphics::Vulkan::RenderPass::RenderPass(const ParentObject<Device> & devi
                                             .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
                                             .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
                                             .setInitialLayout(vk::ImageLayout::eUndefined)
-                                            .setFinalLayout(vk::ImageLayout::ePresentSrcKHR);
+                                            .setFinalLayout(finalLayout);
 
     auto const colorAttachmentRef = vk::AttachmentReference{}.setAttachment(0).setLayout(vk::ImageLayout::eColorAttachmentOptimal);
     auto const depthAttachmentRef = vk::AttachmentReference{}.setAttachment(1).setLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
@@ -85,6 +92,20 @@ Gris::Graphics::Vulkan::RenderPass::RenderPass(const ParentObject<Device> & devi
 
 // -------------------------------------------------------------------------------------------------
 
+Gris::Graphics::Vulkan::RenderPass::RenderPass(const ParentObject<Device> & device, const vk::RenderPassCreateInfo & renderPassInfo)
+    : DeviceResource(device)
+{
+    auto const createRenderPassResult = DeviceHandle().createRenderPass(renderPassInfo, nullptr, Dispatch());
+    if (createRenderPassResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error creating render pass", createRenderPassResult);
+    }
+
+    m_renderPass = createRenderPassResult.value;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Gris::Graphics::Vulkan::RenderPass::RenderPass(RenderPass && other) noexcept
     : DeviceResource(std::move(other))
     , m_renderPass(std::exchange(other.m_renderPass, {}))
@@ -155,7 +176,6 @@ void Gris::Graphics::Vulkan::RenderPass::ReleaseResources()
 {
     if (m_renderPass)
     {
-        DeviceHandle().destroyRenderPass(m_renderPass, nullptr, Dispatch());
-        m_renderPass = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_renderPass, {}));
     }
 }
@@ -0,0 +1,298 @@
+#include <gris/graphics/vulkan/render_target_ring.h>
+
+#include <gris/graphics/vulkan/deferred_context.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/immediate_context.h>
+#include <gris/graphics/vulkan/vulkan_engine_exception.h>
+
+#include <gris/assert.h>
+
+#include <algorithm>
+#include <limits>
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing::RenderTargetRing() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing::RenderTargetRing(
+    const ParentObject<Device> & device,
+    uint32_t width,
+    uint32_t height,
+    vk::Format format,
+    uint32_t imageCount,
+    uint32_t virtualFrameCount)
+    : DeviceResource(device)
+    , m_format(format)
+    , m_extent(width, height)
+    , m_virtualFrameCount(virtualFrameCount)
+{
+    GRIS_ALWAYS_ASSERT(imageCount > 0, "Render target ring must have at least one image");
+    GRIS_ALWAYS_ASSERT(virtualFrameCount > 0, "Render target ring must have at least one virtual frame");
+
+    m_images.reserve(imageCount);
+    m_imageViews.reserve(imageCount);
+    for (uint32_t imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+    {
+        auto & image = m_images.emplace_back(ParentDevice().CreateTexture(
+            width,
+            height,
+            1,
+            vk::SampleCountFlagBits::e1,
+            m_format,
+            vk::ImageTiling::eOptimal,
+            vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eSampled,
+            vk::MemoryPropertyFlagBits::eDeviceLocal));
+        m_imageViews.emplace_back(ParentDevice().CreateTextureView(image, m_format, vk::ImageAspectFlagBits::eColor, 1));
+    }
+
+    m_virtualFrameTimelineValues.resize(m_virtualFrameCount, 0);
+
+    if (ParentDevice().Context().HasTimeline())
+    {
+        m_imageTimelineValues.resize(imageCount, 0);
+        return;
+    }
+
+    m_renderFinishedFences.reserve(m_virtualFrameCount);
+    for (uint32_t frameIndex = 0; frameIndex < m_virtualFrameCount; ++frameIndex)
+    {
+        m_renderFinishedFences.emplace_back(ParentDevice().CreateFence(true));
+    }
+
+    m_imageToVirtualFrame.resize(imageCount, std::numeric_limits<uint32_t>::max());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing::RenderTargetRing(RenderTargetRing && other) noexcept
+    : DeviceResource(std::move(other))
+    , m_images(std::exchange(other.m_images, {}))
+    , m_imageViews(std::exchange(other.m_imageViews, {}))
+    , m_format(std::exchange(other.m_format, {}))
+    , m_extent(std::exchange(other.m_extent, {}))
+    , m_renderFinishedFences(std::exchange(other.m_renderFinishedFences, {}))
+    , m_currentVirtualFrame(std::exchange(other.m_currentVirtualFrame, 0))
+    , m_virtualFrameCount(std::exchange(other.m_virtualFrameCount, 1))
+    , m_currentImage(std::exchange(other.m_currentImage, 0))
+    , m_imageToVirtualFrame(std::exchange(other.m_imageToVirtualFrame, {}))
+    , m_virtualFrameTimelineValues(std::exchange(other.m_virtualFrameTimelineValues, {}))
+    , m_imageTimelineValues(std::exchange(other.m_imageTimelineValues, {}))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing & Gris::Graphics::Vulkan::RenderTargetRing::operator=(RenderTargetRing && other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseResources();
+
+        DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
+        m_images = std::exchange(other.m_images, {});
+        m_imageViews = std::exchange(other.m_imageViews, {});
+        m_format = std::exchange(other.m_format, {});
+        m_extent = std::exchange(other.m_extent, {});
+        m_renderFinishedFences = std::exchange(other.m_renderFinishedFences, {});
+        m_currentVirtualFrame = std::exchange(other.m_currentVirtualFrame, 0);
+        m_virtualFrameCount = std::exchange(other.m_virtualFrameCount, 1);
+        m_currentImage = std::exchange(other.m_currentImage, 0);
+        m_imageToVirtualFrame = std::exchange(other.m_imageToVirtualFrame, {});
+        m_virtualFrameTimelineValues = std::exchange(other.m_virtualFrameTimelineValues, {});
+        m_imageTimelineValues = std::exchange(other.m_imageTimelineValues, {});
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing::~RenderTargetRing()
+{
+    ReleaseResources();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::RenderTargetRing::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::RenderTargetRing::IsValid() const
+{
+    return IsDeviceValid() && !m_images.empty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::RenderTargetRing::ImageCount() const
+{
+    return static_cast<uint32_t>(m_images.size());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::RenderTargetRing::VirtualFrameCount() const
+{
+    return m_virtualFrameCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::Texture & Gris::Graphics::Vulkan::RenderTargetRing::Image(const size_t index) const
+{
+    GRIS_ALWAYS_ASSERT(index < m_images.size(), "Render target index must be in range");
+    return m_images[index];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::Texture & Gris::Graphics::Vulkan::RenderTargetRing::Image(const size_t index)
+{
+    GRIS_ALWAYS_ASSERT(index < m_images.size(), "Render target index must be in range");
+    return m_images[index];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const Gris::Graphics::Vulkan::TextureView & Gris::Graphics::Vulkan::RenderTargetRing::ImageView(const size_t index) const
+{
+    GRIS_ALWAYS_ASSERT(index < m_imageViews.size(), "Render target index must be in range");
+    return m_imageViews[index];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::TextureView & Gris::Graphics::Vulkan::RenderTargetRing::ImageView(const size_t index)
+{
+    GRIS_ALWAYS_ASSERT(index < m_imageViews.size(), "Render target index must be in range");
+    return m_imageViews[index];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Format Gris::Graphics::Vulkan::RenderTargetRing::Format() const
+{
+    return m_format;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Extent2D Gris::Graphics::Vulkan::RenderTargetRing::Extent() const
+{
+    return m_extent;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] std::optional<Gris::Graphics::Vulkan::VirtualFrame> Gris::Graphics::Vulkan::RenderTargetRing::NextImage()
+{
+    auto const virtualFrameIndex = m_currentVirtualFrame;
+    m_currentVirtualFrame = (m_currentVirtualFrame + 1) % m_virtualFrameCount;
+
+    auto const imageIndex = m_currentImage;
+    m_currentImage = (m_currentImage + 1) % ImageCount();
+
+    if (ParentDevice().Context().HasTimeline())
+    {
+        auto const & immediateContext = ParentDevice().Context();
+        immediateContext.WaitForValue(std::max(m_virtualFrameTimelineValues[virtualFrameIndex], m_imageTimelineValues[imageIndex]));
+        ParentDevice().CollectDeferredDestructions();
+        return VirtualFrame{ virtualFrameIndex, imageIndex };
+    }
+
+    std::array fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
+    auto const waitResult = DeviceHandle().waitForFences(fences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
+    if (waitResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Failed to wait for current frame fence!", waitResult);
+    }
+
+    ParentDevice().Context().NotifyCompleted(m_virtualFrameTimelineValues[virtualFrameIndex]);
+
+    ///
+
+    auto const previousVirtualFrameIndex = m_imageToVirtualFrame[imageIndex];
+    if (previousVirtualFrameIndex != virtualFrameIndex && previousVirtualFrameIndex != std::numeric_limits<uint32_t>::max())
+    {
+        std::array additionalFences = { m_renderFinishedFences[previousVirtualFrameIndex].FenceHandle() };
+        auto const additionalFenceWaitResult = DeviceHandle().waitForFences(additionalFences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
+        if (additionalFenceWaitResult != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Failed to wait for image in flight fence!", additionalFenceWaitResult);
+        }
+
+        ParentDevice().Context().NotifyCompleted(m_virtualFrameTimelineValues[previousVirtualFrameIndex]);
+    }
+
+    m_imageToVirtualFrame[imageIndex] = virtualFrameIndex;
+
+    ///
+
+    fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
+    auto const resetResult = DeviceHandle().resetFences(fences, Dispatch());
+    if (resetResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error resetting current frame fence", resetResult);
+    }
+
+    ParentDevice().CollectDeferredDestructions();
+    return VirtualFrame{ virtualFrameIndex, imageIndex };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::RenderTargetRing::Submit(DeferredContext & context, const VirtualFrame & virtualFrame)
+{
+    auto & immediateContext = ParentDevice().Context();
+    if (!immediateContext.HasTimeline())
+    {
+        immediateContext.Submit(&context, {}, {}, m_renderFinishedFences[virtualFrame.VirtualFrameIndex]);
+        m_virtualFrameTimelineValues[virtualFrame.VirtualFrameIndex] = immediateContext.LastSubmittedValue();
+        return;
+    }
+
+    auto const submittedValue = immediateContext.Submit(&context, {}, {}, {});
+    m_virtualFrameTimelineValues[virtualFrame.VirtualFrameIndex] = submittedValue;
+    m_imageTimelineValues[virtualFrame.SwapChainImageIndex] = submittedValue;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::RenderTargetRing::Present(const VirtualFrame & /* virtualFrame */)
+{
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::RenderTargetRing::Reset()
+{
+    ReleaseResources();
+    ResetParent();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::RenderTargetRing::ReleaseResources()
+{
+    m_imageTimelineValues.clear();
+    m_virtualFrameTimelineValues.clear();
+    m_imageToVirtualFrame.clear();
+    m_currentImage = 0;
+    m_virtualFrameCount = 1;
+    m_currentVirtualFrame = 0;
+
+    m_renderFinishedFences.clear();
+
+    m_extent = vk::Extent2D{};
+    m_format = {};
+
+    m_imageViews.clear();
+    m_images.clear();
+}
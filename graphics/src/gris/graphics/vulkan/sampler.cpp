@@ -1,5 +1,6 @@
 ﻿#include <gris/graphics/vulkan/sampler.h>
 
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -11,23 +12,21 @@ Gris::Graphics::Vulkan::Sampler::Sampler() = default;
 Gris::Graphics::Vulkan::Sampler::Sampler(const ParentObject<Device> & device, float minLod, float maxLod)
     : DeviceResource(device)
 {
-    auto const samplerInfo = vk::SamplerCreateInfo{}
-                                 .setMinFilter(vk::Filter::eLinear)
-                                 .setMagFilter(vk::Filter::eLinear)
-                                 .setMipmapMode(vk::SamplerMipmapMode::eLinear)
-                                 .setAddressModeU(vk::SamplerAddressMode::eRepeat)
-                                 .setAddressModeV(vk::SamplerAddressMode::eRepeat)
-                                 .setAddressModeW(vk::SamplerAddressMode::eRepeat)
-                                 .setMipLodBias(0.0F)
-                                 .setAnisotropyEnable(static_cast<vk::Bool32>(true))
-                                 .setMaxAnisotropy(16.0F)
-                                 .setCompareEnable(static_cast<vk::Bool32>(false))
-                                 .setCompareOp(vk::CompareOp::eAlways)
-                                 .setMinLod(minLod)
-                                 .setMaxLod(maxLod)
-                                 .setBorderColor(vk::BorderColor::eIntOpaqueBlack)
-                                 .setUnnormalizedCoordinates(static_cast<vk::Bool32>(false));
+    CreateSampler(CreateInfo(minLod, maxLod, ParentDevice().MaxAnisotropy()));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::Sampler::Sampler(const ParentObject<Device> & device, const vk::SamplerCreateInfo & samplerInfo)
+    : DeviceResource(device)
+{
+    CreateSampler(samplerInfo);
+}
 
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Sampler::CreateSampler(const vk::SamplerCreateInfo & samplerInfo)
+{
     auto const createSamplerResult = DeviceHandle().createSampler(samplerInfo, nullptr, Dispatch());
     if (createSamplerResult.result != vk::Result::eSuccess)
     {
@@ -105,11 +104,32 @@ void Gris::Graphics::Vulkan::Sampler::Reset()
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] vk::SamplerCreateInfo Gris::Graphics::Vulkan::Sampler::CreateInfo(float minLod, float maxLod, float maxAnisotropy)
+{
+    return vk::SamplerCreateInfo{}
+        .setMinFilter(vk::Filter::eLinear)
+        .setMagFilter(vk::Filter::eLinear)
+        .setMipmapMode(vk::SamplerMipmapMode::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeV(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeW(vk::SamplerAddressMode::eRepeat)
+        .setMipLodBias(0.0F)
+        .setAnisotropyEnable(static_cast<vk::Bool32>(maxAnisotropy > 1.0F))
+        .setMaxAnisotropy(maxAnisotropy)
+        .setCompareEnable(static_cast<vk::Bool32>(false))
+        .setCompareOp(vk::CompareOp::eAlways)
+        .setMinLod(minLod)
+        .setMaxLod(maxLod)
+        .setBorderColor(vk::BorderColor::eIntOpaqueBlack)
+        .setUnnormalizedCoordinates(static_cast<vk::Bool32>(false));
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::Sampler::ReleaseResources()
 {
     if (m_sampler)
     {
-        DeviceHandle().destroySampler(m_sampler, nullptr, Dispatch());
-        m_sampler = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_sampler, {}));
     }
 }
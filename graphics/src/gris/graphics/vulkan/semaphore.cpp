@@ -1,5 +1,6 @@
 ﻿#include <gris/graphics/vulkan/semaphore.h>
 
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -94,7 +95,6 @@ void Gris::Graphics::Vulkan::Semaphore::ReleaseResources()
 {
     if (m_semaphore)
     {
-        DeviceHandle().destroySemaphore(m_semaphore, nullptr, Dispatch());
-        m_semaphore = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_semaphore, {}));
     }
 }
\ No newline at end of file
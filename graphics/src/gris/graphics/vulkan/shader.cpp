@@ -1,5 +1,6 @@
 ﻿#include <gris/graphics/vulkan/shader.h>
 
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 // -------------------------------------------------------------------------------------------------
@@ -107,7 +108,6 @@ void Gris::Graphics::Vulkan::Shader::ReleaseResources()
 {
     if (m_shaderModule)
     {
-        DeviceHandle().destroyShaderModule(m_shaderModule, nullptr, Dispatch());
-        m_shaderModule = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_shaderModule, {}));
     }
 }
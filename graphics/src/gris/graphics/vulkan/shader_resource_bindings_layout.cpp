@@ -150,7 +150,6 @@ void Gris::Graphics::Vulkan::ShaderResourceBindingsLayout::ReleaseResources()
 {
     if (m_descriptorSetLayout)
     {
-        DeviceHandle().destroyDescriptorSetLayout(m_descriptorSetLayout, nullptr, Dispatch());
-        m_descriptorSetLayout = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_descriptorSetLayout, {}));
     }
 }
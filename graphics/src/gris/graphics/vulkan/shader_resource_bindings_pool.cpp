@@ -1,5 +1,6 @@
 #include <gris/graphics/vulkan/shader_resource_bindings_pool.h>
 
+#include <gris/graphics/vulkan/device.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
 #include <gris/utils.h>
@@ -120,7 +121,6 @@ void Gris::Graphics::Vulkan::ShaderResourceBindingsPool::ReleaseResources()
 {
     if (m_pool)
     {
-        DeviceHandle().destroyDescriptorPool(m_pool, nullptr, Dispatch());
-        m_pool = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_pool, {}));
     }
 }
@@ -1,12 +1,16 @@
 #include <gris/graphics/vulkan/swap_chain.h>
 
+#include <gris/graphics/vulkan/deferred_context.h>
 #include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/immediate_context.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 #include <gris/graphics/vulkan/window_mixin.h>
 
 #include <gris/assert.h>
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 
 // -------------------------------------------------------------------------------------------------
 
@@ -75,6 +79,7 @@ Gris::Graphics::Vulkan::SwapChain::SwapChain(
     , m_virtualFrameCount(virtualFrameCount)
 {
     CreateSwapChain(window, width, height, {});
+    CreateSynchronizationObjects();
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -90,6 +95,7 @@ Gris::Graphics::Vulkan::SwapChain::SwapChain(
     , m_virtualFrameCount(virtualFrameCount)
 {
     CreateSwapChain(window, width, height, prevSwapChain.m_swapChain);
+    CreateSynchronizationObjects();
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -98,6 +104,7 @@ Gris::Graphics::Vulkan::SwapChain::SwapChain(SwapChain && other) noexcept
     : DeviceResource(std::move(other))
     , m_swapChain(std::exchange(other.m_swapChain, {}))
     , m_swapChainImages(std::exchange(other.m_swapChainImages, {}))
+    , m_minImageCount(std::exchange(other.m_minImageCount, 0))
     , m_presentQueue(std::exchange(other.m_presentQueue, {}))
     , m_swapChainImageFormat(std::exchange(other.m_swapChainImageFormat, {}))
     , m_swapChainExtent(std::exchange(other.m_swapChainExtent, {}))
@@ -108,6 +115,8 @@ Gris::Graphics::Vulkan::SwapChain::SwapChain(SwapChain && other) noexcept
     , m_currentVirtualFrame(std::exchange(other.m_currentVirtualFrame, 0))
     , m_virtualFrameCount(std::exchange(other.m_virtualFrameCount, 1))
     , m_swapChainImageToVirtualFrame(std::exchange(other.m_swapChainImageToVirtualFrame, {}))
+    , m_virtualFrameTimelineValues(std::exchange(other.m_virtualFrameTimelineValues, {}))
+    , m_swapChainImageTimelineValues(std::exchange(other.m_swapChainImageTimelineValues, {}))
 {
 }
 
@@ -122,6 +131,7 @@ Gris::Graphics::Vulkan::SwapChain & Gris::Graphics::Vulkan::SwapChain::operator=
         DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
         m_swapChain = std::exchange(other.m_swapChain, {});
         m_swapChainImages = std::exchange(other.m_swapChainImages, {});
+        m_minImageCount = std::exchange(other.m_minImageCount, 0);
         m_presentQueue = std::exchange(other.m_presentQueue, {});
         m_swapChainImageFormat = std::exchange(other.m_swapChainImageFormat, {});
         m_swapChainExtent = std::exchange(other.m_swapChainExtent, {});
@@ -132,6 +142,8 @@ Gris::Graphics::Vulkan::SwapChain & Gris::Graphics::Vulkan::SwapChain::operator=
         m_currentVirtualFrame = std::exchange(other.m_currentVirtualFrame, 0);
         m_virtualFrameCount = std::exchange(other.m_virtualFrameCount, 1);
         m_swapChainImageToVirtualFrame = std::exchange(other.m_swapChainImageToVirtualFrame, {});
+        m_virtualFrameTimelineValues = std::exchange(other.m_virtualFrameTimelineValues, {});
+        m_swapChainImageTimelineValues = std::exchange(other.m_swapChainImageTimelineValues, {});
     }
 
     return *this;
@@ -167,6 +179,13 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::SwapChain::AcquirableImageCount() const
+{
+    return ImageCount() - m_minImageCount;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] uint32_t Gris::Graphics::Vulkan::SwapChain::VirtualFrameCount() const
 {
     return m_virtualFrameCount;
@@ -174,6 +193,14 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] const vk::Image & Gris::Graphics::Vulkan::SwapChain::Image(const size_t index) const
+{
+    GRIS_ALWAYS_ASSERT(index < m_swapChainImages.size(), "Swap chain index must be in range");
+    return m_swapChainImages[index];
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] const Gris::Graphics::Vulkan::TextureView & Gris::Graphics::Vulkan::SwapChain::ImageView(const size_t index) const
 {
     GRIS_ALWAYS_ASSERT(index < m_swapChainImageViews.size(), "Swap chain index must be in range");
@@ -204,17 +231,32 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+void Gris::Graphics::Vulkan::SwapChain::Resize(const WindowMixin & window, uint32_t width, uint32_t height)
+{
+    GRIS_ALWAYS_ASSERT(IsValid(), "Only a valid swap chain can be resized");
+
+    // The views may still be referenced by frames in flight, their destruction is deferred like the swap chain itself
+    m_swapChainImageViews.clear();
+    m_swapChainImages.clear();
+
+    auto oldSwapChain = std::exchange(m_swapChain, {});
+    CreateSwapChain(window, width, height, oldSwapChain);
+    ParentDevice().DestroyDeferred(oldSwapChain);
+
+    ResetSwapChainImageTracking();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] std::optional<Gris::Graphics::Vulkan::VirtualFrame> Gris::Graphics::Vulkan::SwapChain::NextImage()
 {
     auto const virtualFrameIndex = m_currentVirtualFrame;
     m_currentVirtualFrame = (m_currentVirtualFrame + 1) % m_virtualFrameCount;
 
-    std::array fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
-    auto const waitResult = DeviceHandle().waitForFences(fences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
-    if (waitResult != vk::Result::eSuccess)
-    {
-        throw VulkanEngineException("Failed to wait for current frame fence!", waitResult);
-    }
+    WaitForVirtualFrame(virtualFrameIndex);
+
+    // Objects released while this virtual frame was in flight may be destroyed now
+    ParentDevice().CollectDeferredDestructions();
 
     ///
 
@@ -230,31 +272,29 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
 
     auto const imageIndex = acquireResult.value;
 
-    ///
+    WaitForSwapChainImage(imageIndex, virtualFrameIndex);
 
-    auto const previousVirtualFrameIndex = m_swapChainImageToVirtualFrame[imageIndex];
-    if (previousVirtualFrameIndex != virtualFrameIndex && previousVirtualFrameIndex != std::numeric_limits<uint32_t>::max())
-    {
-        std::array additionalFences = { m_renderFinishedFences[previousVirtualFrameIndex].FenceHandle() };
-        auto const additionalFenceWaitResult = DeviceHandle().waitForFences(additionalFences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
-        if (additionalFenceWaitResult != vk::Result::eSuccess)
-        {
-            throw VulkanEngineException("Failed to wait for image in flight fence!", additionalFenceWaitResult);
-        }
-    }
+    return VirtualFrame{ virtualFrameIndex, imageIndex };
+}
 
-    m_swapChainImageToVirtualFrame[imageIndex] = virtualFrameIndex;
+// -------------------------------------------------------------------------------------------------
 
-    ///
+void Gris::Graphics::Vulkan::SwapChain::Submit(DeferredContext & context, const VirtualFrame & virtualFrame)
+{
+    auto const waitSemaphores = std::vector{ std::ref(m_imageAvailableSemaphores[virtualFrame.VirtualFrameIndex]) };
+    auto const signalSemaphores = std::vector{ std::ref(m_renderFinishedSemaphores[virtualFrame.VirtualFrameIndex]) };
 
-    fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
-    auto const resetResult = DeviceHandle().resetFences(fences, Dispatch());
-    if (resetResult != vk::Result::eSuccess)
+    auto & immediateContext = ParentDevice().Context();
+    if (!immediateContext.HasTimeline())
     {
-        throw VulkanEngineException("Error resetting current frame fence", resetResult);
+        immediateContext.Submit(&context, waitSemaphores, signalSemaphores, m_renderFinishedFences[virtualFrame.VirtualFrameIndex]);
+        m_virtualFrameTimelineValues[virtualFrame.VirtualFrameIndex] = immediateContext.LastSubmittedValue();
+        return;
     }
 
-    return VirtualFrame{ virtualFrameIndex, imageIndex };
+    auto const submittedValue = immediateContext.Submit(&context, waitSemaphores, signalSemaphores, {});
+    m_virtualFrameTimelineValues[virtualFrame.VirtualFrameIndex] = submittedValue;
+    m_swapChainImageTimelineValues[virtualFrame.SwapChainImageIndex] = submittedValue;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -268,6 +308,10 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
                            .setSwapchains(swapChains)
                            .setImageIndices(imageIndices);
 
+    auto const & queueFamilies = ParentDevice().QueueFamilies();
+    auto const presentsFromGraphicsQueue = queueFamilies.presentFamily == queueFamilies.graphicsFamily;
+    auto const queueLock = presentsFromGraphicsQueue ? ParentDevice().Context().LockQueue() : std::unique_lock<std::mutex>{};
+
     auto const presentResult = m_presentQueue.presentKHR(&presentInfo, Dispatch());
     if (presentResult == vk::Result::eErrorOutOfDateKHR || presentResult == vk::Result::eSuboptimalKHR)
     {
@@ -285,6 +329,8 @@ Gris::Graphics::Vulkan::SwapChain::operator bool() const
 
 void Gris::Graphics::Vulkan::SwapChain::Reset()
 {
+    m_swapChainImageTimelineValues.clear();
+    m_virtualFrameTimelineValues.clear();
     m_swapChainImageToVirtualFrame.clear();
     m_virtualFrameCount = 1;
     m_currentVirtualFrame = 0;
@@ -299,12 +345,12 @@ void Gris::Graphics::Vulkan::SwapChain::Reset()
     m_swapChainImageFormat = {};
 
     m_presentQueue = nullptr;
+    m_minImageCount = 0;
     m_swapChainImages.clear();
 
     if (m_swapChain)
     {
-        DeviceHandle().destroySwapchainKHR(m_swapChain, nullptr, Dispatch());
-        m_swapChain = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_swapChain, {}));
     }
 
     ResetParent();
@@ -324,7 +370,9 @@ void Gris::Graphics::Vulkan::SwapChain::CreateSwapChain(
     auto const presentMode = ChooseSwapPresentMode(swapChainSupport.presentModes);
     auto const extent = ChooseSwapExtent(swapChainSupport.capabilities, width, height);
 
-    auto imageCount = swapChainSupport.capabilities.minImageCount + 1;
+    // Every virtual frame but the one being waited on may hold an acquired image that was not presented yet, the
+    // presentation engine keeps up to the minimum count to itself
+    auto imageCount = swapChainSupport.capabilities.minImageCount + std::max(m_virtualFrameCount, 2U) - 1;
     if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount)
     {
         imageCount = swapChainSupport.capabilities.maxImageCount;
@@ -370,6 +418,7 @@ void Gris::Graphics::Vulkan::SwapChain::CreateSwapChain(
     }
 
     m_swapChainImages = std::move(swapChainImagesResult.value);
+    m_minImageCount = std::min(swapChainSupport.capabilities.minImageCount, static_cast<uint32_t>(m_swapChainImages.size()));
     m_presentQueue = DeviceHandle().getQueue(ParentDevice().QueueFamilies().presentFamily.value(), 0, Dispatch());
 
     m_swapChainImageFormat = surfaceFormat.format;
@@ -380,16 +429,100 @@ void Gris::Graphics::Vulkan::SwapChain::CreateSwapChain(
     {
         m_swapChainImageViews.emplace_back(ParentDevice().CreateTextureView(swapChainImage, m_swapChainImageFormat, vk::ImageAspectFlagBits::eColor, 1));
     }
+}
 
-    m_renderFinishedFences.reserve(m_swapChainImages.size());
-    m_imageAvailableSemaphores.reserve(m_swapChainImages.size());
-    m_renderFinishedSemaphores.reserve(m_swapChainImages.size());
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::SwapChain::CreateSynchronizationObjects()
+{
+    m_imageAvailableSemaphores.reserve(m_virtualFrameCount);
+    m_renderFinishedSemaphores.reserve(m_virtualFrameCount);
     for (uint32_t frameIndex = 0; frameIndex < m_virtualFrameCount; ++frameIndex)
     {
-        m_renderFinishedFences.emplace_back(ParentDevice().CreateFence(true));
         m_imageAvailableSemaphores.emplace_back(ParentDevice().CreateSemaphore());
         m_renderFinishedSemaphores.emplace_back(ParentDevice().CreateSemaphore());
     }
 
-    m_swapChainImageToVirtualFrame.resize(m_swapChainImages.size(), std::numeric_limits<uint32_t>::max());
+    m_virtualFrameTimelineValues.resize(m_virtualFrameCount, 0);
+
+    if (!ParentDevice().Context().HasTimeline())
+    {
+        m_renderFinishedFences.reserve(m_virtualFrameCount);
+        for (uint32_t frameIndex = 0; frameIndex < m_virtualFrameCount; ++frameIndex)
+        {
+            m_renderFinishedFences.emplace_back(ParentDevice().CreateFence(true));
+        }
+    }
+
+    ResetSwapChainImageTracking();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::SwapChain::ResetSwapChainImageTracking()
+{
+    // Images of a new swap chain were never rendered to, the virtual frame waits cover the ones of the old swap chain
+    if (ParentDevice().Context().HasTimeline())
+    {
+        m_swapChainImageTimelineValues.assign(m_swapChainImages.size(), 0);
+        return;
+    }
+
+    m_swapChainImageToVirtualFrame.assign(m_swapChainImages.size(), std::numeric_limits<uint32_t>::max());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::SwapChain::WaitForVirtualFrame(uint32_t virtualFrameIndex)
+{
+    if (ParentDevice().Context().HasTimeline())
+    {
+        ParentDevice().Context().WaitForValue(m_virtualFrameTimelineValues[virtualFrameIndex]);
+        return;
+    }
+
+    std::array fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
+    auto const waitResult = DeviceHandle().waitForFences(fences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
+    if (waitResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Failed to wait for current frame fence!", waitResult);
+    }
+
+    ParentDevice().Context().NotifyCompleted(m_virtualFrameTimelineValues[virtualFrameIndex]);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::SwapChain::WaitForSwapChainImage(uint32_t swapChainImageIndex, uint32_t virtualFrameIndex)
+{
+    // With a timeline the image wait is a single value and nothing has to be reset
+    if (ParentDevice().Context().HasTimeline())
+    {
+        ParentDevice().Context().WaitForValue(m_swapChainImageTimelineValues[swapChainImageIndex]);
+        return;
+    }
+
+    auto const previousVirtualFrameIndex = m_swapChainImageToVirtualFrame[swapChainImageIndex];
+    if (previousVirtualFrameIndex != virtualFrameIndex && previousVirtualFrameIndex != std::numeric_limits<uint32_t>::max())
+    {
+        std::array additionalFences = { m_renderFinishedFences[previousVirtualFrameIndex].FenceHandle() };
+        auto const additionalFenceWaitResult = DeviceHandle().waitForFences(additionalFences, static_cast<vk::Bool32>(true), std::numeric_limits<uint64_t>::max(), Dispatch());
+        if (additionalFenceWaitResult != vk::Result::eSuccess)
+        {
+            throw VulkanEngineException("Failed to wait for image in flight fence!", additionalFenceWaitResult);
+        }
+
+        ParentDevice().Context().NotifyCompleted(m_virtualFrameTimelineValues[previousVirtualFrameIndex]);
+    }
+
+    m_swapChainImageToVirtualFrame[swapChainImageIndex] = virtualFrameIndex;
+
+    ///
+
+    std::array fences = { m_renderFinishedFences[virtualFrameIndex].FenceHandle() };
+    auto const resetResult = DeviceHandle().resetFences(fences, Dispatch());
+    if (resetResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error resetting current frame fence", resetResult);
+    }
 }
@@ -1,8 +1,12 @@
 ﻿#include <gris/graphics/vulkan/texture.h>
 
 #include <gris/graphics/vulkan/allocator.h>
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/utils.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
+#include <gris/assert.h>
+
 // -------------------------------------------------------------------------------------------------
 
 Gris::Graphics::Vulkan::Texture::Texture() = default;
@@ -20,6 +24,8 @@ Gris::Graphics::Vulkan::Texture::Texture(const ParentObject<Device> & device,
                                          const vk::MemoryPropertyFlags & properties)
     : DeviceResource(device)
     , m_mipLevels(mipLevels)
+    , m_format(format)
+    , m_subresourceStates(mipLevels)
 {
     auto const imageInfo = vk::ImageCreateInfo{}
                                .setImageType(vk::ImageType::e2D)
@@ -62,6 +68,8 @@ Gris::Graphics::Vulkan::Texture::Texture(Texture && other) noexcept
     , m_image(std::exchange(other.m_image, {}))
     , m_imageMemory(std::exchange(other.m_imageMemory, {}))
     , m_mipLevels(std::exchange(other.m_mipLevels, 1))
+    , m_format(std::exchange(other.m_format, vk::Format::eUndefined))
+    , m_subresourceStates(std::exchange(other.m_subresourceStates, {}))
 {
 }
 
@@ -77,6 +85,8 @@ Gris::Graphics::Vulkan::Texture & Gris::Graphics::Vulkan::Texture::operator=(Tex
         m_image = std::exchange(other.m_image, {});
         m_imageMemory = std::exchange(other.m_imageMemory, {});
         m_mipLevels = std::exchange(other.m_mipLevels, 1);
+        m_format = std::exchange(other.m_format, vk::Format::eUndefined);
+        m_subresourceStates = std::exchange(other.m_subresourceStates, {});
     }
 
     return *this;
@@ -105,6 +115,20 @@ Gris::Graphics::Vulkan::Texture::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] vk::Format Gris::Graphics::Vulkan::Texture::Format() const
+{
+    return m_format;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::ImageAspectFlags Gris::Graphics::Vulkan::Texture::AspectMask() const
+{
+    return AspectMaskForFormat(m_format);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] const vk::Image & Gris::Graphics::Vulkan::Texture::ImageHandle() const
 {
     return m_image;
@@ -119,15 +143,28 @@ Gris::Graphics::Vulkan::Texture::operator bool() const
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] const Gris::Graphics::Vulkan::TextureState & Gris::Graphics::Vulkan::Texture::SubresourceState(uint32_t mipLevel) const
+{
+    GRIS_FAST_ASSERT(mipLevel < m_subresourceStates.size(), "Mip level out of range");
+    return m_subresourceStates[mipLevel];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::Texture::SetSubresourceState(uint32_t mipLevel, const TextureState & state)
+{
+    GRIS_FAST_ASSERT(mipLevel < m_subresourceStates.size(), "Mip level out of range");
+    m_subresourceStates[mipLevel] = state;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 void Gris::Graphics::Vulkan::Texture::Reset()
 {
+    m_subresourceStates.clear();
+    m_format = vk::Format::eUndefined;
     m_mipLevels = 1;
 
-    if (m_imageMemory)
-    {
-        m_imageMemory.Reset();
-    }
-
     ReleaseResources();
     ResetParent();
 }
@@ -138,7 +175,11 @@ void Gris::Graphics::Vulkan::Texture::ReleaseResources()
 {
     if (m_image)
     {
-        DeviceHandle().destroyImage(m_image, nullptr, Dispatch());
-        m_image = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_image, {}));
+    }
+
+    if (m_imageMemory)
+    {
+        ParentDevice().DestroyDeferred(std::exchange(m_imageMemory, {}));
     }
 }
@@ -121,7 +121,6 @@ void Gris::Graphics::Vulkan::TextureView::ReleaseResources()
 {
     if (m_imageView)
     {
-        DeviceHandle().destroyImageView(m_imageView, nullptr, Dispatch());
-        m_imageView = nullptr;
+        ParentDevice().DestroyDeferred(std::exchange(m_imageView, {}));
     }
 }
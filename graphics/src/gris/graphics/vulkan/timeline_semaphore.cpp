@@ -0,0 +1,151 @@
+#include <gris/graphics/vulkan/timeline_semaphore.h>
+
+#include <gris/graphics/vulkan/device.h>
+#include <gris/graphics/vulkan/vulkan_engine_exception.h>
+
+#include <array>
+#include <limits>
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore::TimelineSemaphore() = default;
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore::TimelineSemaphore(const ParentObject<Device> & device, uint64_t initialValue)
+    : DeviceResource(device)
+{
+    auto const typeInfo = vk::SemaphoreTypeCreateInfo{}
+                              .setSemaphoreType(vk::SemaphoreType::eTimeline)
+                              .setInitialValue(initialValue);
+    auto const semaphoreInfo = vk::SemaphoreCreateInfo{}.setPNext(&typeInfo);
+
+    auto const semaphoreCreateResult = DeviceHandle().createSemaphore(semaphoreInfo, nullptr, Dispatch());
+    if (semaphoreCreateResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error creating timeline semaphore", semaphoreCreateResult);
+    }
+
+    m_semaphore = semaphoreCreateResult.value;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore::TimelineSemaphore(TimelineSemaphore && other) noexcept
+    : DeviceResource(std::move(other))
+    , m_semaphore(std::exchange(other.m_semaphore, {}))
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore & Gris::Graphics::Vulkan::TimelineSemaphore::operator=(TimelineSemaphore && other) noexcept
+{
+    if (this != &other)
+    {
+        ReleaseResources();
+
+        DeviceResource::operator=(std::move(static_cast<DeviceResource &&>(other)));
+        m_semaphore = std::exchange(other.m_semaphore, {});
+    }
+
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore::~TimelineSemaphore()
+{
+    ReleaseResources();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Gris::Graphics::Vulkan::TimelineSemaphore::operator bool() const
+{
+    return IsValid();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] bool Gris::Graphics::Vulkan::TimelineSemaphore::IsValid() const
+{
+    return IsDeviceValid() && static_cast<bool>(m_semaphore);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] const vk::Semaphore & Gris::Graphics::Vulkan::TimelineSemaphore::SemaphoreHandle() const
+{
+    return m_semaphore;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::Semaphore & Gris::Graphics::Vulkan::TimelineSemaphore::SemaphoreHandle()
+{
+    return m_semaphore;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint64_t Gris::Graphics::Vulkan::TimelineSemaphore::CompletedValue() const
+{
+    auto const counterValueResult = DeviceHandle().getSemaphoreCounterValueKHR(m_semaphore, Dispatch());
+    if (counterValueResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error reading timeline semaphore value", counterValueResult);
+    }
+
+    return counterValueResult.value;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::TimelineSemaphore::Wait(uint64_t value) const
+{
+    auto const semaphores = std::array{ m_semaphore };
+    auto const values = std::array{ value };
+    auto const waitInfo = vk::SemaphoreWaitInfo{}
+                              .setSemaphores(semaphores)
+                              .setValues(values);
+
+    auto const waitResult = DeviceHandle().waitSemaphoresKHR(waitInfo, std::numeric_limits<uint64_t>::max(), Dispatch());
+    if (waitResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Failed to wait for timeline semaphore value!", waitResult);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::TimelineSemaphore::Signal(uint64_t value)
+{
+    auto const signalInfo = vk::SemaphoreSignalInfo{}
+                                .setSemaphore(m_semaphore)
+                                .setValue(value);
+
+    auto const signalResult = DeviceHandle().signalSemaphoreKHR(signalInfo, Dispatch());
+    if (signalResult != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error signaling timeline semaphore", signalResult);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::TimelineSemaphore::Reset()
+{
+    ReleaseResources();
+    ResetParent();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void Gris::Graphics::Vulkan::TimelineSemaphore::ReleaseResources()
+{
+    if (m_semaphore)
+    {
+        ParentDevice().DestroyDeferred(std::exchange(m_semaphore, {}));
+    }
+}
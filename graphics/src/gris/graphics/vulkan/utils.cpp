@@ -3,8 +3,82 @@
 #include <gris/graphics/vulkan/instance.h>
 #include <gris/graphics/vulkan/vulkan_engine_exception.h>
 
+#include <gris/assert.h>
 #include <gris/casts.h>
 
+#include <algorithm>
+#include <set>
+#include <string>
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::DeviceQueueFamilyIndices Gris::Graphics::Vulkan::FindQueueFamilies(Span<const vk::QueueFamilyProperties> queueFamilies,
+                                                                                                         const std::function<bool(uint32_t)> & supportsPresentation)
+{
+    auto const headless = !supportsPresentation;
+
+    DeviceQueueFamilyIndices indices;
+    auto i = 0U;
+    auto isComplete = false;
+    for (auto const & queueFamily : queueFamilies)
+    {
+        // The first compute family without graphics is used for async compute, the search goes on for it after
+        // the graphics and present families are found
+        auto const isComputeOnly = (queueFamily.queueFlags & vk::QueueFlagBits::eCompute) && !(queueFamily.queueFlags & vk::QueueFlagBits::eGraphics);
+        if (isComputeOnly && !indices.computeFamily)
+        {
+            indices.computeFamily = i;
+            indices.computeQueueCount = queueFamily.queueCount;
+        }
+
+        if (isComplete)
+        {
+            i++;
+            continue;
+        }
+
+        if (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
+        {
+            indices.graphicsFamily = i;
+        }
+
+        if (!headless && supportsPresentation(i))
+        {
+            indices.presentFamily = i;
+        }
+
+        isComplete = headless ? indices.IsHeadlessComplete() : indices.IsComplete();
+        i++;
+    }
+
+    return indices;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] uint32_t Gris::Graphics::Vulkan::AsyncComputeQueueCount(const DeviceQueueFamilyIndices & queueFamilies, const DeviceQueueConfiguration & configuration)
+{
+    if (!queueFamilies.SupportsAsyncCompute())
+    {
+        return 0;
+    }
+
+    return std::min(static_cast<uint32_t>(configuration.AsyncComputePriorities.size()), queueFamilies.computeQueueCount);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] Gris::Graphics::Vulkan::QueueSelection Gris::Graphics::Vulkan::SelectAsyncComputeQueue(const DeviceQueueFamilyIndices & queueFamilies, uint32_t asyncComputeQueueCount, uint32_t queueIndex)
+{
+    if (queueIndex < asyncComputeQueueCount)
+    {
+        return QueueSelection{ queueFamilies.computeFamily.value(), queueIndex, true };
+    }
+
+    GRIS_ALWAYS_ASSERT(asyncComputeQueueCount == 0, "Async compute queue index out of range");
+    return QueueSelection{ queueFamilies.graphicsFamily.value(), 0, false };
+}
+
 // -------------------------------------------------------------------------------------------------
 
 [[nodiscard]] Gris::Graphics::Vulkan::SwapChainSupportDetails Gris::Graphics::Vulkan::QuerySwapChainSupport(const vk::PhysicalDevice & physicalDevice,
@@ -37,6 +111,25 @@
 
 // -------------------------------------------------------------------------------------------------
 
+[[nodiscard]] bool Gris::Graphics::Vulkan::CheckDeviceExtensionSupport(const vk::PhysicalDevice & physicalDevice, Span<const char * const> extensions)
+{
+    auto availableExtensionsResult = physicalDevice.enumerateDeviceExtensionProperties(nullptr, Instance::Dispatch());
+    if (availableExtensionsResult.result != vk::Result::eSuccess)
+    {
+        throw VulkanEngineException("Error enumerating physical device extension properties", availableExtensionsResult);
+    }
+
+    std::set<std::string> requiredExtensions(extensions.begin(), extensions.end());
+    for (auto const & extension : availableExtensionsResult.value)
+    {
+        requiredExtensions.erase(extension.extensionName);
+    }
+
+    return requiredExtensions.empty();
+}
+
+// -------------------------------------------------------------------------------------------------
+
 [[nodiscard]] vk::Format Gris::Graphics::Vulkan::ToVulkanFormat(ImageFormat format)
 {
     constexpr static std::array LookUpTable = {
@@ -50,3 +143,38 @@
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
     return LookUpTable[UnderlyingCast(format)];
 }
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::IndexType Gris::Graphics::Vulkan::ToVulkanIndexType(IndexFormat format)
+{
+    constexpr static std::array LookUpTable = {
+        vk::IndexType::eUint16,
+        vk::IndexType::eUint32,
+    };
+
+    GRIS_ALWAYS_ASSERT(UnderlyingCast(format) < std::size(LookUpTable), "Value of current format exceeds LookUpTable size");
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    return LookUpTable[UnderlyingCast(format)];
+}
+
+// -------------------------------------------------------------------------------------------------
+
+[[nodiscard]] vk::ImageAspectFlags Gris::Graphics::Vulkan::AspectMaskForFormat(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eD16Unorm:
+    case vk::Format::eX8D24UnormPack32:
+    case vk::Format::eD32Sfloat:
+        return vk::ImageAspectFlagBits::eDepth;
+    case vk::Format::eS8Uint:
+        return vk::ImageAspectFlagBits::eStencil;
+    case vk::Format::eD16UnormS8Uint:
+    case vk::Format::eD24UnormS8Uint:
+    case vk::Format::eD32SfloatS8Uint:
+        return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+    default:
+        return vk::ImageAspectFlagBits::eColor;
+    }
+}
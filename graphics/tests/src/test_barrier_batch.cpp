@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/barrier_batch.h>
+
+TEST_CASE("Reads in new stages wait on the last write", "[barrier batch]")
+{
+    auto batch = Gris::Graphics::Vulkan::BarrierBatch{};
+    auto state = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eUndefined);
+
+    auto const fragmentRead = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+    auto const vertexRead = Gris::Graphics::Vulkan::TextureState{ vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits::eShaderRead, vk::PipelineStageFlagBits::eVertexShader };
+
+    batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal));
+    batch.Clear();
+
+    batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, fragmentRead);
+
+    REQUIRE(batch.ImageBarriers().size() == 1);
+    REQUIRE(batch.SourceStages() == vk::PipelineStageFlags(vk::PipelineStageFlagBits::eColorAttachmentOutput));
+    REQUIRE(batch.DestinationStages() == vk::PipelineStageFlags(vk::PipelineStageFlagBits::eFragmentShader));
+    batch.Clear();
+
+    SECTION("Read in a stage the earlier barrier did not cover")
+    {
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, vertexRead);
+
+        REQUIRE(batch.ImageBarriers().size() == 1);
+        REQUIRE(static_cast<bool>(batch.SourceStages() & vk::PipelineStageFlagBits::eColorAttachmentOutput));
+        REQUIRE(batch.DestinationStages() == vk::PipelineStageFlags(vk::PipelineStageFlagBits::eVertexShader));
+        REQUIRE(batch.ImageBarriers()[0].srcAccessMask == vk::AccessFlags(vk::AccessFlagBits::eColorAttachmentWrite));
+        REQUIRE(batch.ImageBarriers()[0].dstAccessMask == vk::AccessFlags(vk::AccessFlagBits::eShaderRead));
+        REQUIRE(batch.ImageBarriers()[0].oldLayout == vk::ImageLayout::eShaderReadOnlyOptimal);
+        REQUIRE(batch.ImageBarriers()[0].newLayout == vk::ImageLayout::eShaderReadOnlyOptimal);
+        batch.Clear();
+
+        // Both stages are synchronized now
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, vertexRead);
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, fragmentRead);
+
+        REQUIRE(batch.IsEmpty());
+    }
+
+    SECTION("Read in a stage the earlier barrier covered")
+    {
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, fragmentRead);
+
+        REQUIRE(batch.IsEmpty());
+    }
+
+    SECTION("Write after the reads waits on all of them")
+    {
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, vertexRead);
+        batch.Clear();
+
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal));
+
+        REQUIRE(batch.ImageBarriers().size() == 1);
+        REQUIRE(batch.SourceStages() == (vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eVertexShader));
+        REQUIRE(!batch.ImageBarriers()[0].srcAccessMask);
+    }
+}
+
+TEST_CASE("Reads of textures with no pending write need no barrier", "[barrier batch]")
+{
+    auto batch = Gris::Graphics::Vulkan::BarrierBatch{};
+
+    // e.g. an uploaded texture once the upload was waited on
+    auto state = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eShaderReadOnlyOptimal);
+
+    batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureState{ vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits::eShaderRead, vk::PipelineStageFlagBits::eVertexShader });
+
+    REQUIRE(batch.IsEmpty());
+    REQUIRE(state.Stages == (vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eVertexShader));
+}
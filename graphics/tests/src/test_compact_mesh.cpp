@@ -0,0 +1,219 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/compact_mesh.h>
+#include <gris/graphics/scene.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::vector<Gris::Graphics::Vertex> MakeRandomVertices(size_t count)
+{
+    auto generator = std::mt19937(42);
+    auto positionDistribution = std::uniform_real_distribution<float>(-50.0F, 150.0F);
+    auto textureCoordsDistribution = std::uniform_real_distribution<float>(-2.0F, 3.0F);
+
+    auto vertices = std::vector<Gris::Graphics::Vertex>(count);
+    for (auto & vertex : vertices)
+    {
+        vertex.Position = glm::vec3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+        vertex.TextureCoords = glm::vec2(textureCoordsDistribution(generator), textureCoordsDistribution(generator));
+    }
+    return vertices;
+}
+
+std::vector<uint32_t> MakeIndices(size_t vertexCount)
+{
+    auto indices = std::vector<uint32_t>{};
+    for (uint32_t index = 0; index + 2 < vertexCount; index += 3)
+    {
+        indices.insert(indices.end(), { index, index + 1, index + 2 });
+    }
+    return indices;
+}
+
+float DecodeUnorm16(uint16_t value)
+{
+    return static_cast<float>(value) / 65535.0F;
+}
+
+float DecodeHalf(uint16_t value)
+{
+    auto const sign = (value & 0x8000U) != 0 ? -1.0F : 1.0F;
+    auto const exponent = static_cast<int>((value >> 10U) & 0x1FU);
+    auto const mantissa = static_cast<float>(value & 0x3FFU);
+    if (exponent == 0)
+    {
+        return sign * std::ldexp(mantissa, -24);
+    }
+    return sign * std::ldexp(1024.0F + mantissa, exponent - 25);
+}
+
+uint32_t ReadIndex(const Gris::Graphics::CompactMesh & mesh, size_t indexIndex)
+{
+    if (mesh.IndexType == Gris::Graphics::IndexFormat::Uint16)
+    {
+        auto index = uint16_t{};
+        std::memcpy(&index, mesh.IndexData.data() + indexIndex * sizeof(index), sizeof(index));
+        return index;
+    }
+
+    auto index = uint32_t{};
+    std::memcpy(&index, mesh.IndexData.data() + indexIndex * sizeof(index), sizeof(index));
+    return index;
+}
+
+}  // namespace
+
+TEST_CASE("Index format follows the vertex count", "[compact mesh]")
+{
+    SECTION("Uint16 up to the limit")
+    {
+        auto const vertices = MakeRandomVertices(Gris::Graphics::MAX_UINT16_INDEXED_VERTEX_COUNT);
+        auto const indices = MakeIndices(vertices.size());
+        auto const mesh = Gris::Graphics::EncodeCompactMesh(vertices, indices, Gris::Graphics::TextureCoordsEncoding::Unorm16);
+
+        REQUIRE(mesh.IndexType == Gris::Graphics::IndexFormat::Uint16);
+        REQUIRE(mesh.IndexCount == indices.size());
+        REQUIRE(mesh.IndexData.size() == indices.size() * sizeof(uint16_t));
+        for (size_t indexIndex = 0; indexIndex < indices.size(); ++indexIndex)
+        {
+            REQUIRE(ReadIndex(mesh, indexIndex) == indices[indexIndex]);
+        }
+    }
+
+    SECTION("Uint32 above it")
+    {
+        auto const vertices = MakeRandomVertices(Gris::Graphics::MAX_UINT16_INDEXED_VERTEX_COUNT + 1);
+        auto indices = MakeIndices(vertices.size());
+        indices.insert(indices.end(), { 0, 1, static_cast<uint32_t>(vertices.size() - 1) });
+        auto const mesh = Gris::Graphics::EncodeCompactMesh(vertices, indices, Gris::Graphics::TextureCoordsEncoding::Unorm16);
+
+        REQUIRE(mesh.IndexType == Gris::Graphics::IndexFormat::Uint32);
+        REQUIRE(mesh.IndexData.size() == indices.size() * sizeof(uint32_t));
+        for (size_t indexIndex = 0; indexIndex < indices.size(); ++indexIndex)
+        {
+            REQUIRE(ReadIndex(mesh, indexIndex) == indices[indexIndex]);
+        }
+    }
+}
+
+TEST_CASE("Compact vertices dequantize to the original attributes", "[compact mesh]")
+{
+    auto const vertices = MakeRandomVertices(1000);
+    auto const indices = MakeIndices(vertices.size());
+
+    SECTION("Unorm16 texture coordinates")
+    {
+        auto const mesh = Gris::Graphics::EncodeCompactMesh(vertices, indices, Gris::Graphics::TextureCoordsEncoding::Unorm16);
+        auto const & dequantization = mesh.Dequantization;
+
+        REQUIRE(mesh.Vertices.size() == vertices.size());
+        for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex)
+        {
+            auto const & original = vertices[vertexIndex];
+            auto const & compact = mesh.Vertices[vertexIndex];
+
+            // Half a step of rounding plus some slack for the float math
+            REQUIRE(std::abs(dequantization.PositionOffset.x + dequantization.PositionScale.x * DecodeUnorm16(compact.Position[0]) - original.Position.x) <= dequantization.PositionScale.x / 65535.0F);
+            REQUIRE(std::abs(dequantization.PositionOffset.y + dequantization.PositionScale.y * DecodeUnorm16(compact.Position[1]) - original.Position.y) <= dequantization.PositionScale.y / 65535.0F);
+            REQUIRE(std::abs(dequantization.PositionOffset.z + dequantization.PositionScale.z * DecodeUnorm16(compact.Position[2]) - original.Position.z) <= dequantization.PositionScale.z / 65535.0F);
+            REQUIRE(std::abs(dequantization.TextureCoordsOffset.x + dequantization.TextureCoordsScale.x * DecodeUnorm16(compact.TextureCoords[0]) - original.TextureCoords.x) <= dequantization.TextureCoordsScale.x / 65535.0F);
+            REQUIRE(std::abs(dequantization.TextureCoordsOffset.y + dequantization.TextureCoordsScale.y * DecodeUnorm16(compact.TextureCoords[1]) - original.TextureCoords.y) <= dequantization.TextureCoordsScale.y / 65535.0F);
+        }
+    }
+
+    SECTION("Half texture coordinates")
+    {
+        auto const mesh = Gris::Graphics::EncodeCompactMesh(vertices, indices, Gris::Graphics::TextureCoordsEncoding::Half);
+        auto const & dequantization = mesh.Dequantization;
+
+        REQUIRE(dequantization.TextureCoordsOffset.x == 0.0F);
+        REQUIRE(dequantization.TextureCoordsOffset.y == 0.0F);
+        REQUIRE(dequantization.TextureCoordsScale.x == 1.0F);
+        REQUIRE(dequantization.TextureCoordsScale.y == 1.0F);
+
+        for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex)
+        {
+            auto const & original = vertices[vertexIndex];
+            auto const & compact = mesh.Vertices[vertexIndex];
+
+            // Eleven bits of mantissa, values below 4 round to within 2^-10
+            REQUIRE(std::abs(DecodeHalf(compact.TextureCoords[0]) - original.TextureCoords.x) <= 0x1p-10F);
+            REQUIRE(std::abs(DecodeHalf(compact.TextureCoords[1]) - original.TextureCoords.y) <= 0x1p-10F);
+        }
+    }
+}
+
+TEST_CASE("Flat meshes keep the flat axis", "[compact mesh]")
+{
+    auto vertices = MakeRandomVertices(30);
+    for (auto & vertex : vertices)
+    {
+        vertex.Position.z = 7.0F;
+    }
+
+    auto const mesh = Gris::Graphics::EncodeCompactMesh(vertices, MakeIndices(vertices.size()), Gris::Graphics::TextureCoordsEncoding::Unorm16);
+
+    REQUIRE(mesh.Dequantization.PositionOffset.z == 7.0F);
+    REQUIRE(mesh.Dequantization.PositionScale.z == 0.0F);
+    for (auto const & vertex : mesh.Vertices)
+    {
+        REQUIRE(vertex.Position[2] == 0);
+    }
+}
+
+TEST_CASE("Compact formats describe their members", "[compact mesh]")
+{
+    using HalfVertexFormat = Gris::Graphics::CompactVertexFormat<Gris::Graphics::TextureCoordsEncoding::Half>;
+    using Unorm16VertexFormat = Gris::Graphics::CompactVertexFormat<Gris::Graphics::TextureCoordsEncoding::Unorm16>;
+
+    SECTION("Vertices")
+    {
+        auto const vertex = Gris::Graphics::CompactVertex{};
+        auto const * const base = reinterpret_cast<const std::byte *>(&vertex);
+
+        auto const & attributes = Unorm16VertexFormat::ATTRIBUTES;
+        REQUIRE(Unorm16VertexFormat::STRIDE == sizeof(Gris::Graphics::CompactVertex));
+
+        REQUIRE(attributes[0].Location == Gris::Graphics::PositionAttribute::LOCATION);
+        REQUIRE(attributes[0].ComponentType == Gris::Graphics::VertexComponentType::Unorm16);
+        REQUIRE(attributes[0].ComponentCount == 4);
+        REQUIRE(attributes[0].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(vertex.Position.data()) - base));
+
+        REQUIRE(attributes[1].Location == Gris::Graphics::TextureCoordsAttribute::LOCATION);
+        REQUIRE(attributes[1].ComponentType == Gris::Graphics::VertexComponentType::Unorm16);
+        REQUIRE(attributes[1].ComponentCount == 2);
+        REQUIRE(attributes[1].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(vertex.TextureCoords.data()) - base));
+
+        // Same layout, only the texture coordinates are read differently
+        REQUIRE(HalfVertexFormat::ATTRIBUTES[1].ComponentType == Gris::Graphics::VertexComponentType::Half);
+        REQUIRE(HalfVertexFormat::ATTRIBUTES[1].Offset == attributes[1].Offset);
+    }
+
+    SECTION("Dequantization")
+    {
+        auto const dequantization = Gris::Graphics::CompactMeshDequantization{};
+        auto const * const base = reinterpret_cast<const std::byte *>(&dequantization);
+
+        auto const & attributes = Gris::Graphics::CompactMeshDequantizationFormat::ATTRIBUTES;
+        REQUIRE(Gris::Graphics::CompactMeshDequantizationFormat::STRIDE == sizeof(Gris::Graphics::CompactMeshDequantization));
+
+        REQUIRE(attributes[0].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(&dequantization.PositionOffset) - base));
+        REQUIRE(attributes[1].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(&dequantization.PositionScale) - base));
+        REQUIRE(attributes[2].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(&dequantization.TextureCoordsOffset) - base));
+        REQUIRE(attributes[3].Offset == static_cast<size_t>(reinterpret_cast<const std::byte *>(&dequantization.TextureCoordsScale) - base));
+
+        // Meshes that were never encoded come back unchanged
+        REQUIRE(dequantization.PositionOffset == glm::vec3(0.0F));
+        REQUIRE(dequantization.PositionScale == glm::vec3(1.0F));
+        REQUIRE(dequantization.TextureCoordsOffset == glm::vec2(0.0F));
+        REQUIRE(dequantization.TextureCoordsScale == glm::vec2(1.0F));
+    }
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/deferred_destruction_queue.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+vk::Buffer FakeBuffer(uint64_t id)
+{
+    return vk::Buffer(reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(id)));
+}
+
+}  // namespace
+
+TEST_CASE("Deferred destruction", "[deferred destruction queue]")
+{
+    auto queue = Gris::Graphics::Vulkan::DeferredDestructionQueue{};
+    auto destroyed = std::vector<vk::Buffer>{};
+    auto const destroy = [&destroyed](Gris::Graphics::Vulkan::DeferredDestruction & object)
+    {
+        destroyed.emplace_back(std::get<vk::Buffer>(object));
+    };
+
+    queue.Enqueue(1, FakeBuffer(1));
+    queue.Enqueue(2, FakeBuffer(2));
+    queue.Enqueue(2, FakeBuffer(3));
+    queue.Enqueue(3, FakeBuffer(4));
+
+    SECTION("Nothing is destroyed before the first value completes")
+    {
+        queue.Collect(0, destroy);
+
+        REQUIRE(destroyed.empty());
+        REQUIRE(queue.PendingCount() == 4);
+    }
+
+    SECTION("Completed values are destroyed in release order")
+    {
+        queue.Collect(2, destroy);
+
+        REQUIRE(destroyed == std::vector{ FakeBuffer(1), FakeBuffer(2), FakeBuffer(3) });
+        REQUIRE(queue.PendingCount() == 1);
+        REQUIRE_FALSE(queue.IsEmpty());
+    }
+
+    SECTION("Flush destroys everything")
+    {
+        queue.Collect(1, destroy);
+        queue.Flush(destroy);
+
+        REQUIRE(destroyed == std::vector{ FakeBuffer(1), FakeBuffer(2), FakeBuffer(3), FakeBuffer(4) });
+        REQUIRE(queue.IsEmpty());
+    }
+}
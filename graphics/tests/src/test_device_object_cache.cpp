@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/device_object_cache.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+Gris::Graphics::Vulkan::DeviceObjectCacheKey MakeKey(uint64_t value, const std::string & name)
+{
+    auto key = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+    key.Append(value);
+    key.Append(std::string_view(name));
+    return key;
+}
+
+}  // namespace
+
+TEST_CASE("Device object cache keys", "[device object cache]")
+{
+    REQUIRE(MakeKey(1, "a") == MakeKey(1, "a"));
+    REQUIRE(MakeKey(1, "a").Hash() == MakeKey(1, "a").Hash());
+    REQUIRE(MakeKey(1, "a") != MakeKey(2, "a"));
+    REQUIRE(MakeKey(1, "a") != MakeKey(1, "b"));
+    REQUIRE(MakeKey(1, "a").Contains(1));
+    REQUIRE(MakeKey(1, "a").Contains('a'));
+    REQUIRE_FALSE(MakeKey(1, "a").Contains(2));
+
+    SECTION("Strings are length prefixed")
+    {
+        auto first = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+        first.Append(std::string_view("ab"));
+        first.Append(std::string_view("c"));
+
+        auto second = Gris::Graphics::Vulkan::DeviceObjectCacheKey{};
+        second.Append(std::string_view("a"));
+        second.Append(std::string_view("bc"));
+
+        REQUIRE(first != second);
+    }
+}
+
+TEST_CASE("Device object cache", "[device object cache]")
+{
+    auto cache = Gris::Graphics::Vulkan::DeviceObjectCache<int>{};
+    auto createCount = 0;
+    auto const factory = [&createCount]()
+    {
+        return ++createCount;
+    };
+
+    auto first = cache.GetOrCreate(MakeKey(1, "a"), factory);
+    auto second = cache.GetOrCreate(MakeKey(1, "a"), factory);
+    auto third = cache.GetOrCreate(MakeKey(2, "a"), factory);
+
+    SECTION("Identical keys share an object")
+    {
+        REQUIRE(first == second);
+        REQUIRE(first != third);
+        REQUIRE(createCount == 2);
+
+        auto const statistics = cache.Statistics();
+        REQUIRE(statistics.Hits == 1);
+        REQUIRE(statistics.Misses == 2);
+        REQUIRE(statistics.Size == 2);
+    }
+
+    SECTION("Trim only releases unreferenced objects")
+    {
+        first.reset();
+        second.reset();
+        cache.Trim();
+
+        REQUIRE(cache.Statistics().Size == 1);
+
+        auto const recreated = cache.GetOrCreate(MakeKey(1, "a"), factory);
+        REQUIRE(*recreated == 3);
+        REQUIRE(cache.GetOrCreate(MakeKey(2, "a"), factory) == third);
+    }
+
+    SECTION("Eviction releases the objects keyed on a word")
+    {
+        cache.EvictContaining(2);
+
+        REQUIRE(cache.Statistics().Size == 1);
+        REQUIRE(*third == 2);
+
+        auto const recreated = cache.GetOrCreate(MakeKey(2, "a"), factory);
+        REQUIRE(*recreated == 3);
+        REQUIRE(cache.GetOrCreate(MakeKey(1, "a"), factory) == first);
+    }
+
+    SECTION("Clear releases everything")
+    {
+        cache.Clear();
+
+        REQUIRE(cache.Statistics().Size == 0);
+        REQUIRE(*first == 1);
+    }
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/device_profile.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace
+{
+
+constexpr uint64_t MEBIBYTE = 1024 * 1024;
+
+vk::PhysicalDeviceProperties FakeProperties(vk::PhysicalDeviceType type, const std::string & name)
+{
+    auto properties = vk::PhysicalDeviceProperties{};
+    properties.deviceType = type;
+    std::copy_n(name.c_str(), name.size() + 1, properties.deviceName.begin());
+    properties.limits.framebufferColorSampleCounts = vk::SampleCountFlagBits::e1 | vk::SampleCountFlagBits::e2 | vk::SampleCountFlagBits::e4 | vk::SampleCountFlagBits::e8;
+    properties.limits.framebufferDepthSampleCounts = vk::SampleCountFlagBits::e1 | vk::SampleCountFlagBits::e2 | vk::SampleCountFlagBits::e4 | vk::SampleCountFlagBits::e8;
+    properties.limits.maxSamplerAnisotropy = 16.0F;
+    return properties;
+}
+
+vk::PhysicalDeviceMemoryProperties FakeMemoryProperties(vk::DeviceSize deviceLocalSize)
+{
+    auto memoryProperties = vk::PhysicalDeviceMemoryProperties{};
+    memoryProperties.memoryHeapCount = 2;
+    memoryProperties.memoryHeaps[0] = vk::MemoryHeap{ deviceLocalSize, vk::MemoryHeapFlagBits::eDeviceLocal };
+    memoryProperties.memoryHeaps[1] = vk::MemoryHeap{ 16 * 1024 * MEBIBYTE, {} };
+    return memoryProperties;
+}
+
+vk::PhysicalDeviceFeatures FakeFeatures()
+{
+    return vk::PhysicalDeviceFeatures{}
+        .setSamplerAnisotropy(static_cast<vk::Bool32>(true))
+        .setPipelineStatisticsQuery(static_cast<vk::Bool32>(true));
+}
+
+}  // namespace
+
+TEST_CASE("Resolving a device profile", "[device profile]")
+{
+    auto const properties = FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "Discrete");
+    auto profile = Gris::Graphics::Vulkan::DeviceProfile{};
+
+    SECTION("MSAA is clamped to the profile")
+    {
+        auto const capabilities = Gris::Graphics::Vulkan::ResolveDeviceProfile(properties, FakeFeatures(), profile);
+
+        REQUIRE(capabilities.MsaaSamples == vk::SampleCountFlagBits::e4);
+    }
+
+    SECTION("MSAA is clamped to the device")
+    {
+        profile.MaxMsaaSamples = vk::SampleCountFlagBits::e64;
+        auto const capabilities = Gris::Graphics::Vulkan::ResolveDeviceProfile(properties, FakeFeatures(), profile);
+
+        REQUIRE(capabilities.MsaaSamples == vk::SampleCountFlagBits::e8);
+    }
+
+    SECTION("Anisotropy is clamped to the device limit")
+    {
+        profile.MaxAnisotropy = 32.0F;
+        auto const capabilities = Gris::Graphics::Vulkan::ResolveDeviceProfile(properties, FakeFeatures(), profile);
+
+        REQUIRE(capabilities.MaxAnisotropy == 16.0F);
+        REQUIRE(capabilities.EnabledFeatures.samplerAnisotropy);
+    }
+
+    SECTION("Anisotropy is disabled without device support")
+    {
+        auto const capabilities = Gris::Graphics::Vulkan::ResolveDeviceProfile(properties, vk::PhysicalDeviceFeatures{}, profile);
+
+        REQUIRE(capabilities.MaxAnisotropy == 1.0F);
+        REQUIRE_FALSE(capabilities.EnabledFeatures.samplerAnisotropy);
+        REQUIRE_FALSE(capabilities.EnabledFeatures.pipelineStatisticsQuery);
+    }
+
+    SECTION("Supported optional features are enabled")
+    {
+        auto const capabilities = Gris::Graphics::Vulkan::ResolveDeviceProfile(properties, FakeFeatures(), profile);
+
+        REQUIRE(capabilities.EnabledFeatures.pipelineStatisticsQuery);
+    }
+}
+
+TEST_CASE("Scoring physical devices", "[device profile]")
+{
+    auto const profile = Gris::Graphics::Vulkan::DeviceProfile{};
+    auto const features = FakeFeatures();
+
+    SECTION("Discrete beats integrated regardless of memory")
+    {
+        auto const discrete = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "Discrete"), FakeMemoryProperties(2 * 1024 * MEBIBYTE), features, profile);
+        auto const integrated = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eIntegratedGpu, "Integrated"), FakeMemoryProperties(32 * 1024 * MEBIBYTE), features, profile);
+
+        REQUIRE(discrete > integrated);
+    }
+
+    SECTION("Larger device local heap breaks ties")
+    {
+        auto const small = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "Small"), FakeMemoryProperties(4 * 1024 * MEBIBYTE), features, profile);
+        auto const large = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "Large"), FakeMemoryProperties(8 * 1024 * MEBIBYTE), features, profile);
+
+        REQUIRE(large > small);
+    }
+
+    SECTION("Optional features break ties")
+    {
+        auto const memoryProperties = FakeMemoryProperties(4 * 1024 * MEBIBYTE);
+        auto const withFeatures = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "A"), memoryProperties, features, profile);
+        auto const withoutFeatures = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "B"), memoryProperties, vk::PhysicalDeviceFeatures{}, profile);
+
+        REQUIRE(withFeatures > withoutFeatures);
+    }
+
+    SECTION("Preferred device name wins")
+    {
+        auto preferredProfile = profile;
+        preferredProfile.PreferredDeviceName = "Integrated";
+
+        auto const discrete = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eDiscreteGpu, "Discrete"), FakeMemoryProperties(8 * 1024 * MEBIBYTE), features, preferredProfile);
+        auto const integrated = Gris::Graphics::Vulkan::ScorePhysicalDevice(FakeProperties(vk::PhysicalDeviceType::eIntegratedGpu, "Some Integrated GPU"), FakeMemoryProperties(1024 * MEBIBYTE), features, preferredProfile);
+
+        REQUIRE(integrated > discrete);
+    }
+}
+
+TEST_CASE("Checking required features", "[device profile]")
+{
+    auto const required = vk::PhysicalDeviceFeatures{}.setGeometryShader(static_cast<vk::Bool32>(true));
+
+    REQUIRE(Gris::Graphics::Vulkan::SupportsFeatures(FakeFeatures(), vk::PhysicalDeviceFeatures{}));
+    REQUIRE_FALSE(Gris::Graphics::Vulkan::SupportsFeatures(FakeFeatures(), required));
+    REQUIRE(Gris::Graphics::Vulkan::SupportsFeatures(FakeFeatures().setGeometryShader(static_cast<vk::Bool32>(true)), required));
+}
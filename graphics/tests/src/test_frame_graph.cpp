@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/barrier_batch.h>
+#include <gris/graphics/vulkan/frame_graph.h>
+
+TEST_CASE("Textures in recycled memory wait for the previous texture", "[frame graph]")
+{
+    auto batch = Gris::Graphics::Vulkan::BarrierBatch{};
+
+    SECTION("Color attachment written by an earlier frame")
+    {
+        // Last state of the slot as Execute left it, carried over to the memory of the next Compile
+        auto const lastState = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal);
+        auto state = Gris::Graphics::Vulkan::AliasedTextureState(lastState);
+
+        REQUIRE(state.Layout == vk::ImageLayout::eUndefined);
+
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal));
+
+        REQUIRE(batch.ImageBarriers().size() == 1);
+        REQUIRE(batch.SourceStages() == vk::PipelineStageFlags(vk::PipelineStageFlagBits::eColorAttachmentOutput));
+        REQUIRE(batch.ImageBarriers()[0].srcAccessMask == vk::AccessFlags(vk::AccessFlagBits::eColorAttachmentWrite));
+        REQUIRE(batch.ImageBarriers()[0].oldLayout == vk::ImageLayout::eUndefined);
+    }
+
+    SECTION("Depth attachment aliased by a color attachment")
+    {
+        auto const lastState = Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eDepthStencilAttachmentOptimal);
+        auto state = Gris::Graphics::Vulkan::AliasedTextureState(lastState);
+
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal));
+
+        REQUIRE(static_cast<bool>(batch.SourceStages() & vk::PipelineStageFlagBits::eLateFragmentTests));
+        REQUIRE(batch.ImageBarriers()[0].srcAccessMask == vk::AccessFlags(vk::AccessFlagBits::eDepthStencilAttachmentWrite));
+    }
+
+    SECTION("Fresh memory has nothing to wait for")
+    {
+        auto state = Gris::Graphics::Vulkan::AliasedTextureState(Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eUndefined));
+
+        batch.TransitionImage(vk::Image{}, vk::ImageAspectFlagBits::eColor, state, Gris::Graphics::Vulkan::TextureStateForLayout(vk::ImageLayout::eColorAttachmentOptimal));
+
+        REQUIRE(batch.SourceStages() == vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTopOfPipe));
+        REQUIRE(!batch.ImageBarriers()[0].srcAccessMask);
+    }
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/loaders/gmesh_file.h>
+#include <gris/graphics/loaders/gmesh_format.h>
+#include <gris/graphics/loaders/gmesh_writer.h>
+#include <gris/graphics/meshlet_builder.h>
+#include <gris/graphics/scene.h>
+
+#include <gris/engine_exception.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+
+Gris::Graphics::Mesh MakeQuad(float offset, size_t materialIndex)
+{
+    auto mesh = Gris::Graphics::Mesh{};
+    mesh.Vertices = {
+        { glm::vec3(offset, 0.0F, 0.0F), glm::vec2(0.0F, 0.0F) },
+        { glm::vec3(offset + 1.0F, 0.0F, -2.0F), glm::vec2(1.0F, 0.0F) },
+        { glm::vec3(offset + 1.0F, 3.0F, 0.0F), glm::vec2(1.0F, 1.0F) },
+        { glm::vec3(offset, 3.0F, 0.0F), glm::vec2(0.0F, 1.0F) },
+    };
+    mesh.Indices = { 0, 1, 2, 2, 3, 0 };
+    mesh.MaterialIndex = materialIndex;
+    Gris::Graphics::BuildMeshlets(mesh);
+    return mesh;
+}
+
+}  // namespace
+
+TEST_CASE("Gmesh index encoding", "[gmesh]")
+{
+    auto const indices = std::vector<uint32_t>{ 0, 1, 2, 2, 1, 3, 1000, 7, 0xFFFFFFFFU, 0, 65536 };
+
+    auto encoded = std::vector<std::byte>{};
+    Gris::Graphics::Loaders::EncodeGmeshIndices(Gris::Span<const uint32_t>(indices.data(), indices.size()), encoded);
+
+    SECTION("Small deltas take a byte each")
+    {
+        auto smallEncoded = std::vector<std::byte>{};
+        auto const smallIndices = std::vector<uint32_t>{ 0, 1, 2, 2, 1, 3 };
+        Gris::Graphics::Loaders::EncodeGmeshIndices(Gris::Span<const uint32_t>(smallIndices.data(), smallIndices.size()), smallEncoded);
+        REQUIRE(smallEncoded.size() == smallIndices.size());
+    }
+
+    SECTION("Decoding restores the indices")
+    {
+        auto decoded = std::vector<uint32_t>{};
+        Gris::Graphics::Loaders::DecodeGmeshIndices(Gris::Span<const std::byte>(encoded.data(), encoded.size()), indices.size(), decoded);
+        REQUIRE(decoded == indices);
+    }
+
+    SECTION("Truncated data throws")
+    {
+        auto decoded = std::vector<uint32_t>{};
+        REQUIRE_THROWS_AS(Gris::Graphics::Loaders::DecodeGmeshIndices(Gris::Span<const std::byte>(encoded.data(), encoded.size() - 1), indices.size(), decoded), Gris::EngineException);
+    }
+}
+
+TEST_CASE("Gmesh roundtrip", "[gmesh]")
+{
+    auto const path = std::filesystem::temp_directory_path() / "gris_test_gmesh_roundtrip.gmesh";
+
+    auto material = Gris::Graphics::MaterialBlueprint{};
+    material.Name = "Brick";
+    material.DiffuseTextures = { "textures/brick_diffuse.dds" };
+    material.NormalTextures = { "textures/brick_normal.dds", "textures/brick_detail.dds" };
+
+    auto const meshes = std::vector<Gris::Graphics::Mesh>{ MakeQuad(0.0F, 0), MakeQuad(5.0F, 1) };
+    auto const materials = std::vector<Gris::Graphics::MaterialBlueprint>{ material, Gris::Graphics::MaterialBlueprint{} };
+
+    auto const encoding = GENERATE(Gris::Graphics::Loaders::GmeshIndexEncoding::Raw, Gris::Graphics::Loaders::GmeshIndexEncoding::DeltaVarint);
+    Gris::Graphics::Loaders::GmeshWriter::Write(path, meshes, materials, encoding);
+
+    SECTION("Views point at the stored data")
+    {
+        auto const file = Gris::Graphics::Loaders::GmeshFile(path);
+        REQUIRE(file.IsValid());
+        REQUIRE(file.MeshCount() == 2);
+
+        auto const view = file.MeshView(1);
+        REQUIRE(view.Vertices.size() == 4);
+        REQUIRE(reinterpret_cast<uintptr_t>(view.Vertices.data()) % Gris::Graphics::Loaders::GMESH_BLOB_ALIGNMENT == 0);
+        REQUIRE(view.Vertices[2].Position == meshes[1].Vertices[2].Position);
+        REQUIRE(view.Vertices[3].TextureCoords == meshes[1].Vertices[3].TextureCoords);
+        REQUIRE(view.IndexCount == 6);
+        REQUIRE(view.IndexEncoding == encoding);
+        REQUIRE(view.Indices.empty() == (encoding != Gris::Graphics::Loaders::GmeshIndexEncoding::Raw));
+        REQUIRE(view.MaterialIndex == 1);
+        REQUIRE(view.BoundsMin == glm::vec3(5.0F, 0.0F, -2.0F));
+        REQUIRE(view.BoundsMax == glm::vec3(6.0F, 3.0F, 0.0F));
+        REQUIRE(view.Meshlets.size() == 1);
+        REQUIRE(view.Meshlets[0].TriangleCount == 2);
+        REQUIRE(view.Meshlets[0].BoundsRadius == meshes[1].Meshlets[0].BoundsRadius);
+        REQUIRE(view.MeshletVertices.size() == meshes[1].MeshletVertices.size());
+        REQUIRE(view.MeshletTriangles.size() == meshes[1].MeshletTriangles.size());
+
+        auto indices = std::vector<uint32_t>{};
+        file.ReadIndices(1, indices);
+        REQUIRE(indices == meshes[1].Indices);
+    }
+
+    SECTION("Materials are restored")
+    {
+        auto const [readMeshes, readMaterials] = Gris::Graphics::Loaders::GmeshFile(path).ReadAll();
+        REQUIRE(readMeshes.size() == 2);
+        REQUIRE(readMeshes[0].Indices == meshes[0].Indices);
+        REQUIRE(readMeshes[0].MeshletVertices == meshes[0].MeshletVertices);
+        REQUIRE(readMeshes[0].MeshletTriangles == meshes[0].MeshletTriangles);
+        REQUIRE(readMaterials.size() == 2);
+        REQUIRE(readMaterials[0].Name == "Brick");
+        REQUIRE(readMaterials[0].DiffuseTextures == material.DiffuseTextures);
+        REQUIRE(readMaterials[0].SpecularTextures.empty());
+        REQUIRE(readMaterials[0].NormalTextures == material.NormalTextures);
+        REQUIRE(readMaterials[1].Name.empty());
+    }
+
+    SECTION("Truncated files are rejected")
+    {
+        auto const size = std::filesystem::file_size(path);
+        std::filesystem::resize_file(path, size - 1);
+        REQUIRE_THROWS_AS(Gris::Graphics::Loaders::GmeshFile(path), Gris::EngineException);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Gmesh references out of range are rejected", "[gmesh]")
+{
+    auto const path = std::filesystem::temp_directory_path() / "gris_test_gmesh_out_of_range.gmesh";
+    auto const encoding = GENERATE(Gris::Graphics::Loaders::GmeshIndexEncoding::Raw, Gris::Graphics::Loaders::GmeshIndexEncoding::DeltaVarint);
+
+    auto mesh = MakeQuad(0.0F, 0);
+
+    SECTION("Index past the last vertex")
+    {
+        mesh.Indices[4] = 4;
+    }
+
+    SECTION("Meshlet vertex past the last vertex")
+    {
+        mesh.MeshletVertices[1] = 17;
+    }
+
+    SECTION("Meshlet triangles past the end of the local indices")
+    {
+        mesh.Meshlets[0].TriangleCount = 3;
+    }
+
+    SECTION("Meshlet vertices past the end of the mapping")
+    {
+        mesh.Meshlets[0].VertexOffset = 1;
+    }
+
+    Gris::Graphics::Loaders::GmeshWriter::Write(path, std::vector<Gris::Graphics::Mesh>{ mesh }, std::vector<Gris::Graphics::MaterialBlueprint>{}, encoding);
+
+    // The blobs themselves fit in the file, so opening succeeds
+    auto const file = Gris::Graphics::Loaders::GmeshFile(path);
+    REQUIRE_THROWS_AS(file.ReadAll(), Gris::EngineException);
+
+    std::filesystem::remove(path);
+}
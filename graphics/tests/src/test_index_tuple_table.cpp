@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/loaders/index_tuple_table.h>
+
+#include <cstdint>
+#include <utility>
+
+TEST_CASE("Index tuple deduplication", "[index tuple table]")
+{
+    auto table = Gris::Graphics::Loaders::IndexTupleTable(8);
+
+    SECTION("New tuples get consecutive vertex indices")
+    {
+        REQUIRE(table.FindOrInsert(0, 0) == std::pair{ uint32_t{ 0 }, true });
+        REQUIRE(table.FindOrInsert(1, 0) == std::pair{ uint32_t{ 1 }, true });
+        REQUIRE(table.FindOrInsert(0, 1) == std::pair{ uint32_t{ 2 }, true });
+        REQUIRE(table.Size() == 3);
+    }
+
+    SECTION("Repeated tuples map to the first vertex")
+    {
+        REQUIRE(table.FindOrInsert(5, 7).second);
+        REQUIRE(table.FindOrInsert(2, 3).second);
+        REQUIRE(table.FindOrInsert(5, 7) == std::pair{ uint32_t{ 0 }, false });
+        REQUIRE(table.FindOrInsert(2, 3) == std::pair{ uint32_t{ 1 }, false });
+        REQUIRE(table.Size() == 2);
+    }
+
+    SECTION("Missing texture coordinates are a distinct index")
+    {
+        REQUIRE(table.FindOrInsert(4, -1).second);
+        REQUIRE(table.FindOrInsert(4, 0).second);
+        REQUIRE(table.FindOrInsert(4, -1) == std::pair{ uint32_t{ 0 }, false });
+    }
+}
+
+TEST_CASE("Index tuple table at capacity", "[index tuple table]")
+{
+    constexpr static int32_t TUPLE_COUNT = 1000;
+
+    auto table = Gris::Graphics::Loaders::IndexTupleTable(TUPLE_COUNT);
+    for (int32_t index = 0; index < TUPLE_COUNT; ++index)
+    {
+        REQUIRE(table.FindOrInsert(index, index / 2).second);
+    }
+
+    auto allFound = true;
+    for (int32_t index = 0; index < TUPLE_COUNT; ++index)
+    {
+        allFound &= table.FindOrInsert(index, index / 2) == std::pair{ static_cast<uint32_t>(index), false };
+    }
+
+    REQUIRE(allFound);
+    REQUIRE(table.Size() == TUPLE_COUNT);
+}
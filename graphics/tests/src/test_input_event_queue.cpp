@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/input_event_queue.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+Gris::Graphics::InputEvent Move(double timestamp, float x, float y)
+{
+    return Gris::Graphics::InputEvent{ timestamp, Gris::Graphics::MouseMoveInputEvent{ x, y } };
+}
+
+Gris::Graphics::InputEvent Wheel(double timestamp, float x, float y, float delta)
+{
+    return Gris::Graphics::InputEvent{ timestamp, Gris::Graphics::MouseWheelInputEvent{ x, y, delta } };
+}
+
+Gris::Graphics::InputEvent Button(double timestamp, Gris::Graphics::MouseButtonAction action)
+{
+    return Gris::Graphics::InputEvent{ timestamp, Gris::Graphics::MouseButtonInputEvent{ Gris::Graphics::MouseButton::Left, action, 0.0F, 0.0F } };
+}
+
+}  // namespace
+
+TEST_CASE("Input event coalescing", "[input event queue]")
+{
+    auto queue = Gris::Graphics::InputEventQueue(16);
+    auto events = std::vector<Gris::Graphics::InputEvent>{};
+
+    SECTION("Runs of moves keep the last one")
+    {
+        queue.Push(Move(1.0, 1.0F, 1.0F));
+        queue.Push(Move(2.0, 2.0F, 2.0F));
+        queue.Push(Move(3.0, 3.0F, 3.0F));
+        queue.Consume(events);
+
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].Timestamp == 3.0);
+        REQUIRE(std::get<Gris::Graphics::MouseMoveInputEvent>(events[0].Data).X == 3.0F);
+    }
+
+    SECTION("Runs of wheel events sum their deltas")
+    {
+        queue.Push(Wheel(1.0, 1.0F, 1.0F, 1.0F));
+        queue.Push(Wheel(2.0, 2.0F, 2.0F, 1.0F));
+        queue.Push(Wheel(3.0, 3.0F, 3.0F, -0.5F));
+        queue.Consume(events);
+
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].Timestamp == 3.0);
+        auto const & wheel = std::get<Gris::Graphics::MouseWheelInputEvent>(events[0].Data);
+        REQUIRE(wheel.X == 3.0F);
+        REQUIRE(wheel.Delta == 1.5F);
+    }
+
+    SECTION("Button events split runs")
+    {
+        queue.Push(Move(1.0, 1.0F, 1.0F));
+        queue.Push(Button(2.0, Gris::Graphics::MouseButtonAction::Down));
+        queue.Push(Move(3.0, 3.0F, 3.0F));
+        queue.Push(Move(4.0, 4.0F, 4.0F));
+        queue.Push(Button(5.0, Gris::Graphics::MouseButtonAction::Up));
+        queue.Consume(events);
+
+        REQUIRE(events.size() == 4);
+        REQUIRE(events[0].Timestamp == 1.0);
+        REQUIRE(std::holds_alternative<Gris::Graphics::MouseButtonInputEvent>(events[1].Data));
+        REQUIRE(events[2].Timestamp == 4.0);
+        REQUIRE(std::get<Gris::Graphics::MouseButtonInputEvent>(events[3].Data).Action == Gris::Graphics::MouseButtonAction::Up);
+    }
+
+    SECTION("Events consumed earlier are not coalesced with new ones")
+    {
+        events.emplace_back(Move(0.0, 0.0F, 0.0F));
+        queue.Push(Move(1.0, 1.0F, 1.0F));
+        queue.Consume(events);
+
+        REQUIRE(events.size() == 2);
+    }
+}
+
+TEST_CASE("Input event queue overflow", "[input event queue]")
+{
+    auto queue = Gris::Graphics::InputEventQueue(4);
+    auto events = std::vector<Gris::Graphics::InputEvent>{};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.Push(Button(static_cast<double>(i), Gris::Graphics::MouseButtonAction::Down)));
+    }
+    REQUIRE_FALSE(queue.Push(Button(4.0, Gris::Graphics::MouseButtonAction::Down)));
+    REQUIRE(queue.DroppedEventCount() == 1);
+
+    queue.Consume(events);
+    REQUIRE(events.size() == 4);
+    REQUIRE(events.back().Timestamp == 3.0);
+
+    REQUIRE(queue.Push(Button(5.0, Gris::Graphics::MouseButtonAction::Up)));
+}
+
+TEST_CASE("Input events cross threads in order", "[input event queue]")
+{
+    constexpr static auto EVENT_COUNT = 10000;
+
+    auto queue = Gris::Graphics::InputEventQueue(64);
+    auto producer = std::thread([&queue]()
+                                {
+                                    for (auto i = 0; i < EVENT_COUNT; ++i)
+                                    {
+                                        auto const action = (i % 2 == 0) ? Gris::Graphics::MouseButtonAction::Down : Gris::Graphics::MouseButtonAction::Up;
+                                        while (!queue.Push(Button(static_cast<double>(i), action)))
+                                        {
+                                            std::this_thread::yield();
+                                        }
+                                    }
+                                });
+
+    auto events = std::vector<Gris::Graphics::InputEvent>{};
+    while (events.size() < EVENT_COUNT)
+    {
+        queue.Consume(events);
+    }
+    producer.join();
+
+    auto inOrder = true;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        inOrder &= events[i].Timestamp == static_cast<double>(i);
+    }
+    REQUIRE(inOrder);
+}
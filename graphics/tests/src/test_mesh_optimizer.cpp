@@ -0,0 +1,126 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/mesh_optimizer.h>
+#include <gris/graphics/scene.h>
+
+#include "test_meshes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+
+// Grid with the triangles in a random order, the worst case for the vertex cache
+Gris::Graphics::Mesh MakeShuffledGrid(uint32_t size)
+{
+    auto mesh = Gris::Graphics::Tests::MakeGrid(size);
+
+    auto triangles = std::vector<std::array<uint32_t, 3>>(mesh.Indices.size() / 3);
+    for (size_t triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex)
+    {
+        std::copy_n(mesh.Indices.begin() + static_cast<std::ptrdiff_t>(3 * triangleIndex), 3, triangles[triangleIndex].begin());
+    }
+
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+    mesh.Indices.clear();
+    for (auto const & triangle : triangles)
+    {
+        mesh.Indices.insert(mesh.Indices.end(), triangle.begin(), triangle.end());
+    }
+
+    return mesh;
+}
+
+// Triangles as position triples starting at the smallest corner, so the comparison ignores vertex order and keeps
+// the winding
+std::vector<std::array<std::tuple<float, float, float>, 3>> TriangleSet(const Gris::Graphics::Mesh & mesh)
+{
+    auto result = std::vector<std::array<std::tuple<float, float, float>, 3>>{};
+    for (size_t cornerIndex = 0; cornerIndex < mesh.Indices.size(); cornerIndex += 3)
+    {
+        auto triangle = std::array<std::tuple<float, float, float>, 3>{};
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            auto const & position = mesh.Vertices[mesh.Indices[cornerIndex + corner]].Position;
+            triangle[corner] = { position.x, position.y, position.z };
+        }
+
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        result.emplace_back(triangle);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Vertex cache analysis", "[mesh optimizer]")
+{
+    auto const indices = std::vector<uint32_t>{ 0, 1, 2, 2, 1, 3 };
+    auto const statistics = Gris::Graphics::AnalyzeVertexCache(Gris::Span<const uint32_t>(indices.data(), indices.size()), 5);
+
+    REQUIRE(statistics.TransformedVertexCount == 4);
+    REQUIRE(statistics.TriangleCount == 2);
+    REQUIRE(statistics.VertexCount == 4);
+    REQUIRE(statistics.Acmr() == 2.0F);
+    REQUIRE(statistics.Atvr() == 1.0F);
+
+    SECTION("Evicted vertices are transformed again")
+    {
+        auto const tiny = Gris::Graphics::AnalyzeVertexCache(Gris::Span<const uint32_t>(indices.data(), indices.size()), 5, 1);
+        REQUIRE(tiny.TransformedVertexCount == 5);
+    }
+}
+
+TEST_CASE("Mesh optimization", "[mesh optimizer]")
+{
+    SECTION("Degenerate triangles are removed")
+    {
+        auto mesh = MakeShuffledGrid(1);
+        mesh.Vertices.push_back({ glm::vec3(2.0F, 0.0F, 0.0F), glm::vec2(0.0F) });
+        mesh.Indices.insert(mesh.Indices.end(), { 0, 0, 1, 0, 1, 4 });
+
+        Gris::Graphics::RemoveDegenerateTriangles(mesh);
+        REQUIRE(mesh.Indices.size() == 6);
+    }
+
+    SECTION("Vertices are reordered by first use and unused ones dropped")
+    {
+        auto mesh = MakeShuffledGrid(2);
+        mesh.Vertices.push_back({ glm::vec3(7.0F), glm::vec2(0.0F) });
+        auto const triangles = TriangleSet(mesh);
+
+        Gris::Graphics::OptimizeVertexFetch(mesh);
+        REQUIRE(mesh.Vertices.size() == 9);
+        REQUIRE(TriangleSet(mesh) == triangles);
+
+        uint32_t nextNewVertex = 0;
+        for (auto const index : mesh.Indices)
+        {
+            REQUIRE(index <= nextNewVertex);
+            nextNewVertex = std::max(nextNewVertex, index + 1);
+        }
+    }
+
+    SECTION("The full pass keeps the triangles and transforms fewer vertices")
+    {
+        auto mesh = MakeShuffledGrid(24);
+        auto const triangles = TriangleSet(mesh);
+
+        auto const report = Gris::Graphics::OptimizeMesh(mesh);
+        REQUIRE(TriangleSet(mesh) == triangles);
+        REQUIRE(report.RemovedTriangleCount == 0);
+        REQUIRE(report.RemovedVertexCount == 0);
+        REQUIRE(report.After.TriangleCount == report.Before.TriangleCount);
+        REQUIRE(report.After.Acmr() < report.Before.Acmr());
+        REQUIRE(report.After.Acmr() < 1.0F);
+        REQUIRE(report.After.Atvr() < 1.6F);
+    }
+}
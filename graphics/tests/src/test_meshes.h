@@ -0,0 +1,34 @@
+#pragma once
+
+#include <gris/graphics/scene.h>
+
+#include <cstdint>
+
+namespace Gris::Graphics::Tests
+{
+
+// Quads in the z = 0 plane, wound so their normals point along +z
+inline Mesh MakeGrid(uint32_t size)
+{
+    auto mesh = Mesh{};
+    for (uint32_t y = 0; y <= size; ++y)
+    {
+        for (uint32_t x = 0; x <= size; ++x)
+        {
+            mesh.Vertices.push_back({ glm::vec3(static_cast<float>(x), static_cast<float>(y), 0.0F), glm::vec2(0.0F) });
+        }
+    }
+
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            auto const corner = y * (size + 1) + x;
+            mesh.Indices.insert(mesh.Indices.end(), { corner, corner + 1, corner + size + 2, corner, corner + size + 2, corner + size + 1 });
+        }
+    }
+
+    return mesh;
+}
+
+}  // namespace Gris::Graphics::Tests
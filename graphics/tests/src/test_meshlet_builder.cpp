@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/meshlet_builder.h>
+#include <gris/graphics/scene.h>
+
+#include "test_meshes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+// Maps the meshlet triangles back to mesh vertex indices
+std::vector<uint32_t> ExpandMeshlets(const Gris::Graphics::Mesh & mesh)
+{
+    auto indices = std::vector<uint32_t>{};
+    for (auto const & meshlet : mesh.Meshlets)
+    {
+        for (uint32_t localIndex = 0; localIndex < meshlet.TriangleCount * 3; ++localIndex)
+        {
+            auto const vertex = mesh.MeshletTriangles[meshlet.LocalIndexOffset + localIndex];
+            indices.emplace_back(mesh.MeshletVertices[meshlet.VertexOffset + vertex]);
+        }
+    }
+    return indices;
+}
+
+}  // namespace
+
+TEST_CASE("Meshlet building", "[meshlet builder]")
+{
+    SECTION("Empty meshes have no meshlets")
+    {
+        auto mesh = Gris::Graphics::Mesh{};
+        Gris::Graphics::BuildMeshlets(mesh);
+        REQUIRE(mesh.Meshlets.empty());
+        REQUIRE(mesh.MeshletVertices.empty());
+        REQUIRE(mesh.MeshletTriangles.empty());
+    }
+
+    SECTION("Meshlets respect the limits and cover every triangle in order")
+    {
+        auto mesh = Gris::Graphics::Tests::MakeGrid(32);
+        Gris::Graphics::BuildMeshlets(mesh);
+
+        REQUIRE(mesh.Meshlets.size() > 1);
+        for (auto const & meshlet : mesh.Meshlets)
+        {
+            REQUIRE(meshlet.VertexCount <= Gris::Graphics::MESHLET_MAX_VERTICES);
+            REQUIRE(meshlet.TriangleCount <= Gris::Graphics::MESHLET_MAX_TRIANGLES);
+            REQUIRE(meshlet.TriangleCount > 0);
+        }
+
+        REQUIRE(ExpandMeshlets(mesh) == mesh.Indices);
+    }
+
+    SECTION("Bounding spheres contain their vertices")
+    {
+        auto mesh = Gris::Graphics::Tests::MakeGrid(16);
+        Gris::Graphics::BuildMeshlets(mesh);
+
+        for (auto const & meshlet : mesh.Meshlets)
+        {
+            for (uint32_t vertexIndex = 0; vertexIndex < meshlet.VertexCount; ++vertexIndex)
+            {
+                auto const & position = mesh.Vertices[mesh.MeshletVertices[meshlet.VertexOffset + vertexIndex]].Position;
+                REQUIRE(glm::length(position - meshlet.BoundsCenter) <= meshlet.BoundsRadius + 1e-4F);
+            }
+        }
+    }
+
+    SECTION("Flat meshlets get a cone along the normal")
+    {
+        auto mesh = Gris::Graphics::Tests::MakeGrid(4);
+        Gris::Graphics::BuildMeshlets(mesh);
+
+        REQUIRE(mesh.Meshlets.size() == 1);
+        auto const & meshlet = mesh.Meshlets.front();
+        REQUIRE(meshlet.ConeAxis.x == Approx(0.0F).margin(1e-6F));
+        REQUIRE(meshlet.ConeAxis.y == Approx(0.0F).margin(1e-6F));
+        REQUIRE(meshlet.ConeAxis.z == Approx(1.0F));
+        REQUIRE(meshlet.ConeCutoff == Approx(0.0F).margin(1e-3F));
+        REQUIRE(meshlet.ConeApex.z <= 0.0F);
+    }
+
+    SECTION("Closed meshlets cannot be culled by their cone")
+    {
+        auto mesh = Gris::Graphics::Tests::MakeGrid(1);
+        auto const vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+        for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+        {
+            mesh.Vertices.push_back(mesh.Vertices[vertexIndex]);
+        }
+
+        // The same quad again, facing the other way
+        mesh.Indices.insert(mesh.Indices.end(), { 4, 7, 6, 4, 6, 5 });
+        Gris::Graphics::BuildMeshlets(mesh);
+
+        REQUIRE(mesh.Meshlets.size() == 1);
+        REQUIRE(mesh.Meshlets.front().ConeCutoff == 1.0F);
+    }
+}
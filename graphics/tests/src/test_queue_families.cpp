@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vulkan/utils.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+vk::QueueFamilyProperties FakeQueueFamily(const vk::QueueFlags & flags, uint32_t queueCount)
+{
+    auto queueFamily = vk::QueueFamilyProperties{};
+    queueFamily.queueFlags = flags;
+    queueFamily.queueCount = queueCount;
+    return queueFamily;
+}
+
+// Layout of a typical discrete GPU: one universal family, one compute only family and one transfer only family
+std::vector<vk::QueueFamilyProperties> FakeDiscreteQueueFamilies()
+{
+    return {
+        FakeQueueFamily(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eTransfer, 16),
+        FakeQueueFamily(vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eTransfer, 8),
+        FakeQueueFamily(vk::QueueFlagBits::eTransfer, 2),
+    };
+}
+
+// A single universal family, as on many integrated GPUs
+std::vector<vk::QueueFamilyProperties> FakeIntegratedQueueFamilies()
+{
+    return {
+        FakeQueueFamily(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eTransfer, 1),
+    };
+}
+
+}  // namespace
+
+TEST_CASE("Finding queue families", "[queue families]")
+{
+    SECTION("The compute only family is found for async compute")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeDiscreteQueueFamilies(), [](uint32_t queueFamilyIndex)
+                                                                             { return queueFamilyIndex == 0; });
+
+        REQUIRE(queueFamilies.IsComplete());
+        REQUIRE(queueFamilies.graphicsFamily == 0U);
+        REQUIRE(queueFamilies.presentFamily == 0U);
+        REQUIRE(queueFamilies.SupportsAsyncCompute());
+        REQUIRE(queueFamilies.computeFamily == 1U);
+        REQUIRE(queueFamilies.computeQueueCount == 8);
+    }
+
+    SECTION("Headless devices have no present family")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeDiscreteQueueFamilies(), {});
+
+        REQUIRE(queueFamilies.IsHeadlessComplete());
+        REQUIRE_FALSE(queueFamilies.SupportsPresentation());
+        REQUIRE(queueFamilies.computeFamily == 1U);
+    }
+
+    SECTION("Presentation can come from another family")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeDiscreteQueueFamilies(), [](uint32_t queueFamilyIndex)
+                                                                             { return queueFamilyIndex == 2; });
+
+        REQUIRE(queueFamilies.IsComplete());
+        REQUIRE(queueFamilies.graphicsFamily == 0U);
+        REQUIRE(queueFamilies.presentFamily == 2U);
+    }
+
+    SECTION("Families with graphics are not used for async compute")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeIntegratedQueueFamilies(), [](uint32_t)
+                                                                             { return true; });
+
+        REQUIRE(queueFamilies.IsComplete());
+        REQUIRE_FALSE(queueFamilies.SupportsAsyncCompute());
+    }
+}
+
+TEST_CASE("Counting async compute queues", "[queue families]")
+{
+    auto configuration = Gris::Graphics::Vulkan::DeviceQueueConfiguration{};
+    configuration.AsyncComputePriorities = { 1.0F, 0.5F };
+
+    SECTION("One queue per priority")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeDiscreteQueueFamilies(), {});
+
+        REQUIRE(Gris::Graphics::Vulkan::AsyncComputeQueueCount(queueFamilies, configuration) == 2);
+    }
+
+    SECTION("Clamped to the queues of the family")
+    {
+        auto families = FakeDiscreteQueueFamilies();
+        families[1].queueCount = 1;
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(families, {});
+
+        REQUIRE(Gris::Graphics::Vulkan::AsyncComputeQueueCount(queueFamilies, configuration) == 1);
+    }
+
+    SECTION("None without a compute only family")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeIntegratedQueueFamilies(), {});
+
+        REQUIRE(Gris::Graphics::Vulkan::AsyncComputeQueueCount(queueFamilies, configuration) == 0);
+    }
+}
+
+TEST_CASE("Selecting the async compute queue", "[queue families]")
+{
+    SECTION("Async queues come from the compute only family")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeDiscreteQueueFamilies(), {});
+        auto const queue = Gris::Graphics::Vulkan::SelectAsyncComputeQueue(queueFamilies, 2, 1);
+
+        REQUIRE(queue.IsAsync);
+        REQUIRE(queue.QueueFamily == 1);
+        REQUIRE(queue.QueueIndex == 1);
+    }
+
+    SECTION("Without async queues every index falls back to the graphics queue")
+    {
+        auto const queueFamilies = Gris::Graphics::Vulkan::FindQueueFamilies(FakeIntegratedQueueFamilies(), {});
+
+        for (uint32_t queueIndex = 0; queueIndex < 2; ++queueIndex)
+        {
+            auto const queue = Gris::Graphics::Vulkan::SelectAsyncComputeQueue(queueFamilies, 0, queueIndex);
+
+            REQUIRE_FALSE(queue.IsAsync);
+            REQUIRE(queue.QueueFamily == 0);
+            REQUIRE(queue.QueueIndex == 0);
+        }
+    }
+}
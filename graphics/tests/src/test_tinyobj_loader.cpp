@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/loaders/tinlyobjloader_mesh_loader.h>
+#include <gris/graphics/scene.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+
+const Gris::Graphics::Vertex * FindVertex(const Gris::Graphics::Mesh & mesh, const glm::vec3 & position, const glm::vec2 & textureCoords)
+{
+    for (auto const & vertex : mesh.Vertices)
+    {
+        if (vertex.Position == position && vertex.TextureCoords == textureCoords)
+        {
+            return &vertex;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("Faces without texture coordinates next to faces with them", "[tinyobj loader]")
+{
+    auto const path = std::filesystem::temp_directory_path() / "gris_test_tinyobj_mixed_faces.obj";
+
+    {
+        auto file = std::ofstream(path);
+        file << "v 0 0 0\n"
+             << "v 1 0 0\n"
+             << "v 0 1 0\n"
+             << "v 1 1 0\n"
+             << "vt 0.25 0.75\n"
+             << "vt 0.5 0.5\n"
+             << "vt 1 0\n"
+             << "f 1/1 2/2 3/3\n"
+             << "f 2 4 3\n";
+    }
+
+    auto const [meshes, materials] = Gris::Graphics::Loaders::TinyObjLoaderMeshLoader::Load(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(meshes.size() == 1);
+    auto const & mesh = meshes[0];
+
+    // Corners of the second face do not share vertices with the first one, their texture coordinates differ
+    REQUIRE(mesh.Vertices.size() == 6);
+    REQUIRE(mesh.Indices.size() == 6);
+
+    // Gathered and flipped
+    REQUIRE(FindVertex(mesh, glm::vec3(0.0F, 0.0F, 0.0F), glm::vec2(0.25F, 0.25F)) != nullptr);
+    REQUIRE(FindVertex(mesh, glm::vec3(1.0F, 0.0F, 0.0F), glm::vec2(0.5F, 0.5F)) != nullptr);
+    REQUIRE(FindVertex(mesh, glm::vec3(0.0F, 1.0F, 0.0F), glm::vec2(1.0F, 1.0F)) != nullptr);
+
+    // Filled like meshes without texture coordinates
+    REQUIRE(FindVertex(mesh, glm::vec3(1.0F, 0.0F, 0.0F), glm::vec2(0.0F, 1.0F)) != nullptr);
+    REQUIRE(FindVertex(mesh, glm::vec3(1.0F, 1.0F, 0.0F), glm::vec2(0.0F, 1.0F)) != nullptr);
+    REQUIRE(FindVertex(mesh, glm::vec3(0.0F, 1.0F, 0.0F), glm::vec2(0.0F, 1.0F)) != nullptr);
+}
+
+TEST_CASE("Quads are split into triangles", "[tinyobj loader]")
+{
+    auto const path = std::filesystem::temp_directory_path() / "gris_test_tinyobj_quad_faces.obj";
+
+    {
+        auto file = std::ofstream(path);
+        file << "v 0 0 0\n"
+             << "v 1 0 0\n"
+             << "v 1 1 0\n"
+             << "v 0 1 0\n"
+             << "v 2 0 0\n"
+             << "v 2 1 0\n"
+             << "f 1 2 3 4\n"
+             << "f 2 5 6 3\n";
+    }
+
+    auto const [meshes, materials] = Gris::Graphics::Loaders::TinyObjLoaderMeshLoader::Load(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(meshes.size() == 1);
+    auto const & mesh = meshes[0];
+
+    REQUIRE(mesh.Vertices.size() == 6);
+    REQUIRE(mesh.Indices.size() == 12);
+
+    // Both quads keep their area, none of the triangles is degenerate
+    auto area = 0.0F;
+    for (size_t cornerIndex = 0; cornerIndex < mesh.Indices.size(); cornerIndex += 3)
+    {
+        auto const & a = mesh.Vertices[mesh.Indices[cornerIndex + 0]].Position;
+        auto const & b = mesh.Vertices[mesh.Indices[cornerIndex + 1]].Position;
+        auto const & c = mesh.Vertices[mesh.Indices[cornerIndex + 2]].Position;
+        auto const triangleArea = 0.5F * ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+        REQUIRE(triangleArea > 0.0F);
+        area += triangleArea;
+    }
+    REQUIRE(area == Approx(2.0F));
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vertex_format.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+
+using FullVertexFormat = Gris::Graphics::VertexFormat<Gris::Graphics::PositionAttribute, Gris::Graphics::ColorAttribute, Gris::Graphics::TextureCoordsAttribute>;
+using PositionOnlyVertexFormat = Gris::Graphics::VertexFormat<Gris::Graphics::PositionAttribute>;
+
+static_assert(FullVertexFormat::STRIDE == 32);
+static_assert(Gris::Graphics::MeshVertexFormat::STRIDE == 20);
+static_assert(PositionOnlyVertexFormat::STRIDE == 12);
+
+static_assert(FullVertexFormat::CONTAINS<Gris::Graphics::ColorAttribute>);
+static_assert(!Gris::Graphics::MeshVertexFormat::CONTAINS<Gris::Graphics::ColorAttribute>);
+
+static_assert(FullVertexFormat::OffsetOf<Gris::Graphics::TextureCoordsAttribute>() == 24);
+static_assert(Gris::Graphics::MeshVertexFormat::OffsetOf<Gris::Graphics::TextureCoordsAttribute>() == 12);
+
+}  // namespace
+
+TEST_CASE("Attribute descriptions follow the attribute order", "[vertex format]")
+{
+    auto const & attributes = FullVertexFormat::ATTRIBUTES;
+    REQUIRE(attributes.size() == 3);
+
+    REQUIRE(attributes[0].Location == Gris::Graphics::PositionAttribute::LOCATION);
+    REQUIRE(attributes[0].ComponentCount == 3);
+    REQUIRE(attributes[0].Offset == 0);
+
+    REQUIRE(attributes[1].Location == Gris::Graphics::ColorAttribute::LOCATION);
+    REQUIRE(attributes[1].ComponentCount == 3);
+    REQUIRE(attributes[1].Offset == 12);
+
+    REQUIRE(attributes[2].Location == Gris::Graphics::TextureCoordsAttribute::LOCATION);
+    REQUIRE(attributes[2].ComponentCount == 2);
+    REQUIRE(attributes[2].Offset == 24);
+
+    for (auto const & attribute : attributes)
+    {
+        REQUIRE(attribute.ComponentType == Gris::Graphics::VertexComponentType::Float);
+    }
+}
+
+TEST_CASE("Attribute data matches the generated members", "[vertex format]")
+{
+    auto vertices = std::vector<FullVertexFormat::Vertex>(2);
+    auto & vertex = vertices[1];
+    auto const * const base = reinterpret_cast<const std::byte *>(&vertex);
+
+    REQUIRE(sizeof(FullVertexFormat::Vertex) == FullVertexFormat::STRIDE);
+    REQUIRE(FullVertexFormat::Data<Gris::Graphics::PositionAttribute>(vertex) == &vertex.Position.x);
+    REQUIRE(FullVertexFormat::Data<Gris::Graphics::ColorAttribute>(vertex) == &vertex.Color.x);
+    REQUIRE(FullVertexFormat::Data<Gris::Graphics::TextureCoordsAttribute>(vertex) == &vertex.TextureCoords.x);
+
+    FullVertexFormat::ForEachAttribute([&](auto attribute)
+                                       {
+                                           using Attribute = decltype(attribute);
+                                           auto const * const data = reinterpret_cast<const std::byte *>(FullVertexFormat::Data<Attribute>(vertex));
+                                           REQUIRE(static_cast<size_t>(data - base) == FullVertexFormat::OffsetOf<Attribute>());
+                                       });
+}
+
+TEST_CASE("Attributes are visited in order", "[vertex format]")
+{
+    auto locations = std::vector<uint32_t>{};
+    Gris::Graphics::MeshVertexFormat::ForEachAttribute([&](auto attribute)
+                                                       { locations.push_back(decltype(attribute)::LOCATION); });
+
+    REQUIRE(locations == std::vector<uint32_t>{ Gris::Graphics::PositionAttribute::LOCATION, Gris::Graphics::TextureCoordsAttribute::LOCATION });
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/vertex_kernels.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+struct InterleavedVertex
+{
+    std::array<float, 3> Position = {};
+    std::array<float, 3> Color = {};
+    std::array<float, 2> TextureCoords = {};
+};
+
+struct IndexTuple
+{
+    int32_t Position = 0;
+    int32_t Normal = 0;
+    int32_t TextureCoords = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Vertex stream copies", "[vertex kernels]")
+{
+    auto const positions = std::vector<float>{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F };
+    auto const uvs = std::vector<float>{ 0.25F, 0.0F, 0.5F, 0.25F, 1.0F, 1.0F };
+
+    auto vertices = std::vector<InterleavedVertex>(3);
+    Gris::Graphics::CopyVec3(positions.data(), 3 * sizeof(float), vertices[0].Position.data(), sizeof(InterleavedVertex), vertices.size());
+    Gris::Graphics::FillVec3(1.0F, 0.5F, 0.0F, vertices[0].Color.data(), sizeof(InterleavedVertex), vertices.size());
+    Gris::Graphics::CopyFlippedUv(uvs.data(), 2 * sizeof(float), vertices[0].TextureCoords.data(), sizeof(InterleavedVertex), vertices.size());
+
+    SECTION("Interleaving leaves the neighbouring fields alone")
+    {
+        REQUIRE(vertices[1].Position == std::array{ 4.0F, 5.0F, 6.0F });
+        REQUIRE(vertices[2].Position == std::array{ 7.0F, 8.0F, 9.0F });
+        REQUIRE(vertices[2].Color == std::array{ 1.0F, 0.5F, 0.0F });
+        REQUIRE(vertices[0].TextureCoords == std::array{ 0.25F, 1.0F });
+        REQUIRE(vertices[1].TextureCoords == std::array{ 0.5F, 0.75F });
+        REQUIRE(vertices[2].TextureCoords == std::array{ 1.0F, 0.0F });
+    }
+
+    SECTION("Deinterleaving restores the packed stream")
+    {
+        auto packed = std::vector<float>(positions.size());
+        Gris::Graphics::CopyVec3(vertices[0].Position.data(), sizeof(InterleavedVertex), packed.data(), 3 * sizeof(float), vertices.size());
+
+        REQUIRE(packed == positions);
+    }
+
+    SECTION("Filling two components")
+    {
+        Gris::Graphics::FillVec2(0.0F, 1.0F, vertices[0].TextureCoords.data(), sizeof(InterleavedVertex), vertices.size());
+
+        REQUIRE(vertices[2].TextureCoords == std::array{ 0.0F, 1.0F });
+        REQUIRE(vertices[2].Color == std::array{ 1.0F, 0.5F, 0.0F });
+    }
+}
+
+TEST_CASE("Vertex stream gathers", "[vertex kernels]")
+{
+    auto const positions = std::vector<float>{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F };
+    auto const uvs = std::vector<float>{ 0.0F, 0.0F, 0.5F, 0.25F };
+    auto const indices = std::vector<IndexTuple>{ { 1, -1, 0 }, { 0, -1, 1 }, { 1, -1, 1 } };
+
+    auto vertices = std::vector<InterleavedVertex>(indices.size());
+    Gris::Graphics::GatherVec3(positions.data(), positions.size() / 3, &indices[0].Position, sizeof(IndexTuple), vertices[0].Position.data(), sizeof(InterleavedVertex), vertices.size());
+    Gris::Graphics::GatherFlippedUv(uvs.data(), uvs.size() / 2, &indices[0].TextureCoords, sizeof(IndexTuple), vertices[0].TextureCoords.data(), sizeof(InterleavedVertex), vertices.size());
+
+    REQUIRE(vertices[0].Position == std::array{ 4.0F, 5.0F, 6.0F });
+    REQUIRE(vertices[1].Position == std::array{ 1.0F, 2.0F, 3.0F });
+    REQUIRE(vertices[2].Position == std::array{ 4.0F, 5.0F, 6.0F });
+    REQUIRE(vertices[0].TextureCoords == std::array{ 0.0F, 1.0F });
+    REQUIRE(vertices[1].TextureCoords == std::array{ 0.5F, 0.75F });
+    REQUIRE(vertices[2].Color == std::array{ 0.0F, 0.0F, 0.0F });
+}
+
+TEST_CASE("Vertex attribute packing", "[vertex kernels]")
+{
+    // Longer than the widest vector loop so both the vector and the scalar tail run
+    auto const values = std::vector<float>{ -2.0F, -1.0F, -0.5F, 0.0F, 0.25F, 0.5F, 1.0F, 2.0F, 65504.0F, 1.0e-7F, -0.0F, 0.1F, 0.75F, 0.3F, -0.3F, 1.5F, 0.6F, 3.0F, -3.0F };
+
+    SECTION("Half")
+    {
+        auto halves = std::vector<uint16_t>(values.size());
+        Gris::Graphics::PackHalf(values.data(), halves.data(), values.size());
+
+        REQUIRE(halves[0] == 0xC000);
+        REQUIRE(halves[1] == 0xBC00);
+        REQUIRE(halves[3] == 0x0000);
+        REQUIRE(halves[5] == 0x3800);
+        REQUIRE(halves[8] == 0x7BFF);
+        REQUIRE(halves[9] == 0x0002);
+        REQUIRE(halves[10] == 0x8000);
+        REQUIRE(halves[11] == 0x2E66);
+        REQUIRE(halves[18] == 0xC200);
+
+        auto const overflow = std::array{ 65520.0F, 1.0e10F };
+        auto overflowHalves = std::array<uint16_t, 2>{};
+        Gris::Graphics::PackHalf(overflow.data(), overflowHalves.data(), overflow.size());
+        REQUIRE(overflowHalves == std::array<uint16_t, 2>{ 0x7C00, 0x7C00 });
+    }
+
+    SECTION("Snorm16")
+    {
+        auto snorms = std::vector<int16_t>(values.size());
+        Gris::Graphics::PackSnorm16(values.data(), snorms.data(), values.size());
+
+        REQUIRE(snorms[0] == -32767);
+        REQUIRE(snorms[2] == -16384);
+        REQUIRE(snorms[6] == 32767);
+        REQUIRE(snorms[7] == 32767);
+        REQUIRE(snorms[14] == -9830);
+        REQUIRE(snorms[18] == -32767);
+    }
+
+    SECTION("Unorm16")
+    {
+        auto unorms = std::vector<uint16_t>(values.size());
+        Gris::Graphics::PackUnorm16(values.data(), unorms.data(), values.size());
+
+        REQUIRE(unorms[0] == 0);
+        REQUIRE(unorms[4] == 16384);
+        REQUIRE(unorms[6] == 65535);
+        REQUIRE(unorms[12] == 49151);
+        REQUIRE(unorms[17] == 65535);
+        REQUIRE(unorms[18] == 0);
+    }
+}
@@ -0,0 +1,39 @@
+#include <catch2/catch.hpp>
+
+#include <gris/graphics/scene.h>
+#include <gris/graphics/vertex_streams.h>
+
+#include <vector>
+
+TEST_CASE("Vertex streams split the mesh vertices", "[vertex streams]")
+{
+    auto vertices = std::vector<Gris::Graphics::Vertex>{};
+    for (size_t vertexIndex = 0; vertexIndex < 17; ++vertexIndex)
+    {
+        auto const value = static_cast<float>(vertexIndex);
+        vertices.push_back({ glm::vec3(value, -value, 2.0F * value), glm::vec2(0.5F * value, 1.0F - value) });
+    }
+
+    auto const positions = Gris::Graphics::ExtractVertexStream<Gris::Graphics::PositionStreamFormat>(vertices);
+    auto const attributes = Gris::Graphics::ExtractVertexStream<Gris::Graphics::AttributeStreamFormat>(vertices);
+
+    static_assert(sizeof(Gris::Graphics::PositionStreamFormat::Vertex) == 12);
+    static_assert(sizeof(Gris::Graphics::AttributeStreamFormat::Vertex) == 8);
+
+    REQUIRE(positions.size() == vertices.size());
+    REQUIRE(attributes.size() == vertices.size());
+    for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex)
+    {
+        REQUIRE(positions[vertexIndex].Position.x == vertices[vertexIndex].Position.x);
+        REQUIRE(positions[vertexIndex].Position.y == vertices[vertexIndex].Position.y);
+        REQUIRE(positions[vertexIndex].Position.z == vertices[vertexIndex].Position.z);
+        REQUIRE(attributes[vertexIndex].TextureCoords.x == vertices[vertexIndex].TextureCoords.x);
+        REQUIRE(attributes[vertexIndex].TextureCoords.y == vertices[vertexIndex].TextureCoords.y);
+    }
+}
+
+TEST_CASE("Empty meshes give empty streams", "[vertex streams]")
+{
+    auto const vertices = std::vector<Gris::Graphics::Vertex>{};
+    REQUIRE(Gris::Graphics::ExtractVertexStream<Gris::Graphics::PositionStreamFormat>(vertices).empty());
+}
@@ -0,0 +1,28 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(set = 0, binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+// Per vertex, quantized
+layout(location = 0) in vec4 inPosition;
+layout(location = 2) in vec2 inTexCoord;
+
+// Per mesh, bound as a single instance
+layout(location = 3) in vec3 inPositionOffset;
+layout(location = 4) in vec3 inPositionScale;
+layout(location = 5) in vec2 inTexCoordOffset;
+layout(location = 6) in vec2 inTexCoordScale;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main() {
+    vec3 position = inPositionOffset + inPositionScale * inPosition.xyz;
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(position, 1.0);
+    fragColor = vec3(1.0);
+    fragTexCoord = inTexCoordOffset + inTexCoordScale * inTexCoord;
+}